@@ -0,0 +1,290 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GAFFINE3D_H_
+#define _GAFFINE3D_H_
+
+#include "GExports.h"
+#include "GTolerance.h"
+#include "GMatrix4D.h"
+#include "GPoint3D.h"
+#include "GVector3D.h"
+
+#include <cstddef>
+#include <initializer_list>
+
+namespace sgl
+{
+
+/**
+ * @brief Affine transformation. Stores top three rows of GMatrix4D, the bottom row is implied
+ *   <br>[ a00, a10, a20, t0 ]
+ *   <br>[ a01, a11, a21, t1 ]
+ *   <br>[ a02, a12, a22, t2 ]
+ *   <br>[   0,   0,   0,  1 ]
+ *   <p/> Composition takes 36 multiplications instead of 64 of GMatrix4D product,
+ *   inversion of orthonormal transformation is transposition of linear part.
+ *   <p/> Converts implicitly to and from GMatrix4D. Conversion from GMatrix4D ignores its bottom row.
+ * @author Artemiy Kanshin
+ */
+class SGL_API GAffine3D
+{
+public:
+    /**
+     * @return identity transformation
+     */
+    static GAffine3D identity();
+
+public:
+    /**
+     * @brief Initializes identity transformation
+     */
+    GAffine3D();
+
+    /**
+     * @brief Copy constructor
+     */
+    GAffine3D(const GAffine3D &) = default;
+
+    /**
+     * @brief Initializes transformation by initializer list which should have 12 numbers (three rows)
+     * @throws std::invalid_argument if list has other number of elements
+     */
+    GAffine3D(std::initializer_list<double>);
+
+    /**
+     * @brief Initializes transformation with coordinate system parameters
+     * @param origin - coordinate system origin
+     * @param x - x axis
+     * @param y - y axis
+     * @param z - z axis
+     */
+    explicit GAffine3D(const GPoint3D & origin, const GVector3D & x, const GVector3D & y, const GVector3D & z);
+
+    /**
+     * @brief Initializes transformation with top three rows of matrix
+     * @param m - matrix
+     */
+    GAffine3D(const GMatrix4D & m);
+
+    /** No doc */
+    ~GAffine3D() = default;
+
+    /**
+     * @brief operator =
+     * @return reference to this transformation object
+     */
+    GAffine3D & operator=(const GAffine3D &) = default;
+
+    /**
+     * @return matrix with the same transformation
+     */
+    operator GMatrix4D() const;
+
+    /**
+     * @return matrix with the same transformation
+     */
+    GMatrix4D toMatrix() const;
+
+    /**
+     * @brief Makes this transformation identity
+     */
+    void setIdentity();
+
+    /**
+     * @return coordinate system origin
+     */
+    GPoint3D origin() const;
+
+    /**
+     * @return coordinate system x axis
+     */
+    GVector3D x() const;
+
+    /**
+     * @return coordinate system y axis
+     */
+    GVector3D y() const;
+
+    /**
+     * @return coordinate system z axis
+     */
+    GVector3D z() const;
+
+    /**
+     * @brief Gives read only access to the row by index
+     * @param row - row index [0-2]
+     * @return const pointer to row
+     */
+    const double * operator[](std::size_t row) const;
+
+    /**
+     * @brief Gives write access to the row by index
+     * @param row - row index [0-2]
+     * @return pointer to row
+     */
+    double * operator[](std::size_t row);
+
+    /**
+     * @brief Returns element of transformation matrix (including implied bottom row).
+     *   Use operator[] for write access
+     * @param row - row index [0-3]
+     * @param column - column index [0-3]
+     * @return element of matrix
+     */
+    double operator()(std::size_t row, std::size_t column) const;
+
+    /**
+     * @brief Gives read only access to the elements of three rows stored row by row
+     * @return pointer to array of 12 doubles
+     */
+    const double * data() const;
+
+    /**
+     * @brief Gives write access to the elements of three rows stored row by row
+     * @return pointer to array of 12 doubles
+     */
+    double * data();
+
+    /**
+     * @brief Produces composition: this * a
+     * @param a - another transformation
+     * @return reference to this transformation object
+     */
+    GAffine3D & postMultiplyBy(const GAffine3D & a);
+
+    /**
+     * @brief Produces composition: a * this
+     * @param a - another transformation
+     * @return reference to this transformation object
+     */
+    GAffine3D & preMultiplyBy(const GAffine3D & a);
+
+    /**
+     * @brief Sets this transformation as composition of given ones
+     * @param a1 - first transformation
+     * @param a2 - second transformation
+     * @return reference to this transformation object
+     */
+    GAffine3D & product(const GAffine3D & a1, const GAffine3D & a2);
+
+    /**
+     * @brief Inverts this transformation
+     * @return reference to this transformation object
+     * @throws std::logic_error
+     */
+    GAffine3D & invert();
+
+    /**
+     * @brief Returns inverted copy of this transformation.
+     *   Orthonormal linear part is inverted by transposition.
+     * @return inverted copy of this transformation
+     * @throws std::logic_error
+     */
+    GAffine3D inverse() const;
+
+    /**
+     * @brief Checks that linear part is orthonormal (rotation or rotation with mirroring)
+     * @param tolerance - tolerance of dot products of axes
+     * @return true if linear part is orthonormal, otherwise false
+     */
+    bool isOrthonormal(double tolerance = GTolerance::angularTol()) const;
+
+    /**
+     * @brief Checks singularity
+     * @param tolerance - zero tolerance
+     * @return true if determinant equals to zero, otherwise false
+     */
+    bool singular(double tolerance = GTolerance::zeroTol()) const;
+
+    /**
+     * @brief Computes determinant (determinant of linear part)
+     * @return determinant
+     */
+    double determinant() const;
+
+    /**
+     * @brief Compares this transformation with given within tolerance
+     * @param a - transformation to check equality
+     * @param tolerance - zero tolerance
+     * @return true if this transformation is equal to given within tolerance, otherwise false
+     */
+    bool equals(const GAffine3D & a, double tolerance = GTolerance::zeroTol()) const;
+
+private:
+    double m_pData[12];
+};
+
+/**
+ * @brief Composition of transformations
+ * @param a1 - left transformation
+ * @param a2 - right transformation
+ * @return a1 * a2
+ */
+SGL_API GAffine3D operator*(const GAffine3D & a1, const GAffine3D & a2);
+
+/**
+ * @brief Product of matrix and affine transformation
+ * @param m - left matrix
+ * @param a - right transformation
+ * @return m * a
+ */
+SGL_API GMatrix4D operator*(const GMatrix4D & m, const GAffine3D & a);
+
+/**
+ * @brief Product of affine transformation and matrix
+ * @param a - left transformation
+ * @param m - right matrix
+ * @return a * m
+ */
+SGL_API GMatrix4D operator*(const GAffine3D & a, const GMatrix4D & m);
+
+//
+// Inline implementation
+//
+
+inline const double * GAffine3D::operator[](std::size_t row) const
+{
+    return &m_pData[4 * row];
+}
+
+inline double * GAffine3D::operator[](std::size_t row)
+{
+    return &m_pData[4 * row];
+}
+
+inline double GAffine3D::operator()(std::size_t row, std::size_t column) const
+{
+    if (row == 3)
+        return column == 3 ? 1.0 : 0.0;
+    return m_pData[4 * row + column];
+}
+
+inline const double * GAffine3D::data() const
+{
+    return m_pData;
+}
+
+inline double * GAffine3D::data()
+{
+    return m_pData;
+}
+
+} //namespace sgl
+
+#endif //_GAFFINE3D_H_
@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GALIGNEDALLOCATOR_H_
+#define _GALIGNEDALLOCATOR_H_
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace sgl
+{
+
+/**
+ * @brief Default alignment of bulk data arrays. Matches cache line size and the widest SIMD register (AVX-512).
+ */
+constexpr std::size_t G_SIMD_ALIGNMENT = 64;
+
+/**
+ * @brief STL allocator which returns memory aligned to 'Alignment' bytes
+ * @tparam T - value type
+ * @tparam Alignment - alignment in bytes (power of two)
+ */
+template <typename T, std::size_t Alignment = G_SIMD_ALIGNMENT>
+class GAlignedAllocator
+{
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+    static_assert(Alignment >= alignof(T), "Alignment must not be less than alignment of type");
+
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = GAlignedAllocator<U, Alignment>;
+    };
+
+    GAlignedAllocator() noexcept = default;
+
+    template <typename U>
+    GAlignedAllocator(const GAlignedAllocator<U, Alignment> &) noexcept
+    {}
+
+    /**
+     * @brief Allocates aligned memory for 'count' objects
+     * @param count - number of objects
+     * @return pointer to allocated memory
+     * @throws std::bad_alloc
+     */
+    T * allocate(std::size_t count)
+    {
+        if (count > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_alloc();
+        return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    /**
+     * @brief Deallocates memory allocated by allocate()
+     * @param p - pointer to memory
+     */
+    void deallocate(T * p, std::size_t) noexcept
+    {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const GAlignedAllocator<U, Alignment> &) const noexcept
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const GAlignedAllocator<U, Alignment> &) const noexcept
+    {
+        return false;
+    }
+};
+
+/**
+ * @brief Array of doubles aligned for SIMD processing
+ */
+using GAlignedDoubleArray = std::vector<double, GAlignedAllocator<double>>;
+
+} //namespace sgl
+
+#endif //_GALIGNEDALLOCATOR_H_
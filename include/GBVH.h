@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GBVH_H_
+#define _GBVH_H_
+
+#include "GExports.h"
+#include "GBox3D.h"
+#include "GCollections.h"
+#include "GMatrix4D.h"
+#include "GPoint3D.h"
+#include "GVector3D.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace sgl
+{
+
+/**
+ * @brief Node of flattened bounding volume hierarchy (32 bytes).
+ *   <p/> Nodes are stored in depth-first order: left child of interior node directly follows it.
+ *   Bounds are single precision, rounded outwards, so they always enclose primitive bounds.
+ * @author Artemiy Kanshin
+ */
+struct GBVHNode
+{
+    float min[3];
+    /** Leaf: position of the first primitive in GBVH::primitives(); interior: index of right child */
+    std::uint32_t index;
+    float max[3];
+    /** Leaf: number of primitives; interior: 0 */
+    std::uint16_t count;
+    /** Interior: split axis (0 - x, 1 - y, 2 - z) */
+    std::uint16_t axis;
+
+    bool isLeaf() const { return count != 0; }
+};
+
+static_assert(sizeof(GBVHNode) == 32, "GBVHNode must occupy 32 bytes");
+
+/**
+ * @brief Bounding volume hierarchy over primitives given by their bounding boxes.
+ *   <p/> Built top-down with binned surface area heuristic, subtrees are built in parallel.
+ *   Queries use stack-based traversal without recursion. Primitive tests are exact against
+ *   primitive bounds (double precision, closed boxes); precise tests of primitive geometry are
+ *   performed by callbacks of closestHit() and nearest().
+ *   <p/> Primitives are referred to by their indices in the build sequence.
+ * @author Artemiy Kanshin
+ */
+class SGL_API GBVH
+{
+public:
+    /**
+     * @brief Ray-primitive test: returns ray parameter of hit or infinity if primitive is missed
+     */
+    using RayHitFunc = std::function<double(std::size_t primitive)>;
+
+    /**
+     * @brief Returns distance from query point to primitive, not less than distance to its bounds
+     */
+    using DistanceFunc = std::function<double(std::size_t primitive)>;
+
+    /**
+     * @brief Initializes empty hierarchy
+     */
+    GBVH();
+
+    /**
+     * @brief Builds hierarchy
+     * @param bounds - bounds of primitives
+     * @param maxLeafSize - maximal number of primitives in leaf, 1..65535
+     * @param threadCount - maximal number of build threads, 0 - number of hardware threads
+     */
+    explicit GBVH(const std::vector<GBox3D> & bounds, std::size_t maxLeafSize = 4, unsigned threadCount = 0);
+
+    /**
+     * @return number of primitives
+     */
+    std::size_t size() const;
+
+    /**
+     * @return true if hierarchy has no primitives, otherwise false
+     */
+    bool empty() const;
+
+    /**
+     * @return nodes in depth-first order, the first one is root
+     */
+    const std::vector<GBVHNode> & nodes() const;
+
+    /**
+     * @return primitive indices in leaf order
+     */
+    const std::vector<std::uint32_t> & primitives() const;
+
+    /**
+     * @return bounds of all primitives
+     * @throws std::logic_error if hierarchy is empty
+     */
+    GBox3D bounds() const;
+
+    /**
+     * @brief Updates bounds of nodes keeping the topology
+     * @param bounds - new bounds of primitives, in build sequence
+     * @throws std::invalid_argument if number of bounds differs from size()
+     */
+    void refit(const std::vector<GBox3D> & bounds);
+
+    /**
+     * @brief Updates bounds of nodes after every primitive is transformed by the same matrix.
+     *   New bounds of primitive enclose its transformed bounding box, so rotations loosen them;
+     *   use refit(bounds) with exact bounds to tighten.
+     *   <p/> Corners are transformed by GPoint3D::operator*=, i.e. as row vectors with translation
+     *   in the last matrix row, so matrices made by GMatrix4D factories must be passed transposed.
+     * @param transform - transformation matrix
+     */
+    void refit(const GMatrix4D & transform);
+
+    /**
+     * @brief Finds primitives whose bounds are hit by ray segment origin + t * direction, t in [0, maxDistance]
+     * @param origin - ray origin
+     * @param direction - ray direction
+     * @param maxDistance - maximal ray parameter
+     * @return primitive indices
+     */
+    std::vector<std::size_t> intersectRay(const GPoint3D & origin, const GVector3D & direction,
+                                          double maxDistance = std::numeric_limits<double>::infinity()) const;
+
+    /**
+     * @brief Finds the first primitive hit by ray segment origin + t * direction, t in [0, maxDistance].
+     *   Nodes are visited front to back and pruned by the closest hit found so far.
+     * @param origin - ray origin
+     * @param direction - ray direction
+     * @param maxDistance - maximal ray parameter
+     * @param hit - ray-primitive test
+     * @param primitive - [out] index of hit primitive
+     * @param distance - [out] ray parameter of hit
+     * @return true if any primitive is hit, otherwise false
+     */
+    bool closestHit(const GPoint3D & origin, const GVector3D & direction, double maxDistance, const RayHitFunc & hit,
+                    std::size_t & primitive, double & distance) const;
+
+    /**
+     * @brief Finds primitives whose bounds overlap box
+     * @param box - box
+     * @return primitive indices
+     */
+    std::vector<std::size_t> intersectBox(const GBox3D & box) const;
+
+    /**
+     * @brief Finds primitive with the nearest bounds
+     * @param pt - query point
+     * @param primitive - [out] index of the nearest primitive
+     * @param distance - [out] distance to its bounds
+     * @return true if hierarchy is not empty, otherwise false
+     */
+    bool nearest(const GPoint3D & pt, std::size_t & primitive, double & distance) const;
+
+    /**
+     * @brief Finds the nearest primitive not farther than maxDistance
+     * @param pt - query point
+     * @param distanceTo - distance from pt to primitive
+     * @param primitive - [out] index of the nearest primitive
+     * @param distance - [out] distance to it
+     * @param maxDistance - maximal distance
+     * @return true if primitive is found, otherwise false
+     */
+    bool nearest(const GPoint3D & pt, const DistanceFunc & distanceTo, std::size_t & primitive, double & distance,
+                 double maxDistance = std::numeric_limits<double>::infinity()) const;
+
+private:
+    void refitNodes();
+
+    template<typename Func>
+    bool findNearest(const GPoint3D & pt, Func && primDistance, std::size_t & primitive, double & distance,
+                     double maxDistance) const;
+
+    std::vector<GBVHNode> m_nodes;
+    std::vector<std::uint32_t> m_primitives;
+    /** Bounds of primitives in leaf order: min x, min y, min z, max x, max y, max z */
+    std::vector<double> m_bounds;
+};
+
+} //namespace sgl
+
+#endif //_GBVH_H_
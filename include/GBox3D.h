@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GBOX3D_H_
+#define _GBOX3D_H_
+
+#include "GExports.h"
+#include "GTolerance.h"
+#include "GCollections.h"
+#include "GInterval.h"
+#include "GPoint3D.h"
+#include "GVector3D.h"
+
+#include <cstddef>
+
+namespace sgl
+{
+
+/**
+ * @brief Axis-aligned box made of three coordinate intervals.
+ *   <p/> Box is closed: points and boxes touching the boundary are inside / intersecting.
+ *   Batched queries over many boxes are provided by GBox3DArray.
+ *   <p/> Use GBox3D (double) and GBox3Df (float) aliases.
+ * @tparam T - scalar type (double or float)
+ * @author Artemiy Kanshin
+ */
+template<typename T>
+class GBox3DT
+{
+public:
+    /**
+     * @brief Creates bounding box of points
+     * @param pPoints - pointer to the first point
+     * @param count - number of points
+     * @return bounding box
+     * @throws std::invalid_argument if there are no points
+     */
+    static GBox3DT fromPoints(const GPoint3DT<T> * pPoints, std::size_t count);
+
+    /**
+     * @brief Creates bounding box of points
+     * @param points - points
+     * @return bounding box
+     * @throws std::invalid_argument if there are no points
+     */
+    static GBox3DT fromPoints(const std::vector<GPoint3DT<T>> & points);
+
+public:
+    /**
+     * @brief Initializes box [0, 1] x [0, 1] x [0, 1]
+     */
+    GBox3DT() = default;
+
+    /**
+     * @brief Initializes box by coordinate intervals
+     * @param x - x interval
+     * @param y - y interval
+     * @param z - z interval
+     */
+    GBox3DT(const GIntervalT<T> & x, const GIntervalT<T> & y, const GIntervalT<T> & z);
+
+    /**
+     * @brief Initializes box by two opposite corners given in any order
+     * @param corner1 - first corner
+     * @param corner2 - second corner
+     */
+    GBox3DT(const GPoint3DT<T> & corner1, const GPoint3DT<T> & corner2);
+
+    /**
+     * @brief Initializes box with bounds of box with other scalar type
+     * @param box - box
+     */
+    template<typename U>
+    explicit GBox3DT(const GBox3DT<U> & box);
+
+    /**
+     * @return x interval
+     */
+    const GIntervalT<T> & x() const;
+
+    /**
+     * @return y interval
+     */
+    const GIntervalT<T> & y() const;
+
+    /**
+     * @return z interval
+     */
+    const GIntervalT<T> & z() const;
+
+    /**
+     * @brief Returns interval by axis index
+     * @param axis - axis index (0 - x, 1 - y, 2 - z)
+     * @return interval
+     */
+    const GIntervalT<T> & operator[](std::size_t axis) const;
+
+    /**
+     * @return corner with minimal coordinates
+     */
+    GPoint3DT<T> min() const;
+
+    /**
+     * @return corner with maximal coordinates
+     */
+    GPoint3DT<T> max() const;
+
+    /**
+     * @return center of box
+     */
+    GPoint3DT<T> center() const;
+
+    /**
+     * @return vector from min() to max()
+     */
+    GVector3DT<T> diagonal() const;
+
+    /**
+     * @brief Checks equality
+     * @param box - box to check equality
+     * @param tolerance - tolerance
+     * @return true if intervals of boxes are equal within tolerance, otherwise false
+     */
+    bool equals(const GBox3DT & box, double tolerance = GTolerance::zeroTol()) const;
+
+    /**
+     * @brief Checks intersection
+     * @param box - box to check intersection
+     * @param tolerance - tolerance
+     * @return true if boxes intersect within tolerance, otherwise false
+     */
+    bool intersects(const GBox3DT & box, double tolerance = GTolerance::zeroTol()) const;
+
+    /**
+     * @brief Checks whether point lies in box
+     * @param pt - point
+     * @param tolerance - tolerance
+     * @return true if point lies in box within tolerance, otherwise false
+     */
+    bool contains(const GPoint3DT<T> & pt, double tolerance = GTolerance::zeroTol()) const;
+
+    /**
+     * @brief Extends this box to contain given box
+     * @param box - box to add
+     * @return reference to this box object
+     */
+    GBox3DT & operator+=(const GBox3DT & box);
+
+    /**
+     * @brief Extends this box to contain given point
+     * @param pt - point to add
+     * @return reference to this box object
+     */
+    GBox3DT & operator+=(const GPoint3DT<T> & pt);
+
+private:
+    GIntervalT<T> m_intervals[3];
+};
+
+extern template class SGL_API GBox3DT<double>;
+extern template class SGL_API GBox3DT<float>;
+
+//
+// Inline implementation
+//
+
+template<typename T>
+template<typename U>
+inline GBox3DT<T>::GBox3DT(const GBox3DT<U> & box)
+    : m_intervals{ GIntervalT<T>(box.x()), GIntervalT<T>(box.y()), GIntervalT<T>(box.z()) }
+{}
+
+template<typename T>
+inline const GIntervalT<T> & GBox3DT<T>::x() const
+{
+    return m_intervals[0];
+}
+
+template<typename T>
+inline const GIntervalT<T> & GBox3DT<T>::y() const
+{
+    return m_intervals[1];
+}
+
+template<typename T>
+inline const GIntervalT<T> & GBox3DT<T>::z() const
+{
+    return m_intervals[2];
+}
+
+template<typename T>
+inline const GIntervalT<T> & GBox3DT<T>::operator[](std::size_t axis) const
+{
+    return m_intervals[axis];
+}
+
+} //namespace sgl
+
+#endif //_GBOX3D_H_
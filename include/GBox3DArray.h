@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GBOX3DARRAY_H_
+#define _GBOX3DARRAY_H_
+
+#include "GExports.h"
+#include "GAlignedAllocator.h"
+#include "GBox3D.h"
+#include "GCollections.h"
+#include "GPoint3D.h"
+#include "GVector3D.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace sgl
+{
+
+/**
+ * @brief Array of axis-aligned boxes stored as structure of arrays.
+ *   <p/> Minimal and maximal coordinates of every axis are kept in separate arrays aligned to
+ *   G_SIMD_ALIGNMENT bytes, so batched queries test several boxes per instruction.
+ *   Kernel (AVX-512, AVX2 or scalar) is chosen at runtime according to simdLevel() (see GSimd.h).
+ *   <p/> Batched queries treat boxes as closed and compare coordinates exactly, without tolerance.
+ *   Query results are written as one byte per box (1 - hit, 0 - miss).
+ * @author Artemiy Kanshin
+ */
+class SGL_API GBox3DArray
+{
+public:
+    /**
+     * @brief Initializes empty array
+     */
+    GBox3DArray();
+
+    /**
+     * @brief Initializes array with boxes of vector
+     * @param boxes - vector of boxes
+     */
+    explicit GBox3DArray(const std::vector<GBox3D> & boxes);
+
+    /**
+     * @brief Copy constructor
+     */
+    GBox3DArray(const GBox3DArray &);
+
+    /**
+     * @brief Move constructor
+     */
+    GBox3DArray(GBox3DArray &&) noexcept;
+
+    /** No doc */
+    ~GBox3DArray();
+
+    /**
+     * @brief Assignment operator
+     * @return reference to this array
+     */
+    GBox3DArray & operator=(const GBox3DArray &);
+
+    /**
+     * @brief Move assignment operator
+     * @return reference to this array
+     */
+    GBox3DArray & operator=(GBox3DArray &&) noexcept;
+
+    /**
+     * @return number of boxes
+     */
+    std::size_t size() const;
+
+    /**
+     * @return true if array has no boxes, otherwise false
+     */
+    bool empty() const;
+
+    /**
+     * @brief Reserves memory
+     * @param capacity - number of boxes
+     */
+    void reserve(std::size_t capacity);
+
+    /**
+     * @brief Removes all boxes
+     */
+    void clear();
+
+    /**
+     * @brief Appends box
+     * @param box - box
+     */
+    void push_back(const GBox3D & box);
+
+    /**
+     * @brief Returns copy of box
+     * @param index - box index
+     * @return box
+     */
+    GBox3D box(std::size_t index) const;
+
+    /**
+     * @brief Replaces box
+     * @param index - box index
+     * @param box - new box
+     */
+    void setBox(std::size_t index, const GBox3D & box);
+
+    /**
+     * @brief Gives read only access to minimal coordinates
+     * @param axis - axis index (0 - x, 1 - y, 2 - z)
+     * @return pointer to array of size() minimal coordinates
+     */
+    const double * minData(std::size_t axis) const;
+
+    /**
+     * @brief Gives read only access to maximal coordinates
+     * @param axis - axis index (0 - x, 1 - y, 2 - z)
+     * @return pointer to array of size() maximal coordinates
+     */
+    const double * maxData(std::size_t axis) const;
+
+    /**
+     * @brief Slab test of ray segment origin + t * direction, t in [0, maxDistance], against every box
+     * @param origin - ray origin
+     * @param direction - ray direction, not necessarily unit; maxDistance is measured in its lengths
+     * @param maxDistance - maximal ray parameter
+     * @param pHits - [out] size() flags, 1 if ray hits box
+     * @return number of hit boxes
+     */
+    std::size_t intersectRay(const GPoint3D & origin, const GVector3D & direction, double maxDistance,
+                             std::uint8_t * pHits) const;
+
+    /**
+     * @brief Slab test of ray segment origin + t * direction, t in [0, maxDistance], against every box
+     * @param origin - ray origin
+     * @param direction - ray direction, not necessarily unit; maxDistance is measured in its lengths
+     * @param maxDistance - maximal ray parameter
+     * @return indices of hit boxes in increasing order
+     */
+    std::vector<std::size_t> intersectRay(const GPoint3D & origin, const GVector3D & direction,
+                                          double maxDistance = std::numeric_limits<double>::infinity()) const;
+
+    /**
+     * @brief Tests overlap of given box with every box
+     * @param box - box
+     * @param pHits - [out] size() flags, 1 if boxes overlap
+     * @return number of overlapping boxes
+     */
+    std::size_t intersectBox(const GBox3D & box, std::uint8_t * pHits) const;
+
+    /**
+     * @brief Tests overlap of given box with every box
+     * @param box - box
+     * @return indices of overlapping boxes in increasing order
+     */
+    std::vector<std::size_t> intersectBox(const GBox3D & box) const;
+
+private:
+    GAlignedDoubleArray m_min[3];
+    GAlignedDoubleArray m_max[3];
+};
+
+/**
+ * @brief Classifies points given by coordinate arrays (structure of arrays) against box
+ * @param box - box
+ * @param pX - x coordinates
+ * @param pY - y coordinates
+ * @param pZ - z coordinates
+ * @param count - number of points
+ * @param pInside - [out] count flags, 1 if point lies in closed box
+ * @return number of points inside of box
+ */
+SGL_API std::size_t containsPoints(const GBox3D & box, const double * pX, const double * pY, const double * pZ,
+                                   std::size_t count, std::uint8_t * pInside);
+
+/**
+ * @brief Classifies array of points against box
+ * @param box - box
+ * @param pPoints - pointer to the first point
+ * @param count - number of points
+ * @param pInside - [out] count flags, 1 if point lies in closed box
+ * @return number of points inside of box
+ */
+SGL_API std::size_t containsPoints(const GBox3D & box, const GPoint3D * pPoints, std::size_t count,
+                                   std::uint8_t * pInside);
+
+/**
+ * @brief Classifies points of cloud against box
+ * @param box - box
+ * @param cloud - point cloud
+ * @param pInside - [out] cloud.size() flags, 1 if point lies in closed box
+ * @return number of points inside of box
+ */
+SGL_API std::size_t containsPoints(const GBox3D & box, const GPointCloud & cloud, std::uint8_t * pInside);
+
+} //namespace sgl
+
+#endif //_GBOX3DARRAY_H_
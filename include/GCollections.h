@@ -25,20 +25,65 @@
 namespace sgl
 {
 
-class GPoint3D;
+template<typename T> class GPoint3DT;
+using GPoint3D = GPoint3DT<double>;
+using GPoint3Df = GPoint3DT<float>;
 using GPoint3DArray = std::vector<GPoint3D>;
+using GPoint3DfArray = std::vector<GPoint3Df>;
 using GPoint3DPtr = std::shared_ptr<GPoint3D>;
 using GPoint3DPtrArray = std::vector<GPoint3DPtr>;
 
-class GVector3D;
+template<typename T> class GVector3DT;
+using GVector3D = GVector3DT<double>;
+using GVector3Df = GVector3DT<float>;
 using GVector3DArray = std::vector<GVector3D>;
+using GVector3DfArray = std::vector<GVector3Df>;
 using GVector3DPtr = std::shared_ptr<GVector3D>;
 using GVector3DPtrArray = std::vector<GVector3DPtr>;
 
-class GMatrix;
-using GMatrixArray = std::vector<GMatrix>;
-using GMatrixPtr = std::shared_ptr<GMatrix>;
-using GMatrixPtrArray = std::vector<GMatrixPtr>;
+template<typename T> class GMatrix4DT;
+using GMatrix4D = GMatrix4DT<double>;
+using GMatrix4Df = GMatrix4DT<float>;
+using GMatrix4DPtr = std::shared_ptr<GMatrix4D>;
+using GMatrix4DPtrArray = std::vector<GMatrix4DPtr>;
+
+template<typename T> class GIntervalT;
+using GInterval = GIntervalT<double>;
+using GIntervalf = GIntervalT<float>;
+
+template<typename T> class GBox3DT;
+using GBox3D = GBox3DT<double>;
+using GBox3Df = GBox3DT<float>;
+
+class GPointCloud;
+using GPointCloudPtr = std::shared_ptr<GPointCloud>;
+
+class GMatrix4DArray;
+using GMatrix4DArrayPtr = std::shared_ptr<GMatrix4DArray>;
+
+class GBox3DArray;
+using GBox3DArrayPtr = std::shared_ptr<GBox3DArray>;
+
+class GIntervalTree;
+using GIntervalTreePtr = std::shared_ptr<GIntervalTree>;
+
+class GSweepAndPrune;
+using GSweepAndPrunePtr = std::shared_ptr<GSweepAndPrune>;
+
+class GBVH;
+using GBVHPtr = std::shared_ptr<GBVH>;
+
+class GKDTree;
+using GKDTreePtr = std::shared_ptr<GKDTree>;
+
+class GOctree;
+using GOctreePtr = std::shared_ptr<GOctree>;
+
+class GSpatialHash;
+using GSpatialHashPtr = std::shared_ptr<GSpatialHash>;
+
+class GConvexHull;
+using GConvexHullPtr = std::shared_ptr<GConvexHull>;
 
 } //namespace sgl
 
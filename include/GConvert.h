@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GCONVERT_H_
+#define _GCONVERT_H_
+
+#include "GExports.h"
+#include "GCollections.h"
+
+#include <cstddef>
+
+namespace sgl
+{
+
+/**
+ * Batch conversion between double and float precision.
+ * <p/> Down-conversion rounds every coordinate to nearest float, exactly as
+ * static_cast<float> does; up-conversion is exact. Kernel (AVX-512, AVX2, SSE2 or scalar)
+ * is chosen at runtime according to simdLevel() (see GSimd.h).
+ * <p/> Source and destination ranges must not overlap.
+ */
+
+/**
+ * @brief Converts array of doubles to floats
+ * @param pSrc - pointer to the first source value
+ * @param pDst - pointer to the first destination value
+ * @param count - number of values
+ */
+SGL_API void convert(const double * pSrc, float * pDst, std::size_t count);
+
+/**
+ * @brief Converts array of floats to doubles
+ * @param pSrc - pointer to the first source value
+ * @param pDst - pointer to the first destination value
+ * @param count - number of values
+ */
+SGL_API void convert(const float * pSrc, double * pDst, std::size_t count);
+
+/**
+ * @brief Converts array of points to single precision
+ * @param pSrc - pointer to the first source point
+ * @param pDst - pointer to the first destination point
+ * @param count - number of points
+ */
+SGL_API void convert(const GPoint3D * pSrc, GPoint3Df * pDst, std::size_t count);
+
+/**
+ * @brief Converts array of points to double precision
+ * @param pSrc - pointer to the first source point
+ * @param pDst - pointer to the first destination point
+ * @param count - number of points
+ */
+SGL_API void convert(const GPoint3Df * pSrc, GPoint3D * pDst, std::size_t count);
+
+/**
+ * @brief Converts array of vectors to single precision
+ * @param pSrc - pointer to the first source vector
+ * @param pDst - pointer to the first destination vector
+ * @param count - number of vectors
+ */
+SGL_API void convert(const GVector3D * pSrc, GVector3Df * pDst, std::size_t count);
+
+/**
+ * @brief Converts array of vectors to double precision
+ * @param pSrc - pointer to the first source vector
+ * @param pDst - pointer to the first destination vector
+ * @param count - number of vectors
+ */
+SGL_API void convert(const GVector3Df * pSrc, GVector3D * pDst, std::size_t count);
+
+/**
+ * @brief Converts points to single precision
+ * @param points - points
+ * @return converted points
+ */
+SGL_API GPoint3DfArray toFloat(const GPoint3DArray & points);
+
+/**
+ * @brief Converts points to double precision
+ * @param points - points
+ * @return converted points
+ */
+SGL_API GPoint3DArray toDouble(const GPoint3DfArray & points);
+
+/**
+ * @brief Converts vectors to single precision
+ * @param vectors - vectors
+ * @return converted vectors
+ */
+SGL_API GVector3DfArray toFloat(const GVector3DArray & vectors);
+
+/**
+ * @brief Converts vectors to double precision
+ * @param vectors - vectors
+ * @return converted vectors
+ */
+SGL_API GVector3DArray toDouble(const GVector3DfArray & vectors);
+
+} //namespace sgl
+
+#endif //_GCONVERT_H_
@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GCONVEXHULL_H_
+#define _GCONVEXHULL_H_
+
+#include "GExports.h"
+#include "GCollections.h"
+#include "GPoint3D.h"
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace sgl
+{
+
+/**
+ * @brief Half-edge of convex hull.
+ *   <p/> Half-edge 3 * f + k goes from vertex k to vertex (k + 1) % 3 of face f.
+ * @author Artemiy Kanshin
+ */
+struct GHullHalfEdge
+{
+    /** Index of origin point */
+    std::size_t origin;
+    /** Index of opposite half-edge */
+    std::size_t twin;
+    /** Index of the next half-edge of the same face */
+    std::size_t next;
+    /** Index of face */
+    std::size_t face;
+};
+
+/**
+ * @brief Convex hull of points in space.
+ *   <p/> Built with Quickhull: every point outside of the current hull is assigned to one face it
+ *   sees, the farthest point of a face is added to the hull, faces visible from it are replaced by
+ *   the cone to their horizon and their points are reassigned to the new faces. Points are assigned
+ *   in parallel; assignments of all faces are kept in one flat array.
+ *   <p/> Visibility is decided by exact orient3d predicate, so the hull is convex for any input and
+ *   no tolerance is involved. Coplanar faces are not merged: every face is a triangle.
+ *   <p/> Faces and vertices refer to points by their indices in the build sequence. If points are
+ *   coplanar or there are less than four of them, hull is empty.
+ * @author Artemiy Kanshin
+ */
+class SGL_API GConvexHull
+{
+public:
+    /** Index of missing element */
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @brief Initializes empty hull
+     */
+    GConvexHull();
+
+    /**
+     * @brief Builds hull
+     * @param pPoints - pointer to the first point
+     * @param count - number of points
+     * @param threadCount - maximal number of build threads, 0 - number of hardware threads
+     */
+    GConvexHull(const GPoint3D * pPoints, std::size_t count, unsigned threadCount = 0);
+
+    /**
+     * @brief Builds hull
+     * @param points - points
+     * @param threadCount - maximal number of build threads, 0 - number of hardware threads
+     */
+    explicit GConvexHull(const GPoint3DArray & points, unsigned threadCount = 0);
+
+    /**
+     * @brief Builds hull
+     * @param cloud - point cloud
+     * @param threadCount - maximal number of build threads, 0 - number of hardware threads
+     */
+    explicit GConvexHull(const GPointCloud & cloud, unsigned threadCount = 0);
+
+    /**
+     * @return true if hull has no faces, otherwise false
+     */
+    bool empty() const;
+
+    /**
+     * @return number of faces
+     */
+    std::size_t faceCount() const;
+
+    /**
+     * @return indices of face points, three per face, counterclockwise when viewed from outside
+     */
+    const std::vector<std::size_t> & faces() const;
+
+    /**
+     * @return indices of faces adjacent to every face, three per face:
+     *   k-th neighbour shares edge from vertex k to vertex (k + 1) % 3
+     */
+    const std::vector<std::size_t> & neighbours() const;
+
+    /**
+     * @return sorted indices of hull vertices
+     */
+    const std::vector<std::size_t> & vertices() const;
+
+    /**
+     * @brief Builds half-edge representation of the hull
+     * @return half-edges, three per face
+     */
+    std::vector<GHullHalfEdge> halfEdges() const;
+
+private:
+    void build(const double * const * pCoords, std::size_t stride, std::size_t count, unsigned threadCount);
+
+private:
+    std::vector<std::size_t> m_faces;
+    std::vector<std::size_t> m_neighbours;
+    std::vector<std::size_t> m_vertices;
+};
+
+} //namespace sgl
+
+#endif //_GCONVEXHULL_H_
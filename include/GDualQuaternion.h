@@ -0,0 +1,298 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GDUALQUATERNION_H_
+#define _GDUALQUATERNION_H_
+
+#include "GExports.h"
+#include "GTolerance.h"
+#include "GCollections.h"
+#include "GPoint3D.h"
+#include "GQuaternion.h"
+#include "GVector3D.h"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace sgl
+{
+
+/**
+ * @brief Dual quaternion real + eps * dual. Unit dual quaternions represent rigid transformations
+ *   (rotation followed by translation) the same way as GMatrix4D(origin, x, y, z) does:
+ *   point p is transformed to R * p + t, where R is rotation of real part and t is translation.
+ *   <p/> Product dq1 * dq2 is a transformation by dq2 followed by dq1 (the same order as matrix product).
+ * @author Artemiy Kanshin
+ */
+class SGL_API GDualQuaternion
+{
+public:
+    /**
+     * @return identity dual quaternion
+     */
+    static constexpr GDualQuaternion identity();
+
+    /**
+     * @brief Creates translation
+     * @param v - translation vector
+     * @return unit dual quaternion
+     */
+    static constexpr GDualQuaternion translation(const GVector3D & v);
+
+    /**
+     * @brief Creates rotation around axis which goes through center
+     * @param angle - rotation angle
+     * @param axis - rotation axis, not necessarily unit
+     * @param center - center of rotation
+     * @return unit dual quaternion
+     * @throws std::logic_error if axis is zero vector
+     */
+    static GDualQuaternion rotation(double angle, const GVector3D & axis, const GPoint3D & center = GPoint3D::origin());
+
+    /**
+     * @brief Creates dual quaternion from rigid transformation matrix [R t; 0 0 0 1].
+     *   Rotation is normalized, so small orthogonality errors of matrix are tolerated
+     * @param m - rigid transformation matrix
+     * @return unit dual quaternion
+     */
+    static GDualQuaternion fromMatrix(const GMatrix4D & m);
+
+public:
+    /**
+     * @brief Initializes identity dual quaternion
+     */
+    constexpr GDualQuaternion() = default;
+
+    /**
+     * @brief Initializes dual quaternion with real and dual parts
+     * @param real - real part
+     * @param dual - dual part
+     */
+    constexpr explicit GDualQuaternion(const GQuaternion & real, const GQuaternion & dual);
+
+    /**
+     * @brief Initializes rigid transformation: rotation followed by translation
+     * @param rotation - unit rotation quaternion
+     * @param translation - translation vector
+     */
+    constexpr explicit GDualQuaternion(const GQuaternion & rotation, const GVector3D & translation);
+
+    /**
+     * @return real part
+     */
+    constexpr const GQuaternion & real() const;
+
+    /**
+     * @return dual part
+     */
+    constexpr const GQuaternion & dual() const;
+
+    /**
+     * @return rotation quaternion (real part)
+     */
+    constexpr const GQuaternion & rotation() const;
+
+    /**
+     * @return translation vector. Dual quaternion must be unit
+     */
+    constexpr GVector3D translation() const;
+
+    /**
+     * @brief Returns true if real part has unit norm and is orthogonal to dual part
+     * @param tolerance - tolerance
+     * @return true if dual quaternion is unit, otherwise false
+     */
+    bool isUnit(double tolerance = GTolerance::lengthTol()) const;
+
+    /**
+     * @brief Transforms dual quaternion to unit dual quaternion:
+     *   scales both parts by inverse norm of real part and removes component of dual part parallel to real part
+     * @return Reference to this dual quaternion object
+     * @throws std::logic_error
+     */
+    GDualQuaternion & normalize();
+
+    /**
+     * @brief Returns normalized copy of this dual quaternion
+     * @return normalized copy of this dual quaternion
+     * @throws std::logic_error
+     */
+    GDualQuaternion normalize() const;
+
+    /**
+     * @return inverse transformation. Dual quaternion must be unit
+     */
+    constexpr GDualQuaternion inverse() const;
+
+    /**
+     * @brief Transforms vector (only rotation is applied). Dual quaternion must be unit
+     * @param v - vector
+     * @return transformed vector
+     */
+    constexpr GVector3D transform(const GVector3D & v) const;
+
+    /**
+     * @brief Transforms point. Dual quaternion must be unit
+     * @param pt - point
+     * @return transformed point
+     */
+    constexpr GPoint3D transform(const GPoint3D & pt) const;
+
+    /**
+     * @brief Transforms array of points in place (see GTransform.h). Dual quaternion must be unit
+     * @param pPoints - pointer to the first point
+     * @param count - number of points
+     */
+    void transform(GPoint3D * pPoints, std::size_t count) const;
+
+    /**
+     * @brief Transforms array of points in place. Dual quaternion must be unit
+     * @param points - array of points
+     */
+    void transform(GPoint3DArray & points) const;
+
+    /**
+     * @brief Transforms point cloud in place. Dual quaternion must be unit
+     * @param cloud - point cloud
+     */
+    void transform(GPointCloud & cloud) const;
+
+    /**
+     * @brief Transforms array of vectors in place (only rotation is applied). Dual quaternion must be unit
+     * @param pVectors - pointer to the first vector
+     * @param count - number of vectors
+     */
+    void transform(GVector3D * pVectors, std::size_t count) const;
+
+    /**
+     * @brief Transforms array of vectors in place (only rotation is applied). Dual quaternion must be unit
+     * @param vectors - array of vectors
+     */
+    void transform(GVector3DArray & vectors) const;
+
+    /**
+     * @brief Converts dual quaternion to matrix [R t; 0 0 0 1]. Dual quaternion must be unit
+     * @return rigid transformation matrix
+     */
+    GMatrix4D toMatrix() const;
+
+    /**
+     * @brief Returns true if this dual quaternion is equal to given within tolerance
+     * @param dq - dual quaternion to check equality
+     * @param tolerance - tolerance
+     * @return true if this dual quaternion is equal to given within tolerance, otherwise false
+     */
+    bool equals(const GDualQuaternion & dq, double tolerance = GTolerance::lengthTol()) const;
+
+    /**
+     * @brief Multiplies this dual quaternion by given from the right: this = this * dq
+     * @param dq - dual quaternion
+     * @return Reference to this dual quaternion object
+     */
+    constexpr GDualQuaternion & operator*=(const GDualQuaternion & dq);
+
+private:
+    GQuaternion m_real;
+    GQuaternion m_dual{0.0, 0.0, 0.0, 0.0};
+};
+
+static_assert(std::is_trivially_copyable<GDualQuaternion>::value, "GDualQuaternion must be trivially copyable");
+static_assert(std::is_standard_layout<GDualQuaternion>::value, "GDualQuaternion must have standard layout");
+
+/**
+ * @brief Dual quaternion product (composition of transformations, dq2 is applied first)
+ * @param dq1 - first dual quaternion
+ * @param dq2 - second dual quaternion
+ * @return product
+ */
+constexpr GDualQuaternion operator*(const GDualQuaternion & dq1, const GDualQuaternion & dq2);
+
+//
+// Inline implementation
+//
+
+constexpr GDualQuaternion GDualQuaternion::identity()
+{
+    return GDualQuaternion();
+}
+
+constexpr GDualQuaternion GDualQuaternion::translation(const GVector3D & v)
+{
+    return GDualQuaternion(GQuaternion::identity(), v);
+}
+
+constexpr GDualQuaternion::GDualQuaternion(const GQuaternion & real, const GQuaternion & dual)
+    : m_real(real)
+    , m_dual(dual)
+{}
+
+constexpr GDualQuaternion::GDualQuaternion(const GQuaternion & rotation, const GVector3D & translation)
+    : m_real(rotation)
+    , m_dual(0.5 * (GQuaternion(0.0, translation) * rotation))
+{}
+
+constexpr const GQuaternion & GDualQuaternion::real() const
+{
+    return m_real;
+}
+
+constexpr const GQuaternion & GDualQuaternion::dual() const
+{
+    return m_dual;
+}
+
+constexpr const GQuaternion & GDualQuaternion::rotation() const
+{
+    return m_real;
+}
+
+constexpr GVector3D GDualQuaternion::translation() const
+{
+    GVector3D res = (m_dual * m_real.conjugate()).vector();
+    res *= 2.0;
+    return res;
+}
+
+constexpr GDualQuaternion GDualQuaternion::inverse() const
+{
+    return GDualQuaternion(m_real.conjugate(), m_dual.conjugate());
+}
+
+constexpr GVector3D GDualQuaternion::transform(const GVector3D & v) const
+{
+    return m_real.rotate(v);
+}
+
+constexpr GPoint3D GDualQuaternion::transform(const GPoint3D & pt) const
+{
+    return m_real.rotate(pt) + translation();
+}
+
+constexpr GDualQuaternion & GDualQuaternion::operator*=(const GDualQuaternion & dq)
+{
+    return *this = *this * dq;
+}
+
+constexpr GDualQuaternion operator*(const GDualQuaternion & dq1, const GDualQuaternion & dq2)
+{
+    return GDualQuaternion(dq1.real() * dq2.real(), dq1.real() * dq2.dual() + dq1.dual() * dq2.real());
+}
+
+} //namespace sgl
+
+#endif //_GDUALQUATERNION_H_
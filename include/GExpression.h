@@ -0,0 +1,430 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GEXPRESSION_H_
+#define _GEXPRESSION_H_
+
+#include "GCollections.h"
+#include "GMatrix4D.h"
+#include "GPoint3D.h"
+#include "GTolerance.h"
+#include "GUtils.h"
+#include "GVector3D.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sgl
+{
+
+/**
+ * Opt-in expression templates for point and vector arithmetic.
+ * <p/> Wrapping any operand with lazy() turns the whole expression into a tree of light
+ * nodes instead of a chain of temporaries:
+ * <pre>
+ *     GPoint3D res = evaluate(lazy(pt) + (lazy(v1) * v2) * m);
+ *     evaluate(lazy(points) + (lazy(normals) * 0.5) * m, result);
+ * </pre>
+ * Operators have the same meaning as for plain values: * is cross product of vectors,
+ * product with scalar or transformation by matrix (either side, like GPoint3D::operator*=),
+ * % is scalar product. Arrays (std::vector or pointer with size) are combined element-wise
+ * and single values are broadcast to every element, so evaluate() over arrays runs
+ * one fused loop without intermediate arrays.
+ * <p/> Points, vectors and scalars are captured by value, matrices and arrays by reference,
+ * so expression holding them must not outlive them. Destination array may be one of
+ * array operands.
+ */
+namespace expr
+{
+
+/**
+ * Size reported by expressions without array operands, such expressions are broadcast
+ * to every element. Empty array has size 0 and is not broadcast.
+ */
+constexpr std::size_t BROADCAST = static_cast<std::size_t>(-1);
+
+/**
+ * @brief Base of all expression nodes
+ * @tparam Derived - node type
+ */
+template<typename Derived>
+struct GExpr
+{
+    constexpr const Derived & derived() const { return static_cast<const Derived &>(*this); }
+};
+
+/**
+ * @brief Single value broadcast to every element
+ */
+template<typename V>
+class GValue : public GExpr<GValue<V>>
+{
+public:
+    using value_type = V;
+
+    constexpr explicit GValue(const V & value) : m_value{ value } {}
+
+    constexpr std::size_t size() const { return BROADCAST; }
+    constexpr const V & eval(std::size_t) const { return m_value; }
+
+private:
+    V m_value;
+};
+
+/**
+ * @brief Matrix operand, captured by reference
+ */
+template<typename T>
+class GMatrixRef : public GExpr<GMatrixRef<T>>
+{
+public:
+    using value_type = GMatrix4DT<T>;
+
+    constexpr explicit GMatrixRef(const GMatrix4DT<T> & m) : m_pMatrix{ &m } {}
+
+    constexpr std::size_t size() const { return BROADCAST; }
+    constexpr const GMatrix4DT<T> & eval(std::size_t) const { return *m_pMatrix; }
+
+private:
+    const GMatrix4DT<T> * m_pMatrix;
+};
+
+/**
+ * @brief Array operand, captured by reference
+ */
+template<typename V>
+class GArray : public GExpr<GArray<V>>
+{
+public:
+    using value_type = V;
+
+    constexpr GArray(const V * pData, std::size_t count) : m_pData{ pData }, m_count{ count } {}
+
+    constexpr std::size_t size() const { return m_count; }
+    constexpr const V & eval(std::size_t idx) const { return m_pData[idx]; }
+
+private:
+    const V * m_pData;
+    std::size_t m_count;
+};
+
+/**
+ * @brief Node applying Op to results of two nodes
+ */
+template<typename Op, typename L, typename R>
+class GBinary : public GExpr<GBinary<Op, L, R>>
+{
+public:
+    using value_type = decltype(Op::apply(std::declval<typename L::value_type>(),
+                                          std::declval<typename R::value_type>()));
+
+    constexpr GBinary(const L & left, const R & right) : m_left{ left }, m_right{ right } {}
+
+    /**
+     * @return number of elements, 0 if expression has no array operands
+     * @throws std::invalid_argument if array operands have different sizes
+     */
+    constexpr std::size_t size() const
+    {
+        const std::size_t left = m_left.size();
+        const std::size_t right = m_right.size();
+        if (left == BROADCAST)
+            return right;
+        if (right != BROADCAST && left != right)
+            throw std::invalid_argument("Expression: array operands have different sizes");
+        return left;
+    }
+
+    constexpr value_type eval(std::size_t idx) const
+    {
+        return Op::apply(m_left.eval(idx), m_right.eval(idx));
+    }
+
+private:
+    L m_left;
+    R m_right;
+};
+
+/**
+ * @brief Node applying Op to result of single node
+ */
+template<typename Op, typename E>
+class GUnary : public GExpr<GUnary<Op, E>>
+{
+public:
+    using value_type = decltype(Op::apply(std::declval<typename E::value_type>()));
+
+    constexpr explicit GUnary(const E & e) : m_expr{ e } {}
+
+    constexpr std::size_t size() const { return m_expr.size(); }
+    constexpr value_type eval(std::size_t idx) const { return Op::apply(m_expr.eval(idx)); }
+
+private:
+    E m_expr;
+};
+
+struct GPlus
+{
+    template<typename A, typename B>
+    static constexpr auto apply(const A & a, const B & b) { return a + b; }
+};
+
+struct GMinus
+{
+    template<typename A, typename B>
+    static constexpr auto apply(const A & a, const B & b) { return a - b; }
+};
+
+struct GDot
+{
+    template<typename T>
+    static constexpr T apply(const GVector3DT<T> & v1, const GVector3DT<T> & v2) { return v1 % v2; }
+};
+
+struct GNegate
+{
+    template<typename T>
+    static constexpr GVector3DT<T> apply(const GVector3DT<T> & v) { return GVector3DT<T>(-v[0], -v[1], -v[2]); }
+};
+
+struct GDivide
+{
+    template<typename T, typename S, typename = std::enable_if_t<std::is_arithmetic<S>::value>>
+    static constexpr GVector3DT<T> apply(const GVector3DT<T> & v, S scalar)
+    {
+        if (equal(static_cast<double>(scalar), 0, GTolerance::zeroTol()))
+            throw std::logic_error("Expression: division by zero");
+        const T inv = T(1) / static_cast<T>(scalar);
+        return GVector3DT<T>(v[0] * inv, v[1] * inv, v[2] * inv);
+    }
+};
+
+struct GMultiply
+{
+    template<typename T>
+    static constexpr GVector3DT<T> apply(const GVector3DT<T> & v1, const GVector3DT<T> & v2) { return v1 * v2; }
+
+    template<typename T, typename S, typename = std::enable_if_t<std::is_arithmetic<S>::value>>
+    static constexpr GVector3DT<T> apply(const GVector3DT<T> & v, S scalar)
+    {
+        const T s = static_cast<T>(scalar);
+        return GVector3DT<T>(v[0] * s, v[1] * s, v[2] * s);
+    }
+
+    template<typename T, typename S, typename = std::enable_if_t<std::is_arithmetic<S>::value>>
+    static constexpr GVector3DT<T> apply(S scalar, const GVector3DT<T> & v) { return apply(v, scalar); }
+
+    template<typename T>
+    static GPoint3DT<T> apply(const GPoint3DT<T> & pt, const GMatrix4DT<T> & m)
+    {
+        const T * pM = m.data();
+        return GPoint3DT<T>(pM[0] * pt[0] + pM[4] * pt[1] + pM[8] * pt[2] + pM[12],
+                            pM[1] * pt[0] + pM[5] * pt[1] + pM[9] * pt[2] + pM[13],
+                            pM[2] * pt[0] + pM[6] * pt[1] + pM[10] * pt[2] + pM[14]);
+    }
+
+    template<typename T>
+    static GVector3DT<T> apply(const GVector3DT<T> & v, const GMatrix4DT<T> & m)
+    {
+        const T * pM = m.data();
+        return GVector3DT<T>(pM[0] * v[0] + pM[4] * v[1] + pM[8] * v[2],
+                             pM[1] * v[0] + pM[5] * v[1] + pM[9] * v[2],
+                             pM[2] * v[0] + pM[6] * v[1] + pM[10] * v[2]);
+    }
+
+    template<typename T>
+    static GPoint3DT<T> apply(const GMatrix4DT<T> & m, const GPoint3DT<T> & pt) { return apply(pt, m); }
+
+    template<typename T>
+    static GVector3DT<T> apply(const GMatrix4DT<T> & m, const GVector3DT<T> & v) { return apply(v, m); }
+};
+
+/**
+ * @brief Maps operand type to expression node. Not defined for unsupported types.
+ */
+template<typename X, typename = void>
+struct GWrap
+{};
+
+template<typename E>
+struct GWrap<E, std::enable_if_t<std::is_base_of<GExpr<E>, E>::value>>
+{
+    using type = E;
+    static constexpr const E & wrap(const E & e) { return e; }
+};
+
+template<typename S>
+struct GWrap<S, std::enable_if_t<std::is_arithmetic<S>::value>>
+{
+    using type = GValue<S>;
+    static constexpr type wrap(S s) { return type(s); }
+};
+
+template<typename T>
+struct GWrap<GPoint3DT<T>>
+{
+    using type = GValue<GPoint3DT<T>>;
+    static constexpr type wrap(const GPoint3DT<T> & pt) { return type(pt); }
+};
+
+template<typename T>
+struct GWrap<GVector3DT<T>>
+{
+    using type = GValue<GVector3DT<T>>;
+    static constexpr type wrap(const GVector3DT<T> & v) { return type(v); }
+};
+
+template<typename T>
+struct GWrap<GMatrix4DT<T>>
+{
+    using type = GMatrixRef<T>;
+    static constexpr type wrap(const GMatrix4DT<T> & m) { return type(m); }
+};
+
+template<typename V, typename Alloc>
+struct GWrap<std::vector<V, Alloc>>
+{
+    using type = GArray<V>;
+    static type wrap(const std::vector<V, Alloc> & array) { return type(array.data(), array.size()); }
+};
+
+template<typename X>
+using GWrapped = typename GWrap<X>::type;
+
+template<typename X>
+constexpr bool isExpr = std::is_base_of<GExpr<X>, X>::value;
+
+template<typename A, typename B>
+using GEnableBinary = std::enable_if_t<isExpr<A> || isExpr<B>>;
+
+template<typename A, typename B, typename = GEnableBinary<A, B>>
+constexpr GBinary<GPlus, GWrapped<A>, GWrapped<B>> operator+(const A & a, const B & b)
+{
+    return { GWrap<A>::wrap(a), GWrap<B>::wrap(b) };
+}
+
+template<typename A, typename B, typename = GEnableBinary<A, B>>
+constexpr GBinary<GMinus, GWrapped<A>, GWrapped<B>> operator-(const A & a, const B & b)
+{
+    return { GWrap<A>::wrap(a), GWrap<B>::wrap(b) };
+}
+
+template<typename A, typename B, typename = GEnableBinary<A, B>>
+constexpr GBinary<GMultiply, GWrapped<A>, GWrapped<B>> operator*(const A & a, const B & b)
+{
+    return { GWrap<A>::wrap(a), GWrap<B>::wrap(b) };
+}
+
+template<typename A, typename B, typename = GEnableBinary<A, B>>
+constexpr GBinary<GDivide, GWrapped<A>, GWrapped<B>> operator/(const A & a, const B & b)
+{
+    return { GWrap<A>::wrap(a), GWrap<B>::wrap(b) };
+}
+
+template<typename A, typename B, typename = GEnableBinary<A, B>>
+constexpr GBinary<GDot, GWrapped<A>, GWrapped<B>> operator%(const A & a, const B & b)
+{
+    return { GWrap<A>::wrap(a), GWrap<B>::wrap(b) };
+}
+
+template<typename E>
+constexpr GUnary<GNegate, E> operator-(const GExpr<E> & e)
+{
+    return GUnary<GNegate, E>(e.derived());
+}
+
+} //namespace expr
+
+/**
+ * @brief Starts lazy expression
+ * @param x - point, vector, scalar, matrix or std::vector of points or vectors
+ * @return expression node
+ */
+template<typename X>
+constexpr expr::GWrapped<X> lazy(const X & x)
+{
+    return expr::GWrap<X>::wrap(x);
+}
+
+/**
+ * @brief Starts lazy expression over array given by pointer
+ * @param pData - pointer to the first element
+ * @param count - number of elements
+ * @return expression node
+ */
+template<typename V>
+constexpr expr::GArray<V> lazy(const V * pData, std::size_t count)
+{
+    return expr::GArray<V>(pData, count);
+}
+
+/**
+ * @brief Evaluates expression without array operands
+ * @param e - expression
+ * @return result
+ * @throws std::invalid_argument if expression has array operands
+ */
+template<typename E>
+constexpr typename E::value_type evaluate(const expr::GExpr<E> & e)
+{
+    if (e.derived().size() != expr::BROADCAST)
+        throw std::invalid_argument("Expression: array expression cannot be evaluated to single value");
+    return e.derived().eval(0);
+}
+
+/**
+ * @brief Evaluates expression element by element in one loop
+ * @param e - expression
+ * @param pDst - pointer to the first destination element
+ * @param count - number of elements
+ * @throws std::invalid_argument if expression has array operands of other size
+ */
+template<typename E>
+void evaluate(const expr::GExpr<E> & e, typename E::value_type * pDst, std::size_t count)
+{
+    const E & ex = e.derived();
+    const std::size_t size = ex.size();
+    if (size != expr::BROADCAST && size != count)
+        throw std::invalid_argument("Expression: destination size differs from operands size");
+    for (std::size_t idx = 0; idx < count; ++idx)
+        pDst[idx] = ex.eval(idx);
+}
+
+/**
+ * @brief Evaluates expression element by element in one loop
+ * @param e - expression
+ * @param dst - destination array, resized to the size of array operands
+ * @throws std::invalid_argument if array operands have different sizes
+ *         or expression has no array operands
+ */
+template<typename E>
+void evaluate(const expr::GExpr<E> & e, std::vector<typename E::value_type> & dst)
+{
+    const std::size_t size = e.derived().size();
+    if (size == expr::BROADCAST)
+        throw std::invalid_argument("Expression: expression without array operands has no size");
+    dst.resize(size);
+    evaluate(e, dst.data(), dst.size());
+}
+
+} //namespace sgl
+
+#endif //_GEXPRESSION_H_
@@ -21,75 +21,88 @@
 
 #include "GExports.h"
 #include "GTolerance.h"
+#include "GCollections.h"
+
+#include <initializer_list>
 
 namespace sgl
 {
 
 /**
  * @brief Class represents linear interval. 'from' <= 'to'
+ *   <p/> Use GInterval (double) and GIntervalf (float) aliases.
+ * @tparam T - scalar type (double or float)
  */
-class SGL_API GInterval
+template<typename T>
+class GIntervalT
 {
 public:
     /**
      * @brief Initializes interval [0, 1]
      */
-    GInterval();
+    GIntervalT();
 
     /**
      * @brief Copy constructor
      */
-    GInterval(const GInterval &);
+    GIntervalT(const GIntervalT &);
 
     /**
      * @brief Move constructor
      */
-    GInterval(GInterval&&) noexcept;
+    GIntervalT(GIntervalT&&) noexcept;
 
     /**
      * @brief Initializes interval ['from', 'to'] if 'from' <= 'to' or ['to', 'from'] if 'from' > 'to'
      * @param from - from
      * @param to - to
      */
-    GInterval(double from, double to);
+    GIntervalT(T from, T to);
+
+    /**
+     * @brief Initializes interval with bounds of interval with other scalar type
+     * @param interval - interval
+     */
+    template<typename U>
+    explicit GIntervalT(const GIntervalT<U> & interval);
 
     /**
      * @brief Initializes interval by initializer list
      */
-    GInterval(std::initializer_list<double>);
+    GIntervalT(std::initializer_list<T>);
 
     /** No doc */
-    ~GInterval();
+    ~GIntervalT();
 
     /**
      * @brief Assignment operator
      * @return reference to this interval object
      */
-    GInterval & operator=(const GInterval&);
+    GIntervalT & operator=(const GIntervalT&);
 
     /**
      * @brief Returns first value of interval
      * @return first value of interval
      */
-    double from() const;
+    T from() const;
 
     /**
      * @brief Sets 'from' value. Inverts if new 'from' is more than current 'to'
      * @param from - new 'from' value
      */
-    void setFrom(double from);
+    void setFrom(T from);
 
     /**
      * @brief Returns second value of interval
      * @return second value of interval
      */
-    double to() const;
+    T to() const;
 
     /**
      * @brief Sets 'to' value. Inverts if new 'to' is less than current 'from'
      * @param to - new 'to' value
      */
-    void setTo(double to);
+    void setTo(T to);
 
     /**
      * @brief Checks equality
@@ -97,7 +110,7 @@ public:
      * @param tolerance - tolerance
      * @return true if 'this' interval equals to given interval within tolerance, otherwise false
      */
-    bool equals(const GInterval & interval, double tolerance = GTolerance::zeroTol()) const;
+    bool equals(const GIntervalT & interval, double tolerance = GTolerance::zeroTol()) const;
 
     /**
      * @brief Checks intersection
@@ -105,7 +118,15 @@ public:
      * @param tolerance - tolerance
      * @return true if 'this' and given interval intersect within tolerance
      */
-    bool intersects(const GInterval & interval, double tolerance = GTolerance::zeroTol()) const;
+    bool intersects(const GIntervalT & interval, double tolerance = GTolerance::zeroTol()) const;
+
+    /**
+     * @brief Checks whether value lies in the interval
+     * @param value - value to check
+     * @param tolerance - tolerance
+     * @return true if 'from' - tolerance <= value <= 'to' + tolerance, otherwise false
+     */
+    bool contains(T value, double tolerance = GTolerance::zeroTol()) const;
 
     /**
      * @brief Returns true if this->to() < interval.from()
@@ -113,7 +134,7 @@ public:
      * @param tolerance - tolerance
      * @return true if this->to() < interval.from(), otherwise false
      */
-    bool less(const GInterval & interval, double tolerance = GTolerance::zeroTol()) const;
+    bool less(const GIntervalT & interval, double tolerance = GTolerance::zeroTol()) const;
 
     /**
      * @brief Returns true if this->from() > interval.to()
@@ -121,19 +142,32 @@ public:
      * @param tolerance - tolerance
      * @return true if this->from() > interval.to(), otherwise false
      */
-    bool more(const GInterval & interval, double tolerance = GTolerance::zeroTol()) const;
+    bool more(const GIntervalT & interval, double tolerance = GTolerance::zeroTol()) const;
 
     /**
      * @brief Creates interval [std::min(this->from(), interval.from()), std::max(this->to(), interval.to())]
      * @param interval - interval to add
      * @return Reference to this interval object
      */
-    GInterval & operator+=(const GInterval & interval);
+    GIntervalT & operator+=(const GIntervalT & interval);
 
 private:
-    double m_from{0}, m_to{1.0};
+    T m_from{0}, m_to{1};
 };
 
+extern template class SGL_API GIntervalT<double>;
+extern template class SGL_API GIntervalT<float>;
+
+//
+// Inline implementation
+//
+
+template<typename T>
+template<typename U>
+inline GIntervalT<T>::GIntervalT(const GIntervalT<U> & interval)
+    : m_from{ static_cast<T>(interval.from()) }, m_to{ static_cast<T>(interval.to()) }
+{}
+
 } //namespace sgl
 
 #endif //_GINTERVAL_H_
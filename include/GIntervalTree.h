@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GINTERVALTREE_H_
+#define _GINTERVALTREE_H_
+
+#include "GExports.h"
+#include "GCollections.h"
+#include "GInterval.h"
+#include "GTolerance.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace sgl
+{
+
+/**
+ * @brief Static index of intervals answering stabbing and overlap queries.
+ *   <p/> Intervals are sorted by 'from' and kept as an implicit balanced binary tree laid over
+ *   the sorted arrays (in-order layout): every node stores the maximal 'to' of its subtree,
+ *   so no pointers are allocated and subtrees occupy contiguous memory.
+ *   <p/> Query visits only subtrees with 'from' not past the query and maximal 'to' reaching it,
+ *   i.e. the search path and the paths to reported intervals: O((k + 1) * log(n)) for k results
+ *   in the worst case, close to O(log(n) + k) when results are clustered as they share paths.
+ *   <p/> Queries follow GInterval::intersects: interval [a, b] is reported for query [c, d]
+ *   if !(b < c - tolerance) and !(a > d + tolerance). Stabbing query of value v is overlap
+ *   query of degenerate interval [v, v].
+ *   <p/> Results are indices of intervals in the build sequence; their order is unspecified.
+ * @author Artemiy Kanshin
+ */
+class SGL_API GIntervalTree
+{
+public:
+    /**
+     * @brief Initializes empty index
+     */
+    GIntervalTree();
+
+    /**
+     * @brief Builds index over intervals
+     * @param pIntervals - pointer to the first interval
+     * @param count - number of intervals
+     */
+    GIntervalTree(const GInterval * pIntervals, std::size_t count);
+
+    /**
+     * @brief Builds index over intervals
+     * @param intervals - intervals
+     */
+    explicit GIntervalTree(const std::vector<GInterval> & intervals);
+
+    /**
+     * @return number of intervals
+     */
+    std::size_t size() const;
+
+    /**
+     * @return true if index has no intervals, otherwise false
+     */
+    bool empty() const;
+
+    /**
+     * @brief Returns indexed interval
+     * @param index - index of interval in the build sequence
+     * @return interval
+     */
+    GInterval interval(std::size_t index) const;
+
+    /**
+     * @brief Finds intervals containing value
+     * @param value - value
+     * @param tolerance - tolerance
+     * @return indices of intervals
+     */
+    std::vector<std::size_t> stab(double value, double tolerance = GTolerance::zeroTol()) const;
+
+    /**
+     * @brief Finds intervals intersecting given interval
+     * @param interval - query interval
+     * @param tolerance - tolerance
+     * @return indices of intervals
+     */
+    std::vector<std::size_t> overlap(const GInterval & interval, double tolerance = GTolerance::zeroTol()) const;
+
+    /**
+     * @brief Appends indices of intervals intersecting given interval to result
+     * @param interval - query interval
+     * @param tolerance - tolerance
+     * @param result - [out] vector the indices are appended to
+     * @return number of appended indices
+     */
+    std::size_t overlap(const GInterval & interval, double tolerance, std::vector<std::size_t> & result) const;
+
+    /**
+     * @brief Answers stabbing queries of several values
+     * @param values - values
+     * @param tolerance - tolerance
+     * @return indices of intervals for every value
+     */
+    std::vector<std::vector<std::size_t>> stab(const std::vector<double> & values,
+                                               double tolerance = GTolerance::zeroTol()) const;
+
+    /**
+     * @brief Answers overlap queries of several intervals
+     * @param intervals - query intervals
+     * @param tolerance - tolerance
+     * @return indices of intervals for every query
+     */
+    std::vector<std::vector<std::size_t>> overlap(const std::vector<GInterval> & intervals,
+                                                  double tolerance = GTolerance::zeroTol()) const;
+
+private:
+    std::size_t query(double from, double to, std::vector<std::size_t> & result) const;
+
+    std::vector<double> m_from;
+    std::vector<double> m_to;
+    std::vector<double> m_maxTo;
+    std::vector<std::size_t> m_index;
+    std::vector<std::size_t> m_position;
+    int m_rootLevel = -1;
+};
+
+} //namespace sgl
+
+#endif //_GINTERVALTREE_H_
@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GKDTREE_H_
+#define _GKDTREE_H_
+
+#include "GExports.h"
+#include "GCollections.h"
+#include "GPoint3D.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace sgl
+{
+
+/**
+ * @brief Static KD-tree over points for nearest neighbour and radius queries.
+ *   <p/> The tree is implicit: points are reordered so that every range [begin, end) longer than
+ *   leaf size has its splitting point in the middle, points of the left half are not greater and
+ *   points of the right half are not less along the split axis. Coordinates are stored packed in
+ *   this order, so no node structures are allocated and leaves are contiguous in memory.
+ *   <p/> Query results are indices of points in the build sequence and Euclidean distances.
+ *   Single queries don't allocate; batched queries split query set between threads and write
+ *   results to caller buffers.
+ * @author Artemiy Kanshin
+ */
+class SGL_API GKDTree
+{
+public:
+    /** Index of missing neighbour in batched results */
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @brief Initializes empty tree
+     */
+    GKDTree();
+
+    /**
+     * @brief Builds tree
+     * @param pPoints - pointer to the first point
+     * @param count - number of points
+     * @param threadCount - maximal number of build threads, 0 - number of hardware threads
+     */
+    GKDTree(const GPoint3D * pPoints, std::size_t count, unsigned threadCount = 0);
+
+    /**
+     * @brief Builds tree
+     * @param points - points
+     * @param threadCount - maximal number of build threads, 0 - number of hardware threads
+     */
+    explicit GKDTree(const GPoint3DArray & points, unsigned threadCount = 0);
+
+    /**
+     * @brief Builds tree
+     * @param cloud - point cloud
+     * @param threadCount - maximal number of build threads, 0 - number of hardware threads
+     */
+    explicit GKDTree(const GPointCloud & cloud, unsigned threadCount = 0);
+
+    /**
+     * @return number of points
+     */
+    std::size_t size() const;
+
+    /**
+     * @return true if tree has no points, otherwise false
+     */
+    bool empty() const;
+
+    /**
+     * @brief Returns point
+     * @param index - index of point in the build sequence
+     * @return point
+     */
+    GPoint3D point(std::size_t index) const;
+
+    /**
+     * @return coordinates of points in tree order: x, y and z of every point, 3 * size() numbers
+     */
+    const std::vector<double> & coords() const;
+
+    /**
+     * @return indices of points in the build sequence, in tree order
+     */
+    const std::vector<std::size_t> & indices() const;
+
+    /**
+     * @brief Finds the nearest point
+     * @param pt - query point
+     * @param distance - [out] distance to the nearest point
+     * @return index of the nearest point
+     * @throws std::logic_error if tree is empty
+     */
+    std::size_t nearest(const GPoint3D & pt, double & distance) const;
+
+    /**
+     * @brief Finds k nearest points sorted by distance
+     * @param pt - query point
+     * @param k - number of neighbours
+     * @param pIndices - [out] min(k, size()) indices of points
+     * @param pDistances - [out] min(k, size()) distances
+     * @return number of found points: min(k, size())
+     */
+    std::size_t knn(const GPoint3D & pt, std::size_t k, std::size_t * pIndices, double * pDistances) const;
+
+    /**
+     * @brief Finds k nearest points sorted by distance
+     * @param pt - query point
+     * @param k - number of neighbours
+     * @return indices of points
+     */
+    std::vector<std::size_t> knn(const GPoint3D & pt, std::size_t k) const;
+
+    /**
+     * @brief Finds points within closed ball. Order of points is unspecified
+     * @param pt - center of ball
+     * @param radius - radius of ball
+     * @param result - [out] vector the indices are appended to
+     * @return number of appended indices
+     */
+    std::size_t radius(const GPoint3D & pt, double radius, std::vector<std::size_t> & result) const;
+
+    /**
+     * @brief Finds points within closed ball. Order of points is unspecified
+     * @param pt - center of ball
+     * @param radius - radius of ball
+     * @param pIndices - [out] buffer for at most capacity indices
+     * @param capacity - size of buffer
+     * @return number of points in ball, may exceed capacity
+     */
+    std::size_t radius(const GPoint3D & pt, double radius, std::size_t * pIndices, std::size_t capacity) const;
+
+    /**
+     * @brief Answers k nearest neighbours queries in parallel.
+     *   Neighbours of query q are written to pIndices[q * k] and pDistances[q * k],
+     *   missing ones (k > size()) are npos with infinite distance.
+     * @param pQueries - pointer to the first query point
+     * @param count - number of queries
+     * @param k - number of neighbours
+     * @param pIndices - [out] count * k indices
+     * @param pDistances - [out] count * k distances, may be nullptr
+     * @param threadCount - maximal number of threads, 0 - number of hardware threads
+     */
+    void knn(const GPoint3D * pQueries, std::size_t count, std::size_t k, std::size_t * pIndices,
+             double * pDistances, unsigned threadCount = 0) const;
+
+    /**
+     * @brief Answers radius queries in parallel.
+     *   At most capacity indices of query q are written to pIndices[q * capacity].
+     * @param pQueries - pointer to the first query point
+     * @param count - number of queries
+     * @param radius - radius of balls
+     * @param capacity - size of result buffer of every query
+     * @param pIndices - [out] count * capacity indices
+     * @param pCounts - [out] count numbers of points in balls, may exceed capacity
+     * @param threadCount - maximal number of threads, 0 - number of hardware threads
+     */
+    void radius(const GPoint3D * pQueries, std::size_t count, double radius, std::size_t capacity,
+                std::size_t * pIndices, std::size_t * pCounts, unsigned threadCount = 0) const;
+
+private:
+    void build(const double * const * pCoords, std::size_t stride, std::size_t count, unsigned threadCount);
+    std::size_t search(const GPoint3D & pt, std::size_t k, std::size_t * pIndices, double * pDistances) const;
+
+    template<typename Func>
+    void visitBall(const GPoint3D & pt, double radius, Func && func) const;
+
+    /** Coordinates in tree order: x, y, z of every point */
+    std::vector<double> m_coords;
+    /** Indices of points in the build sequence, in tree order */
+    std::vector<std::size_t> m_index;
+    /** Split axis of range whose middle is this position */
+    std::vector<std::uint8_t> m_axis;
+    /** Position of point in tree order, by index in the build sequence */
+    std::vector<std::size_t> m_position;
+};
+
+} //namespace sgl
+
+#endif //_GKDTREE_H_
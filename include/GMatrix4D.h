@@ -21,14 +21,59 @@
 
 #include "GExports.h"
 #include "GTolerance.h"
+#include "GCollections.h"
 #include "GPoint3D.h"
+#include "GVector3D.h"
 
 #include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
 
 namespace sgl
 {
 
-class GVector3D;
+/**
+ * @brief 2x2 minors of 4x4 matrix stored row by row, shared by determinant and inversion
+ *   (Laplace expansion along the first two rows).
+ *   <p/> s[k] are minors of rows 0-1 and c[k] are complementary minors of rows 2-3,
+ *   so that determinant is s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0.
+ * @tparam T - scalar type (double or float)
+ */
+template<typename T>
+struct GMatrix4DMinors
+{
+    T s[6]{};
+    T c[6]{};
+
+    /**
+     * @brief Computes minors of matrix
+     * @param a - 16 elements of matrix, row by row
+     */
+    constexpr explicit GMatrix4DMinors(const T * a)
+    {
+        s[0] = a[0] * a[5] - a[4] * a[1];
+        s[1] = a[0] * a[6] - a[4] * a[2];
+        s[2] = a[0] * a[7] - a[4] * a[3];
+        s[3] = a[1] * a[6] - a[5] * a[2];
+        s[4] = a[1] * a[7] - a[5] * a[3];
+        s[5] = a[2] * a[7] - a[6] * a[3];
+
+        c[5] = a[10] * a[15] - a[14] * a[11];
+        c[4] = a[9] * a[15] - a[13] * a[11];
+        c[3] = a[9] * a[14] - a[13] * a[10];
+        c[2] = a[8] * a[15] - a[12] * a[11];
+        c[1] = a[8] * a[14] - a[12] * a[10];
+        c[0] = a[8] * a[13] - a[12] * a[9];
+    }
+
+    /**
+     * @return determinant of matrix
+     */
+    constexpr T determinant() const
+    {
+        return s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+    }
+};
 
 /**
  * @brief Transformation matrix
@@ -41,36 +86,49 @@ class GVector3D;
  *   <br>                         0.0, 1.0, 0.0, 7.0,
  *   <br>                         0.0, 0.0, 1.0, 4.0,
  *   <br>                         0.0, 0.0, 0.0, 1.0 };
+ *   <p/> Constructors, factories except rotation() and operator * are constexpr, so fixed
+ *   transformation chains can be folded into single matrix at compile time:
+ *   <br> constexpr GMatrix4D calibration = GMatrix4D::translation(v) * GMatrix4D::scale(2.0);
+ *   <p/> Use GMatrix4D (double) and GMatrix4Df (float) aliases.
+ * @tparam T - scalar type (double or float)
  * @author Artemiy Kanshin
  */
-class SGL_API GMatrix4D
+template<typename T>
+class GMatrix4DT
 {
 public:
     /**
      * @return identity matrix
      */
-    static const GMatrix4D & identity();
+    static constexpr GMatrix4DT identity();
 
 public:
     /**
      * @brief Initializes identity matrix
      */
-    GMatrix4D();
+    constexpr GMatrix4DT() = default;
 
     /**
      * @brief Copy constructor
      */
-    GMatrix4D(const GMatrix4D &);
+    constexpr GMatrix4DT(const GMatrix4DT &) = default;
 
     /**
      * @brief Move constructor
      */
-    GMatrix4D(GMatrix4D &&) noexcept;
+    constexpr GMatrix4DT(GMatrix4DT &&) noexcept = default;
 
     /**
      * @brief Initializes matrix by initializer list which should have 16 numbers
      */
-    GMatrix4D(std::initializer_list<double>);
+    constexpr GMatrix4DT(std::initializer_list<T>);
+
+    /**
+     * @brief Initializes matrix with elements of matrix with other scalar type
+     * @param m - matrix
+     */
+    template<typename U>
+    constexpr explicit GMatrix4DT(const GMatrix4DT<U> & m);
 
     /**
      * @brief Initializes matrix with coordinate system parameters
@@ -79,56 +137,64 @@ public:
      * @param y - y axis
      * @param z - z axis
      */
-    explicit GMatrix4D(const GPoint3D & origin, const GVector3D & x, const GVector3D & y, const GVector3D & z);
+    constexpr explicit GMatrix4DT(const GPoint3DT<T> & origin,
+                                  const GVector3DT<T> & x, const GVector3DT<T> & y, const GVector3DT<T> & z);
 
     /** No doc */
-    ~GMatrix4D();
+    ~GMatrix4DT() = default;
 
     /**
      * @brief operator =
      * @param m - matrix
      * @return reference to this matrix object
      */
-    GMatrix4D & operator=(const GMatrix4D & m);
+    constexpr GMatrix4DT & operator=(const GMatrix4DT & m) = default;
+
+    /**
+     * @brief Move assignment operator
+     * @param m - matrix
+     * @return reference to this matrix object
+     */
+    constexpr GMatrix4DT & operator=(GMatrix4DT && m) noexcept = default;
 
     /**
      * @brief Makes this matrix identity
      */
-    void setIdentity();
+    constexpr void setIdentity();
 
     /**
      * @return coordinate system origin
      */
-    GPoint3D origin() const;
+    constexpr GPoint3DT<T> origin() const;
 
     /**
      * @return coordinate system x axis
      */
-    GVector3D x() const;
+    constexpr GVector3DT<T> x() const;
 
     /**
      * @return coordinate system y axis
      */
-    GVector3D y() const;
+    constexpr GVector3DT<T> y() const;
 
     /**
      * @return coordinate system z axis
      */
-    GVector3D z() const;
+    constexpr GVector3DT<T> z() const;
 
     /**
      * @brief Gives read only access to the matrix row by index
      * @param row - row index
      * @return const pointer to row
      */
-    const double * const operator[](std::size_t row) const;
+    constexpr const T * const operator[](std::size_t row) const;
 
     /**
      * @brief Gives write access to the matrix row by index
      * @param row - row index
      * @return pointer to row
      */
-    double * operator[](std::size_t row);
+    constexpr T * operator[](std::size_t row);
 
     /**
      * @brief Returns element of matrix
@@ -136,7 +202,7 @@ public:
      * @param column - column index
      * @return element of matrix
      */
-    double operator()(std::size_t row, std::size_t column) const;
+    constexpr T operator()(std::size_t row, std::size_t column) const;
 
     /**
      * @brief Returns reference to element of matrix
@@ -144,21 +210,33 @@ public:
      * @param column - column index
      * @return reference to element of matrix
      */
-    double & operator()(std::size_t row, std::size_t column);
+    constexpr T & operator()(std::size_t row, std::size_t column);
+
+    /**
+     * @brief Gives read only access to the matrix elements stored row by row
+     * @return pointer to array of 16 scalars
+     */
+    constexpr const T * data() const;
+
+    /**
+     * @brief Gives write access to the matrix elements stored row by row
+     * @return pointer to array of 16 scalars
+     */
+    constexpr T * data();
 
     /**
      * @brief Produces multiplication of matrix: this * m
      * @param m - another matrix
      * @return reference to this matrix object
      */
-    GMatrix4D & postMultiplyBy(const GMatrix4D & m);
+    constexpr GMatrix4DT & postMultiplyBy(const GMatrix4DT & m);
 
     /**
      * @brief Produces multiplication of matrix: m * this
      * @param m - another matrix
      * @return reference to this matrix object
      */
-    GMatrix4D & preMultiplyBy(const GMatrix4D & m);
+    constexpr GMatrix4DT & preMultiplyBy(const GMatrix4DT & m);
 
     /**
      * @brief Sets this matrix as result of multiplication of given matrices
@@ -166,25 +244,46 @@ public:
      * @param m2 - second matrix
      * @return reference to this matrix object
      */
-    GMatrix4D & product(const GMatrix4D & m1, const GMatrix4D & m2);
+    constexpr GMatrix4DT & product(const GMatrix4DT & m1, const GMatrix4DT & m2);
 
     /**
      * @brief Returns transposed copy of this matrix
      * @return transposed copy of this matrix
      */
-    GMatrix4D transpose() const;
+    constexpr GMatrix4DT transpose() const;
 
     /**
      * @brief Inverts this matrix
      * @return reference to this matrix object
+     * @throws std::logic_error
      */
-    GMatrix4D & invert();
+    GMatrix4DT & invert();
 
     /**
      * @brief Returns inverted copy of this matrix
      * @return inverted copy of this matrix
+     * @throws std::logic_error
      */
-    GMatrix4D inverse() const;
+    GMatrix4DT inverse() const;
+
+    /**
+     * @brief Computes inverse matrix without throwing.
+     *   Determinant, adjugate and condition number are computed in one pass (2x2 subdeterminants expansion),
+     *   so near-singular matrices can be rejected by condition number without extra cost.
+     * @param inverse - [out] inverted matrix, unchanged if matrix is singular
+     * @param pCondition - [out, optional] condition number in infinity norm: ||m|| * ||m^-1||,
+     *   infinity if matrix is singular
+     * @param tolerance - zero tolerance of determinant
+     * @return true if matrix has been inverted, false if determinant equals to zero
+     */
+    bool tryInvert(GMatrix4DT & inverse, T * pCondition = nullptr, double tolerance = GTolerance::zeroTol()) const;
+
+    /**
+     * @brief Computes condition number in infinity norm: ||m|| * ||m^-1||.
+     *   Values close to 1 mean well conditioned matrix, large values mean that matrix is close to singular
+     * @return condition number or infinity if matrix is singular
+     */
+    T conditionNumber() const;
 
     /**
      * @brief Checks matrix singularity
@@ -197,7 +296,7 @@ public:
      * @brief Computes determinant of this matrix
      * @return determinant of this matrix
      */
-    double determinant() const;
+    constexpr T determinant() const;
 
     /**
      * @brief Compares this matrix with given within tolerance
@@ -205,28 +304,28 @@ public:
      * @param tolerance - zero tolerance
      * @return true if this matrix is equal to given within tolerance, otherwise false
      */
-    bool equals(const GMatrix4D & m, double tolerance = GTolerance::zeroTol());
+    bool equals(const GMatrix4DT & m, double tolerance = GTolerance::zeroTol()) const;
 
     /**
      * @brief Multiplies each matrix element by scalar
      * @param scalar - scalar
      * @return Reference to this matrix object
      */
-    GMatrix4D & operator*=(double scalar);
+    constexpr GMatrix4DT & operator*=(T scalar);
 
     /**
      * @brief Divides each matrix element by scalar
      * @param scalar - scalar
      * @return Reference to this matrix object
      */
-    GMatrix4D & operator/=(double scalar);
+    constexpr GMatrix4DT & operator/=(T scalar);
 
     /**
      * @brief Creates translation matrix
      * @param v - translation vector
      * @return translation matrix
      */
-    static GMatrix4D translation(const GVector3D & v);
+    static constexpr GMatrix4DT translation(const GVector3DT<T> & v);
 
     /**
      * @brief Creates rotation matrix
@@ -235,7 +334,8 @@ public:
      * @param center - center of rotation
      * @return rotation matrix
      */
-    static GMatrix4D rotation(double angle, const GVector3D & axis, const GPoint3D & center = GPoint3D::origin());
+    static GMatrix4DT rotation(T angle, const GVector3DT<T> & axis,
+                               const GPoint3DT<T> & center = GPoint3DT<T>::origin());
 
     /**
      * @brief Creates scale matrix
@@ -243,7 +343,7 @@ public:
      * @param base - base point
      * @return scale matrix
      */
-    static GMatrix4D scale(double scale, const GPoint3D & base = GPoint3D::origin());
+    static constexpr GMatrix4DT scale(T scale, const GPoint3DT<T> & base = GPoint3DT<T>());
 
     /**
      * @brief Creates scale matrix
@@ -253,7 +353,7 @@ public:
      * @param base - base point
      * @return scale matrix
      */
-    static GMatrix4D scale(double scaleX, double scaleY, double scaleZ, const GPoint3D & base = GPoint3D::origin());
+    static constexpr GMatrix4DT scale(T scaleX, T scaleY, T scaleZ, const GPoint3DT<T> & base = GPoint3DT<T>());
 
     /**
      * @brief Creates scale matrix
@@ -262,7 +362,8 @@ public:
      * @param base - base point
      * @return scale matrix
      */
-    static GMatrix4D scale(double scale, const GVector3D & direction, const GPoint3D & base = GPoint3D::origin());
+    static constexpr GMatrix4DT scale(T scale, const GVector3DT<T> & direction,
+                                      const GPoint3DT<T> & base = GPoint3DT<T>());
 
     /**
      * @brief Creates mirror matrix
@@ -270,7 +371,7 @@ public:
      * @param direction - mirroring direction
      * @return mirror matrix
      */
-    static GMatrix4D mirror(const GPoint3D & base, const GVector3D & direction);
+    static constexpr GMatrix4DT mirror(const GPoint3DT<T> & base, const GVector3DT<T> & direction);
 
     /**
      * @brief Creates projection matrix
@@ -279,7 +380,8 @@ public:
      * @param prjDir - projection direction
      * @return projection matrix
      */
-    static GMatrix4D projection(const GPoint3D & plnPoint, const GVector3D & plnNormal, const GVector3D & prjDir);
+    static constexpr GMatrix4DT projection(const GPoint3DT<T> & plnPoint, const GVector3DT<T> & plnNormal,
+                                           const GVector3DT<T> & prjDir);
 
     /**
      * @brief Creates projection matrix
@@ -287,10 +389,13 @@ public:
      * @param plnNormal - projection plane normal
      * @return projection matrix
      */
-    static GMatrix4D projection(const GPoint3D & plnPoint, const GVector3D & plnNormal);
+    static constexpr GMatrix4DT projection(const GPoint3DT<T> & plnPoint, const GVector3DT<T> & plnNormal);
 
 private:
-    double m_pData[16];
+    T m_pData[16]{ 1, 0, 0, 0,
+                   0, 1, 0, 0,
+                   0, 0, 1, 0,
+                   0, 0, 0, 1 };
 };
 
 /**
@@ -299,7 +404,262 @@ private:
  * @param m2 - right matrix
  * @return Result matrix
  */
-SGL_API GMatrix4D operator*(const GMatrix4D & m1, const GMatrix4D & m2);
+template<typename T>
+constexpr GMatrix4DT<T> operator*(const GMatrix4DT<T> & m1, const GMatrix4DT<T> & m2);
+
+extern template class SGL_API GMatrix4DT<double>;
+extern template class SGL_API GMatrix4DT<float>;
+
+static_assert(std::is_trivially_copyable<GMatrix4D>::value, "GMatrix4D must be trivially copyable");
+
+//
+// Inline implementation
+//
+
+template<typename T>
+constexpr GMatrix4DT<T> GMatrix4DT<T>::identity()
+{
+    return GMatrix4DT();
+}
+
+template<typename T>
+constexpr GMatrix4DT<T>::GMatrix4DT(std::initializer_list<T> l)
+{
+    std::size_t idx = 0;
+    for (auto it = l.begin(); it != l.end() && idx < 16; ++it)
+        m_pData[idx++] = *it;
+}
+
+template<typename T>
+template<typename U>
+constexpr GMatrix4DT<T>::GMatrix4DT(const GMatrix4DT<U> & m)
+{
+    for (std::size_t idx = 0; idx < 16; ++idx)
+        m_pData[idx] = static_cast<T>(m.data()[idx]);
+}
+
+template<typename T>
+constexpr GMatrix4DT<T>::GMatrix4DT(const GPoint3DT<T> & o,
+                                    const GVector3DT<T> & x, const GVector3DT<T> & y, const GVector3DT<T> & z)
+    : m_pData{ x[0], y[0], z[0], o[0],
+               x[1], y[1], z[1], o[1],
+               x[2], y[2], z[2], o[2],
+                  0,    0,    0,    1 }
+{}
+
+template<typename T>
+constexpr void GMatrix4DT<T>::setIdentity()
+{
+    *this = GMatrix4DT();
+}
+
+template<typename T>
+constexpr GPoint3DT<T> GMatrix4DT<T>::origin() const
+{
+    return GPoint3DT<T>(m_pData[3], m_pData[7], m_pData[11]);
+}
+
+template<typename T>
+constexpr GVector3DT<T> GMatrix4DT<T>::x() const
+{
+    return GVector3DT<T>(m_pData[0], m_pData[4], m_pData[8]);
+}
+
+template<typename T>
+constexpr GVector3DT<T> GMatrix4DT<T>::y() const
+{
+    return GVector3DT<T>(m_pData[1], m_pData[5], m_pData[9]);
+}
+
+template<typename T>
+constexpr GVector3DT<T> GMatrix4DT<T>::z() const
+{
+    return GVector3DT<T>(m_pData[2], m_pData[6], m_pData[10]);
+}
+
+template<typename T>
+constexpr const T * const GMatrix4DT<T>::operator[](std::size_t row) const
+{
+    return &m_pData[4 * row];
+}
+
+template<typename T>
+constexpr T * GMatrix4DT<T>::operator[](std::size_t row)
+{
+    return &m_pData[4 * row];
+}
+
+template<typename T>
+constexpr T GMatrix4DT<T>::operator()(std::size_t row, std::size_t column) const
+{
+    return m_pData[4 * row + column];
+}
+
+template<typename T>
+constexpr T & GMatrix4DT<T>::operator()(std::size_t row, std::size_t column)
+{
+    return m_pData[4 * row + column];
+}
+
+template<typename T>
+constexpr const T * GMatrix4DT<T>::data() const
+{
+    return m_pData;
+}
+
+template<typename T>
+constexpr T * GMatrix4DT<T>::data()
+{
+    return m_pData;
+}
+
+template<typename T>
+constexpr GMatrix4DT<T> & GMatrix4DT<T>::postMultiplyBy(const GMatrix4DT<T> & m)
+{
+    return *this = *this * m;
+}
+
+template<typename T>
+constexpr GMatrix4DT<T> & GMatrix4DT<T>::preMultiplyBy(const GMatrix4DT<T> & m)
+{
+    return *this = m * *this;
+}
+
+template<typename T>
+constexpr GMatrix4DT<T> & GMatrix4DT<T>::product(const GMatrix4DT<T> & m1, const GMatrix4DT<T> & m2)
+{
+    return *this = m1 * m2;
+}
+
+template<typename T>
+constexpr GMatrix4DT<T> GMatrix4DT<T>::transpose() const
+{
+    const auto & m = *this;
+    return { m(0, 0), m(1, 0), m(2, 0), m(3, 0),
+             m(0, 1), m(1, 1), m(2, 1), m(3, 1),
+             m(0, 2), m(1, 2), m(2, 2), m(3, 2),
+             m(0, 3), m(1, 3), m(2, 3), m(3, 3) };
+}
+
+template<typename T>
+constexpr T GMatrix4DT<T>::determinant() const
+{
+    return GMatrix4DMinors<T>(m_pData).determinant();
+}
+
+template<typename T>
+constexpr GMatrix4DT<T> & GMatrix4DT<T>::operator*=(T scalar)
+{
+    for (auto it = m_pData; it != m_pData + 16; ++it)
+        *it *= scalar;
+    return *this;
+}
+
+template<typename T>
+constexpr GMatrix4DT<T> & GMatrix4DT<T>::operator/=(T scalar)
+{
+    for (auto it = m_pData; it != m_pData + 16; ++it)
+        *it /= scalar;
+    return *this;
+}
+
+template<typename T>
+constexpr GMatrix4DT<T> GMatrix4DT<T>::translation(const GVector3DT<T> & v)
+{
+    return { 1, 0, 0, v[0],
+             0, 1, 0, v[1],
+             0, 0, 1, v[2],
+             0, 0, 0,    1 };
+}
+
+template<typename T>
+constexpr GMatrix4DT<T> GMatrix4DT<T>::scale(T scale, const GPoint3DT<T> & base)
+{
+    return { scale,     0,     0, base[0],
+                 0, scale,     0, base[1],
+                 0,     0, scale, base[2],
+                 0,     0,     0,       1 };
+}
+
+template<typename T>
+constexpr GMatrix4DT<T> GMatrix4DT<T>::scale(T scaleX, T scaleY, T scaleZ, const GPoint3DT<T> & base)
+{
+    return { scaleX,      0,      0, base[0],
+                  0, scaleY,      0, base[1],
+                  0,      0, scaleZ, base[2],
+                  0,      0,      0,       1 };
+}
+
+template<typename T>
+constexpr GMatrix4DT<T> GMatrix4DT<T>::scale(T scale, const GVector3DT<T> & direction, const GPoint3DT<T> & base)
+{
+    return { scale * direction[0],                    0,                    0, base[0],
+                                0, scale * direction[1],                    0, base[1],
+                                0,                    0, scale * direction[2], base[2],
+                                0,                    0,                    0,       1 };
+}
+
+// Mirror and projection matrices don't depend on length of direction vectors,
+// so they are built from squared lengths and dot products without normalization.
+
+template<typename T>
+constexpr GMatrix4DT<T> GMatrix4DT<T>::mirror(const GPoint3DT<T> & base, const GVector3DT<T> & direction)
+{
+    const T len2 = direction % direction;
+    if (len2 == 0)
+        throw std::logic_error("GVector3D: division by zero");
+    const GVector3DT<T> & d = direction;
+    const T k = 2 / len2;
+    const T coef = k * (base.asVector() % d);
+    return { 1 - k * d[0] * d[0],    -k * d[0] * d[1],    -k * d[0] * d[2], d[0] * coef,
+                -k * d[0] * d[1], 1 - k * d[1] * d[1],    -k * d[1] * d[2], d[1] * coef,
+                -k * d[0] * d[2],    -k * d[1] * d[2], 1 - k * d[2] * d[2], d[2] * coef,
+                               0,                   0,                   0,           1 };
+}
+
+template<typename T>
+constexpr GMatrix4DT<T> GMatrix4DT<T>::projection(const GPoint3DT<T> & plnPoint, const GVector3DT<T> & plnNormal,
+                                                  const GVector3DT<T> & prjDir)
+{
+    if (plnNormal % plnNormal == 0 || prjDir % prjDir == 0)
+        throw std::logic_error("GVector3D: division by zero");
+    const GVector3DT<T> & n = plnNormal;
+    const GVector3DT<T> & u = prjDir;
+    const T coef1 = 1 / (n % u);
+    const T coef2 = (n % plnPoint.asVector()) * coef1;
+    return { 1 - u[0] * n[0] * coef1,    -u[1] * n[0] * coef1,    -u[2] * n[0] * coef1, u[0] * coef2,
+                -u[0] * n[1] * coef1, 1 - u[1] * n[1] * coef1,    -u[2] * n[1] * coef1, u[1] * coef2,
+                -u[0] * n[2] * coef1,    -u[1] * n[2] * coef1, 1 - u[2] * n[2] * coef1, u[2] * coef2,
+                                   0,                       0,                       0,            1 };
+}
+
+template<typename T>
+constexpr GMatrix4DT<T> GMatrix4DT<T>::projection(const GPoint3DT<T> & plnPoint, const GVector3DT<T> & plnNormal)
+{
+    const T len2 = plnNormal % plnNormal;
+    if (len2 == 0)
+        throw std::logic_error("GVector3D: division by zero");
+    const GVector3DT<T> & n = plnNormal;
+    const T k = 1 / len2;
+    const T coef = k * (n % plnPoint.asVector());
+    return { 1 - k * n[0] * n[0],    -k * n[0] * n[1],    -k * n[0] * n[2], n[0] * coef,
+                -k * n[0] * n[1], 1 - k * n[1] * n[1],    -k * n[1] * n[2], n[1] * coef,
+                -k * n[0] * n[2],    -k * n[1] * n[2], 1 - k * n[2] * n[2], n[2] * coef,
+                               0,                   0,                   0,           1 };
+}
+
+template<typename T>
+constexpr GMatrix4DT<T> operator*(const GMatrix4DT<T> & m1, const GMatrix4DT<T> & m2)
+{
+    GMatrix4DT<T> res;
+    for (std::size_t row = 0; row < 4; ++row)
+    {
+        for (std::size_t col = 0; col < 4; ++col)
+            res(row, col) = m1(row, 0) * m2(0, col) + m1(row, 1) * m2(1, col) +
+                            m1(row, 2) * m2(2, col) + m1(row, 3) * m2(3, col);
+    }
+    return res;
+}
 
 } //namespace sgl
 
@@ -0,0 +1,282 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GMATRIX4DARRAY_H_
+#define _GMATRIX4DARRAY_H_
+
+#include "GExports.h"
+#include "GTolerance.h"
+#include "GAlignedAllocator.h"
+#include "GCollections.h"
+#include "GMatrix4D.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace sgl
+{
+
+/**
+ * @brief Array of transformation matrices stored as array of structures of arrays (AoSoA).
+ *   <p/> Matrices are grouped into blocks of BlockSize matrices. Inside of a block every matrix element
+ *   is stored as BlockSize consecutive values (one per matrix), so element (row, column) of matrix 'index' is
+ *   data()[(index / BlockSize) * BlockStride + (4 * row + column) * BlockSize + index % BlockSize].
+ *   <p/> Batched operations process a whole block (one matrix per SIMD lane) per instruction.
+ *   Unused matrices of the last block are kept equal to identity.
+ * @author Artemiy Kanshin
+ */
+class SGL_API GMatrix4DArray
+{
+public:
+    /** Number of matrices in a block */
+    static constexpr std::size_t BlockSize = 8;
+    /** Number of values in a block */
+    static constexpr std::size_t BlockStride = 16 * BlockSize;
+public:
+    /**
+     * @brief Initializes empty array
+     */
+    GMatrix4DArray();
+    /**
+     * @brief Initializes array with 'size' identity matrices
+     * @param size - number of matrices
+     */
+    explicit GMatrix4DArray(std::size_t size);
+    /**
+     * @brief Initializes array with matrices of vector
+     * @param matrices - vector of matrices
+     */
+    explicit GMatrix4DArray(const std::vector<GMatrix4D> & matrices);
+    /**
+     * @brief Copy constructor
+     */
+    GMatrix4DArray(const GMatrix4DArray &);
+    /**
+     * @brief Move constructor
+     */
+    GMatrix4DArray(GMatrix4DArray &&) noexcept;
+    /** No doc */
+    ~GMatrix4DArray();
+    /**
+     * @brief Assignment operator
+     * @return reference to this array
+     */
+    GMatrix4DArray & operator=(const GMatrix4DArray &);
+    /**
+     * @brief Move assignment operator
+     * @return reference to this array
+     */
+    GMatrix4DArray & operator=(GMatrix4DArray &&) noexcept;
+    /**
+     * @return number of matrices
+     */
+    std::size_t size() const;
+    /**
+     * @return true if array has no matrices, otherwise false
+     */
+    bool empty() const;
+    /**
+     * @return number of blocks
+     */
+    std::size_t blockCount() const;
+    /**
+     * @brief Changes number of matrices. New matrices are identity
+     * @param size - new number of matrices
+     */
+    void resize(std::size_t size);
+    /**
+     * @brief Reserves memory
+     * @param capacity - number of matrices
+     */
+    void reserve(std::size_t capacity);
+    /**
+     * @brief Removes all matrices
+     */
+    void clear();
+    /**
+     * @brief Appends matrix
+     * @param m - matrix
+     */
+    void push_back(const GMatrix4D & m);
+    /**
+     * @brief Replaces matrices of this array with matrices of vector. Reuses allocated memory
+     * @param matrices - vector of matrices
+     */
+    void assign(const std::vector<GMatrix4D> & matrices);
+    /**
+     * @return vector with copy of matrices
+     */
+    std::vector<GMatrix4D> toArray() const;
+    /**
+     * @brief Returns copy of matrix
+     * @param index - matrix index
+     * @return copy of matrix
+     */
+    GMatrix4D matrix(std::size_t index) const;
+    /**
+     * @brief Sets matrix
+     * @param index - matrix index
+     * @param m - new matrix value
+     */
+    void setMatrix(std::size_t index, const GMatrix4D & m);
+    /**
+     * @brief Gives read only access to matrix element
+     * @param index - matrix index
+     * @param row - row index
+     * @param column - column index
+     * @return matrix element
+     */
+    double operator()(std::size_t index, std::size_t row, std::size_t column) const;
+    /**
+     * @brief Gives write access to matrix element
+     * @param index - matrix index
+     * @param row - row index
+     * @param column - column index
+     * @return reference to matrix element
+     */
+    double & operator()(std::size_t index, std::size_t row, std::size_t column);
+    /**
+     * @return pointer to aligned AoSoA data (blockCount() * BlockStride values)
+     */
+    const double * data() const;
+    /**
+     * @return pointer to aligned AoSoA data (blockCount() * BlockStride values)
+     */
+    double * data();
+    /**
+     * @brief Multiplies every matrix by matrix 'm' from the right
+     * @param m - right matrix
+     * @return reference to this array
+     */
+    GMatrix4DArray & postMultiplyBy(const GMatrix4D & m);
+    /**
+     * @brief Multiplies every matrix by matrix 'm' from the left
+     * @param m - left matrix
+     * @return reference to this array
+     */
+    GMatrix4DArray & preMultiplyBy(const GMatrix4D & m);
+    /**
+     * @brief Multiplies every matrix by the matrix of array 'm' with the same index from the right
+     * @param m - array of right matrices
+     * @return reference to this array
+     * @throws std::invalid_argument if arrays have different sizes
+     */
+    GMatrix4DArray & postMultiplyBy(const GMatrix4DArray & m);
+    /**
+     * @brief Multiplies every matrix by the matrix of array 'm' with the same index from the left
+     * @param m - array of left matrices
+     * @return reference to this array
+     * @throws std::invalid_argument if arrays have different sizes
+     */
+    GMatrix4DArray & preMultiplyBy(const GMatrix4DArray & m);
+    /**
+     * @brief Sets this array to element-wise products m1[i] * m2[i]
+     * @param m1 - array of left matrices
+     * @param m2 - array of right matrices
+     * @return reference to this array
+     * @throws std::invalid_argument if arrays have different sizes
+     */
+    GMatrix4DArray & product(const GMatrix4DArray & m1, const GMatrix4DArray & m2);
+    /**
+     * @return array of transposed matrices
+     */
+    GMatrix4DArray transpose() const;
+    /**
+     * @brief Inverts all matrices
+     * @return reference to this array
+     * @throws std::logic_error if any matrix is singular, array stays unchanged in that case
+     */
+    GMatrix4DArray & invert();
+    /**
+     * @brief Returns array of inverted matrices
+     * @return array of inverted matrices
+     * @throws std::logic_error if any matrix is singular
+     */
+    GMatrix4DArray inverse() const;
+    /**
+     * @brief Inverts matrices without throwing. Singular matrices are replaced by identity
+     * @param inverse - [out] array of inverted matrices, resized to size()
+     * @param pInverted - [out, optional] array of size() flags, false for singular matrices
+     * @param tolerance - zero tolerance of determinant
+     * @return true if all matrices have been inverted, otherwise false
+     */
+    bool tryInvert(GMatrix4DArray & inverse, bool * pInverted = nullptr,
+                   double tolerance = GTolerance::zeroTol()) const;
+    /**
+     * @brief Computes determinants of all matrices
+     * @param pDeterminants - [out] array of size() determinants
+     */
+    void determinants(double * pDeterminants) const;
+    /**
+     * @return vector of determinants
+     */
+    std::vector<double> determinants() const;
+private:
+    static std::size_t offset(std::size_t index, std::size_t row, std::size_t column);
+private:
+    GAlignedDoubleArray m_data;
+    std::size_t m_size{ 0 };
+};
+
+//
+// Inline implementation
+//
+
+inline std::size_t GMatrix4DArray::size() const
+{
+    return m_size;
+}
+
+inline bool GMatrix4DArray::empty() const
+{
+    return m_size == 0;
+}
+
+inline std::size_t GMatrix4DArray::blockCount() const
+{
+    return m_data.size() / BlockStride;
+}
+
+inline std::size_t GMatrix4DArray::offset(std::size_t index, std::size_t row, std::size_t column)
+{
+    return (index / BlockSize) * BlockStride + (4 * row + column) * BlockSize + index % BlockSize;
+}
+
+inline double GMatrix4DArray::operator()(std::size_t index, std::size_t row, std::size_t column) const
+{
+    return m_data[offset(index, row, column)];
+}
+
+inline double & GMatrix4DArray::operator()(std::size_t index, std::size_t row, std::size_t column)
+{
+    return m_data[offset(index, row, column)];
+}
+
+inline const double * GMatrix4DArray::data() const
+{
+    return m_data.data();
+}
+
+inline double * GMatrix4DArray::data()
+{
+    return m_data.data();
+}
+
+} //namespace sgl
+
+#endif //_GMATRIX4DARRAY_H_
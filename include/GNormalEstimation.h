@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GNORMALESTIMATION_H_
+#define _GNORMALESTIMATION_H_
+
+#include "GExports.h"
+#include "GCollections.h"
+
+#include <cstddef>
+
+namespace sgl
+{
+
+/**
+ * Estimation of point cloud normals.
+ * <p/> Normal of point is the eigenvector of the smallest eigenvalue of covariance matrix of its
+ * neighbours (k nearest points or points within radius, including the point itself). Eigenvectors
+ * are computed by Jacobi rotations. Points are split between threads, every thread reuses its own
+ * neighbour buffers, so no memory is allocated per point.
+ * <p/> Normal is undefined if point has less than three neighbours or the smallest eigenvalue is
+ * not simple (neighbours are coincident, collinear or isotropic); such normals are zero vectors.
+ * Estimated normals are unit vectors with arbitrary sign, orientNormals() makes signs consistent.
+ * <p/> Points are given by GKDTree, normals are indexed by the build sequence of the tree.
+ */
+
+/**
+ * @brief Estimates normals from k nearest neighbours
+ * @param tree - tree of points
+ * @param k - number of neighbours, at least 3
+ * @param normals - [out] tree.size() normals
+ * @param threadCount - maximal number of threads, 0 - number of hardware threads
+ * @return number of defined normals
+ * @throws std::invalid_argument if number of neighbours is less than 3
+ */
+SGL_API std::size_t estimateNormals(const GKDTree & tree, std::size_t k, GVector3DArray & normals,
+                                    unsigned threadCount = 0);
+
+/**
+ * @brief Estimates normals from k nearest neighbours to coordinate arrays
+ * @param tree - tree of points
+ * @param k - number of neighbours, at least 3
+ * @param pX - [out] tree.size() x coordinates of normals
+ * @param pY - [out] tree.size() y coordinates of normals
+ * @param pZ - [out] tree.size() z coordinates of normals
+ * @param threadCount - maximal number of threads, 0 - number of hardware threads
+ * @return number of defined normals
+ * @throws std::invalid_argument if number of neighbours is less than 3
+ */
+SGL_API std::size_t estimateNormals(const GKDTree & tree, std::size_t k, double * pX, double * pY, double * pZ,
+                                    unsigned threadCount = 0);
+
+/**
+ * @brief Estimates normals of cloud points from k nearest neighbours and stores them in the cloud
+ *   (normals are enabled if necessary)
+ * @param cloud - point cloud
+ * @param k - number of neighbours, at least 3
+ * @param threadCount - maximal number of threads, 0 - number of hardware threads
+ * @return number of defined normals
+ * @throws std::invalid_argument if number of neighbours is less than 3
+ */
+SGL_API std::size_t estimateNormals(GPointCloud & cloud, std::size_t k, unsigned threadCount = 0);
+
+/**
+ * @brief Estimates normals from neighbours within radius. If there are more than maxNeighbours points
+ *   within radius, maxNeighbours nearest ones are used
+ * @param tree - tree of points
+ * @param radius - radius of neighbourhood
+ * @param maxNeighbours - maximal number of neighbours
+ * @param normals - [out] tree.size() normals
+ * @param threadCount - maximal number of threads, 0 - number of hardware threads
+ * @return number of defined normals
+ * @throws std::invalid_argument if number of neighbours is less than 3
+ */
+SGL_API std::size_t estimateNormalsInRadius(const GKDTree & tree, double radius, std::size_t maxNeighbours,
+                                            GVector3DArray & normals, unsigned threadCount = 0);
+
+/**
+ * @brief Estimates normals from neighbours within radius to coordinate arrays
+ * @see estimateNormalsInRadius(const GKDTree &, double, std::size_t, GVector3DArray &, unsigned)
+ * @param tree - tree of points
+ * @param radius - radius of neighbourhood
+ * @param maxNeighbours - maximal number of neighbours
+ * @param pX - [out] tree.size() x coordinates of normals
+ * @param pY - [out] tree.size() y coordinates of normals
+ * @param pZ - [out] tree.size() z coordinates of normals
+ * @param threadCount - maximal number of threads, 0 - number of hardware threads
+ * @return number of defined normals
+ * @throws std::invalid_argument if number of neighbours is less than 3
+ */
+SGL_API std::size_t estimateNormalsInRadius(const GKDTree & tree, double radius, std::size_t maxNeighbours,
+                                            double * pX, double * pY, double * pZ, unsigned threadCount = 0);
+
+/**
+ * @brief Flips normals so that they look toward viewpoint (scanner position)
+ * @param tree - tree of points
+ * @param viewpoint - viewpoint
+ * @param normals - [in, out] tree.size() normals
+ * @param threadCount - maximal number of threads, 0 - number of hardware threads
+ * @throws std::invalid_argument if number of normals differs from tree.size()
+ */
+SGL_API void orientNormals(const GKDTree & tree, const GPoint3D & viewpoint, GVector3DArray & normals,
+                           unsigned threadCount = 0);
+
+/**
+ * @brief Flips normals given by coordinate arrays so that they look toward viewpoint
+ * @param tree - tree of points
+ * @param viewpoint - viewpoint
+ * @param pX - [in, out] tree.size() x coordinates of normals
+ * @param pY - [in, out] tree.size() y coordinates of normals
+ * @param pZ - [in, out] tree.size() z coordinates of normals
+ * @param threadCount - maximal number of threads, 0 - number of hardware threads
+ */
+SGL_API void orientNormals(const GKDTree & tree, const GPoint3D & viewpoint, double * pX, double * pY, double * pZ,
+                           unsigned threadCount = 0);
+
+/**
+ * @brief Makes signs of normals consistent by propagation (H. Hoppe et al., "Surface Reconstruction
+ *   from Unorganized Points"). Orientation spreads over minimal spanning tree of k nearest neighbours
+ *   graph weighted by 1 - |n1 * n2|, so it passes between nearly parallel normals first. Every connected
+ *   part starts from its highest point (largest z), whose normal is turned upwards.
+ *   Neighbour queries run in parallel, propagation is sequential. Undefined (zero) normals are skipped.
+ * @param tree - tree of points
+ * @param k - number of neighbours
+ * @param normals - [in, out] tree.size() normals
+ * @param threadCount - maximal number of threads, 0 - number of hardware threads
+ * @throws std::invalid_argument if number of normals differs from tree.size()
+ */
+SGL_API void orientNormals(const GKDTree & tree, std::size_t k, GVector3DArray & normals, unsigned threadCount = 0);
+
+/**
+ * @brief Makes signs of normals given by coordinate arrays consistent by propagation
+ * @see orientNormals(const GKDTree &, std::size_t, GVector3DArray &, unsigned)
+ * @param tree - tree of points
+ * @param k - number of neighbours
+ * @param pX - [in, out] tree.size() x coordinates of normals
+ * @param pY - [in, out] tree.size() y coordinates of normals
+ * @param pZ - [in, out] tree.size() z coordinates of normals
+ * @param threadCount - maximal number of threads, 0 - number of hardware threads
+ */
+SGL_API void orientNormals(const GKDTree & tree, std::size_t k, double * pX, double * pY, double * pZ,
+                           unsigned threadCount = 0);
+
+} //namespace sgl
+
+#endif //_GNORMALESTIMATION_H_
@@ -0,0 +1,229 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GOCTREE_H_
+#define _GOCTREE_H_
+
+#include "GExports.h"
+#include "GBox3D.h"
+#include "GCollections.h"
+#include "GPoint3D.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace sgl
+{
+
+/**
+ * @brief Node of octree with aggregates of its points.
+ *   <p/> Node is addressed by locational code: 1 bit followed by 3 bits (x, y, z from low to high)
+ *   of octant at every level from the root, so key of root is 1 and key of child is (key << 3) | octant.
+ * @author Artemiy Kanshin
+ */
+struct GOctreeNode
+{
+    /** Locational code (Morton code of cell with leading 1 bit) */
+    std::uint64_t key;
+    /** Position of the first point of node in GOctree::indices() */
+    std::uint32_t begin;
+    /** Number of points */
+    std::uint32_t count;
+    /** Index of the first child, children of present octants follow in octant order */
+    std::uint32_t firstChild;
+    /** Bit i is set if child of octant i exists; 0 for leaf */
+    std::uint8_t childMask;
+    /** Depth of node, 0 for root */
+    std::uint8_t depth;
+    /** Centroid of points */
+    GPoint3D centroid;
+    /** Bounds of points */
+    GBox3D bounds;
+
+    bool isLeaf() const { return childMask == 0; }
+};
+
+/**
+ * @brief Sparse octree over points with per-node aggregates for level of detail.
+ *   <p/> Points are sorted by Morton codes of their cells at the finest resolution (2^21 cells per axis
+ *   of the bounding cube), so points of every node occupy contiguous range. Node is split while it holds
+ *   more than leaf capacity points and is above maximal depth; only non-empty children are created.
+ *   <p/> Nodes are stored level by level, sorted by key within level. Every node keeps number of points,
+ *   centroid and bounds, so coarse levels answer approximate queries without visiting points.
+ *   <p/> Morton codes, topology and aggregates are computed in parallel. Topology is built top-down
+ *   level by level, since whether node is split depends on its own number of points: nodes of level
+ *   are split concurrently and prefix sums of their child counts place children. Aggregates are then
+ *   built bottom-up, level by level as well.
+ * @author Artemiy Kanshin
+ */
+class SGL_API GOctree
+{
+public:
+    /** Maximal supported depth */
+    static constexpr std::size_t MAX_DEPTH = 21;
+
+    /** Index of missing node */
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @brief Initializes empty octree
+     */
+    GOctree();
+
+    /**
+     * @brief Builds octree
+     * @param pPoints - pointer to the first point
+     * @param count - number of points
+     * @param leafCapacity - maximal number of points in leaf above maximal depth
+     * @param maxDepth - maximal depth, 0..MAX_DEPTH
+     * @param threadCount - maximal number of build threads, 0 - number of hardware threads
+     */
+    GOctree(const GPoint3D * pPoints, std::size_t count, std::size_t leafCapacity = 32,
+            std::size_t maxDepth = MAX_DEPTH, unsigned threadCount = 0);
+
+    /**
+     * @brief Builds octree
+     * @param points - points
+     * @param leafCapacity - maximal number of points in leaf above maximal depth
+     * @param maxDepth - maximal depth, 0..MAX_DEPTH
+     * @param threadCount - maximal number of build threads, 0 - number of hardware threads
+     */
+    explicit GOctree(const GPoint3DArray & points, std::size_t leafCapacity = 32, std::size_t maxDepth = MAX_DEPTH,
+                     unsigned threadCount = 0);
+
+    /**
+     * @brief Builds octree
+     * @param cloud - point cloud
+     * @param leafCapacity - maximal number of points in leaf above maximal depth
+     * @param maxDepth - maximal depth, 0..MAX_DEPTH
+     * @param threadCount - maximal number of build threads, 0 - number of hardware threads
+     */
+    explicit GOctree(const GPointCloud & cloud, std::size_t leafCapacity = 32, std::size_t maxDepth = MAX_DEPTH,
+                     unsigned threadCount = 0);
+
+    /**
+     * @return number of points
+     */
+    std::size_t size() const;
+
+    /**
+     * @return true if octree has no points, otherwise false
+     */
+    bool empty() const;
+
+    /**
+     * @return depth of the deepest node
+     */
+    std::size_t depth() const;
+
+    /**
+     * @return bounding cube; cells of nodes subdivide it
+     */
+    GBox3D cube() const;
+
+    /**
+     * @return nodes level by level, the first one is root
+     */
+    const std::vector<GOctreeNode> & nodes() const;
+
+    /**
+     * @return point indices in the build sequence, in octree order
+     */
+    const std::vector<std::size_t> & indices() const;
+
+    /**
+     * @brief Returns range of nodes of level
+     * @param depth - depth of level
+     * @return indices [first, second) of nodes of level, empty if level doesn't exist
+     */
+    std::pair<std::size_t, std::size_t> level(std::size_t depth) const;
+
+    /**
+     * @brief Finds node by locational code
+     * @param key - locational code
+     * @return node index or npos
+     */
+    std::size_t find(std::uint64_t key) const;
+
+    /**
+     * @brief Returns child of node
+     * @param node - node index
+     * @param octant - octant 0..7
+     * @return child index or npos
+     */
+    std::size_t child(std::size_t node, std::size_t octant) const;
+
+    /**
+     * @brief Returns cell of node
+     * @param node - node index
+     * @return cube of node cell
+     */
+    GBox3D cell(std::size_t node) const;
+
+    /**
+     * @brief Finds the deepest node whose cell contains point
+     * @param pt - point
+     * @return node index or npos if octree is empty or point is outside of cube()
+     */
+    std::size_t locate(const GPoint3D & pt) const;
+
+    /**
+     * @brief Returns level of detail: all nodes of given depth and leaves above it.
+     *   Points of returned nodes form partition of all points.
+     * @param depth - depth of detail
+     * @return node indices
+     */
+    std::vector<std::size_t> cut(std::size_t depth) const;
+
+    /**
+     * @brief Finds nodes covering points in box: nodes whose bounds lie in box, and nodes
+     *   of maxDepth and leaves whose bounds overlap box. Their counts give an estimate of
+     *   points in box with accuracy increasing with maxDepth.
+     * @param box - box
+     * @param maxDepth - maximal depth of returned nodes
+     * @return node indices
+     */
+    std::vector<std::size_t> intersectBox(const GBox3D & box, std::size_t maxDepth = MAX_DEPTH) const;
+
+    /**
+     * @brief Finds points in closed box
+     * @param box - box
+     * @return point indices in the build sequence
+     */
+    std::vector<std::size_t> pointsInBox(const GBox3D & box) const;
+
+private:
+    void build(const double * const * pCoords, std::size_t stride, std::size_t count, std::size_t leafCapacity,
+               std::size_t maxDepth, unsigned threadCount);
+    std::uint64_t pointKey(const double * pCoord) const;
+
+    std::vector<GOctreeNode> m_nodes;
+    /** First node index of every level and total number of nodes */
+    std::vector<std::size_t> m_levels;
+    std::vector<std::size_t> m_indices;
+    /** Coordinates in octree order: x, y, z of every point */
+    std::vector<double> m_coords;
+    double m_origin[3] = { 0.0, 0.0, 0.0 };
+    double m_size = 1.0;
+};
+
+} //namespace sgl
+
+#endif //_GOCTREE_H_
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GORIENTEDBOX_H_
+#define _GORIENTEDBOX_H_
+
+#include "GExports.h"
+#include "GCollections.h"
+#include "GMatrix4D.h"
+#include "GVector3D.h"
+
+#include <cstddef>
+
+namespace sgl
+{
+
+/**
+ * @brief Method of oriented bounding box fitting
+ */
+enum class GOrientedBoxFit
+{
+    PCA = 0,    ///< axes of covariance matrix of points, one parallel pass over points plus one for extents
+    Hull = 1    ///< the smallest box flush with a face of convex hull, never larger than PCA box
+};
+
+/**
+ * @brief Oriented bounding box
+ */
+struct GOrientedBox
+{
+    /** Box frame: origin is the box center, axes are orthonormal, right handed and sorted by decreasing extent */
+    GMatrix4D frame;
+    /** Half-extents along x, y and z axes of the frame */
+    GVector3D halfExtents;
+};
+
+/**
+ * @brief Fits oriented bounding box to points.
+ *   <p/> PCA mode takes axes of covariance matrix of points. Covariance is reduced over fixed blocks
+ *   of points, so the result doesn't depend on number of threads.
+ *   <p/> Hull mode builds convex hull of points and for every distinct face normal n finds the
+ *   minimal area rectangle of hull projected to plane orthogonal to n: silhouette of the hull is
+ *   traced along half-edges and rotating calipers run over its projection; extents of promising
+ *   boxes are taken over all hull vertices. The smallest volume box is chosen. Candidates are
+ *   checked in parallel, so fitting is quick for typical hulls of hundreds of vertices. Boxes of
+ *   coplanar points lie in their plane and have zero z extent.
+ * @param pPoints - pointer to the first point
+ * @param count - number of points
+ * @param fit - fitting method
+ * @param threadCount - maximal number of threads, 0 - number of hardware threads
+ * @return oriented bounding box
+ * @throws std::invalid_argument if there are no points
+ */
+SGL_API GOrientedBox fitOrientedBox(const GPoint3D * pPoints, std::size_t count,
+                                    GOrientedBoxFit fit = GOrientedBoxFit::PCA, unsigned threadCount = 0);
+
+/**
+ * @brief Fits oriented bounding box to points,
+ *   see fitOrientedBox(const GPoint3D *, std::size_t, GOrientedBoxFit, unsigned)
+ * @param points - points
+ * @param fit - fitting method
+ * @param threadCount - maximal number of threads, 0 - number of hardware threads
+ * @return oriented bounding box
+ * @throws std::invalid_argument if there are no points
+ */
+SGL_API GOrientedBox fitOrientedBox(const GPoint3DArray & points, GOrientedBoxFit fit = GOrientedBoxFit::PCA,
+                                    unsigned threadCount = 0);
+
+/**
+ * @brief Fits oriented bounding box to cloud points,
+ *   see fitOrientedBox(const GPoint3D *, std::size_t, GOrientedBoxFit, unsigned)
+ * @param cloud - point cloud
+ * @param fit - fitting method
+ * @param threadCount - maximal number of threads, 0 - number of hardware threads
+ * @return oriented bounding box
+ * @throws std::invalid_argument if cloud is empty
+ */
+SGL_API GOrientedBox fitOrientedBox(const GPointCloud & cloud, GOrientedBoxFit fit = GOrientedBoxFit::PCA,
+                                    unsigned threadCount = 0);
+
+} //namespace sgl
+
+#endif //_GORIENTEDBOX_H_
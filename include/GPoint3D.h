@@ -21,44 +21,52 @@
 
 #include "GExports.h"
 #include "GTolerance.h"
+#include "GVector3D.h"
+#include "GCollections.h"
 
+#include <cstddef>
 #include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
 
 namespace sgl
 {
 
-class GVector3D;
-class GMatrix4D;
-
 /**
- * @brief 3D Point class for mathematical operations
+ * @brief 3D Point class for mathematical operations.
+ *   <p/> Point is a trivially copyable standard layout type which consists of exactly
+ *   three scalars, so GPoint3DArray can be used as packed [x0, y0, z0, x1, ...] buffer
+ *   (see coordinates()).
+ *   <p/> Use GPoint3D (double) and GPoint3Df (float) aliases.
+ * @tparam T - scalar type (double or float)
  * @author Artemiy Kanshin
  */
-class SGL_API GPoint3D
+template<typename T>
+class GPoint3DT
 {
 public:
     /**
      * @return World coordinate system origin (0.0, 0.0, 0.0)
      */
-    static const GPoint3D & origin();
+    static const GPoint3DT & origin();
 
 public:
     /**
      * @brief Initializes zero point.
      */
-    GPoint3D();
+    constexpr GPoint3DT() = default;
 
     /**
      * @brief Copy constructor
      * @param other - other point
      */
-    GPoint3D(const GPoint3D & other);
+    constexpr GPoint3DT(const GPoint3DT & other) = default;
 
     /**
      * @brief Move constructor
      * @param other
      */
-    GPoint3D(GPoint3D && other) noexcept;
+    constexpr GPoint3DT(GPoint3DT && other) noexcept = default;
 
     /**
      * @brief Initializes point with specified coordinates
@@ -66,54 +74,61 @@ public:
      * @param y - Y coordinate
      * @param z - Z coordinate
      */
-    explicit GPoint3D(double x, double y, double z);
+    constexpr explicit GPoint3DT(T x, T y, T z);
+
+    /**
+     * @brief Initializes point with coordinates of point with other scalar type
+     * @param pt - point
+     */
+    template<typename U>
+    constexpr explicit GPoint3DT(const GPoint3DT<U> & pt);
 
     /**
-     * @brief Initializes point with pointer to array of (at least) 3 doubles
+     * @brief Initializes point with pointer to array of (at least) 3 scalars
      * @param pCoords - Pointer to array with coordinates
      */
-    explicit GPoint3D(double * pCoords);
+    constexpr explicit GPoint3DT(const T * pCoords);
 
     /**
      * @brief Initializes point by initializer list
      */
-    GPoint3D(std::initializer_list<double>);
+    constexpr GPoint3DT(std::initializer_list<T>);
 
     /** No doc */
-    virtual ~GPoint3D();
+    ~GPoint3DT() = default;
 
     /**
      * @return X coordinate
      */
-    double x() const;
+    constexpr T x() const;
 
     /**
      * @brief Sets new value of x coordinate
      * @param newX - new value of x coordinate
      */
-    void setX(double newX);
+    constexpr void setX(T newX);
 
     /**
      * @return Y coordinate
      */
-    double y() const;
+    constexpr T y() const;
 
     /**
      * @brief Sets new value of y coordinate
      * @param newY - new value of y coordinate
      */
-    void setY(double newY);
+    constexpr void setY(T newY);
 
     /**
      * @return Z coordinate
      */
-    double z() const;
+    constexpr T z() const;
 
     /**
      * @brief Sets new value of z coordinate
      * @param newZ - new value of z coordinate
      */
-    void setZ(double newZ);
+    constexpr void setZ(T newZ);
 
     /**
      * @brief Sets new coordinates to the point.
@@ -121,7 +136,19 @@ public:
      * @param newY - new value of y coordinate
      * @param newZ - new value of z coordinate
      */
-    void set(double newX, double newY, double newZ);
+    constexpr void set(T newX, T newY, T newZ);
+
+    /**
+     * @brief Gives read only access to the coordinates as to array of 3 scalars
+     * @return pointer to x coordinate
+     */
+    constexpr const T * data() const;
+
+    /**
+     * @brief Gives write access to the coordinates as to array of 3 scalars
+     * @return pointer to x coordinate
+     */
+    constexpr T * data();
 
     /**
      * @brief Returns true if this point equals to given within tolerance
@@ -129,7 +156,7 @@ public:
      * @param tolerance - length tolerance
      * @return true if this point equals to given within tolerance, otherwise false
      */
-    bool equals(const GPoint3D & pt, double tolerance = GTolerance::lengthTol()) const;
+    bool equals(const GPoint3DT & pt, double tolerance = GTolerance::lengthTol()) const;
 
     /**
      * @brief operator [] for read only access
@@ -137,7 +164,7 @@ public:
      * @return coordinate value
      * @throws std::invalid_argument
      */
-    double operator[](std::size_t coordIdx) const;
+    constexpr T operator[](std::size_t coordIdx) const;
 
     /**
      * @brief operator [] for write access
@@ -145,74 +172,84 @@ public:
      * @return reference to coordinate value
      * @throws std::invalid_argument
      */
-    double & operator[](std::size_t coordIdx);
+    constexpr T & operator[](std::size_t coordIdx);
 
     /**
      * @brief operator =
      * @param pt - point
      * @return reference to this point object
      */
-    GPoint3D & operator=(const GPoint3D & pt);
+    constexpr GPoint3DT & operator=(const GPoint3DT & pt) = default;
 
     /**
      * brief Move assignment operator
      * @param pt - point
      * @return reference to this point object
      */
-    GPoint3D & operator=(GPoint3D && pt);
+    constexpr GPoint3DT & operator=(GPoint3DT && pt) noexcept = default;
 
     /**
      * @brief Adds input point coordinates
      * @param pt - point
      * @return reference to this point object
      */
-    GPoint3D & operator+=(const GPoint3D & pt);
+    constexpr GPoint3DT & operator+=(const GPoint3DT & pt);
 
     /**
      * @brief Subtracts input point coordinates
      * @param pt - point
      * @return reference to this point object
      */
-    GPoint3D & operator-=(const GPoint3D & pt);
+    constexpr GPoint3DT & operator-=(const GPoint3DT & pt);
 
     /**
      * @brief Adds input vector coordinates
      * @param v - vector
      * @return reference to this point object
      */
-    GPoint3D & operator+=(const GVector3D & v);
+    constexpr GPoint3DT & operator+=(const GVector3DT<T> & v);
 
     /**
      * @brief Subtracts input vector coordinates
      * @param v - vector
      * @return reference to this point object
      */
-    GPoint3D & operator-=(const GVector3D & v);
+    constexpr GPoint3DT & operator-=(const GVector3DT<T> & v);
 
     /**
      * @brief Transforms by matrix
      * @param m - matrix
      * @return reference to this point object
      */
-    GPoint3D & operator*=(const GMatrix4D & m);
+    GPoint3DT & operator*=(const GMatrix4DT<T> & m);
 
     /**
      * @brief Returns vector with the same coordinates
      * @return vector with the same coordinates
      */
-    GVector3D asVector() const;
+    constexpr GVector3DT<T> asVector() const;
 
 private:
-    double m_x{0}, m_y{0}, m_z{0};
+    T m_coords[3]{0, 0, 0};
 };
 
+extern template class SGL_API GPoint3DT<double>;
+extern template class SGL_API GPoint3DT<float>;
+
+static_assert(std::is_trivially_copyable<GPoint3D>::value, "GPoint3D must be trivially copyable");
+static_assert(std::is_standard_layout<GPoint3D>::value, "GPoint3D must have standard layout");
+static_assert(sizeof(GPoint3D) == 3 * sizeof(double), "GPoint3D must be packed as 3 doubles");
+static_assert(std::is_trivially_copyable<GPoint3Df>::value, "GPoint3Df must be trivially copyable");
+static_assert(sizeof(GPoint3Df) == 3 * sizeof(float), "GPoint3Df must be packed as 3 floats");
+
 /**
  * @brief Returns vector from pt2 to pt1
  * @param pt1 - first point
  * @param pt2 - second point
  * @return vector from pt2 to pt1
  */
-SGL_API GVector3D operator-(const GPoint3D & pt1, const GPoint3D & pt2);
+template<typename T>
+constexpr GVector3DT<T> operator-(const GPoint3DT<T> & pt1, const GPoint3DT<T> & pt2);
 
 /**
  * @brief Returns point which is a sum of given points coordinates
@@ -220,7 +257,8 @@ SGL_API GVector3D operator-(const GPoint3D & pt1, const GPoint3D & pt2);
  * @param pt2 - second point
  * @return point which is a summary of given points coordinates
  */
-SGL_API GPoint3D operator+(const GPoint3D & pt1, const GPoint3D & pt2);
+template<typename T>
+constexpr GPoint3DT<T> operator+(const GPoint3DT<T> & pt1, const GPoint3DT<T> & pt2);
 
 /**
  * @brief Returns point which is shifted from given point by given vector
@@ -228,7 +266,8 @@ SGL_API GPoint3D operator+(const GPoint3D & pt1, const GPoint3D & pt2);
  * @param v - vector
  * @return point which is shifted from given point by given vector
  */
-SGL_API GPoint3D operator+(const GPoint3D & pt, const GVector3D & v);
+template<typename T>
+constexpr GPoint3DT<T> operator+(const GPoint3DT<T> & pt, const GVector3DT<T> & v);
 
 /**
  * @brief Returns point which is shifted from given point by given vector
@@ -236,7 +275,8 @@ SGL_API GPoint3D operator+(const GPoint3D & pt, const GVector3D & v);
  * @param pt - point
  * @return point which is shifted from given point by given vector
  */
-SGL_API GPoint3D operator+(const GVector3D & v, const GPoint3D & pt);
+template<typename T>
+constexpr GPoint3DT<T> operator+(const GVector3DT<T> & v, const GPoint3DT<T> & pt);
 
 /**
  * @brief Returns point which is shifted from given point by given vector in opposite way
@@ -244,7 +284,8 @@ SGL_API GPoint3D operator+(const GVector3D & v, const GPoint3D & pt);
  * @param v - vector
  * @return point which is shifted from given point by given vector in opposite way
  */
-SGL_API GPoint3D operator-(const GPoint3D & pt, const GVector3D & v);
+template<typename T>
+constexpr GPoint3DT<T> operator-(const GPoint3DT<T> & pt, const GVector3DT<T> & v);
 
 /**
  * @brief Returns transformed copy of given point
@@ -252,7 +293,208 @@ SGL_API GPoint3D operator-(const GPoint3D & pt, const GVector3D & v);
  * @param pt - point to transform
  * @return transformed copy of given point
  */
-SGL_API GPoint3D operator*(const GMatrix4D & m, const GPoint3D & pt);
+template<typename T>
+GPoint3DT<T> operator*(const GMatrix4DT<T> & m, const GPoint3DT<T> & pt);
+
+extern template SGL_API GPoint3D operator*(const GMatrix4D & m, const GPoint3D & pt);
+extern template SGL_API GPoint3Df operator*(const GMatrix4Df & m, const GPoint3Df & pt);
+
+/**
+ * @brief Gives access to the points as to packed array of 3 * points.size() scalars
+ * @param points - points array
+ * @return pointer to x coordinate of the first point or nullptr if array is empty
+ */
+template<typename T>
+inline T * coordinates(std::vector<GPoint3DT<T>> & points);
+
+/**
+ * @brief Gives read only access to the points as to packed array of 3 * points.size() scalars
+ * @param points - points array
+ * @return pointer to x coordinate of the first point or nullptr if array is empty
+ */
+template<typename T>
+inline const T * coordinates(const std::vector<GPoint3DT<T>> & points);
+
+//
+// Inline implementation
+//
+
+template<typename T>
+constexpr GPoint3DT<T>::GPoint3DT(T x, T y, T z)
+    : m_coords{ x, y, z }
+{}
+
+template<typename T>
+template<typename U>
+constexpr GPoint3DT<T>::GPoint3DT(const GPoint3DT<U> & pt)
+    : m_coords{ static_cast<T>(pt.x()), static_cast<T>(pt.y()), static_cast<T>(pt.z()) }
+{}
+
+template<typename T>
+constexpr GPoint3DT<T>::GPoint3DT(const T * pCoords)
+    : m_coords{ pCoords[0], pCoords[1], pCoords[2] }
+{}
+
+template<typename T>
+constexpr GPoint3DT<T>::GPoint3DT(std::initializer_list<T> l)
+    : m_coords{ l.begin()[0], l.begin()[1], l.begin()[2] }
+{}
+
+template<typename T>
+constexpr T GPoint3DT<T>::x() const
+{
+    return m_coords[0];
+}
+
+template<typename T>
+constexpr void GPoint3DT<T>::setX(T newX)
+{
+    m_coords[0] = newX;
+}
+
+template<typename T>
+constexpr T GPoint3DT<T>::y() const
+{
+    return m_coords[1];
+}
+
+template<typename T>
+constexpr void GPoint3DT<T>::setY(T newY)
+{
+    m_coords[1] = newY;
+}
+
+template<typename T>
+constexpr T GPoint3DT<T>::z() const
+{
+    return m_coords[2];
+}
+
+template<typename T>
+constexpr void GPoint3DT<T>::setZ(T newZ)
+{
+    m_coords[2] = newZ;
+}
+
+template<typename T>
+constexpr void GPoint3DT<T>::set(T newX, T newY, T newZ)
+{
+    m_coords[0] = newX;
+    m_coords[1] = newY;
+    m_coords[2] = newZ;
+}
+
+template<typename T>
+constexpr const T * GPoint3DT<T>::data() const
+{
+    return m_coords;
+}
+
+template<typename T>
+constexpr T * GPoint3DT<T>::data()
+{
+    return m_coords;
+}
+
+template<typename T>
+constexpr T GPoint3DT<T>::operator[](std::size_t coordIdx) const
+{
+    if (coordIdx > 2)
+        throw std::invalid_argument("GPoint3D: index out of range");
+    return m_coords[coordIdx];
+}
+
+template<typename T>
+constexpr T & GPoint3DT<T>::operator[](std::size_t coordIdx)
+{
+    if (coordIdx > 2)
+        throw std::invalid_argument("GPoint3D: index out of range");
+    return m_coords[coordIdx];
+}
+
+template<typename T>
+constexpr GPoint3DT<T> & GPoint3DT<T>::operator+=(const GPoint3DT<T> & pt)
+{
+    m_coords[0] += pt.m_coords[0];
+    m_coords[1] += pt.m_coords[1];
+    m_coords[2] += pt.m_coords[2];
+    return *this;
+}
+
+template<typename T>
+constexpr GPoint3DT<T> & GPoint3DT<T>::operator-=(const GPoint3DT<T> & pt)
+{
+    m_coords[0] -= pt.m_coords[0];
+    m_coords[1] -= pt.m_coords[1];
+    m_coords[2] -= pt.m_coords[2];
+    return *this;
+}
+
+template<typename T>
+constexpr GPoint3DT<T> & GPoint3DT<T>::operator+=(const GVector3DT<T> & v)
+{
+    m_coords[0] += v.x();
+    m_coords[1] += v.y();
+    m_coords[2] += v.z();
+    return *this;
+}
+
+template<typename T>
+constexpr GPoint3DT<T> & GPoint3DT<T>::operator-=(const GVector3DT<T> & v)
+{
+    m_coords[0] -= v.x();
+    m_coords[1] -= v.y();
+    m_coords[2] -= v.z();
+    return *this;
+}
+
+template<typename T>
+constexpr GVector3DT<T> GPoint3DT<T>::asVector() const
+{
+    return GVector3DT<T>(m_coords[0], m_coords[1], m_coords[2]);
+}
+
+template<typename T>
+constexpr GVector3DT<T> operator-(const GPoint3DT<T> & pt1, const GPoint3DT<T> & pt2)
+{
+    return GVector3DT<T>(pt1.x() - pt2.x(), pt1.y() - pt2.y(), pt1.z() - pt2.z());
+}
+
+template<typename T>
+constexpr GPoint3DT<T> operator+(const GPoint3DT<T> & pt1, const GPoint3DT<T> & pt2)
+{
+    return GPoint3DT<T>(pt1.x() + pt2.x(), pt1.y() + pt2.y(), pt1.z() + pt2.z());
+}
+
+template<typename T>
+constexpr GPoint3DT<T> operator+(const GPoint3DT<T> & pt, const GVector3DT<T> & v)
+{
+    return GPoint3DT<T>(pt.x() + v.x(), pt.y() + v.y(), pt.z() + v.z());
+}
+
+template<typename T>
+constexpr GPoint3DT<T> operator+(const GVector3DT<T> & v, const GPoint3DT<T> & pt)
+{
+    return GPoint3DT<T>(pt.x() + v.x(), pt.y() + v.y(), pt.z() + v.z());
+}
+
+template<typename T>
+constexpr GPoint3DT<T> operator-(const GPoint3DT<T> & pt, const GVector3DT<T> & v)
+{
+    return GPoint3DT<T>(pt.x() - v.x(), pt.y() - v.y(), pt.z() - v.z());
+}
+
+template<typename T>
+inline T * coordinates(std::vector<GPoint3DT<T>> & points)
+{
+    return points.empty() ? nullptr : points.front().data();
+}
+
+template<typename T>
+inline const T * coordinates(const std::vector<GPoint3DT<T>> & points)
+{
+    return points.empty() ? nullptr : points.front().data();
+}
 
 } //namespace sgl
 
@@ -0,0 +1,798 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GPOINTCLOUD_H_
+#define _GPOINTCLOUD_H_
+
+#include "GExports.h"
+#include "GTolerance.h"
+#include "GAlignedAllocator.h"
+#include "GCollections.h"
+#include "GPoint3D.h"
+#include "GVector3D.h"
+
+#include <cstddef>
+#include <iterator>
+
+namespace sgl
+{
+
+/**
+ * @brief Proxy object which refers to a point stored in GPointCloud.
+ *   Has the same read interface as GPoint3D and converts to it implicitly,
+ *   so code written against GPoint3D works with cloud elements.
+ * @tparam Cloud - GPointCloud or const GPointCloud
+ */
+template <typename Cloud>
+class GPointCloudPointRef
+{
+public:
+    /**
+     * @brief Initializes reference to the point of cloud
+     * @param cloud - point cloud
+     * @param index - point index
+     */
+    GPointCloudPointRef(Cloud & cloud, std::size_t index);
+
+    /** No doc */
+    GPointCloudPointRef(const GPointCloudPointRef &) = default;
+
+    /**
+     * @brief Assigns coordinates of referenced point (does not rebind reference)
+     * @param other - reference to another point
+     * @return reference to this object
+     */
+    GPointCloudPointRef & operator=(const GPointCloudPointRef & other);
+
+    /**
+     * @brief Assigns coordinates of given point to referenced point
+     * @param pt - point
+     * @return reference to this object
+     */
+    GPointCloudPointRef & operator=(const GPoint3D & pt);
+
+    /**
+     * @return index of referenced point
+     */
+    std::size_t index() const;
+
+    /**
+     * @return X coordinate
+     */
+    double x() const;
+
+    /**
+     * @brief Sets new value of x coordinate
+     * @param newX - new value of x coordinate
+     */
+    void setX(double newX) const;
+
+    /**
+     * @return Y coordinate
+     */
+    double y() const;
+
+    /**
+     * @brief Sets new value of y coordinate
+     * @param newY - new value of y coordinate
+     */
+    void setY(double newY) const;
+
+    /**
+     * @return Z coordinate
+     */
+    double z() const;
+
+    /**
+     * @brief Sets new value of z coordinate
+     * @param newZ - new value of z coordinate
+     */
+    void setZ(double newZ) const;
+
+    /**
+     * @brief Sets new coordinates to the point.
+     * @param newX - new value of x coordinate
+     * @param newY - new value of y coordinate
+     * @param newZ - new value of z coordinate
+     */
+    void set(double newX, double newY, double newZ) const;
+
+    /**
+     * @brief operator [] for read only access
+     * @param coordIdx - index of coordinate [0-2]
+     * @return coordinate value
+     * @throws std::invalid_argument
+     */
+    double operator[](std::size_t coordIdx) const;
+
+    /**
+     * @brief Returns true if referenced point equals to given within tolerance
+     * @param pt - point to check equality
+     * @param tolerance - length tolerance
+     * @return true if referenced point equals to given within tolerance, otherwise false
+     */
+    bool equals(const GPoint3D & pt, double tolerance = GTolerance::lengthTol()) const;
+
+    /**
+     * @brief Adds input vector coordinates
+     * @param v - vector
+     * @return reference to this object
+     */
+    const GPointCloudPointRef & operator+=(const GVector3D & v) const;
+
+    /**
+     * @brief Subtracts input vector coordinates
+     * @param v - vector
+     * @return reference to this object
+     */
+    const GPointCloudPointRef & operator-=(const GVector3D & v) const;
+
+    /**
+     * @return copy of referenced point
+     */
+    GPoint3D point() const;
+
+    /**
+     * @return copy of referenced point
+     */
+    operator GPoint3D() const;
+
+    /**
+     * @brief Returns vector with the same coordinates
+     * @return vector with the same coordinates
+     */
+    GVector3D asVector() const;
+
+    /**
+     * Arithmetic operators of GPoint3D are templates and do not see implicit conversion
+     * of the reference, so the reference provides its own overloads.
+     */
+    friend GVector3D operator-(const GPointCloudPointRef & pt1, const GPointCloudPointRef & pt2)
+    {
+        return pt1.point() - pt2.point();
+    }
+
+    friend GVector3D operator-(const GPointCloudPointRef & pt1, const GPoint3D & pt2)
+    {
+        return pt1.point() - pt2;
+    }
+
+    friend GVector3D operator-(const GPoint3D & pt1, const GPointCloudPointRef & pt2)
+    {
+        return pt1 - pt2.point();
+    }
+
+    friend GPoint3D operator+(const GPointCloudPointRef & pt, const GVector3D & v)
+    {
+        return pt.point() + v;
+    }
+
+    friend GPoint3D operator-(const GPointCloudPointRef & pt, const GVector3D & v)
+    {
+        return pt.point() - v;
+    }
+
+private:
+    Cloud * m_pCloud;
+    std::size_t m_index;
+};
+
+/**
+ * @brief Iterator over GPointCloud points. Dereferences to GPointCloudPointRef.
+ *   <p/> Iterator supports random access arithmetic, but is declared as input iterator: proxy
+ *   references can't be swapped (moving coordinates would leave attributes behind), so algorithms
+ *   that permute elements, like std::sort, are not applicable. Permute indices instead.
+ * @tparam Cloud - GPointCloud or const GPointCloud
+ */
+template <typename Cloud>
+class GPointCloudIterator
+{
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = GPoint3D;
+    using difference_type = std::ptrdiff_t;
+    using reference = GPointCloudPointRef<Cloud>;
+    using pointer = void;
+
+    GPointCloudIterator() = default;
+
+    GPointCloudIterator(Cloud & cloud, std::size_t index)
+        : m_pCloud{ &cloud }, m_index{ index }
+    {}
+
+    reference operator*() const { return reference(*m_pCloud, m_index); }
+    reference operator[](difference_type n) const { return reference(*m_pCloud, m_index + n); }
+
+    GPointCloudIterator & operator++() { ++m_index; return *this; }
+    GPointCloudIterator operator++(int) { GPointCloudIterator res = *this; ++m_index; return res; }
+    GPointCloudIterator & operator--() { --m_index; return *this; }
+    GPointCloudIterator operator--(int) { GPointCloudIterator res = *this; --m_index; return res; }
+    GPointCloudIterator & operator+=(difference_type n) { m_index += n; return *this; }
+    GPointCloudIterator & operator-=(difference_type n) { m_index -= n; return *this; }
+    GPointCloudIterator operator+(difference_type n) const { return GPointCloudIterator(*m_pCloud, m_index + n); }
+    GPointCloudIterator operator-(difference_type n) const { return GPointCloudIterator(*m_pCloud, m_index - n); }
+
+    difference_type operator-(const GPointCloudIterator & it) const
+    {
+        return static_cast<difference_type>(m_index) - static_cast<difference_type>(it.m_index);
+    }
+
+    bool operator==(const GPointCloudIterator & it) const { return m_index == it.m_index; }
+    bool operator!=(const GPointCloudIterator & it) const { return m_index != it.m_index; }
+    bool operator<(const GPointCloudIterator & it) const { return m_index < it.m_index; }
+    bool operator>(const GPointCloudIterator & it) const { return m_index > it.m_index; }
+    bool operator<=(const GPointCloudIterator & it) const { return m_index <= it.m_index; }
+    bool operator>=(const GPointCloudIterator & it) const { return m_index >= it.m_index; }
+
+private:
+    Cloud * m_pCloud{ nullptr };
+    std::size_t m_index{ 0 };
+};
+
+/**
+ * @brief Point cloud stored as structure of arrays.
+ *   <p/> X, Y and Z coordinates are kept in separate arrays aligned to G_SIMD_ALIGNMENT bytes,
+ *   which allows bulk algorithms to process coordinates with SIMD instructions.
+ *   Optional per-point attributes (normals and intensity) are stored the same way
+ *   and are resized together with coordinates once enabled.
+ *   <p/> Elements are accessed via GPointCloudPointRef proxies which behave like GPoint3D.
+ * @author Artemiy Kanshin
+ */
+class SGL_API GPointCloud
+{
+public:
+    using reference = GPointCloudPointRef<GPointCloud>;
+    using const_reference = GPointCloudPointRef<const GPointCloud>;
+    using iterator = GPointCloudIterator<GPointCloud>;
+    using const_iterator = GPointCloudIterator<const GPointCloud>;
+
+public:
+    /**
+     * @brief Initializes empty point cloud
+     */
+    GPointCloud();
+
+    /**
+     * @brief Initializes point cloud with 'size' zero points
+     * @param size - number of points
+     */
+    explicit GPointCloud(std::size_t size);
+
+    /**
+     * @brief Initializes point cloud with points of array
+     * @param points - array of points
+     */
+    explicit GPointCloud(const GPoint3DArray & points);
+
+    /**
+     * @brief Initializes point cloud by taking ownership of coordinate arrays without copying
+     * @param x - array of x coordinates
+     * @param y - array of y coordinates
+     * @param z - array of z coordinates
+     * @throws std::invalid_argument if arrays have different sizes
+     */
+    GPointCloud(GAlignedDoubleArray && x, GAlignedDoubleArray && y, GAlignedDoubleArray && z);
+
+    /**
+     * @brief Copy constructor
+     */
+    GPointCloud(const GPointCloud &);
+
+    /**
+     * @brief Move constructor
+     */
+    GPointCloud(GPointCloud &&) noexcept;
+
+    /** No doc */
+    ~GPointCloud();
+
+    /**
+     * @brief Assignment operator
+     * @return reference to this point cloud
+     */
+    GPointCloud & operator=(const GPointCloud &);
+
+    /**
+     * @brief Move assignment operator
+     * @return reference to this point cloud
+     */
+    GPointCloud & operator=(GPointCloud &&) noexcept;
+
+    /**
+     * @return number of points
+     */
+    std::size_t size() const;
+
+    /**
+     * @return true if cloud has no points, otherwise false
+     */
+    bool empty() const;
+
+    /**
+     * @brief Changes number of points. New points (and their attributes) are zero initialized
+     * @param size - new number of points
+     */
+    void resize(std::size_t size);
+
+    /**
+     * @brief Reserves memory for coordinates and enabled attributes
+     * @param capacity - number of points
+     */
+    void reserve(std::size_t capacity);
+
+    /**
+     * @brief Removes all points. Enabled attributes stay enabled
+     */
+    void clear();
+
+    /**
+     * @brief Appends point. Enabled attributes of new point are zero initialized
+     * @param pt - point
+     */
+    void push_back(const GPoint3D & pt);
+
+    /**
+     * @brief Replaces points of this cloud with points of array. Reuses allocated memory
+     * @param points - array of points
+     */
+    void assign(const GPoint3DArray & points);
+
+    /**
+     * @brief Copies points to array. Reuses memory allocated by array
+     * @param points - destination array
+     */
+    void copyTo(GPoint3DArray & points) const;
+
+    /**
+     * @return array with copy of points
+     */
+    GPoint3DArray toArray() const;
+
+    /**
+     * @brief Returns copy of point
+     * @param index - point index
+     * @return copy of point
+     */
+    GPoint3D point(std::size_t index) const;
+
+    /**
+     * @brief Sets point
+     * @param index - point index
+     * @param pt - new point value
+     */
+    void setPoint(std::size_t index, const GPoint3D & pt);
+
+    /**
+     * @brief Gives write access to point
+     * @param index - point index
+     * @return reference to point
+     */
+    reference operator[](std::size_t index);
+
+    /**
+     * @brief Gives read only access to point
+     * @param index - point index
+     * @return reference to point
+     */
+    const_reference operator[](std::size_t index) const;
+
+    /** No doc */
+    iterator begin();
+    /** No doc */
+    iterator end();
+    /** No doc */
+    const_iterator begin() const;
+    /** No doc */
+    const_iterator end() const;
+    /** No doc */
+    const_iterator cbegin() const;
+    /** No doc */
+    const_iterator cend() const;
+
+    /**
+     * @return pointer to aligned array of x coordinates
+     */
+    const double * xData() const;
+
+    /**
+     * @return pointer to aligned array of x coordinates
+     */
+    double * xData();
+
+    /**
+     * @return pointer to aligned array of y coordinates
+     */
+    const double * yData() const;
+
+    /**
+     * @return pointer to aligned array of y coordinates
+     */
+    double * yData();
+
+    /**
+     * @return pointer to aligned array of z coordinates
+     */
+    const double * zData() const;
+
+    /**
+     * @return pointer to aligned array of z coordinates
+     */
+    double * zData();
+
+    /**
+     * @brief Gives read only access to coordinate array
+     * @param coordIdx - index of coordinate [0-2]
+     * @return pointer to aligned array of coordinates
+     * @throws std::invalid_argument
+     */
+    const double * data(std::size_t coordIdx) const;
+
+    /**
+     * @brief Gives write access to coordinate array
+     * @param coordIdx - index of coordinate [0-2]
+     * @return pointer to aligned array of coordinates
+     * @throws std::invalid_argument
+     */
+    double * data(std::size_t coordIdx);
+
+    /**
+     * @return true if cloud stores normals, otherwise false
+     */
+    bool hasNormals() const;
+
+    /**
+     * @brief Enables per-point normals. Normals are zero initialized
+     */
+    void enableNormals();
+
+    /**
+     * @brief Disables per-point normals and releases their memory
+     */
+    void disableNormals();
+
+    /**
+     * @brief Returns normal of point
+     * @param index - point index
+     * @return normal of point
+     */
+    GVector3D normal(std::size_t index) const;
+
+    /**
+     * @brief Sets normal of point
+     * @param index - point index
+     * @param normal - new normal
+     */
+    void setNormal(std::size_t index, const GVector3D & normal);
+
+    /**
+     * @brief Gives read only access to normal coordinate array
+     * @param coordIdx - index of coordinate [0-2]
+     * @return pointer to aligned array of normal coordinates or nullptr if normals are disabled
+     * @throws std::invalid_argument
+     */
+    const double * normalData(std::size_t coordIdx) const;
+
+    /**
+     * @brief Gives write access to normal coordinate array
+     * @param coordIdx - index of coordinate [0-2]
+     * @return pointer to aligned array of normal coordinates or nullptr if normals are disabled
+     * @throws std::invalid_argument
+     */
+    double * normalData(std::size_t coordIdx);
+
+    /**
+     * @return true if cloud stores intensity, otherwise false
+     */
+    bool hasIntensity() const;
+
+    /**
+     * @brief Enables per-point intensity. Intensity is zero initialized
+     */
+    void enableIntensity();
+
+    /**
+     * @brief Disables per-point intensity and releases its memory
+     */
+    void disableIntensity();
+
+    /**
+     * @brief Returns intensity of point
+     * @param index - point index
+     * @return intensity of point
+     */
+    double intensity(std::size_t index) const;
+
+    /**
+     * @brief Sets intensity of point
+     * @param index - point index
+     * @param intensity - new intensity
+     */
+    void setIntensity(std::size_t index, double intensity);
+
+    /**
+     * @return pointer to aligned array of intensity or nullptr if intensity is disabled
+     */
+    const double * intensityData() const;
+
+    /**
+     * @return pointer to aligned array of intensity or nullptr if intensity is disabled
+     */
+    double * intensityData();
+
+private:
+    GAlignedDoubleArray m_coords[3];
+    GAlignedDoubleArray m_normals[3];
+    GAlignedDoubleArray m_intensity;
+    bool m_hasNormals{ false };
+    bool m_hasIntensity{ false };
+};
+
+//
+// Inline implementation
+//
+
+template <typename Cloud>
+inline GPointCloudPointRef<Cloud>::GPointCloudPointRef(Cloud & cloud, std::size_t index)
+    : m_pCloud{ &cloud }, m_index{ index }
+{}
+
+template <typename Cloud>
+inline GPointCloudPointRef<Cloud> & GPointCloudPointRef<Cloud>::operator=(const GPointCloudPointRef & other)
+{
+    set(other.x(), other.y(), other.z());
+    return *this;
+}
+
+template <typename Cloud>
+inline GPointCloudPointRef<Cloud> & GPointCloudPointRef<Cloud>::operator=(const GPoint3D & pt)
+{
+    set(pt.x(), pt.y(), pt.z());
+    return *this;
+}
+
+template <typename Cloud>
+inline std::size_t GPointCloudPointRef<Cloud>::index() const
+{
+    return m_index;
+}
+
+template <typename Cloud>
+inline double GPointCloudPointRef<Cloud>::x() const
+{
+    return m_pCloud->xData()[m_index];
+}
+
+template <typename Cloud>
+inline void GPointCloudPointRef<Cloud>::setX(double newX) const
+{
+    m_pCloud->xData()[m_index] = newX;
+}
+
+template <typename Cloud>
+inline double GPointCloudPointRef<Cloud>::y() const
+{
+    return m_pCloud->yData()[m_index];
+}
+
+template <typename Cloud>
+inline void GPointCloudPointRef<Cloud>::setY(double newY) const
+{
+    m_pCloud->yData()[m_index] = newY;
+}
+
+template <typename Cloud>
+inline double GPointCloudPointRef<Cloud>::z() const
+{
+    return m_pCloud->zData()[m_index];
+}
+
+template <typename Cloud>
+inline void GPointCloudPointRef<Cloud>::setZ(double newZ) const
+{
+    m_pCloud->zData()[m_index] = newZ;
+}
+
+template <typename Cloud>
+inline void GPointCloudPointRef<Cloud>::set(double newX, double newY, double newZ) const
+{
+    setX(newX);
+    setY(newY);
+    setZ(newZ);
+}
+
+template <typename Cloud>
+inline double GPointCloudPointRef<Cloud>::operator[](std::size_t coordIdx) const
+{
+    return m_pCloud->data(coordIdx)[m_index];
+}
+
+template <typename Cloud>
+inline bool GPointCloudPointRef<Cloud>::equals(const GPoint3D & pt, double tolerance /*= GTolerance::lengthTol()*/) const
+{
+    return point().equals(pt, tolerance);
+}
+
+template <typename Cloud>
+inline const GPointCloudPointRef<Cloud> & GPointCloudPointRef<Cloud>::operator+=(const GVector3D & v) const
+{
+    set(x() + v.x(), y() + v.y(), z() + v.z());
+    return *this;
+}
+
+template <typename Cloud>
+inline const GPointCloudPointRef<Cloud> & GPointCloudPointRef<Cloud>::operator-=(const GVector3D & v) const
+{
+    set(x() - v.x(), y() - v.y(), z() - v.z());
+    return *this;
+}
+
+template <typename Cloud>
+inline GPoint3D GPointCloudPointRef<Cloud>::point() const
+{
+    return GPoint3D(x(), y(), z());
+}
+
+template <typename Cloud>
+inline GPointCloudPointRef<Cloud>::operator GPoint3D() const
+{
+    return point();
+}
+
+template <typename Cloud>
+inline GVector3D GPointCloudPointRef<Cloud>::asVector() const
+{
+    return GVector3D(x(), y(), z());
+}
+
+inline std::size_t GPointCloud::size() const
+{
+    return m_coords[0].size();
+}
+
+inline bool GPointCloud::empty() const
+{
+    return m_coords[0].empty();
+}
+
+inline GPoint3D GPointCloud::point(std::size_t index) const
+{
+    return GPoint3D(m_coords[0][index], m_coords[1][index], m_coords[2][index]);
+}
+
+inline void GPointCloud::setPoint(std::size_t index, const GPoint3D & pt)
+{
+    m_coords[0][index] = pt.x();
+    m_coords[1][index] = pt.y();
+    m_coords[2][index] = pt.z();
+}
+
+inline GPointCloud::reference GPointCloud::operator[](std::size_t index)
+{
+    return reference(*this, index);
+}
+
+inline GPointCloud::const_reference GPointCloud::operator[](std::size_t index) const
+{
+    return const_reference(*this, index);
+}
+
+inline GPointCloud::iterator GPointCloud::begin()
+{
+    return iterator(*this, 0);
+}
+
+inline GPointCloud::iterator GPointCloud::end()
+{
+    return iterator(*this, size());
+}
+
+inline GPointCloud::const_iterator GPointCloud::begin() const
+{
+    return const_iterator(*this, 0);
+}
+
+inline GPointCloud::const_iterator GPointCloud::end() const
+{
+    return const_iterator(*this, size());
+}
+
+inline GPointCloud::const_iterator GPointCloud::cbegin() const
+{
+    return begin();
+}
+
+inline GPointCloud::const_iterator GPointCloud::cend() const
+{
+    return end();
+}
+
+inline const double * GPointCloud::xData() const
+{
+    return m_coords[0].data();
+}
+
+inline double * GPointCloud::xData()
+{
+    return m_coords[0].data();
+}
+
+inline const double * GPointCloud::yData() const
+{
+    return m_coords[1].data();
+}
+
+inline double * GPointCloud::yData()
+{
+    return m_coords[1].data();
+}
+
+inline const double * GPointCloud::zData() const
+{
+    return m_coords[2].data();
+}
+
+inline double * GPointCloud::zData()
+{
+    return m_coords[2].data();
+}
+
+inline bool GPointCloud::hasNormals() const
+{
+    return m_hasNormals;
+}
+
+inline GVector3D GPointCloud::normal(std::size_t index) const
+{
+    return GVector3D(m_normals[0][index], m_normals[1][index], m_normals[2][index]);
+}
+
+inline void GPointCloud::setNormal(std::size_t index, const GVector3D & normal)
+{
+    m_normals[0][index] = normal.x();
+    m_normals[1][index] = normal.y();
+    m_normals[2][index] = normal.z();
+}
+
+inline bool GPointCloud::hasIntensity() const
+{
+    return m_hasIntensity;
+}
+
+inline double GPointCloud::intensity(std::size_t index) const
+{
+    return m_intensity[index];
+}
+
+inline void GPointCloud::setIntensity(std::size_t index, double intensity)
+{
+    m_intensity[index] = intensity;
+}
+
+inline const double * GPointCloud::intensityData() const
+{
+    return m_hasIntensity ? m_intensity.data() : nullptr;
+}
+
+inline double * GPointCloud::intensityData()
+{
+    return m_hasIntensity ? m_intensity.data() : nullptr;
+}
+
+} //namespace sgl
+
+#endif //_GPOINTCLOUD_H_
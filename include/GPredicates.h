@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GPREDICATES_H_
+#define _GPREDICATES_H_
+
+#include "GExports.h"
+#include "GPoint3D.h"
+
+namespace sgl
+{
+
+/**
+ * Robust geometric predicates (J. R. Shewchuk, "Adaptive Precision Floating-Point Arithmetic
+ * and Fast Robust Geometric Predicates").
+ * <p/> Each predicate evaluates determinant in floating point and returns it at once when its
+ * magnitude exceeds the rounding error bound, which is the common case. Otherwise determinant is
+ * recomputed exactly with floating-point expansions. Sign of the result is always exact, no tolerance
+ * is involved, so results are scale-invariant. Magnitude is an approximation of the determinant.
+ * <p/> Input coordinates are raw spans: 2 doubles for 2D predicates, 3 doubles for 3D ones.
+ * Exactness assumes no overflow or underflow in intermediate products.
+ */
+
+/**
+ * @brief Orientation of three points in plane
+ * @param pa - first point coordinates (x, y)
+ * @param pb - second point coordinates (x, y)
+ * @param pc - third point coordinates (x, y)
+ * @return positive value if points a, b, c are in counterclockwise order,
+ *   negative if clockwise, zero if collinear
+ */
+SGL_API double orient2d(const double * pa, const double * pb, const double * pc);
+
+/**
+ * @brief Orientation of four points in space
+ * @param pa - first point coordinates (x, y, z)
+ * @param pb - second point coordinates (x, y, z)
+ * @param pc - third point coordinates (x, y, z)
+ * @param pd - fourth point coordinates (x, y, z)
+ * @return positive value if point d lies below the plane of a, b, c, which appear
+ *   in counterclockwise order when viewed from above; negative if above; zero if coplanar
+ */
+SGL_API double orient3d(const double * pa, const double * pb, const double * pc, const double * pd);
+
+/**
+ * @brief Position of point relative to circle through three points
+ * @param pa - first circle point coordinates (x, y)
+ * @param pb - second circle point coordinates (x, y)
+ * @param pc - third circle point coordinates (x, y)
+ * @param pd - tested point coordinates (x, y)
+ * @return positive value if d lies inside the circle (a, b, c must be in counterclockwise order,
+ *   otherwise the sign is reversed), negative if outside, zero if cocircular
+ */
+SGL_API double incircle(const double * pa, const double * pb, const double * pc, const double * pd);
+
+/**
+ * @brief Position of point relative to sphere through four points
+ * @param pa - first sphere point coordinates (x, y, z)
+ * @param pb - second sphere point coordinates (x, y, z)
+ * @param pc - third sphere point coordinates (x, y, z)
+ * @param pd - fourth sphere point coordinates (x, y, z)
+ * @param pe - tested point coordinates (x, y, z)
+ * @return positive value if e lies inside the sphere (orient3d(a, b, c, d) must be positive,
+ *   otherwise the sign is reversed), negative if outside, zero if cospherical
+ */
+SGL_API double insphere(const double * pa, const double * pb, const double * pc, const double * pd,
+                        const double * pe);
+
+/**
+ * @brief Orientation of projections of three points to XY plane
+ * @see orient2d(const double *, const double *, const double *)
+ */
+inline double orient2d(const GPoint3D & a, const GPoint3D & b, const GPoint3D & c)
+{
+    return orient2d(a.data(), b.data(), c.data());
+}
+
+/**
+ * @brief Orientation of four points in space
+ * @see orient3d(const double *, const double *, const double *, const double *)
+ */
+inline double orient3d(const GPoint3D & a, const GPoint3D & b, const GPoint3D & c, const GPoint3D & d)
+{
+    return orient3d(a.data(), b.data(), c.data(), d.data());
+}
+
+/**
+ * @brief Position of projection of point to XY plane relative to circle through projections of three points
+ * @see incircle(const double *, const double *, const double *, const double *)
+ */
+inline double incircle(const GPoint3D & a, const GPoint3D & b, const GPoint3D & c, const GPoint3D & d)
+{
+    return incircle(a.data(), b.data(), c.data(), d.data());
+}
+
+/**
+ * @brief Position of point relative to sphere through four points
+ * @see insphere(const double *, const double *, const double *, const double *, const double *)
+ */
+inline double insphere(const GPoint3D & a, const GPoint3D & b, const GPoint3D & c, const GPoint3D & d,
+                       const GPoint3D & e)
+{
+    return insphere(a.data(), b.data(), c.data(), d.data(), e.data());
+}
+
+} //namespace sgl
+
+#endif //_GPREDICATES_H_
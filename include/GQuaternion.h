@@ -0,0 +1,487 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GQUATERNION_H_
+#define _GQUATERNION_H_
+
+#include "GExports.h"
+#include "GTolerance.h"
+#include "GCollections.h"
+#include "GPoint3D.h"
+#include "GVector3D.h"
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace sgl
+{
+
+/**
+ * @brief Quaternion w + x*i + y*j + z*k. Unit quaternions represent rotations.
+ *   <p/> Rotation quaternions follow the same convention as GMatrix4D::rotation():
+ *   GQuaternion::rotation(angle, axis).toMatrix() equals GMatrix4D::rotation(angle, axis),
+ *   and rotate() applies the rotation as the rotation block of that matrix applied to a column vector.
+ *   <p/> Product q1 * q2 is a rotation by q2 followed by rotation by q1 (the same order as matrix product).
+ *   Composition costs 16 multiplications against 64 of 4x4 matrix product, long chains of products
+ *   are kept orthonormal by normalize().
+ * @author Artemiy Kanshin
+ */
+class SGL_API GQuaternion
+{
+public:
+    /**
+     * @return identity quaternion [1, 0, 0, 0]
+     */
+    static constexpr GQuaternion identity();
+
+    /**
+     * @brief Creates rotation quaternion
+     * @param angle - rotation angle
+     * @param axis - rotation axis, not necessarily unit
+     * @return unit quaternion
+     * @throws std::logic_error if axis is zero vector
+     */
+    static GQuaternion rotation(double angle, const GVector3D & axis);
+
+    /**
+     * @brief Creates rotation quaternion from rotation block of matrix.
+     *   Result is normalized, so small orthogonality errors of matrix are tolerated
+     * @param m - rotation matrix
+     * @return unit quaternion
+     */
+    static GQuaternion fromMatrix(const GMatrix4D & m);
+
+public:
+    /**
+     * @brief Initializes identity quaternion
+     */
+    constexpr GQuaternion() = default;
+
+    /**
+     * @brief Initializes quaternion with specified components
+     * @param w - scalar part
+     * @param x - i component
+     * @param y - j component
+     * @param z - k component
+     */
+    constexpr explicit GQuaternion(double w, double x, double y, double z);
+
+    /**
+     * @brief Initializes quaternion with scalar and vector parts
+     * @param w - scalar part
+     * @param v - vector part
+     */
+    constexpr explicit GQuaternion(double w, const GVector3D & v);
+
+    /**
+     * @return scalar part
+     */
+    constexpr double w() const;
+
+    /**
+     * @return i component
+     */
+    constexpr double x() const;
+
+    /**
+     * @return j component
+     */
+    constexpr double y() const;
+
+    /**
+     * @return k component
+     */
+    constexpr double z() const;
+
+    /**
+     * @return vector part [x, y, z]
+     */
+    constexpr GVector3D vector() const;
+
+    /**
+     * @brief Sets new components
+     * @param newW - scalar part
+     * @param newX - i component
+     * @param newY - j component
+     * @param newZ - k component
+     */
+    constexpr void set(double newW, double newX, double newY, double newZ);
+
+    /**
+     * @brief Gives read only access to the components as to array [w, x, y, z]
+     * @return pointer to scalar part
+     */
+    constexpr const double * data() const;
+
+    /**
+     * @brief Computes dot product of quaternions as 4D vectors
+     * @param q - quaternion
+     * @return dot product
+     */
+    constexpr double dot(const GQuaternion & q) const;
+
+    /**
+     * @return squared norm
+     */
+    constexpr double squaredNorm() const;
+
+    /**
+     * @return norm
+     */
+    double norm() const;
+
+    /**
+     * @brief Returns true if quaternion has unit norm
+     * @param tolerance - tolerance
+     * @return true if quaternion has unit norm, otherwise false
+     */
+    bool isUnit(double tolerance = GTolerance::lengthTol()) const;
+
+    /**
+     * @brief Transforms quaternion to unit quaternion.
+     * @return Reference to this quaternion object
+     * @throws std::logic_error
+     */
+    GQuaternion & normalize();
+
+    /**
+     * @brief Returns normalized copy of this quaternion
+     * @return normalized copy of this quaternion
+     * @throws std::logic_error
+     */
+    GQuaternion normalize() const;
+
+    /**
+     * @return conjugate quaternion [w, -x, -y, -z]. It is inverse rotation for unit quaternion
+     */
+    constexpr GQuaternion conjugate() const;
+
+    /**
+     * @return inverse quaternion
+     * @throws std::logic_error if quaternion is zero
+     */
+    GQuaternion inverse() const;
+
+    /**
+     * @return rotation angle in range [0, 2*PI]
+     */
+    double angle() const;
+
+    /**
+     * @return unit rotation axis, X axis for identity rotation
+     */
+    GVector3D axis() const;
+
+    /**
+     * @brief Rotates vector. Quaternion must be unit
+     * @param v - vector
+     * @return rotated vector
+     */
+    constexpr GVector3D rotate(const GVector3D & v) const;
+
+    /**
+     * @brief Rotates point around origin. Quaternion must be unit
+     * @param pt - point
+     * @return rotated point
+     */
+    constexpr GPoint3D rotate(const GPoint3D & pt) const;
+
+    /**
+     * @brief Rotates array of points in place (see GTransform.h). Quaternion must be unit
+     * @param pPoints - pointer to the first point
+     * @param count - number of points
+     */
+    void rotate(GPoint3D * pPoints, std::size_t count) const;
+
+    /**
+     * @brief Rotates array of points in place. Quaternion must be unit
+     * @param points - array of points
+     */
+    void rotate(GPoint3DArray & points) const;
+
+    /**
+     * @brief Rotates point cloud in place. Quaternion must be unit
+     * @param cloud - point cloud
+     */
+    void rotate(GPointCloud & cloud) const;
+
+    /**
+     * @brief Rotates array of vectors in place. Quaternion must be unit
+     * @param pVectors - pointer to the first vector
+     * @param count - number of vectors
+     */
+    void rotate(GVector3D * pVectors, std::size_t count) const;
+
+    /**
+     * @brief Rotates array of vectors in place. Quaternion must be unit
+     * @param vectors - array of vectors
+     */
+    void rotate(GVector3DArray & vectors) const;
+
+    /**
+     * @brief Converts quaternion to rotation matrix. Quaternion must be unit
+     * @return rotation matrix with zero translation
+     */
+    GMatrix4D toMatrix() const;
+
+    /**
+     * @brief Returns true if this quaternion is equal to given within tolerance.
+     *   Note that q and -q represent the same rotation but are not equal
+     * @param q - quaternion to check equality
+     * @param tolerance - tolerance
+     * @return true if this quaternion is equal to given within tolerance, otherwise false
+     */
+    bool equals(const GQuaternion & q, double tolerance = GTolerance::lengthTol()) const;
+
+    /**
+     * @brief Multiplies this quaternion by given from the right: this = this * q
+     * @param q - quaternion
+     * @return Reference to this quaternion object
+     */
+    constexpr GQuaternion & operator*=(const GQuaternion & q);
+
+    /**
+     * @brief Multiplies components by scalar
+     * @param scalar - scalar
+     * @return Reference to this quaternion object
+     */
+    constexpr GQuaternion & operator*=(double scalar);
+
+    /**
+     * @brief Adds components of quaternion
+     * @param q - quaternion
+     * @return Reference to this quaternion object
+     */
+    constexpr GQuaternion & operator+=(const GQuaternion & q);
+
+    /**
+     * @brief Subtracts components of quaternion
+     * @param q - quaternion
+     * @return Reference to this quaternion object
+     */
+    constexpr GQuaternion & operator-=(const GQuaternion & q);
+
+private:
+    double m_coords[4]{1.0, 0.0, 0.0, 0.0};
+};
+
+static_assert(std::is_trivially_copyable<GQuaternion>::value, "GQuaternion must be trivially copyable");
+static_assert(std::is_standard_layout<GQuaternion>::value, "GQuaternion must have standard layout");
+
+/**
+ * @brief Quaternion product (composition of rotations, q2 is applied first)
+ * @param q1 - first quaternion
+ * @param q2 - second quaternion
+ * @return product
+ */
+constexpr GQuaternion operator*(const GQuaternion & q1, const GQuaternion & q2);
+
+/**
+ * @brief Multiplies quaternion components by scalar
+ * @param q - quaternion
+ * @param scalar - scalar
+ * @return scaled quaternion
+ */
+constexpr GQuaternion operator*(const GQuaternion & q, double scalar);
+
+/**
+ * @brief Multiplies quaternion components by scalar
+ * @param scalar - scalar
+ * @param q - quaternion
+ * @return scaled quaternion
+ */
+constexpr GQuaternion operator*(double scalar, const GQuaternion & q);
+
+/**
+ * @brief Returns a sum of given quaternions
+ * @param q1 - first quaternion
+ * @param q2 - second quaternion
+ * @return sum of quaternions
+ */
+constexpr GQuaternion operator+(const GQuaternion & q1, const GQuaternion & q2);
+
+/**
+ * @brief Returns a difference of given quaternions
+ * @param q1 - first quaternion
+ * @param q2 - second quaternion
+ * @return difference of quaternions
+ */
+constexpr GQuaternion operator-(const GQuaternion & q1, const GQuaternion & q2);
+
+/**
+ * @brief Spherical linear interpolation of rotations along the shortest arc
+ * @param q1 - unit quaternion for t = 0
+ * @param q2 - unit quaternion for t = 1
+ * @param t - interpolation parameter [0, 1]
+ * @return unit quaternion
+ */
+SGL_API GQuaternion slerp(const GQuaternion & q1, const GQuaternion & q2, double t);
+
+//
+// Inline implementation
+//
+
+constexpr GQuaternion GQuaternion::identity()
+{
+    return GQuaternion();
+}
+
+constexpr GQuaternion::GQuaternion(double w, double x, double y, double z)
+    : m_coords{w, x, y, z}
+{}
+
+constexpr GQuaternion::GQuaternion(double w, const GVector3D & v)
+    : m_coords{w, v.x(), v.y(), v.z()}
+{}
+
+constexpr double GQuaternion::w() const
+{
+    return m_coords[0];
+}
+
+constexpr double GQuaternion::x() const
+{
+    return m_coords[1];
+}
+
+constexpr double GQuaternion::y() const
+{
+    return m_coords[2];
+}
+
+constexpr double GQuaternion::z() const
+{
+    return m_coords[3];
+}
+
+constexpr GVector3D GQuaternion::vector() const
+{
+    return GVector3D(m_coords[1], m_coords[2], m_coords[3]);
+}
+
+constexpr void GQuaternion::set(double newW, double newX, double newY, double newZ)
+{
+    m_coords[0] = newW;
+    m_coords[1] = newX;
+    m_coords[2] = newY;
+    m_coords[3] = newZ;
+}
+
+constexpr const double * GQuaternion::data() const
+{
+    return m_coords;
+}
+
+constexpr double GQuaternion::dot(const GQuaternion & q) const
+{
+    return m_coords[0] * q.m_coords[0] + m_coords[1] * q.m_coords[1]
+        + m_coords[2] * q.m_coords[2] + m_coords[3] * q.m_coords[3];
+}
+
+constexpr double GQuaternion::squaredNorm() const
+{
+    return dot(*this);
+}
+
+inline double GQuaternion::norm() const
+{
+    return std::sqrt(squaredNorm());
+}
+
+constexpr GQuaternion GQuaternion::conjugate() const
+{
+    return GQuaternion(m_coords[0], -m_coords[1], -m_coords[2], -m_coords[3]);
+}
+
+constexpr GVector3D GQuaternion::rotate(const GVector3D & v) const
+{
+    // v' = v + w * t + q.v x t, where t = 2 * q.v x v
+    const GVector3D u = vector();
+    GVector3D t = u * v;
+    t *= 2.0;
+    GVector3D res = u * t;
+    res += v;
+    t *= m_coords[0];
+    res += t;
+    return res;
+}
+
+constexpr GPoint3D GQuaternion::rotate(const GPoint3D & pt) const
+{
+    const GVector3D v = rotate(pt.asVector());
+    return GPoint3D(v.x(), v.y(), v.z());
+}
+
+constexpr GQuaternion & GQuaternion::operator*=(const GQuaternion & q)
+{
+    return *this = *this * q;
+}
+
+constexpr GQuaternion & GQuaternion::operator*=(double scalar)
+{
+    for (auto & coord : m_coords)
+        coord *= scalar;
+    return *this;
+}
+
+constexpr GQuaternion & GQuaternion::operator+=(const GQuaternion & q)
+{
+    for (std::size_t idx = 0; idx < 4; ++idx)
+        m_coords[idx] += q.m_coords[idx];
+    return *this;
+}
+
+constexpr GQuaternion & GQuaternion::operator-=(const GQuaternion & q)
+{
+    for (std::size_t idx = 0; idx < 4; ++idx)
+        m_coords[idx] -= q.m_coords[idx];
+    return *this;
+}
+
+constexpr GQuaternion operator*(const GQuaternion & q1, const GQuaternion & q2)
+{
+    return GQuaternion(q1.w() * q2.w() - q1.x() * q2.x() - q1.y() * q2.y() - q1.z() * q2.z(),
+                       q1.w() * q2.x() + q1.x() * q2.w() + q1.y() * q2.z() - q1.z() * q2.y(),
+                       q1.w() * q2.y() - q1.x() * q2.z() + q1.y() * q2.w() + q1.z() * q2.x(),
+                       q1.w() * q2.z() + q1.x() * q2.y() - q1.y() * q2.x() + q1.z() * q2.w());
+}
+
+constexpr GQuaternion operator*(const GQuaternion & q, double scalar)
+{
+    return GQuaternion(q.w() * scalar, q.x() * scalar, q.y() * scalar, q.z() * scalar);
+}
+
+constexpr GQuaternion operator*(double scalar, const GQuaternion & q)
+{
+    return q * scalar;
+}
+
+constexpr GQuaternion operator+(const GQuaternion & q1, const GQuaternion & q2)
+{
+    return GQuaternion(q1.w() + q2.w(), q1.x() + q2.x(), q1.y() + q2.y(), q1.z() + q2.z());
+}
+
+constexpr GQuaternion operator-(const GQuaternion & q1, const GQuaternion & q2)
+{
+    return GQuaternion(q1.w() - q2.w(), q1.x() - q2.x(), q1.y() - q2.y(), q1.z() - q2.z());
+}
+
+} //namespace sgl
+
+#endif //_GQUATERNION_H_
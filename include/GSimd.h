@@ -0,0 +1,62 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GSIMD_H_
+#define _GSIMD_H_
+
+#include "GExports.h"
+
+namespace sgl
+{
+
+/**
+ * @brief Instruction set levels used by bulk kernels. Levels are ordered, each one implies previous.
+ */
+enum class GSimdLevel
+{
+    Scalar = 0,     ///< portable C++ code
+    SSE2 = 1,       ///< 128-bit vectors
+    AVX2 = 2,       ///< 256-bit vectors with FMA
+    AVX512 = 3      ///< 512-bit vectors (AVX-512F)
+};
+
+/**
+ * @brief Returns the best instruction set level supported by CPU and operating system.
+ *   Detected once via CPUID.
+ * @return supported instruction set level
+ */
+SGL_API GSimdLevel supportedSimdLevel();
+
+/**
+ * @brief Returns instruction set level which is used by bulk kernels.
+ *   Defaults to supportedSimdLevel().
+ * @return active instruction set level
+ */
+SGL_API GSimdLevel simdLevel();
+
+/**
+ * @brief Restricts instruction set level used by bulk kernels (e.g. for testing or benchmarking).
+ *   Level is clamped to supportedSimdLevel().
+ * @param level - requested instruction set level
+ * @return level which has been set
+ */
+SGL_API GSimdLevel setSimdLevel(GSimdLevel level);
+
+} //namespace sgl
+
+#endif //_GSIMD_H_
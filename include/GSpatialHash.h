@@ -0,0 +1,191 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GSPATIALHASH_H_
+#define _GSPATIALHASH_H_
+
+#include "GExports.h"
+#include "GCollections.h"
+#include "GPoint3D.h"
+#include "GTolerance.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace sgl
+{
+
+/**
+ * @brief Uniform grid of points hashed by cell for fixed radius neighbourhood queries.
+ *   <p/> Space is divided into cubic cells of given size; non-empty cells are kept in open-addressing
+ *   table (linear probing, keyed by integer cell coordinates), points of a cell form a linked list.
+ *   Query of radius not greater than cell size visits 27 cells around the query point, so for
+ *   evenly distributed points insertion, removal and queries take O(1) expected time.
+ *   Larger radius is supported by visiting more cells.
+ *   <p/> Points get consecutive ids in insertion order; ids of removed points are not reused.
+ *   Neighbours are points within closed ball, their order is unspecified.
+ * @author Artemiy Kanshin
+ */
+class SGL_API GSpatialHash
+{
+public:
+    /** Missing point id */
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @brief Initializes empty grid
+     * @param cellSize - size of cell, typical query radius
+     * @throws std::invalid_argument if cellSize is not positive
+     */
+    explicit GSpatialHash(double cellSize = GTolerance::lengthTol());
+
+    /**
+     * @return size of cell
+     */
+    double cellSize() const;
+
+    /**
+     * @return number of points
+     */
+    std::size_t size() const;
+
+    /**
+     * @return true if grid has no points, otherwise false
+     */
+    bool empty() const;
+
+    /**
+     * @brief Removes all points and resets ids
+     */
+    void clear();
+
+    /**
+     * @brief Reserves memory for points; cell table grows with number of non-empty cells
+     * @param count - number of points
+     */
+    void reserve(std::size_t count);
+
+    /**
+     * @brief Inserts point
+     * @param pt - point
+     * @return id of point
+     */
+    std::size_t insert(const GPoint3D & pt);
+
+    /**
+     * @brief Inserts points
+     * @param pPoints - pointer to the first point
+     * @param count - number of points
+     * @return id of the first inserted point, others follow consecutively
+     */
+    std::size_t insert(const GPoint3D * pPoints, std::size_t count);
+
+    /**
+     * @brief Inserts points
+     * @param points - points
+     * @return id of the first inserted point, others follow consecutively
+     */
+    std::size_t insert(const GPoint3DArray & points);
+
+    /**
+     * @brief Inserts points of cloud
+     * @param cloud - point cloud
+     * @return id of the first inserted point, others follow consecutively
+     */
+    std::size_t insert(const GPointCloud & cloud);
+
+    /**
+     * @brief Removes point
+     * @param id - id of point
+     * @throws std::out_of_range if there is no point with such id
+     */
+    void remove(std::size_t id);
+
+    /**
+     * @brief Checks whether point with id is in grid
+     * @param id - id of point
+     * @return true if point was inserted and not removed
+     */
+    bool contains(std::size_t id) const;
+
+    /**
+     * @brief Returns point
+     * @param id - id of point
+     * @return point
+     * @throws std::out_of_range if there is no point with such id
+     */
+    GPoint3D point(std::size_t id) const;
+
+    /**
+     * @brief Finds points within distance
+     * @param pt - query point
+     * @param radius - distance
+     * @param result - [out] vector the ids are appended to
+     * @return number of appended ids
+     */
+    std::size_t neighbours(const GPoint3D & pt, double radius, std::vector<std::size_t> & result) const;
+
+    /**
+     * @brief Finds points within cell size
+     * @param pt - query point
+     * @return ids of points
+     */
+    std::vector<std::size_t> neighbours(const GPoint3D & pt) const;
+
+    /**
+     * @brief Finds the nearest point within distance
+     * @param pt - query point
+     * @param radius - distance
+     * @param distance - [out] distance to the found point
+     * @return id of point or npos if there are no points within radius
+     */
+    std::size_t nearest(const GPoint3D & pt, double radius, double & distance) const;
+
+private:
+    struct Slot
+    {
+        std::int64_t cell[3];
+        std::uint32_t head;
+        std::uint32_t count;
+    };
+
+    void cellOf(const double * pCoord, std::int64_t * pCell) const;
+    std::size_t findSlot(const std::int64_t * pCell) const;
+    void insertId(std::size_t id);
+    void grow(std::size_t count);
+
+    template<typename Func>
+    void visit(const GPoint3D & pt, double radius, Func && func) const;
+
+    double m_cellSize;
+    double m_invCellSize;
+    std::size_t m_count = 0;
+    std::size_t m_cellCount = 0;
+    std::vector<Slot> m_slots;
+    /** Coordinates of points by id: x, y, z */
+    std::vector<double> m_coords;
+    /** Next point of the same cell by id */
+    std::vector<std::uint32_t> m_next;
+    std::vector<std::uint8_t> m_alive;
+};
+
+} //namespace sgl
+
+#endif //_GSPATIALHASH_H_
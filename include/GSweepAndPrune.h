@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GSWEEPANDPRUNE_H_
+#define _GSWEEPANDPRUNE_H_
+
+#include "GExports.h"
+#include "GBox3D.h"
+#include "GCollections.h"
+#include "GTolerance.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace sgl
+{
+
+/**
+ * @brief Sweep-and-prune broadphase: tracks pairs of overlapping boxes of moving objects.
+ *   <p/> Every axis keeps sorted list of interval endpoints of all objects. Boxes are changed
+ *   by setBox() and update() restores the order by insertion sort, so for coherent motion
+ *   between frames update() costs O(n + s), where s is number of endpoint swaps.
+ *   Only pairs whose endpoints swapped are retested for overlap.
+ *   <p/> Endpoints of objects added since the previous update() are sorted in bulk and merged,
+ *   then their pairs are found by one sweep along the first axis, so adding m objects at once
+ *   costs O(n + m log(m) + p), where p is number of pairs overlapping on that axis. If boxes moved
+ *   so far that insertion sort would exceed a budget of moves, all endpoints are sorted and pairs are
+ *   found by the same sweep, so update() never costs more than O(n log(n) + p).
+ *   <p/> Boxes overlap if their intervals intersect on every axis (as in GInterval::intersects):
+ *   touching boxes and boxes with gap not greater than tolerance are overlapping.
+ *   <p/> Pair is given as (id1, id2), id1 < id2. Pairs of the last update() are sorted.
+ * @author Artemiy Kanshin
+ */
+class SGL_API GSweepAndPrune
+{
+public:
+    using Pair = std::pair<std::size_t, std::size_t>;
+
+    /**
+     * @brief Initializes empty broadphase
+     * @param tolerance - maximal gap between overlapping boxes, not negative
+     */
+    explicit GSweepAndPrune(double tolerance = GTolerance::zeroTol());
+
+    /**
+     * @brief Adds object. It takes part in overlaps since next update()
+     * @param box - box of object
+     * @return object id
+     */
+    std::size_t add(const GBox3D & box);
+
+    /**
+     * @brief Removes object. Its pairs are reported as removed by next update(),
+     *   then its id may be reused
+     * @param id - object id
+     */
+    void remove(std::size_t id);
+
+    /**
+     * @brief Changes box of object. Overlaps are updated by next update()
+     * @param id - object id
+     * @param box - new box
+     */
+    void setBox(std::size_t id, const GBox3D & box);
+
+    /**
+     * @brief Returns box of object
+     * @param id - object id
+     * @return box
+     */
+    const GBox3D & box(std::size_t id) const;
+
+    /**
+     * @return number of objects
+     */
+    std::size_t size() const;
+
+    /**
+     * @return tolerance
+     */
+    double tolerance() const;
+
+    /**
+     * @brief Sorts endpoints and updates set of overlapping pairs
+     */
+    void update();
+
+    /**
+     * @return pairs which started overlapping during last update()
+     */
+    const std::vector<Pair> & addedPairs() const;
+
+    /**
+     * @return pairs which stopped overlapping during last update()
+     */
+    const std::vector<Pair> & removedPairs() const;
+
+    /**
+     * @return all overlapping pairs, sorted
+     */
+    std::vector<Pair> pairs() const;
+
+private:
+    struct Endpoint
+    {
+        double value;
+        std::uint32_t id;
+        bool isMax;
+    };
+
+    double minValue(std::size_t id, std::size_t axis) const;
+    double maxValue(std::size_t id, std::size_t axis) const;
+    bool overlaps(std::size_t id1, std::size_t id2) const;
+    void sweep(std::vector<std::uint64_t> & candidates, bool all) const;
+    void checkId(std::size_t id) const;
+
+    double m_tolerance;
+    std::size_t m_count = 0;
+    std::vector<GBox3D> m_boxes;
+    std::vector<std::uint8_t> m_state;
+    std::vector<std::size_t> m_freeIds;
+    std::vector<Endpoint> m_endpoints[3];
+    std::unordered_set<std::uint64_t> m_pairs;
+    std::vector<Pair> m_added;
+    std::vector<Pair> m_removed;
+};
+
+} //namespace sgl
+
+#endif //_GSWEEPANDPRUNE_H_
@@ -21,11 +21,16 @@
 
 #include "GExports.h"
 
+#include <atomic>
+
 namespace sgl
 {
 
 /**
  * @brief Utility class which provides access to tolerance constants.
+ *   <p/> Tolerances are process-wide defaults which can be overridden for the current thread
+ *   by GToleranceScope, so parallel workers can use different tolerances without locks.
+ *   Reads are inline: one thread-local flag check and one load.
  */
 class SGL_API GTolerance
 {
@@ -49,24 +54,122 @@ public:
     static double zeroTol();
 
     /**
-     * @brief Sets length tolerance
+     * @brief Sets process-wide length tolerance. Threads inside GToleranceScope keep scope value
      * @param tolerance - length tolerance value
      */
     static void setLengthTol(double tolerance);
 
     /**
-     * @brief Sets angular tolerance
+     * @brief Sets process-wide angular tolerance. Threads inside GToleranceScope keep scope value
      * @param tolerance - angular tolerance value
      */
     static void setAngularTol(double tolerance);
 
     /**
-     * @brief Sets zero tolerance
+     * @brief Sets process-wide zero tolerance. Threads inside GToleranceScope keep scope value
      * @param tolerance - zero tolerance value
      */
     static void setZeroTol(double tolerance);
+
+private:
+    friend class GToleranceScope;
+
+    struct State
+    {
+        double lengthTol;
+        double angularTol;
+        double zeroTol;
+        bool scoped;
+    };
+
+    /**
+     * @return tolerances of the current thread. Thread-local storage can't be shared
+     *   between modules on Windows, so there it is accessed through the library.
+     */
+    static State & threadState();
+
+    static std::atomic<double> s_lengthTol;
+    static std::atomic<double> s_angularTol;
+    static std::atomic<double> s_zeroTol;
 };
 
+/**
+ * @brief Overrides tolerances for the current thread until destruction.
+ *   <p/> Scopes can be nested, destruction restores tolerances which were active on construction.
+ *   Other threads are not affected.
+ *   <pre>
+ *     {
+ *         GToleranceScope scope(1.0e-3);
+ *         // GTolerance::lengthTol() == 1.0e-3 in this thread
+ *     }
+ *   </pre>
+ */
+class GToleranceScope
+{
+public:
+    /**
+     * @brief Sets tolerances of the current thread
+     * @param lengthTol - length tolerance
+     * @param angularTol - angular tolerance, defaults to current value
+     * @param zeroTol - zero tolerance, defaults to current value
+     */
+    explicit GToleranceScope(double lengthTol,
+                             double angularTol = GTolerance::angularTol(),
+                             double zeroTol = GTolerance::zeroTol());
+
+    /**
+     * @brief Restores tolerances of the current thread
+     */
+    ~GToleranceScope();
+
+    GToleranceScope(const GToleranceScope &) = delete;
+    GToleranceScope & operator=(const GToleranceScope &) = delete;
+
+private:
+    GTolerance::State m_previous;
+};
+
+//
+// Inline implementation
+//
+
+#ifndef _WIN32
+inline GTolerance::State & GTolerance::threadState()
+{
+    static thread_local State s_state{ 0.0, 0.0, 0.0, false };
+    return s_state;
+}
+#endif
+
+inline double GTolerance::lengthTol()
+{
+    const State & state = threadState();
+    return state.scoped ? state.lengthTol : s_lengthTol.load(std::memory_order_relaxed);
+}
+
+inline double GTolerance::angularTol()
+{
+    const State & state = threadState();
+    return state.scoped ? state.angularTol : s_angularTol.load(std::memory_order_relaxed);
+}
+
+inline double GTolerance::zeroTol()
+{
+    const State & state = threadState();
+    return state.scoped ? state.zeroTol : s_zeroTol.load(std::memory_order_relaxed);
+}
+
+inline GToleranceScope::GToleranceScope(double lengthTol, double angularTol, double zeroTol)
+    : m_previous{ GTolerance::threadState() }
+{
+    GTolerance::threadState() = { lengthTol, angularTol, zeroTol, true };
+}
+
+inline GToleranceScope::~GToleranceScope()
+{
+    GTolerance::threadState() = m_previous;
+}
+
 } //namespace sgl
 
 #endif //_GTOLERANCE_H_
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GTRANSFORM_H_
+#define _GTRANSFORM_H_
+
+#include "GExports.h"
+#include "GCollections.h"
+
+#include <cstddef>
+
+namespace sgl
+{
+
+/**
+ * Bulk transformation of points and vectors by single matrix.
+ * <p/> Every function gives the same result, up to rounding, as applying
+ * GPoint3D::operator*=(const GMatrix4D &) (or GVector3D::operator*=(const GMatrix4D &)) to each
+ * element, but reads the matrix once and processes several elements per instruction. Kernel
+ * (AVX-512, AVX2, SSE2 or scalar) is chosen at runtime according to simdLevel() (see GSimd.h).
+ * <p/> Like those operators, the functions treat points and vectors as row vectors multiplied
+ * on the left of the matrix: x' = m(0, 0) * x + m(1, 0) * y + m(2, 0) * z + m(3, 0) and so on,
+ * so translation is taken from the last row (elements 12..14 of data()). Matrices built by
+ * GMatrix4D factories and GMatrix4D(origin, x, y, z) keep translation in the last column
+ * and must be passed transposed.
+ * <p/> Source and destination ranges may be the same but must not partially overlap.
+ */
+
+/**
+ * @brief Transforms array of points in place
+ * @param m - transformation matrix
+ * @param pPoints - pointer to the first point
+ * @param count - number of points
+ */
+SGL_API void transformPoints(const GMatrix4D & m, GPoint3D * pPoints, std::size_t count);
+
+/**
+ * @brief Transforms array of points
+ * @param m - transformation matrix
+ * @param pSrc - pointer to the first source point
+ * @param pDst - pointer to the first destination point
+ * @param count - number of points
+ */
+SGL_API void transformPoints(const GMatrix4D & m, const GPoint3D * pSrc, GPoint3D * pDst, std::size_t count);
+
+/**
+ * @brief Transforms array of points in place
+ * @param m - transformation matrix
+ * @param points - points
+ */
+SGL_API void transformPoints(const GMatrix4D & m, GPoint3DArray & points);
+
+/**
+ * @brief Transforms points given by coordinate arrays (structure of arrays) in place
+ * @param m - transformation matrix
+ * @param pX - x coordinates
+ * @param pY - y coordinates
+ * @param pZ - z coordinates
+ * @param count - number of points
+ */
+SGL_API void transformPoints(const GMatrix4D & m, double * pX, double * pY, double * pZ, std::size_t count);
+
+/**
+ * @brief Transforms points of cloud in place. Per-point attributes are not changed
+ * @param m - transformation matrix
+ * @param cloud - point cloud
+ */
+SGL_API void transformPoints(const GMatrix4D & m, GPointCloud & cloud);
+
+/**
+ * @brief Transforms array of vectors in place
+ * @param m - transformation matrix
+ * @param pVectors - pointer to the first vector
+ * @param count - number of vectors
+ */
+SGL_API void transformVectors(const GMatrix4D & m, GVector3D * pVectors, std::size_t count);
+
+/**
+ * @brief Transforms array of vectors
+ * @param m - transformation matrix
+ * @param pSrc - pointer to the first source vector
+ * @param pDst - pointer to the first destination vector
+ * @param count - number of vectors
+ */
+SGL_API void transformVectors(const GMatrix4D & m, const GVector3D * pSrc, GVector3D * pDst, std::size_t count);
+
+/**
+ * @brief Transforms array of vectors in place
+ * @param m - transformation matrix
+ * @param vectors - vectors
+ */
+SGL_API void transformVectors(const GMatrix4D & m, GVector3DArray & vectors);
+
+/**
+ * @brief Transforms vectors given by coordinate arrays (structure of arrays) in place
+ * @param m - transformation matrix
+ * @param pX - x coordinates
+ * @param pY - y coordinates
+ * @param pZ - z coordinates
+ * @param count - number of vectors
+ */
+SGL_API void transformVectors(const GMatrix4D & m, double * pX, double * pY, double * pZ, std::size_t count);
+
+} //namespace sgl
+
+#endif //_GTRANSFORM_H_
@@ -21,54 +21,61 @@
 
 #include "GExports.h"
 #include "GTolerance.h"
+#include "GCollections.h"
 
+#include <cmath>
+#include <cstddef>
 #include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
 
 namespace sgl
 {
 
-class GMatrix4D;
-class GPoint3D;
-
 /**
- * @brief 3D Vector class for mathematical operations
+ * @brief 3D Vector class for mathematical operations.
+ *   <p/> Vector is a trivially copyable standard layout type which consists of exactly
+ *   three scalars, so arrays of vectors can be treated as packed [x0, y0, z0, x1, ...] buffers.
+ *   <p/> Use GVector3D (double) and GVector3Df (float) aliases.
+ * @tparam T - scalar type (double or float)
  * @author Artemiy Kanshin
  */
-class SGL_API GVector3D
+template<typename T>
+class GVector3DT
 {
 public:
     /**
      * @return const reference to [1.0, 0.0, 0.0] vector
      */
-    static const GVector3D & axisX();
+    static const GVector3DT & axisX();
 
     /**
      * @return const reference to [0.0, 1.0, 0.0] vector
      */
-    static const GVector3D & axisY();
+    static const GVector3DT & axisY();
 
     /**
      * @return const reference to [0.0, 0.0, 1.0] vector
      */
-    static const GVector3D & axisZ();
+    static const GVector3DT & axisZ();
 
 public:
     /**
      * @brief Initializes zero vector.
      */
-    GVector3D();
+    constexpr GVector3DT() = default;
 
     /**
      * @brief Copy constructor
      * @param other - other vector
      */
-    GVector3D(const GVector3D & other);
+    constexpr GVector3DT(const GVector3DT & other) = default;
 
     /**
      * @brief Move constructor
      * @param other
      */
-    GVector3D(GVector3D && other) noexcept;
+    constexpr GVector3DT(GVector3DT && other) noexcept = default;
 
     /**
      * @brief Initializes vector with specified coordinates
@@ -76,54 +83,61 @@ public:
      * @param y - Y coordinate
      * @param z - Z coordinate
      */
-    explicit GVector3D(double x, double y, double z);
+    constexpr explicit GVector3DT(T x, T y, T z);
+
+    /**
+     * @brief Initializes vector with coordinates of vector with other scalar type
+     * @param v - vector
+     */
+    template<typename U>
+    constexpr explicit GVector3DT(const GVector3DT<U> & v);
 
     /**
-     * @brief Initializes vector with pointer to array of (at least) 3 doubles
+     * @brief Initializes vector with pointer to array of (at least) 3 scalars
      * @param pCoords - Pointer to array with coordinates
      */
-    explicit GVector3D(double * pCoords);
+    constexpr explicit GVector3DT(const T * pCoords);
 
     /**
      * @brief Initializes vector by initializer list
      */
-    GVector3D(std::initializer_list<double>);
+    constexpr GVector3DT(std::initializer_list<T>);
 
     /** No doc */
-    virtual ~GVector3D();
+    ~GVector3DT() = default;
 
     /**
      * @return X coordinate
      */
-    double x() const;
+    constexpr T x() const;
 
     /**
      * @brief Sets new value of x coordinate
      * @param newX - new value of x coordinate
      */
-    void setX(double newX);
+    constexpr void setX(T newX);
 
     /**
      * @return Y coordinate
      */
-    double y() const;
+    constexpr T y() const;
 
     /**
      * @brief Sets new value of y coordinate
      * @param newY - new value of y coordinate
      */
-    void setY(double newY);
+    constexpr void setY(T newY);
 
     /**
      * @return Z coordinate
      */
-    double z() const;
+    constexpr T z() const;
 
     /**
      * @brief Sets new value of z coordinate
      * @param newZ - new value of z coordinate
      */
-    void setZ(double newZ);
+    constexpr void setZ(T newZ);
 
     /**
      * @brief Sets new coordinates to the vector.
@@ -131,7 +145,19 @@ public:
      * @param newY - new value of y coordinate
      * @param newZ - new value of z coordinate
      */
-    void set(double newX, double newY, double newZ);
+    constexpr void set(T newX, T newY, T newZ);
+
+    /**
+     * @brief Gives read only access to the coordinates as to array of 3 scalars
+     * @return pointer to x coordinate
+     */
+    constexpr const T * data() const;
+
+    /**
+     * @brief Gives write access to the coordinates as to array of 3 scalars
+     * @return pointer to x coordinate
+     */
+    constexpr T * data();
 
     /**
      * @brief operator [] for read only access
@@ -139,7 +165,7 @@ public:
      * @return coordinate value
      * @throws std::invalid_argument
      */
-    double operator[](std::size_t coordIdx) const;
+    constexpr T operator[](std::size_t coordIdx) const;
 
     /**
      * @brief operator [] for write access
@@ -147,13 +173,19 @@ public:
      * @return reference to coordinate value
      * @throws std::invalid_argument
      */
-    double & operator[](std::size_t coordIdx);
+    constexpr T & operator[](std::size_t coordIdx);
 
     /**
      * @brief Returns length of vector
      * @return vector length
      */
-    double length() const;
+    T length() const;
+
+    /**
+     * @brief Returns squared length of vector
+     * @return squared vector length
+     */
+    constexpr T squaredLength() const;
 
     /**
      * @brief Returns true if vector has zero length
@@ -174,13 +206,13 @@ public:
      * @return Reference to this vector object
      * @throws std::logic_error
      */
-    GVector3D & normalize();
+    GVector3DT & normalize();
 
     /**
      * @brief Returns normalized copy of this vector
      * @return normalized copy of this vector
      */
-    GVector3D normalize() const;
+    GVector3DT normalize() const;
 
     /**
      * @brief Returns true if this vector is equal to given within tolerance.
@@ -188,7 +220,7 @@ public:
      * @param tolerance - length tolerance
      * @return true if this vector is equal to given within tolerance, otherwise false
      */
-    bool equals(const GVector3D & v, double tolerance = GTolerance::lengthTol()) const;
+    bool equals(const GVector3DT & v, double tolerance = GTolerance::lengthTol()) const;
 
     /**
      * @brief Returns true if this vector is parallel to given within tolerance.
@@ -197,7 +229,7 @@ public:
      * @return true if this vector is parallel to given within tolerance, otherwise false.
      * @throws std::logic_error
      */
-    bool parallel(const GVector3D & v, double tolerance = GTolerance::angularTol()) const;
+    bool parallel(const GVector3DT & v, double tolerance = GTolerance::angularTol()) const;
 
     /**
      * @brief Returns true if this vector is antiparallel to given within tolerance
@@ -206,7 +238,7 @@ public:
      * @return true if this vector is antiparallel to given within tolerance, otherwise false
      * @throws std::logic_error
      */
-    bool antiparallel(const GVector3D & v, double tolerance = GTolerance::angularTol()) const;
+    bool antiparallel(const GVector3DT & v, double tolerance = GTolerance::angularTol()) const;
 
     /**
      * @brief Returns true if this vector is biparallel to given within tolerance
@@ -215,7 +247,7 @@ public:
      * @return true if this vector is biparallel to given within tolerance, otherwise false
      * @throws std::logic_error
      */
-    bool biparallel(const GVector3D & v, double tolerance = GTolerance::angularTol()) const;
+    bool biparallel(const GVector3DT & v, double tolerance = GTolerance::angularTol()) const;
 
     /**
      * @brief Returns true if this is perpendicular to given within tolerance
@@ -224,61 +256,79 @@ public:
      * @return true if this vector is perpendicular to given within tolerance, otherwise false
      * @throws std::logic_error
      */
-    bool perpendicular(const GVector3D & v, double tolerance = GTolerance::angularTol()) const;
+    bool perpendicular(const GVector3DT & v, double tolerance = GTolerance::angularTol()) const;
 
     /**
      * @brief operator =
      * @param v - vector
      * @return reference to this vector object
      */
-    GVector3D & operator=(const GVector3D & v);
+    constexpr GVector3DT & operator=(const GVector3DT & v) = default;
+
+    /**
+     * @brief Move assignment operator
+     * @param v - vector
+     * @return reference to this vector object
+     */
+    constexpr GVector3DT & operator=(GVector3DT && v) noexcept = default;
 
     /**
      * @brief Adds input vector coordinates
      * @param v - vector
      * @return Reference to this vector object
      */
-    GVector3D & operator+=(const GVector3D & v);
+    constexpr GVector3DT & operator+=(const GVector3DT & v);
 
     /**
      * @brief Subtracts input vector coordinates
      * @param v - vector
      * @return Reference to this vector object
      */
-    GVector3D & operator-=(const GVector3D & v);
+    constexpr GVector3DT & operator-=(const GVector3DT & v);
 
     /**
      * @brief Multiplies this vector coordinates by scalar
      * @param scalar - scalar
      * @return Reference to this vector object
      */
-    GVector3D & operator*=(double scalar);
+    constexpr GVector3DT & operator*=(T scalar);
 
     /**
      * @brief Divides this vector coordinates by scalar
      * @param scalar - scalar
      * @return Reference to this vector object
+     * @throws std::logic_error
      */
-    GVector3D & operator/=(double scalar);
+    GVector3DT & operator/=(T scalar);
 
     /**
      * @brief Transforms this vector by given transformation matrix
      * @param m - transformation matrix
      * @return Reference to this vector object
      */
-    GVector3D & operator*=(const GMatrix4D & m);
+    GVector3DT & operator*=(const GMatrix4DT<T> & m);
 
 private:
-    double m_x{0}, m_y{0}, m_z{0};
+    T m_coords[3]{0, 0, 0};
 };
 
+extern template class SGL_API GVector3DT<double>;
+extern template class SGL_API GVector3DT<float>;
+
+static_assert(std::is_trivially_copyable<GVector3D>::value, "GVector3D must be trivially copyable");
+static_assert(std::is_standard_layout<GVector3D>::value, "GVector3D must have standard layout");
+static_assert(sizeof(GVector3D) == 3 * sizeof(double), "GVector3D must be packed as 3 doubles");
+static_assert(std::is_trivially_copyable<GVector3Df>::value, "GVector3Df must be trivially copyable");
+static_assert(sizeof(GVector3Df) == 3 * sizeof(float), "GVector3Df must be packed as 3 floats");
+
 /**
  * @brief Scalar product operator
  * @param v1 - first vector
  * @param v2 - second vector
  * @return scalar product result
  */
-SGL_API double operator%(const GVector3D & v1, const GVector3D & v2);
+template<typename T>
+constexpr T operator%(const GVector3DT<T> & v1, const GVector3DT<T> & v2);
 
 /**
  * @brief Cross product operator
@@ -286,7 +336,8 @@ SGL_API double operator%(const GVector3D & v1, const GVector3D & v2);
  * @param v2 - second vector
  * @return vector which is cross product result
  */
-SGL_API GVector3D operator*(const GVector3D & v1, const GVector3D & v2);
+template<typename T>
+constexpr GVector3DT<T> operator*(const GVector3DT<T> & v1, const GVector3DT<T> & v2);
 
 /**
  * @brief Returns a sum of given vectors
@@ -294,7 +345,8 @@ SGL_API GVector3D operator*(const GVector3D & v1, const GVector3D & v2);
  * @param v2 - second vector
  * @return a sum of given vectors
  */
-SGL_API GVector3D operator+(const GVector3D & v1, const GVector3D & v2);
+template<typename T>
+constexpr GVector3DT<T> operator+(const GVector3DT<T> & v1, const GVector3DT<T> & v2);
 
 /**
  * @brief Returns a difference of given vector
@@ -302,7 +354,8 @@ SGL_API GVector3D operator+(const GVector3D & v1, const GVector3D & v2);
  * @param v2 - second vector
  * @return a difference
  */
-SGL_API GVector3D operator-(const GVector3D & v1, const GVector3D & v2);
+template<typename T>
+constexpr GVector3DT<T> operator-(const GVector3DT<T> & v1, const GVector3DT<T> & v2);
 
 /**
  * @brief Returns transformed copy of given vector
@@ -310,7 +363,201 @@ SGL_API GVector3D operator-(const GVector3D & v1, const GVector3D & v2);
  * @param v - vector to transform
  * @return transformed copy of given vector
  */
-SGL_API GVector3D operator*(const GMatrix4D & m, const GVector3D & v);
+template<typename T>
+GVector3DT<T> operator*(const GMatrix4DT<T> & m, const GVector3DT<T> & v);
+
+extern template SGL_API GVector3D operator*(const GMatrix4D & m, const GVector3D & v);
+extern template SGL_API GVector3Df operator*(const GMatrix4Df & m, const GVector3Df & v);
+
+/**
+ * @brief Gives access to the vectors as to packed array of 3 * vectors.size() scalars
+ * @param vectors - vectors array
+ * @return pointer to x coordinate of the first vector or nullptr if array is empty
+ */
+template<typename T>
+inline T * coordinates(std::vector<GVector3DT<T>> & vectors);
+
+/**
+ * @brief Gives read only access to the vectors as to packed array of 3 * vectors.size() scalars
+ * @param vectors - vectors array
+ * @return pointer to x coordinate of the first vector or nullptr if array is empty
+ */
+template<typename T>
+inline const T * coordinates(const std::vector<GVector3DT<T>> & vectors);
+
+//
+// Inline implementation
+//
+
+template<typename T>
+constexpr GVector3DT<T>::GVector3DT(T x, T y, T z)
+    : m_coords{ x, y, z }
+{}
+
+template<typename T>
+template<typename U>
+constexpr GVector3DT<T>::GVector3DT(const GVector3DT<U> & v)
+    : m_coords{ static_cast<T>(v.x()), static_cast<T>(v.y()), static_cast<T>(v.z()) }
+{}
+
+template<typename T>
+constexpr GVector3DT<T>::GVector3DT(const T * pCoords)
+    : m_coords{ pCoords[0], pCoords[1], pCoords[2] }
+{}
+
+template<typename T>
+constexpr GVector3DT<T>::GVector3DT(std::initializer_list<T> l)
+    : m_coords{ l.begin()[0], l.begin()[1], l.begin()[2] }
+{}
+
+template<typename T>
+constexpr T GVector3DT<T>::x() const
+{
+    return m_coords[0];
+}
+
+template<typename T>
+constexpr void GVector3DT<T>::setX(T newX)
+{
+    m_coords[0] = newX;
+}
+
+template<typename T>
+constexpr T GVector3DT<T>::y() const
+{
+    return m_coords[1];
+}
+
+template<typename T>
+constexpr void GVector3DT<T>::setY(T newY)
+{
+    m_coords[1] = newY;
+}
+
+template<typename T>
+constexpr T GVector3DT<T>::z() const
+{
+    return m_coords[2];
+}
+
+template<typename T>
+constexpr void GVector3DT<T>::setZ(T newZ)
+{
+    m_coords[2] = newZ;
+}
+
+template<typename T>
+constexpr void GVector3DT<T>::set(T newX, T newY, T newZ)
+{
+    m_coords[0] = newX;
+    m_coords[1] = newY;
+    m_coords[2] = newZ;
+}
+
+template<typename T>
+constexpr const T * GVector3DT<T>::data() const
+{
+    return m_coords;
+}
+
+template<typename T>
+constexpr T * GVector3DT<T>::data()
+{
+    return m_coords;
+}
+
+template<typename T>
+constexpr T GVector3DT<T>::operator[](std::size_t coordIdx) const
+{
+    if (coordIdx > 2)
+        throw std::invalid_argument("GVector3D: index out of bounds");
+    return m_coords[coordIdx];
+}
+
+template<typename T>
+constexpr T & GVector3DT<T>::operator[](std::size_t coordIdx)
+{
+    if (coordIdx > 2)
+        throw std::invalid_argument("GVector3D: index out of bounds");
+    return m_coords[coordIdx];
+}
+
+template<typename T>
+inline T GVector3DT<T>::length() const
+{
+    return std::sqrt(squaredLength());
+}
+
+template<typename T>
+constexpr T GVector3DT<T>::squaredLength() const
+{
+    return m_coords[0] * m_coords[0] + m_coords[1] * m_coords[1] + m_coords[2] * m_coords[2];
+}
+
+template<typename T>
+constexpr GVector3DT<T> & GVector3DT<T>::operator+=(const GVector3DT<T> & v)
+{
+    m_coords[0] += v.m_coords[0];
+    m_coords[1] += v.m_coords[1];
+    m_coords[2] += v.m_coords[2];
+    return *this;
+}
+
+template<typename T>
+constexpr GVector3DT<T> & GVector3DT<T>::operator-=(const GVector3DT<T> & v)
+{
+    m_coords[0] -= v.m_coords[0];
+    m_coords[1] -= v.m_coords[1];
+    m_coords[2] -= v.m_coords[2];
+    return *this;
+}
+
+template<typename T>
+constexpr GVector3DT<T> & GVector3DT<T>::operator*=(T scalar)
+{
+    m_coords[0] *= scalar;
+    m_coords[1] *= scalar;
+    m_coords[2] *= scalar;
+    return *this;
+}
+
+template<typename T>
+constexpr T operator%(const GVector3DT<T> & v1, const GVector3DT<T> & v2)
+{
+    return v1.x() * v2.x() + v1.y() * v2.y() + v1.z() * v2.z();
+}
+
+template<typename T>
+constexpr GVector3DT<T> operator*(const GVector3DT<T> & v1, const GVector3DT<T> & v2)
+{
+    return GVector3DT<T>(v1.y() * v2.z() - v1.z() * v2.y(),
+                         v1.z() * v2.x() - v1.x() * v2.z(),
+                         v1.x() * v2.y() - v1.y() * v2.x());
+}
+
+template<typename T>
+constexpr GVector3DT<T> operator+(const GVector3DT<T> & v1, const GVector3DT<T> & v2)
+{
+    return GVector3DT<T>(v1.x() + v2.x(), v1.y() + v2.y(), v1.z() + v2.z());
+}
+
+template<typename T>
+constexpr GVector3DT<T> operator-(const GVector3DT<T> & v1, const GVector3DT<T> & v2)
+{
+    return GVector3DT<T>(v1.x() - v2.x(), v1.y() - v2.y(), v1.z() - v2.z());
+}
+
+template<typename T>
+inline T * coordinates(std::vector<GVector3DT<T>> & vectors)
+{
+    return vectors.empty() ? nullptr : vectors.front().data();
+}
+
+template<typename T>
+inline const T * coordinates(const std::vector<GVector3DT<T>> & vectors)
+{
+    return vectors.empty() ? nullptr : vectors.front().data();
+}
 
 } //namespace sgl
 
@@ -0,0 +1,215 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GVECTOROPS_H_
+#define _GVECTOROPS_H_
+
+#include "GExports.h"
+#include "GCollections.h"
+#include "GTolerance.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sgl
+{
+
+/**
+ * Bulk operations over arrays of vectors.
+ * <p/> Every function gives the same result as applying corresponding GVector3D operation
+ * (length(), squaredLength(), normalize(), operator%, operator*) to each element up to rounding
+ * of fused multiply-add, but processes several elements per instruction. Kernel (AVX-512, AVX2
+ * or scalar) is chosen at runtime according to simdLevel() (see GSimd.h).
+ * <p/> Vectors are given either as arrays of GVector3D or as coordinate arrays (structure of arrays).
+ * Source and destination ranges may be the same but must not partially overlap.
+ */
+
+/**
+ * @brief Computes lengths of vectors
+ * @param pVectors - pointer to the first vector
+ * @param count - number of vectors
+ * @param pLengths - [out] count lengths
+ */
+SGL_API void lengths(const GVector3D * pVectors, std::size_t count, double * pLengths);
+
+/**
+ * @brief Computes lengths of vectors given by coordinate arrays
+ * @param pX - x coordinates
+ * @param pY - y coordinates
+ * @param pZ - z coordinates
+ * @param count - number of vectors
+ * @param pLengths - [out] count lengths
+ */
+SGL_API void lengths(const double * pX, const double * pY, const double * pZ, std::size_t count, double * pLengths);
+
+/**
+ * @brief Computes squared lengths of vectors
+ * @param pVectors - pointer to the first vector
+ * @param count - number of vectors
+ * @param pLengths - [out] count squared lengths
+ */
+SGL_API void squaredLengths(const GVector3D * pVectors, std::size_t count, double * pLengths);
+
+/**
+ * @brief Computes squared lengths of vectors given by coordinate arrays
+ * @param pX - x coordinates
+ * @param pY - y coordinates
+ * @param pZ - z coordinates
+ * @param count - number of vectors
+ * @param pLengths - [out] count squared lengths
+ */
+SGL_API void squaredLengths(const double * pX, const double * pY, const double * pZ, std::size_t count,
+                            double * pLengths);
+
+/**
+ * @brief Normalizes vectors in place. Unlike GVector3D::normalize() doesn't throw:
+ *   vectors with length less than GTolerance::zeroTol() are left unchanged and marked in status
+ * @param pVectors - pointer to the first vector
+ * @param count - number of vectors
+ * @param pNormalized - [out] count flags, 1 if vector has been normalized, 0 if it has zero length
+ * @return number of normalized vectors
+ */
+SGL_API std::size_t normalizeVectors(GVector3D * pVectors, std::size_t count, std::uint8_t * pNormalized);
+
+/**
+ * @brief Normalizes vectors in place
+ * @see normalizeVectors(GVector3D *, std::size_t, std::uint8_t *)
+ * @param vectors - vectors
+ * @param pNormalized - [out] vectors.size() flags, 1 if vector has been normalized, 0 if it has zero length
+ * @return number of normalized vectors
+ */
+SGL_API std::size_t normalizeVectors(GVector3DArray & vectors, std::uint8_t * pNormalized);
+
+/**
+ * @brief Normalizes vectors given by coordinate arrays in place
+ * @see normalizeVectors(GVector3D *, std::size_t, std::uint8_t *)
+ * @param pX - x coordinates
+ * @param pY - y coordinates
+ * @param pZ - z coordinates
+ * @param count - number of vectors
+ * @param pNormalized - [out] count flags, 1 if vector has been normalized, 0 if it has zero length
+ * @return number of normalized vectors
+ */
+SGL_API std::size_t normalizeVectors(double * pX, double * pY, double * pZ, std::size_t count,
+                                     std::uint8_t * pNormalized);
+
+/**
+ * @brief Computes dot products of pairs of vectors
+ * @param pVectors1 - pointer to the first vector of the first array
+ * @param pVectors2 - pointer to the first vector of the second array
+ * @param count - number of pairs
+ * @param pDots - [out] count dot products
+ */
+SGL_API void dotProducts(const GVector3D * pVectors1, const GVector3D * pVectors2, std::size_t count,
+                         double * pDots);
+
+/**
+ * @brief Computes dot products of pairs of vectors given by coordinate arrays
+ * @param pX1 - x coordinates of the first vectors
+ * @param pY1 - y coordinates of the first vectors
+ * @param pZ1 - z coordinates of the first vectors
+ * @param pX2 - x coordinates of the second vectors
+ * @param pY2 - y coordinates of the second vectors
+ * @param pZ2 - z coordinates of the second vectors
+ * @param count - number of pairs
+ * @param pDots - [out] count dot products
+ */
+SGL_API void dotProducts(const double * pX1, const double * pY1, const double * pZ1, const double * pX2,
+                         const double * pY2, const double * pZ2, std::size_t count, double * pDots);
+
+/**
+ * @brief Computes cross products of pairs of vectors
+ * @param pVectors1 - pointer to the first vector of the first array
+ * @param pVectors2 - pointer to the first vector of the second array
+ * @param pResult - [out] count cross products
+ * @param count - number of pairs
+ */
+SGL_API void crossProducts(const GVector3D * pVectors1, const GVector3D * pVectors2, GVector3D * pResult,
+                           std::size_t count);
+
+/**
+ * @brief Computes cross products of pairs of vectors given by coordinate arrays
+ * @param pX1 - x coordinates of the first vectors
+ * @param pY1 - y coordinates of the first vectors
+ * @param pZ1 - z coordinates of the first vectors
+ * @param pX2 - x coordinates of the second vectors
+ * @param pY2 - y coordinates of the second vectors
+ * @param pZ2 - z coordinates of the second vectors
+ * @param pX - [out] x coordinates of cross products
+ * @param pY - [out] y coordinates of cross products
+ * @param pZ - [out] z coordinates of cross products
+ * @param count - number of pairs
+ */
+SGL_API void crossProducts(const double * pX1, const double * pY1, const double * pZ1, const double * pX2,
+                           const double * pY2, const double * pZ2, double * pX, double * pY, double * pZ,
+                           std::size_t count);
+
+/**
+ * @brief Relation of two directions found by classifyDirections()
+ */
+enum class GDirectionRelation : std::uint8_t
+{
+    None = 0,           ///< none of the following or one of vectors has zero length
+    Parallel = 1,       ///< GVector3D::parallel() is true
+    Antiparallel = 2,   ///< GVector3D::antiparallel() is true
+    Perpendicular = 3   ///< GVector3D::perpendicular() is true
+};
+
+/**
+ * @brief Classifies pairs of directions as parallel, antiparallel or perpendicular.
+ *   <p/> Cosine of angle is not computed: dot product d is compared with product of squared lengths p,
+ *   so vectors are parallel if d > 0 and d * d > (1 - tolerance)^2 * p, perpendicular if
+ *   d * d < tolerance^2 * p. Results match GVector3D predicates except of pairs within rounding error
+ *   of the thresholds. Pairs are split between threads, each thread uses vectorized kernel.
+ *   Pairs with vector lengths out of [1e-70, 1e70], where the products could overflow or underflow,
+ *   are classified by slower scalar code after dividing each vector by its largest coordinate.
+ * @param pVectors1 - pointer to the first vector of the first array
+ * @param pVectors2 - pointer to the first vector of the second array
+ * @param count - number of pairs
+ * @param pRelations - [out] count relations
+ * @param tolerance - angular tolerance, in (0, 0.5)
+ * @param threadCount - maximal number of threads, 0 - number of hardware threads
+ * @throws std::invalid_argument if tolerance is out of range
+ */
+SGL_API void classifyDirections(const GVector3D * pVectors1, const GVector3D * pVectors2, std::size_t count,
+                                GDirectionRelation * pRelations, double tolerance = GTolerance::angularTol(),
+                                unsigned threadCount = 0);
+
+/**
+ * @brief Classifies pairs of directions given by coordinate arrays
+ * @see classifyDirections(const GVector3D *, const GVector3D *, std::size_t, GDirectionRelation *, double, unsigned)
+ * @param pX1 - x coordinates of the first vectors
+ * @param pY1 - y coordinates of the first vectors
+ * @param pZ1 - z coordinates of the first vectors
+ * @param pX2 - x coordinates of the second vectors
+ * @param pY2 - y coordinates of the second vectors
+ * @param pZ2 - z coordinates of the second vectors
+ * @param count - number of pairs
+ * @param pRelations - [out] count relations
+ * @param tolerance - angular tolerance, in (0, 0.5)
+ * @param threadCount - maximal number of threads, 0 - number of hardware threads
+ * @throws std::invalid_argument if tolerance is out of range
+ */
+SGL_API void classifyDirections(const double * pX1, const double * pY1, const double * pZ1, const double * pX2,
+                                const double * pY2, const double * pZ2, std::size_t count,
+                                GDirectionRelation * pRelations, double tolerance = GTolerance::angularTol(),
+                                unsigned threadCount = 0);
+
+} //namespace sgl
+
+#endif //_GVECTOROPS_H_
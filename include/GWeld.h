@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GWELD_H_
+#define _GWELD_H_
+
+#include "GExports.h"
+#include "GCollections.h"
+#include "GPoint3D.h"
+#include "GTolerance.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace sgl
+{
+
+/**
+ * @brief Result of point welding
+ */
+struct GWeldResult
+{
+    /** Unique points, sorted lexicographically (x, then y, then z) */
+    GPoint3DArray points;
+    /** Index of unique point for every source point */
+    std::vector<std::size_t> remap;
+};
+
+/**
+ * @brief Merges coincident points.
+ *   <p/> Points p and q are coincident if p.equals(q, tolerance); clusters are closed transitively,
+ *   so chains of coincident points merge into one point even if their ends are farther apart.
+ *   Cluster is represented by its lexicographically smallest point, so the result doesn't depend
+ *   on order of source points or on number of threads.
+ *   <p/> Points are sorted by cells of grid with cell size equal to tolerance and compared with
+ *   points of neighbour cells only; sorting and comparison run in parallel. Exact duplicates are
+ *   merged right after sorting and points of one cell are welded to its first point, so welding
+ *   takes O(n log(n)) even if many points coincide.
+ * @param pPoints - pointer to the first point
+ * @param count - number of points
+ * @param tolerance - tolerance, positive
+ * @param threadCount - maximal number of threads, 0 - number of hardware threads
+ * @return unique points and remap indices
+ * @throws std::invalid_argument if tolerance is not positive
+ */
+SGL_API GWeldResult weldPoints(const GPoint3D * pPoints, std::size_t count,
+                               double tolerance = GTolerance::lengthTol(), unsigned threadCount = 0);
+
+/**
+ * @brief Merges coincident points, see weldPoints(const GPoint3D *, std::size_t, double, unsigned)
+ * @param points - points
+ * @param tolerance - tolerance, positive
+ * @param threadCount - maximal number of threads, 0 - number of hardware threads
+ * @return unique points and remap indices
+ */
+SGL_API GWeldResult weldPoints(const GPoint3DArray & points, double tolerance = GTolerance::lengthTol(),
+                               unsigned threadCount = 0);
+
+} //namespace sgl
+
+#endif //_GWELD_H_
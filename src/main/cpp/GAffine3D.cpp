@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GAffine3D.h"
+#include "GUtils.h"
+
+namespace sgl
+{
+
+GAffine3D GAffine3D::identity()
+{
+    return GAffine3D();
+}
+
+GAffine3D::GAffine3D()
+{
+    setIdentity();
+}
+
+GAffine3D::GAffine3D(std::initializer_list<double> l)
+{
+    if (l.size() != 12)
+        throw std::invalid_argument("GAffine3D: initializer list must have 12 numbers");
+    std::copy(l.begin(), l.end(), m_pData);
+}
+
+GAffine3D::GAffine3D(const GPoint3D & o, const GVector3D & x, const GVector3D & y, const GVector3D & z)
+    : GAffine3D({ x[0], y[0], z[0], o[0],
+                  x[1], y[1], z[1], o[1],
+                  x[2], y[2], z[2], o[2] })
+{}
+
+GAffine3D::GAffine3D(const GMatrix4D & m)
+{
+    std::memcpy(m_pData, m.data(), 12 * sizeof(double));
+}
+
+GAffine3D::operator GMatrix4D() const
+{
+    return toMatrix();
+}
+
+GMatrix4D GAffine3D::toMatrix() const
+{
+    GMatrix4D res;
+    std::memcpy(res.data(), m_pData, 12 * sizeof(double));
+    return res;
+}
+
+void GAffine3D::setIdentity()
+{
+    for (std::size_t idx = 0; idx < 12; ++idx)
+        m_pData[idx] = idx % 5 == 0 ? 1.0 : 0.0;
+}
+
+GPoint3D GAffine3D::origin() const
+{
+    return GPoint3D(m_pData[3], m_pData[7], m_pData[11]);
+}
+
+GVector3D GAffine3D::x() const
+{
+    return GVector3D(m_pData[0], m_pData[4], m_pData[8]);
+}
+
+GVector3D GAffine3D::y() const
+{
+    return GVector3D(m_pData[1], m_pData[5], m_pData[9]);
+}
+
+GVector3D GAffine3D::z() const
+{
+    return GVector3D(m_pData[2], m_pData[6], m_pData[10]);
+}
+
+GAffine3D & GAffine3D::postMultiplyBy(const GAffine3D & a)
+{
+    return *this = *this * a;
+}
+
+GAffine3D & GAffine3D::preMultiplyBy(const GAffine3D & a)
+{
+    return *this = a * *this;
+}
+
+GAffine3D & GAffine3D::product(const GAffine3D & a1, const GAffine3D & a2)
+{
+    return *this = a1 * a2;
+}
+
+GAffine3D & GAffine3D::invert()
+{
+    return *this = inverse();
+}
+
+GAffine3D GAffine3D::inverse() const
+{
+    const double * a = m_pData;
+    GAffine3D res;
+    double * r = res.m_pData;
+
+    if (isOrthonormal())
+    {
+        // [R t]^-1 = [R^T, -R^T * t]
+        for (std::size_t row = 0; row < 3; ++row)
+        {
+            for (std::size_t col = 0; col < 3; ++col)
+                r[4 * row + col] = a[4 * col + row];
+            r[4 * row + 3] = -(a[row] * a[3] + a[4 + row] * a[7] + a[8 + row] * a[11]);
+        }
+        return res;
+    }
+
+    const double c00 = a[5] * a[10] - a[6] * a[9];
+    const double c01 = a[6] * a[8] - a[4] * a[10];
+    const double c02 = a[4] * a[9] - a[5] * a[8];
+    const double det = a[0] * c00 + a[1] * c01 + a[2] * c02;
+    if (sgl::equal(det, 0.0))
+        throw std::logic_error("Matrix with zero determinant cannot be inverted");
+
+    const double invDet = 1.0 / det;
+    r[0] = c00 * invDet;
+    r[1] = (a[2] * a[9] - a[1] * a[10]) * invDet;
+    r[2] = (a[1] * a[6] - a[2] * a[5]) * invDet;
+    r[4] = c01 * invDet;
+    r[5] = (a[0] * a[10] - a[2] * a[8]) * invDet;
+    r[6] = (a[2] * a[4] - a[0] * a[6]) * invDet;
+    r[8] = c02 * invDet;
+    r[9] = (a[1] * a[8] - a[0] * a[9]) * invDet;
+    r[10] = (a[0] * a[5] - a[1] * a[4]) * invDet;
+
+    for (std::size_t row = 0; row < 3; ++row)
+        r[4 * row + 3] = -(r[4 * row] * a[3] + r[4 * row + 1] * a[7] + r[4 * row + 2] * a[11]);
+    return res;
+}
+
+bool GAffine3D::isOrthonormal(double tolerance /*= GTolerance::angularTol()*/) const
+{
+    const double * a = m_pData;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        for (std::size_t j = i; j < 3; ++j)
+        {
+            const double dot = a[4 * i] * a[4 * j] + a[4 * i + 1] * a[4 * j + 1] + a[4 * i + 2] * a[4 * j + 2];
+            if (!equal(dot, i == j ? 1.0 : 0.0, tolerance))
+                return false;
+        }
+    }
+    return true;
+}
+
+bool GAffine3D::singular(double tolerance /*= GTolerance::zeroTol()*/) const
+{
+    return equal(determinant(), 0.0, tolerance);
+}
+
+double GAffine3D::determinant() const
+{
+    const double * a = m_pData;
+    return a[0] * (a[5] * a[10] - a[6] * a[9])
+         + a[1] * (a[6] * a[8] - a[4] * a[10])
+         + a[2] * (a[4] * a[9] - a[5] * a[8]);
+}
+
+bool GAffine3D::equals(const GAffine3D & a, double tolerance /*= GTolerance::zeroTol()*/) const
+{
+    for (std::size_t idx = 0; idx < 12; ++idx)
+    {
+        if (!equal(m_pData[idx], a.m_pData[idx], tolerance))
+            return false;
+    }
+    return true;
+}
+
+GAffine3D operator*(const GAffine3D & a1, const GAffine3D & a2)
+{
+    const double * l = a1.data();
+    const double * r = a2.data();
+    GAffine3D res;
+    double * p = res.data();
+    for (std::size_t row = 0; row < 3; ++row, l += 4, p += 4)
+    {
+        p[0] = l[0] * r[0] + l[1] * r[4] + l[2] * r[8];
+        p[1] = l[0] * r[1] + l[1] * r[5] + l[2] * r[9];
+        p[2] = l[0] * r[2] + l[1] * r[6] + l[2] * r[10];
+        p[3] = l[0] * r[3] + l[1] * r[7] + l[2] * r[11] + l[3];
+    }
+    return res;
+}
+
+GMatrix4D operator*(const GMatrix4D & m, const GAffine3D & a)
+{
+    return m * a.toMatrix();
+}
+
+GMatrix4D operator*(const GAffine3D & a, const GMatrix4D & m)
+{
+    return a.toMatrix() * m;
+}
+
+} //namespace sgl
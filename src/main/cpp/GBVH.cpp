@@ -0,0 +1,639 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GBVH.h"
+
+#include <cfloat>
+#include <future>
+#include <memory>
+#include <thread>
+
+namespace sgl
+{
+
+namespace
+{
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+// Number of bins of surface area heuristic
+constexpr std::size_t BIN_COUNT = 16;
+// Smaller subtrees are built on the calling thread
+constexpr std::size_t PARALLEL_THRESHOLD = 4096;
+// Deeper nodes are split by object median, which limits tree depth by MEDIAN_DEPTH + log2(n) <= 64
+constexpr std::size_t MEDIAN_DEPTH = 32;
+// Traversal stack holds at most one entry per level plus one
+constexpr std::size_t STACK_SIZE = 128;
+
+struct Aabb
+{
+    double lo[3] = { INF, INF, INF };
+    double hi[3] = { -INF, -INF, -INF };
+
+    void grow(const double * pLo, const double * pHi)
+    {
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            lo[axis] = std::min(lo[axis], pLo[axis]);
+            hi[axis] = std::max(hi[axis], pHi[axis]);
+        }
+    }
+
+    void grow(const Aabb & box)
+    {
+        grow(box.lo, box.hi);
+    }
+
+    // Half of surface area, 0 for empty box
+    double halfArea() const
+    {
+        if (lo[0] > hi[0])
+            return 0.0;
+        const double dx = hi[0] - lo[0];
+        const double dy = hi[1] - lo[1];
+        const double dz = hi[2] - lo[2];
+        return dx * dy + dy * dz + dz * dx;
+    }
+};
+
+// Single precision bounds rounded outwards
+float lowerBound(double value)
+{
+    if (value < -FLT_MAX)
+        return -std::numeric_limits<float>::infinity();
+    if (value > FLT_MAX)
+        return FLT_MAX;
+    const float res = static_cast<float>(value);
+    return static_cast<double>(res) > value ? std::nextafter(res, -std::numeric_limits<float>::infinity()) : res;
+}
+
+float upperBound(double value)
+{
+    if (value > FLT_MAX)
+        return std::numeric_limits<float>::infinity();
+    if (value < -FLT_MAX)
+        return -FLT_MAX;
+    const float res = static_cast<float>(value);
+    return static_cast<double>(res) < value ? std::nextafter(res, std::numeric_limits<float>::infinity()) : res;
+}
+
+void setBounds(GBVHNode & node, const Aabb & box)
+{
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        node.min[axis] = lowerBound(box.lo[axis]);
+        node.max[axis] = upperBound(box.hi[axis]);
+    }
+}
+
+struct BuildNode
+{
+    Aabb box;
+    std::unique_ptr<BuildNode> left;
+    std::unique_ptr<BuildNode> right;
+    std::uint32_t begin = 0;
+    std::uint32_t count = 0;
+    std::uint16_t axis = 0;
+};
+
+// Top-down builder with binned surface area heuristic. Subtrees cover disjoint ranges of
+// primitive order, so they are built by concurrent tasks.
+class Builder
+{
+public:
+    Builder(const std::vector<double> & bounds, std::size_t maxLeafSize, unsigned threadCount)
+        : m_bounds(bounds), m_maxLeafSize{ maxLeafSize }
+    {
+        const std::size_t count = bounds.size() / 6;
+        m_centroids.resize(3 * count);
+        for (std::size_t idx = 0; idx < count; ++idx)
+        {
+            for (std::size_t axis = 0; axis < 3; ++axis)
+                m_centroids[3 * idx + axis] = 0.5 * (bounds[6 * idx + axis] + bounds[6 * idx + 3 + axis]);
+        }
+        order.resize(count);
+        for (std::size_t idx = 0; idx < count; ++idx)
+            order[idx] = static_cast<std::uint32_t>(idx);
+        while ((1u << m_parallelDepth) < threadCount)
+            ++m_parallelDepth;
+    }
+
+    std::unique_ptr<BuildNode> build(std::uint32_t begin, std::uint32_t end, std::size_t depth)
+    {
+        auto node = std::make_unique<BuildNode>();
+        Aabb centroids;
+        for (std::uint32_t idx = begin; idx < end; ++idx)
+        {
+            const std::uint32_t prim = order[idx];
+            node->box.grow(&m_bounds[6 * prim], &m_bounds[6 * prim + 3]);
+            centroids.grow(&m_centroids[3 * prim], &m_centroids[3 * prim]);
+        }
+        node->begin = begin;
+        node->count = end - begin;
+        if (node->count <= m_maxLeafSize)
+            return node;
+
+        std::size_t axis = 0;
+        std::uint32_t mid = depth < MEDIAN_DEPTH ? binnedSplit(begin, end, centroids, axis) : begin;
+        if (mid == begin || mid == end)
+        {
+            // Object median along the largest centroid extent
+            for (std::size_t idx = 1; idx < 3; ++idx)
+            {
+                if (centroids.hi[idx] - centroids.lo[idx] > centroids.hi[axis] - centroids.lo[axis])
+                    axis = idx;
+            }
+            mid = begin + node->count / 2;
+            std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                             [this, axis](std::uint32_t prim1, std::uint32_t prim2)
+            {
+                return m_centroids[3 * prim1 + axis] < m_centroids[3 * prim2 + axis];
+            });
+        }
+        node->axis = static_cast<std::uint16_t>(axis);
+        node->count = 0;
+
+        if (end - begin >= PARALLEL_THRESHOLD && depth < m_parallelDepth)
+        {
+            auto left = std::async(std::launch::async, [this, begin, mid, depth]()
+            {
+                return build(begin, mid, depth + 1);
+            });
+            node->right = build(mid, end, depth + 1);
+            node->left = left.get();
+        }
+        else
+        {
+            node->left = build(begin, mid, depth + 1);
+            node->right = build(mid, end, depth + 1);
+        }
+        return node;
+    }
+
+    std::vector<std::uint32_t> order;
+
+private:
+    std::size_t binIndex(double centroid, double lo, double scale) const
+    {
+        return std::min(BIN_COUNT - 1, static_cast<std::size_t>((centroid - lo) * scale));
+    }
+
+    // Returns partition point of the cheapest split or begin if no split separates primitives
+    std::uint32_t binnedSplit(std::uint32_t begin, std::uint32_t end, const Aabb & centroids, std::size_t & bestAxis)
+    {
+        double bestCost = INF;
+        std::size_t bestBin = 0;
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            const double extent = centroids.hi[axis] - centroids.lo[axis];
+            if (!(extent > 0.0))
+                continue;
+            const double scale = static_cast<double>(BIN_COUNT) / extent;
+
+            Aabb bins[BIN_COUNT];
+            std::uint32_t counts[BIN_COUNT] = {};
+            for (std::uint32_t idx = begin; idx < end; ++idx)
+            {
+                const std::uint32_t prim = order[idx];
+                const std::size_t bin = binIndex(m_centroids[3 * prim + axis], centroids.lo[axis], scale);
+                ++counts[bin];
+                bins[bin].grow(&m_bounds[6 * prim], &m_bounds[6 * prim + 3]);
+            }
+
+            double leftArea[BIN_COUNT - 1];
+            std::uint32_t leftCount[BIN_COUNT - 1];
+            Aabb box;
+            std::uint32_t count = 0;
+            for (std::size_t bin = 0; bin + 1 < BIN_COUNT; ++bin)
+            {
+                box.grow(bins[bin]);
+                count += counts[bin];
+                leftArea[bin] = box.halfArea();
+                leftCount[bin] = count;
+            }
+            box = Aabb();
+            count = 0;
+            for (std::size_t bin = BIN_COUNT - 1; bin > 0; --bin)
+            {
+                box.grow(bins[bin]);
+                count += counts[bin];
+                if (count == 0 || leftCount[bin - 1] == 0)
+                    continue;
+                const double cost = leftCount[bin - 1] * leftArea[bin - 1] + count * box.halfArea();
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = bin;
+                }
+            }
+        }
+        if (bestCost == INF)
+            return begin;
+
+        const double lo = centroids.lo[bestAxis];
+        const double scale = static_cast<double>(BIN_COUNT) / (centroids.hi[bestAxis] - lo);
+        const auto it = std::partition(order.begin() + begin, order.begin() + end, [&](std::uint32_t prim)
+        {
+            return binIndex(m_centroids[3 * prim + bestAxis], lo, scale) < bestBin;
+        });
+        return static_cast<std::uint32_t>(it - order.begin());
+    }
+
+    const std::vector<double> & m_bounds;
+    std::vector<double> m_centroids;
+    std::size_t m_maxLeafSize;
+    std::size_t m_parallelDepth = 0;
+};
+
+void flatten(const BuildNode & node, std::vector<GBVHNode> & nodes)
+{
+    const std::size_t idx = nodes.size();
+    nodes.emplace_back();
+    setBounds(nodes[idx], node.box);
+    if (!node.left)
+    {
+        nodes[idx].index = node.begin;
+        nodes[idx].count = static_cast<std::uint16_t>(node.count);
+        return;
+    }
+    nodes[idx].axis = node.axis;
+    flatten(*node.left, nodes);
+    nodes[idx].index = static_cast<std::uint32_t>(nodes.size());
+    flatten(*node.right, nodes);
+}
+
+// Ray segment origin + t * direction, t in [0, maxDistance], prepared for slab tests
+struct Ray
+{
+    Ray(const GPoint3D & pt, const GVector3D & direction)
+    {
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            origin[axis] = pt[axis];
+            parallel[axis] = direction[axis] == 0.0;
+            invDir[axis] = parallel[axis] ? 0.0 : 1.0 / direction[axis];
+        }
+    }
+
+    template<typename T>
+    bool hits(const T * pLo, const T * pHi, double maxDistance) const
+    {
+        double tNear = 0.0;
+        double tFar = maxDistance;
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            if (parallel[axis])
+            {
+                if (pLo[axis] > origin[axis] || pHi[axis] < origin[axis])
+                    return false;
+                continue;
+            }
+            const double t1 = (pLo[axis] - origin[axis]) * invDir[axis];
+            const double t2 = (pHi[axis] - origin[axis]) * invDir[axis];
+            tNear = std::max(tNear, std::min(t1, t2));
+            tFar = std::min(tFar, std::max(t1, t2));
+        }
+        return tNear <= tFar;
+    }
+
+    double origin[3];
+    double invDir[3];
+    bool parallel[3];
+};
+
+template<typename T>
+bool overlaps(const T * pLo, const T * pHi, const double * pBoxLo, const double * pBoxHi)
+{
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        if (pLo[axis] > pBoxHi[axis] || pHi[axis] < pBoxLo[axis])
+            return false;
+    }
+    return true;
+}
+
+template<typename T>
+double pointBoxDistance(const GPoint3D & pt, const T * pLo, const T * pHi)
+{
+    double res = 0.0;
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        const double delta = std::max({ static_cast<double>(pLo[axis]) - pt[axis], 0.0,
+                                        pt[axis] - static_cast<double>(pHi[axis]) });
+        res += delta * delta;
+    }
+    return std::sqrt(res);
+}
+
+} //namespace
+
+GBVH::GBVH() = default;
+
+GBVH::GBVH(const std::vector<GBox3D> & bounds, std::size_t maxLeafSize /*= 4*/, unsigned threadCount /*= 0*/)
+{
+    if (maxLeafSize == 0 || maxLeafSize > 0xFFFF)
+        throw std::invalid_argument("GBVH: leaf size must be in range [1, 65535]");
+    if (bounds.size() > 0xFFFFFFFFu)
+        throw std::length_error("GBVH: too many primitives");
+    if (bounds.empty())
+        return;
+
+    std::vector<double> primBounds(6 * bounds.size());
+    for (std::size_t idx = 0; idx < bounds.size(); ++idx)
+    {
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            primBounds[6 * idx + axis] = bounds[idx][axis].from();
+            primBounds[6 * idx + 3 + axis] = bounds[idx][axis].to();
+        }
+    }
+
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    Builder builder(primBounds, maxLeafSize, threadCount);
+    const auto root = builder.build(0, static_cast<std::uint32_t>(bounds.size()), 0);
+    m_nodes.reserve(2 * bounds.size() / maxLeafSize + 1);
+    flatten(*root, m_nodes);
+
+    m_primitives = std::move(builder.order);
+    m_bounds.resize(primBounds.size());
+    for (std::size_t idx = 0; idx < m_primitives.size(); ++idx)
+        std::copy_n(&primBounds[6 * m_primitives[idx]], 6, &m_bounds[6 * idx]);
+}
+
+std::size_t GBVH::size() const
+{
+    return m_primitives.size();
+}
+
+bool GBVH::empty() const
+{
+    return m_primitives.empty();
+}
+
+const std::vector<GBVHNode> & GBVH::nodes() const
+{
+    return m_nodes;
+}
+
+const std::vector<std::uint32_t> & GBVH::primitives() const
+{
+    return m_primitives;
+}
+
+GBox3D GBVH::bounds() const
+{
+    if (empty())
+        throw std::logic_error("GBVH: bounds of empty hierarchy");
+    Aabb box;
+    for (std::size_t idx = 0; idx < size(); ++idx)
+        box.grow(&m_bounds[6 * idx], &m_bounds[6 * idx + 3]);
+    return GBox3D(GPoint3D(box.lo[0], box.lo[1], box.lo[2]), GPoint3D(box.hi[0], box.hi[1], box.hi[2]));
+}
+
+void GBVH::refit(const std::vector<GBox3D> & bounds)
+{
+    if (bounds.size() != size())
+        throw std::invalid_argument("GBVH: number of bounds differs from number of primitives");
+    for (std::size_t idx = 0; idx < size(); ++idx)
+    {
+        const GBox3D & box = bounds[m_primitives[idx]];
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            m_bounds[6 * idx + axis] = box[axis].from();
+            m_bounds[6 * idx + 3 + axis] = box[axis].to();
+        }
+    }
+    refitNodes();
+}
+
+void GBVH::refit(const GMatrix4D & transform)
+{
+    for (std::size_t idx = 0; idx < size(); ++idx)
+    {
+        double * pBox = &m_bounds[6 * idx];
+        Aabb box;
+        for (std::size_t corner = 0; corner < 8; ++corner)
+        {
+            GPoint3D pt(pBox[(corner & 1) ? 3 : 0], pBox[(corner & 2) ? 4 : 1], pBox[(corner & 4) ? 5 : 2]);
+            pt *= transform;
+            box.grow(pt.data(), pt.data());
+        }
+        std::copy_n(box.lo, 3, pBox);
+        std::copy_n(box.hi, 3, pBox + 3);
+    }
+    refitNodes();
+}
+
+// Children follow their parent in depth-first order, so reverse pass sees children first
+void GBVH::refitNodes()
+{
+    for (std::size_t idx = m_nodes.size(); idx-- > 0;)
+    {
+        GBVHNode & node = m_nodes[idx];
+        if (node.isLeaf())
+        {
+            Aabb box;
+            for (std::size_t prim = node.index; prim < node.index + node.count; ++prim)
+                box.grow(&m_bounds[6 * prim], &m_bounds[6 * prim + 3]);
+            setBounds(node, box);
+            continue;
+        }
+        const GBVHNode & left = m_nodes[idx + 1];
+        const GBVHNode & right = m_nodes[node.index];
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            node.min[axis] = std::min(left.min[axis], right.min[axis]);
+            node.max[axis] = std::max(left.max[axis], right.max[axis]);
+        }
+    }
+}
+
+std::vector<std::size_t> GBVH::intersectRay(const GPoint3D & origin, const GVector3D & direction,
+                                            double maxDistance /*= infinity*/) const
+{
+    std::vector<std::size_t> res;
+    if (empty())
+        return res;
+
+    const Ray ray(origin, direction);
+    std::uint32_t stack[STACK_SIZE];
+    std::size_t top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const std::uint32_t idx = stack[--top];
+        const GBVHNode & node = m_nodes[idx];
+        if (!ray.hits(node.min, node.max, maxDistance))
+            continue;
+        if (node.isLeaf())
+        {
+            for (std::size_t prim = node.index; prim < node.index + node.count; ++prim)
+            {
+                if (ray.hits(&m_bounds[6 * prim], &m_bounds[6 * prim + 3], maxDistance))
+                    res.push_back(m_primitives[prim]);
+            }
+            continue;
+        }
+        stack[top++] = node.index;
+        stack[top++] = idx + 1;
+    }
+    return res;
+}
+
+bool GBVH::closestHit(const GPoint3D & origin, const GVector3D & direction, double maxDistance,
+                      const RayHitFunc & hit, std::size_t & primitive, double & distance) const
+{
+    if (empty())
+        return false;
+
+    const Ray ray(origin, direction);
+    double best = maxDistance;
+    bool found = false;
+    std::uint32_t stack[STACK_SIZE];
+    std::size_t top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const std::uint32_t idx = stack[--top];
+        const GBVHNode & node = m_nodes[idx];
+        if (!ray.hits(node.min, node.max, best))
+            continue;
+        if (node.isLeaf())
+        {
+            for (std::size_t prim = node.index; prim < node.index + node.count; ++prim)
+            {
+                if (!ray.hits(&m_bounds[6 * prim], &m_bounds[6 * prim + 3], best))
+                    continue;
+                const double t = hit(m_primitives[prim]);
+                if (t >= 0.0 && (t < best || (!found && t <= best)))
+                {
+                    best = t;
+                    found = true;
+                    primitive = m_primitives[prim];
+                }
+            }
+            continue;
+        }
+        // Near child is visited first
+        const bool leftFirst = !(direction[node.axis] < 0.0);
+        stack[top++] = leftFirst ? node.index : idx + 1;
+        stack[top++] = leftFirst ? idx + 1 : node.index;
+    }
+    if (found)
+        distance = best;
+    return found;
+}
+
+std::vector<std::size_t> GBVH::intersectBox(const GBox3D & box) const
+{
+    std::vector<std::size_t> res;
+    if (empty())
+        return res;
+
+    const double lo[3] = { box.x().from(), box.y().from(), box.z().from() };
+    const double hi[3] = { box.x().to(), box.y().to(), box.z().to() };
+    std::uint32_t stack[STACK_SIZE];
+    std::size_t top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const std::uint32_t idx = stack[--top];
+        const GBVHNode & node = m_nodes[idx];
+        if (!overlaps(node.min, node.max, lo, hi))
+            continue;
+        if (node.isLeaf())
+        {
+            for (std::size_t prim = node.index; prim < node.index + node.count; ++prim)
+            {
+                if (overlaps(&m_bounds[6 * prim], &m_bounds[6 * prim + 3], lo, hi))
+                    res.push_back(m_primitives[prim]);
+            }
+            continue;
+        }
+        stack[top++] = node.index;
+        stack[top++] = idx + 1;
+    }
+    return res;
+}
+
+bool GBVH::nearest(const GPoint3D & pt, std::size_t & primitive, double & distance) const
+{
+    return findNearest(pt, [](std::size_t, double boxDistance) { return boxDistance; }, primitive, distance, INF);
+}
+
+bool GBVH::nearest(const GPoint3D & pt, const DistanceFunc & distanceTo, std::size_t & primitive, double & distance,
+                   double maxDistance /*= infinity*/) const
+{
+    return findNearest(pt, [this, &distanceTo](std::size_t prim, double)
+    {
+        return distanceTo(m_primitives[prim]);
+    }, primitive, distance, maxDistance);
+}
+
+// Depth-first search visiting the nearer child first and pruning nodes farther than the best distance.
+// primDistance(position in leaf order, distance to primitive bounds) gives distance to primitive.
+template<typename Func>
+bool GBVH::findNearest(const GPoint3D & pt, Func && primDistance, std::size_t & primitive, double & distance,
+                       double maxDistance) const
+{
+    if (empty())
+        return false;
+
+    double best = maxDistance;
+    bool found = false;
+    std::uint32_t stack[STACK_SIZE];
+    std::size_t top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const std::uint32_t idx = stack[--top];
+        const GBVHNode & node = m_nodes[idx];
+        if (pointBoxDistance(pt, node.min, node.max) > best)
+            continue;
+        if (node.isLeaf())
+        {
+            for (std::size_t prim = node.index; prim < node.index + node.count; ++prim)
+            {
+                const double boxDistance = pointBoxDistance(pt, &m_bounds[6 * prim], &m_bounds[6 * prim + 3]);
+                if (boxDistance > best)
+                    continue;
+                const double d = primDistance(prim, boxDistance);
+                if (d < best || (!found && d <= best))
+                {
+                    best = d;
+                    found = true;
+                    primitive = m_primitives[prim];
+                }
+            }
+            continue;
+        }
+        const GBVHNode & left = m_nodes[idx + 1];
+        const GBVHNode & right = m_nodes[node.index];
+        const bool leftFirst = pointBoxDistance(pt, left.min, left.max) <= pointBoxDistance(pt, right.min, right.max);
+        stack[top++] = leftFirst ? node.index : idx + 1;
+        stack[top++] = leftFirst ? idx + 1 : node.index;
+    }
+    if (found)
+        distance = best;
+    return found;
+}
+
+} //namespace sgl
@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GBox3D.h"
+
+namespace sgl
+{
+
+template<typename T>
+GBox3DT<T> GBox3DT<T>::fromPoints(const GPoint3DT<T> * pPoints, std::size_t count)
+{
+    if (count == 0)
+        throw std::invalid_argument("GBox3D: bounding box of empty set of points");
+
+    GBox3DT<T> res(pPoints[0], pPoints[0]);
+    for (std::size_t idx = 1; idx < count; ++idx)
+        res += pPoints[idx];
+    return res;
+}
+
+template<typename T>
+GBox3DT<T> GBox3DT<T>::fromPoints(const std::vector<GPoint3DT<T>> & points)
+{
+    return fromPoints(points.data(), points.size());
+}
+
+template<typename T>
+GBox3DT<T>::GBox3DT(const GIntervalT<T> & x, const GIntervalT<T> & y, const GIntervalT<T> & z)
+    : m_intervals{ x, y, z }
+{}
+
+template<typename T>
+GBox3DT<T>::GBox3DT(const GPoint3DT<T> & corner1, const GPoint3DT<T> & corner2)
+    : m_intervals{ GIntervalT<T>(corner1.x(), corner2.x()),
+                   GIntervalT<T>(corner1.y(), corner2.y()),
+                   GIntervalT<T>(corner1.z(), corner2.z()) }
+{}
+
+template<typename T>
+GPoint3DT<T> GBox3DT<T>::min() const
+{
+    return GPoint3DT<T>(m_intervals[0].from(), m_intervals[1].from(), m_intervals[2].from());
+}
+
+template<typename T>
+GPoint3DT<T> GBox3DT<T>::max() const
+{
+    return GPoint3DT<T>(m_intervals[0].to(), m_intervals[1].to(), m_intervals[2].to());
+}
+
+template<typename T>
+GPoint3DT<T> GBox3DT<T>::center() const
+{
+    return GPoint3DT<T>((m_intervals[0].from() + m_intervals[0].to()) / 2,
+                        (m_intervals[1].from() + m_intervals[1].to()) / 2,
+                        (m_intervals[2].from() + m_intervals[2].to()) / 2);
+}
+
+template<typename T>
+GVector3DT<T> GBox3DT<T>::diagonal() const
+{
+    return max() - min();
+}
+
+template<typename T>
+bool GBox3DT<T>::equals(const GBox3DT<T> & box, double tolerance /*= GTolerance::zeroTol()*/) const
+{
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        if (!m_intervals[axis].equals(box.m_intervals[axis], tolerance))
+            return false;
+    }
+    return true;
+}
+
+template<typename T>
+bool GBox3DT<T>::intersects(const GBox3DT<T> & box, double tolerance /*= GTolerance::zeroTol()*/) const
+{
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        if (!m_intervals[axis].intersects(box.m_intervals[axis], tolerance))
+            return false;
+    }
+    return true;
+}
+
+template<typename T>
+bool GBox3DT<T>::contains(const GPoint3DT<T> & pt, double tolerance /*= GTolerance::zeroTol()*/) const
+{
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        if (!m_intervals[axis].contains(pt[axis], tolerance))
+            return false;
+    }
+    return true;
+}
+
+template<typename T>
+GBox3DT<T> & GBox3DT<T>::operator+=(const GBox3DT<T> & box)
+{
+    for (std::size_t axis = 0; axis < 3; ++axis)
+        m_intervals[axis] += box.m_intervals[axis];
+    return *this;
+}
+
+template<typename T>
+GBox3DT<T> & GBox3DT<T>::operator+=(const GPoint3DT<T> & pt)
+{
+    for (std::size_t axis = 0; axis < 3; ++axis)
+        m_intervals[axis] += GIntervalT<T>(pt[axis], pt[axis]);
+    return *this;
+}
+
+template class SGL_API GBox3DT<double>;
+template class SGL_API GBox3DT<float>;
+
+} //namespace sgl
@@ -0,0 +1,537 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GBox3DArray.h"
+#include "GPointCloud.h"
+#include "GSimd.h"
+#include "GSimdDefs.h"
+
+namespace sgl
+{
+
+namespace
+{
+
+// Box arrays of one query: lo[axis][idx], hi[axis][idx]
+struct Boxes
+{
+    const double * lo[3];
+    const double * hi[3];
+};
+
+// Ray segment origin + t * direction, t in [0, maxDistance].
+// Axes with zero direction component are tested as 'origin inside of slab',
+// so no 0 * inf products appear in the slab arithmetic.
+struct Ray
+{
+    double origin[3];
+    double invDir[3];
+    bool parallel[3];
+    double maxDistance;
+};
+
+// Queried closed box or point (lo == hi)
+struct Range
+{
+    double lo[3];
+    double hi[3];
+};
+
+std::uint8_t rayHitsScalar(const Boxes & boxes, const Ray & ray, std::size_t idx)
+{
+    double tNear = 0.0;
+    double tFar = ray.maxDistance;
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        const double lo = boxes.lo[axis][idx];
+        const double hi = boxes.hi[axis][idx];
+        if (ray.parallel[axis])
+        {
+            if (ray.origin[axis] < lo || ray.origin[axis] > hi)
+                return 0;
+            continue;
+        }
+        const double t1 = (lo - ray.origin[axis]) * ray.invDir[axis];
+        const double t2 = (hi - ray.origin[axis]) * ray.invDir[axis];
+        tNear = std::max(tNear, std::min(t1, t2));
+        tFar = std::min(tFar, std::max(t1, t2));
+    }
+    return tNear <= tFar ? 1 : 0;
+}
+
+std::uint8_t overlapsScalar(const Boxes & boxes, const Range & range, std::size_t idx)
+{
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        if (boxes.lo[axis][idx] > range.hi[axis] || boxes.hi[axis][idx] < range.lo[axis])
+            return 0;
+    }
+    return 1;
+}
+
+std::size_t intersectRayScalar(const Boxes & boxes, const Ray & ray, std::size_t begin, std::size_t count,
+                               std::uint8_t * pHits)
+{
+    std::size_t res = 0;
+    for (std::size_t idx = begin; idx < count; ++idx)
+        res += pHits[idx] = rayHitsScalar(boxes, ray, idx);
+    return res;
+}
+
+std::size_t intersectBoxScalar(const Boxes & boxes, const Range & range, std::size_t begin, std::size_t count,
+                               std::uint8_t * pHits)
+{
+    std::size_t res = 0;
+    for (std::size_t idx = begin; idx < count; ++idx)
+        res += pHits[idx] = overlapsScalar(boxes, range, idx);
+    return res;
+}
+
+std::size_t containsScalar(const Range & box, const double * const * pCoords, std::size_t stride,
+                           std::size_t begin, std::size_t count, std::uint8_t * pInside)
+{
+    std::size_t res = 0;
+    for (std::size_t idx = begin; idx < count; ++idx)
+    {
+        std::uint8_t inside = 1;
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            const double value = pCoords[axis][idx * stride];
+            if (value < box.lo[axis] || value > box.hi[axis])
+                inside = 0;
+        }
+        res += pInside[idx] = inside;
+    }
+    return res;
+}
+
+std::size_t storeMask(unsigned mask, std::size_t lanes, std::uint8_t * pOut)
+{
+    std::size_t res = 0;
+    for (std::size_t lane = 0; lane < lanes; ++lane)
+        res += pOut[lane] = static_cast<std::uint8_t>((mask >> lane) & 1u);
+    return res;
+}
+
+#if SGL_SIMD_X86
+
+SGL_TARGET_AVX2
+std::size_t intersectRayAVX2(const Boxes & boxes, const Ray & ray, std::size_t begin, std::size_t count,
+                             std::uint8_t * pHits)
+{
+    __m256d origin[3];
+    __m256d invDir[3];
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        origin[axis] = _mm256_set1_pd(ray.origin[axis]);
+        invDir[axis] = _mm256_set1_pd(ray.invDir[axis]);
+    }
+    const __m256d maxDistance = _mm256_set1_pd(ray.maxDistance);
+    const __m256d allOnes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+
+    std::size_t res = 0;
+    std::size_t idx = begin;
+    for (; idx + 4 <= count; idx += 4)
+    {
+        __m256d tNear = _mm256_setzero_pd();
+        __m256d tFar = maxDistance;
+        __m256d inside = allOnes;
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            const __m256d lo = _mm256_loadu_pd(boxes.lo[axis] + idx);
+            const __m256d hi = _mm256_loadu_pd(boxes.hi[axis] + idx);
+            if (ray.parallel[axis])
+            {
+                inside = _mm256_and_pd(inside, _mm256_and_pd(_mm256_cmp_pd(lo, origin[axis], _CMP_LE_OQ),
+                                                             _mm256_cmp_pd(hi, origin[axis], _CMP_GE_OQ)));
+                continue;
+            }
+            const __m256d t1 = _mm256_mul_pd(_mm256_sub_pd(lo, origin[axis]), invDir[axis]);
+            const __m256d t2 = _mm256_mul_pd(_mm256_sub_pd(hi, origin[axis]), invDir[axis]);
+            tNear = _mm256_max_pd(tNear, _mm256_min_pd(t1, t2));
+            tFar = _mm256_min_pd(tFar, _mm256_max_pd(t1, t2));
+        }
+        const __m256d hit = _mm256_and_pd(inside, _mm256_cmp_pd(tNear, tFar, _CMP_LE_OQ));
+        res += storeMask(static_cast<unsigned>(_mm256_movemask_pd(hit)), 4, pHits + idx);
+    }
+    return res + intersectRayScalar(boxes, ray, idx, count, pHits);
+}
+
+SGL_TARGET_AVX2
+std::size_t intersectBoxAVX2(const Boxes & boxes, const Range & range, std::size_t begin, std::size_t count,
+                             std::uint8_t * pHits)
+{
+    __m256d lo[3];
+    __m256d hi[3];
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        lo[axis] = _mm256_set1_pd(range.lo[axis]);
+        hi[axis] = _mm256_set1_pd(range.hi[axis]);
+    }
+    const __m256d allOnes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+
+    std::size_t res = 0;
+    std::size_t idx = begin;
+    for (; idx + 4 <= count; idx += 4)
+    {
+        __m256d hit = allOnes;
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            const __m256d boxLo = _mm256_loadu_pd(boxes.lo[axis] + idx);
+            const __m256d boxHi = _mm256_loadu_pd(boxes.hi[axis] + idx);
+            hit = _mm256_and_pd(hit, _mm256_and_pd(_mm256_cmp_pd(boxLo, hi[axis], _CMP_LE_OQ),
+                                                   _mm256_cmp_pd(boxHi, lo[axis], _CMP_GE_OQ)));
+        }
+        res += storeMask(static_cast<unsigned>(_mm256_movemask_pd(hit)), 4, pHits + idx);
+    }
+    return res + intersectBoxScalar(boxes, range, idx, count, pHits);
+}
+
+// Coordinates are read with stride: 1 for coordinate arrays, 3 for packed points (gathered)
+SGL_TARGET_AVX2
+std::size_t containsAVX2(const Range & box, const double * const * pCoords, std::size_t stride,
+                         std::size_t begin, std::size_t count, std::uint8_t * pInside)
+{
+    __m256d lo[3];
+    __m256d hi[3];
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        lo[axis] = _mm256_set1_pd(box.lo[axis]);
+        hi[axis] = _mm256_set1_pd(box.hi[axis]);
+    }
+    const __m256d allOnes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    const int step = static_cast<int>(stride);
+    const __m128i offsets = _mm_setr_epi32(0, step, 2 * step, 3 * step);
+
+    std::size_t res = 0;
+    std::size_t idx = begin;
+    for (; idx + 4 <= count; idx += 4)
+    {
+        __m256d inside = allOnes;
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            const double * pSrc = pCoords[axis] + idx * stride;
+            const __m256d value = stride == 1
+                                      ? _mm256_loadu_pd(pSrc)
+                                      : _mm256_mask_i32gather_pd(_mm256_setzero_pd(), pSrc, offsets, allOnes, 8);
+            inside = _mm256_and_pd(inside, _mm256_and_pd(_mm256_cmp_pd(value, lo[axis], _CMP_GE_OQ),
+                                                         _mm256_cmp_pd(value, hi[axis], _CMP_LE_OQ)));
+        }
+        res += storeMask(static_cast<unsigned>(_mm256_movemask_pd(inside)), 4, pInside + idx);
+    }
+    return res + containsScalar(box, pCoords, stride, idx, count, pInside);
+}
+
+SGL_TARGET_AVX512
+std::size_t intersectRayAVX512(const Boxes & boxes, const Ray & ray, std::size_t count, std::uint8_t * pHits)
+{
+    __m512d origin[3];
+    __m512d invDir[3];
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        origin[axis] = _mm512_set1_pd(ray.origin[axis]);
+        invDir[axis] = _mm512_set1_pd(ray.invDir[axis]);
+    }
+    const __m512d maxDistance = _mm512_set1_pd(ray.maxDistance);
+
+    std::size_t res = 0;
+    std::size_t idx = 0;
+    for (; idx + 8 <= count; idx += 8)
+    {
+        __m512d tNear = _mm512_setzero_pd();
+        __m512d tFar = maxDistance;
+        __mmask8 inside = 0xFF;
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            const __m512d lo = _mm512_loadu_pd(boxes.lo[axis] + idx);
+            const __m512d hi = _mm512_loadu_pd(boxes.hi[axis] + idx);
+            if (ray.parallel[axis])
+            {
+                inside &= _mm512_cmp_pd_mask(lo, origin[axis], _CMP_LE_OQ) &
+                          _mm512_cmp_pd_mask(hi, origin[axis], _CMP_GE_OQ);
+                continue;
+            }
+            const __m512d t1 = _mm512_mul_pd(_mm512_sub_pd(lo, origin[axis]), invDir[axis]);
+            const __m512d t2 = _mm512_mul_pd(_mm512_sub_pd(hi, origin[axis]), invDir[axis]);
+            tNear = _mm512_max_pd(tNear, _mm512_min_pd(t1, t2));
+            tFar = _mm512_min_pd(tFar, _mm512_max_pd(t1, t2));
+        }
+        const __mmask8 hit = inside & _mm512_cmp_pd_mask(tNear, tFar, _CMP_LE_OQ);
+        res += storeMask(hit, 8, pHits + idx);
+    }
+    return res + intersectRayAVX2(boxes, ray, idx, count, pHits);
+}
+
+SGL_TARGET_AVX512
+std::size_t intersectBoxAVX512(const Boxes & boxes, const Range & range, std::size_t count, std::uint8_t * pHits)
+{
+    __m512d lo[3];
+    __m512d hi[3];
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        lo[axis] = _mm512_set1_pd(range.lo[axis]);
+        hi[axis] = _mm512_set1_pd(range.hi[axis]);
+    }
+
+    std::size_t res = 0;
+    std::size_t idx = 0;
+    for (; idx + 8 <= count; idx += 8)
+    {
+        __mmask8 hit = 0xFF;
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            const __m512d boxLo = _mm512_loadu_pd(boxes.lo[axis] + idx);
+            const __m512d boxHi = _mm512_loadu_pd(boxes.hi[axis] + idx);
+            hit &= _mm512_cmp_pd_mask(boxLo, hi[axis], _CMP_LE_OQ) & _mm512_cmp_pd_mask(boxHi, lo[axis], _CMP_GE_OQ);
+        }
+        res += storeMask(hit, 8, pHits + idx);
+    }
+    return res + intersectBoxAVX2(boxes, range, idx, count, pHits);
+}
+
+SGL_TARGET_AVX512
+std::size_t containsAVX512(const Range & box, const double * const * pCoords, std::size_t stride,
+                           std::size_t count, std::uint8_t * pInside)
+{
+    __m512d lo[3];
+    __m512d hi[3];
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        lo[axis] = _mm512_set1_pd(box.lo[axis]);
+        hi[axis] = _mm512_set1_pd(box.hi[axis]);
+    }
+    const int step = static_cast<int>(stride);
+    const __m256i offsets = _mm256_setr_epi32(0, step, 2 * step, 3 * step, 4 * step, 5 * step, 6 * step, 7 * step);
+
+    std::size_t res = 0;
+    std::size_t idx = 0;
+    for (; idx + 8 <= count; idx += 8)
+    {
+        __mmask8 inside = 0xFF;
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            const double * pSrc = pCoords[axis] + idx * stride;
+            const __m512d value = stride == 1
+                                      ? _mm512_loadu_pd(pSrc)
+                                      : _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, offsets, pSrc, 8);
+            inside &= _mm512_cmp_pd_mask(value, lo[axis], _CMP_GE_OQ) & _mm512_cmp_pd_mask(value, hi[axis], _CMP_LE_OQ);
+        }
+        res += storeMask(inside, 8, pInside + idx);
+    }
+    return res + containsAVX2(box, pCoords, stride, idx, count, pInside);
+}
+
+#endif //SGL_SIMD_X86
+
+std::size_t intersectRay(const Boxes & boxes, const Ray & ray, std::size_t count, std::uint8_t * pHits)
+{
+    switch (simdLevel())
+    {
+#if SGL_SIMD_X86
+        case GSimdLevel::AVX512: return intersectRayAVX512(boxes, ray, count, pHits);
+        case GSimdLevel::AVX2: return intersectRayAVX2(boxes, ray, 0, count, pHits);
+#endif
+        default: return intersectRayScalar(boxes, ray, 0, count, pHits);
+    }
+}
+
+std::size_t intersectBox(const Boxes & boxes, const Range & range, std::size_t count, std::uint8_t * pHits)
+{
+    switch (simdLevel())
+    {
+#if SGL_SIMD_X86
+        case GSimdLevel::AVX512: return intersectBoxAVX512(boxes, range, count, pHits);
+        case GSimdLevel::AVX2: return intersectBoxAVX2(boxes, range, 0, count, pHits);
+#endif
+        default: return intersectBoxScalar(boxes, range, 0, count, pHits);
+    }
+}
+
+std::size_t contains(const Range & box, const double * const * pCoords, std::size_t stride, std::size_t count,
+                     std::uint8_t * pInside)
+{
+    switch (simdLevel())
+    {
+#if SGL_SIMD_X86
+        case GSimdLevel::AVX512: return containsAVX512(box, pCoords, stride, count, pInside);
+        case GSimdLevel::AVX2: return containsAVX2(box, pCoords, stride, 0, count, pInside);
+#endif
+        default: return containsScalar(box, pCoords, stride, 0, count, pInside);
+    }
+}
+
+Range toRange(const GBox3D & box)
+{
+    return { { box.x().from(), box.y().from(), box.z().from() }, { box.x().to(), box.y().to(), box.z().to() } };
+}
+
+std::vector<std::size_t> hitIndices(const std::vector<std::uint8_t> & hits, std::size_t count)
+{
+    std::vector<std::size_t> res;
+    res.reserve(count);
+    for (std::size_t idx = 0; idx < hits.size(); ++idx)
+    {
+        if (hits[idx])
+            res.push_back(idx);
+    }
+    return res;
+}
+
+} //namespace
+
+GBox3DArray::GBox3DArray() = default;
+
+GBox3DArray::GBox3DArray(const std::vector<GBox3D> & boxes)
+{
+    reserve(boxes.size());
+    for (const auto & box : boxes)
+        push_back(box);
+}
+
+GBox3DArray::GBox3DArray(const GBox3DArray &) = default;
+
+GBox3DArray::GBox3DArray(GBox3DArray &&) noexcept = default;
+
+GBox3DArray::~GBox3DArray() = default;
+
+GBox3DArray & GBox3DArray::operator=(const GBox3DArray &) = default;
+
+GBox3DArray & GBox3DArray::operator=(GBox3DArray &&) noexcept = default;
+
+std::size_t GBox3DArray::size() const
+{
+    return m_min[0].size();
+}
+
+bool GBox3DArray::empty() const
+{
+    return m_min[0].empty();
+}
+
+void GBox3DArray::reserve(std::size_t capacity)
+{
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        m_min[axis].reserve(capacity);
+        m_max[axis].reserve(capacity);
+    }
+}
+
+void GBox3DArray::clear()
+{
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        m_min[axis].clear();
+        m_max[axis].clear();
+    }
+}
+
+void GBox3DArray::push_back(const GBox3D & box)
+{
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        m_min[axis].push_back(box[axis].from());
+        m_max[axis].push_back(box[axis].to());
+    }
+}
+
+GBox3D GBox3DArray::box(std::size_t index) const
+{
+    return GBox3D(GInterval(m_min[0][index], m_max[0][index]),
+                  GInterval(m_min[1][index], m_max[1][index]),
+                  GInterval(m_min[2][index], m_max[2][index]));
+}
+
+void GBox3DArray::setBox(std::size_t index, const GBox3D & box)
+{
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        m_min[axis][index] = box[axis].from();
+        m_max[axis][index] = box[axis].to();
+    }
+}
+
+const double * GBox3DArray::minData(std::size_t axis) const
+{
+    return m_min[axis].data();
+}
+
+const double * GBox3DArray::maxData(std::size_t axis) const
+{
+    return m_max[axis].data();
+}
+
+std::size_t GBox3DArray::intersectRay(const GPoint3D & origin, const GVector3D & direction, double maxDistance,
+                                      std::uint8_t * pHits) const
+{
+    Ray ray;
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        ray.origin[axis] = origin[axis];
+        ray.parallel[axis] = direction[axis] == 0.0;
+        ray.invDir[axis] = ray.parallel[axis] ? 0.0 : 1.0 / direction[axis];
+    }
+    ray.maxDistance = maxDistance;
+    const Boxes boxes{ { minData(0), minData(1), minData(2) }, { maxData(0), maxData(1), maxData(2) } };
+    return sgl::intersectRay(boxes, ray, size(), pHits);
+}
+
+std::vector<std::size_t> GBox3DArray::intersectRay(const GPoint3D & origin, const GVector3D & direction,
+                                                   double maxDistance /*= infinity*/) const
+{
+    std::vector<std::uint8_t> hits(size());
+    const std::size_t count = intersectRay(origin, direction, maxDistance, hits.data());
+    return hitIndices(hits, count);
+}
+
+std::size_t GBox3DArray::intersectBox(const GBox3D & box, std::uint8_t * pHits) const
+{
+    const Boxes boxes{ { minData(0), minData(1), minData(2) }, { maxData(0), maxData(1), maxData(2) } };
+    return sgl::intersectBox(boxes, toRange(box), size(), pHits);
+}
+
+std::vector<std::size_t> GBox3DArray::intersectBox(const GBox3D & box) const
+{
+    std::vector<std::uint8_t> hits(size());
+    const std::size_t count = intersectBox(box, hits.data());
+    return hitIndices(hits, count);
+}
+
+std::size_t containsPoints(const GBox3D & box, const double * pX, const double * pY, const double * pZ,
+                           std::size_t count, std::uint8_t * pInside)
+{
+    const double * coords[3] = { pX, pY, pZ };
+    return contains(toRange(box), coords, 1, count, pInside);
+}
+
+std::size_t containsPoints(const GBox3D & box, const GPoint3D * pPoints, std::size_t count, std::uint8_t * pInside)
+{
+    if (count == 0)
+        return 0;
+    const double * pData = pPoints->data();
+    const double * coords[3] = { pData, pData + 1, pData + 2 };
+    return contains(toRange(box), coords, 3, count, pInside);
+}
+
+std::size_t containsPoints(const GBox3D & box, const GPointCloud & cloud, std::uint8_t * pInside)
+{
+    return containsPoints(box, cloud.xData(), cloud.yData(), cloud.zData(), cloud.size(), pInside);
+}
+
+} //namespace sgl
@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GConvert.h"
+#include "GPoint3D.h"
+#include "GSimd.h"
+#include "GSimdDefs.h"
+#include "GVector3D.h"
+
+namespace sgl
+{
+
+namespace
+{
+
+template<typename Src, typename Dst>
+void convertScalar(const Src * pSrc, Dst * pDst, std::size_t count)
+{
+    for (std::size_t idx = 0; idx < count; ++idx)
+        pDst[idx] = static_cast<Dst>(pSrc[idx]);
+}
+
+#if SGL_SIMD_X86
+
+SGL_TARGET_SSE2
+void downSSE2(const double * pSrc, float * pDst, std::size_t count)
+{
+    std::size_t idx = 0;
+    for (; idx + 4 <= count; idx += 4)
+    {
+        const __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(pSrc + idx));
+        const __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(pSrc + idx + 2));
+        _mm_storeu_ps(pDst + idx, _mm_movelh_ps(lo, hi));
+    }
+    convertScalar(pSrc + idx, pDst + idx, count - idx);
+}
+
+SGL_TARGET_SSE2
+void upSSE2(const float * pSrc, double * pDst, std::size_t count)
+{
+    std::size_t idx = 0;
+    for (; idx + 4 <= count; idx += 4)
+    {
+        const __m128 v = _mm_loadu_ps(pSrc + idx);
+        _mm_storeu_pd(pDst + idx, _mm_cvtps_pd(v));
+        _mm_storeu_pd(pDst + idx + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+    convertScalar(pSrc + idx, pDst + idx, count - idx);
+}
+
+SGL_TARGET_AVX2
+void downAVX2(const double * pSrc, float * pDst, std::size_t count)
+{
+    std::size_t idx = 0;
+    for (; idx + 8 <= count; idx += 8)
+    {
+        const __m128 lo = _mm256_cvtpd_ps(_mm256_loadu_pd(pSrc + idx));
+        const __m128 hi = _mm256_cvtpd_ps(_mm256_loadu_pd(pSrc + idx + 4));
+        _mm256_storeu_ps(pDst + idx, _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1));
+    }
+    downSSE2(pSrc + idx, pDst + idx, count - idx);
+}
+
+SGL_TARGET_AVX2
+void upAVX2(const float * pSrc, double * pDst, std::size_t count)
+{
+    std::size_t idx = 0;
+    for (; idx + 8 <= count; idx += 8)
+    {
+        _mm256_storeu_pd(pDst + idx, _mm256_cvtps_pd(_mm_loadu_ps(pSrc + idx)));
+        _mm256_storeu_pd(pDst + idx + 4, _mm256_cvtps_pd(_mm_loadu_ps(pSrc + idx + 4)));
+    }
+    upSSE2(pSrc + idx, pDst + idx, count - idx);
+}
+
+SGL_TARGET_AVX512
+void downAVX512(const double * pSrc, float * pDst, std::size_t count)
+{
+    std::size_t idx = 0;
+    for (; idx + 16 <= count; idx += 16)
+    {
+        _mm256_storeu_ps(pDst + idx, _mm512_cvtpd_ps(_mm512_loadu_pd(pSrc + idx)));
+        _mm256_storeu_ps(pDst + idx + 8, _mm512_cvtpd_ps(_mm512_loadu_pd(pSrc + idx + 8)));
+    }
+    downAVX2(pSrc + idx, pDst + idx, count - idx);
+}
+
+SGL_TARGET_AVX512
+void upAVX512(const float * pSrc, double * pDst, std::size_t count)
+{
+    std::size_t idx = 0;
+    for (; idx + 16 <= count; idx += 16)
+    {
+        _mm512_storeu_pd(pDst + idx, _mm512_cvtps_pd(_mm256_loadu_ps(pSrc + idx)));
+        _mm512_storeu_pd(pDst + idx + 8, _mm512_cvtps_pd(_mm256_loadu_ps(pSrc + idx + 8)));
+    }
+    upAVX2(pSrc + idx, pDst + idx, count - idx);
+}
+
+#endif //SGL_SIMD_X86
+
+template<typename Dst, typename Src>
+std::vector<Dst> convertArray(const std::vector<Src> & src)
+{
+    std::vector<Dst> res(src.size());
+    if (!src.empty())
+        convert(src.data(), res.data(), src.size());
+    return res;
+}
+
+} //namespace
+
+void convert(const double * pSrc, float * pDst, std::size_t count)
+{
+    switch (simdLevel())
+    {
+#if SGL_SIMD_X86
+        case GSimdLevel::AVX512: return downAVX512(pSrc, pDst, count);
+        case GSimdLevel::AVX2: return downAVX2(pSrc, pDst, count);
+        case GSimdLevel::SSE2: return downSSE2(pSrc, pDst, count);
+#endif
+        default: return convertScalar(pSrc, pDst, count);
+    }
+}
+
+void convert(const float * pSrc, double * pDst, std::size_t count)
+{
+    switch (simdLevel())
+    {
+#if SGL_SIMD_X86
+        case GSimdLevel::AVX512: return upAVX512(pSrc, pDst, count);
+        case GSimdLevel::AVX2: return upAVX2(pSrc, pDst, count);
+        case GSimdLevel::SSE2: return upSSE2(pSrc, pDst, count);
+#endif
+        default: return convertScalar(pSrc, pDst, count);
+    }
+}
+
+void convert(const GPoint3D * pSrc, GPoint3Df * pDst, std::size_t count)
+{
+    if (count != 0)
+        convert(pSrc->data(), pDst->data(), 3 * count);
+}
+
+void convert(const GPoint3Df * pSrc, GPoint3D * pDst, std::size_t count)
+{
+    if (count != 0)
+        convert(pSrc->data(), pDst->data(), 3 * count);
+}
+
+void convert(const GVector3D * pSrc, GVector3Df * pDst, std::size_t count)
+{
+    if (count != 0)
+        convert(pSrc->data(), pDst->data(), 3 * count);
+}
+
+void convert(const GVector3Df * pSrc, GVector3D * pDst, std::size_t count)
+{
+    if (count != 0)
+        convert(pSrc->data(), pDst->data(), 3 * count);
+}
+
+GPoint3DfArray toFloat(const GPoint3DArray & points)
+{
+    return convertArray<GPoint3Df>(points);
+}
+
+GPoint3DArray toDouble(const GPoint3DfArray & points)
+{
+    return convertArray<GPoint3D>(points);
+}
+
+GVector3DfArray toFloat(const GVector3DArray & vectors)
+{
+    return convertArray<GVector3Df>(vectors);
+}
+
+GVector3DArray toDouble(const GVector3DfArray & vectors)
+{
+    return convertArray<GVector3D>(vectors);
+}
+
+} //namespace sgl
@@ -0,0 +1,587 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GConvexHull.h"
+#include "GParallel.h"
+#include "GPointCloud.h"
+#include "GPredicates.h"
+
+#include <cstdint>
+#include <mutex>
+
+namespace sgl
+{
+
+namespace
+{
+
+constexpr std::size_t NONE = GConvexHull::npos;
+constexpr std::uint32_t NO_OWNER = std::numeric_limits<std::uint32_t>::max();
+
+// Minimal number of points per thread
+constexpr std::size_t PARALLEL_CHUNK = 16384;
+// Relative error bound of height computed in floating point (with a wide margin)
+constexpr double HEIGHT_ERROR = 1.0e-14;
+
+struct Face
+{
+    std::size_t vertex[3];
+    // Neighbour across edge from vertex k to vertex (k + 1) % 3
+    std::size_t neighbour[3];
+    // Vertex coordinates for exact orientation tests
+    double coords[9];
+    // Normal of length of doubled area and magnitudes of its terms for error bound of height
+    double normal[3];
+    double permanent[3];
+    // Range of assigned points in the pool
+    std::size_t conflictBegin;
+    std::size_t conflictCount;
+    std::size_t farthest;
+    // Step at which visibility was tested
+    std::size_t stamp;
+    bool visible;
+    bool alive;
+};
+
+// Point assigned to face, coordinates are kept with index so that reassignment reads memory sequentially
+struct Conflict
+{
+    double coord[3];
+    std::size_t index;
+};
+
+// Candidate point of reduction, ties are resolved to the smaller index so that result doesn't depend on threads
+struct Candidate
+{
+    double value = -std::numeric_limits<double>::infinity();
+    std::size_t index = NONE;
+
+    void update(double newValue, std::size_t newIndex)
+    {
+        if (newValue > value || (newValue == value && newIndex < index))
+        {
+            value = newValue;
+            index = newIndex;
+        }
+    }
+};
+
+class Builder
+{
+public:
+    Builder(const double * const * pCoords, std::size_t stride, std::size_t count, unsigned threadCount)
+        : m_pCoords(pCoords), m_stride{ stride }, m_count{ count }, m_threadCount{ resolveThreadCount(threadCount) }
+    {
+    }
+
+    bool build(std::vector<std::size_t> & faces, std::vector<std::size_t> & neighbours)
+    {
+        std::size_t simplex[4];
+        if (!findSimplex(simplex))
+            return false;
+
+        // Faces are counterclockwise from outside: the fourth point must lie below the first face
+        double pts[4][3];
+        for (std::size_t idx = 0; idx < 4; ++idx)
+            load(simplex[idx], pts[idx]);
+        if (orient3d(pts[0], pts[1], pts[2], pts[3]) < 0.0)
+            std::swap(simplex[1], simplex[2]);
+        const std::size_t faceVertices[4][3] = { { 0, 1, 2 }, { 0, 3, 1 }, { 1, 3, 2 }, { 2, 3, 0 } };
+        for (const auto & vertices : faceVertices)
+            m_faces.push_back(makeFace(simplex[vertices[0]], simplex[vertices[1]], simplex[vertices[2]]));
+        for (std::size_t face = 0; face < 4; ++face)
+        {
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                const std::size_t from = m_faces[face].vertex[k];
+                const std::size_t to = m_faces[face].vertex[(k + 1) % 3];
+                for (std::size_t other = 0; other < 4; ++other)
+                {
+                    for (std::size_t j = 0; j < 3; ++j)
+                    {
+                        if (m_faces[other].vertex[j] == to && m_faces[other].vertex[(j + 1) % 3] == from)
+                            m_faces[face].neighbour[k] = other;
+                    }
+                }
+            }
+        }
+
+        m_slot.resize(m_count);
+        assign(nullptr, m_count, 0, 4);
+        while (!m_pending.empty())
+        {
+            const std::size_t face = m_pending.back();
+            m_pending.pop_back();
+            if (m_faces[face].alive && m_faces[face].conflictCount != 0)
+                addPoint(face);
+        }
+
+        std::vector<std::size_t> faceIndex(m_faces.size(), NONE);
+        for (std::size_t face = 0; face < m_faces.size(); ++face)
+        {
+            if (m_faces[face].alive)
+            {
+                faceIndex[face] = faces.size() / 3;
+                faces.insert(faces.end(), m_faces[face].vertex, m_faces[face].vertex + 3);
+            }
+        }
+        for (const auto & face : m_faces)
+        {
+            if (face.alive)
+            {
+                for (std::size_t k = 0; k < 3; ++k)
+                    neighbours.push_back(faceIndex[face.neighbour[k]]);
+            }
+        }
+        return true;
+    }
+
+private:
+    void load(std::size_t idx, double * pCoord) const
+    {
+        for (std::size_t axis = 0; axis < 3; ++axis)
+            pCoord[axis] = m_pCoords[axis][idx * m_stride];
+    }
+
+    Face makeFace(std::size_t v0, std::size_t v1, std::size_t v2) const
+    {
+        Face face;
+        face.vertex[0] = v0;
+        face.vertex[1] = v1;
+        face.vertex[2] = v2;
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+            face.neighbour[k] = NONE;
+            load(face.vertex[k], face.coords + 3 * k);
+        }
+        const double * pA = face.coords;
+        const double u[3] = { face.coords[3] - pA[0], face.coords[4] - pA[1], face.coords[5] - pA[2] };
+        const double v[3] = { face.coords[6] - pA[0], face.coords[7] - pA[1], face.coords[8] - pA[2] };
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            const std::size_t axis1 = (axis + 1) % 3;
+            const std::size_t axis2 = (axis + 2) % 3;
+            face.normal[axis] = u[axis1] * v[axis2] - u[axis2] * v[axis1];
+            face.permanent[axis] = (std::abs(u[axis1] * v[axis2]) + std::abs(u[axis2] * v[axis1])) * HEIGHT_ERROR;
+        }
+        face.conflictBegin = 0;
+        face.conflictCount = 0;
+        face.farthest = NONE;
+        face.stamp = 0;
+        face.visible = false;
+        face.alive = true;
+        return face;
+    }
+
+    // Distance from face plane multiplied by doubled face area, positive if face sees point.
+    // Sign is exact: uncertain values are recomputed with exact predicate
+    static double height(const Face & face, const double * pt)
+    {
+        const double w[3] = { pt[0] - face.coords[0], pt[1] - face.coords[1], pt[2] - face.coords[2] };
+        const double value = face.normal[0] * w[0] + face.normal[1] * w[1] + face.normal[2] * w[2];
+        const double bound = face.permanent[0] * std::abs(w[0]) + face.permanent[1] * std::abs(w[1]) +
+                             face.permanent[2] * std::abs(w[2]);
+        if (value > bound || value < -bound)
+            return value;
+        return -orient3d(face.coords, face.coords + 3, face.coords + 6, pt);
+    }
+
+    // Calls func(idx, pt) for every point in parallel and merges per-thread candidates
+    template<typename Func>
+    Candidate reduce(Func && func) const
+    {
+        Candidate res;
+        std::mutex mutex;
+        parallelFor(m_count, m_threadCount, PARALLEL_CHUNK, [&](std::size_t begin, std::size_t end)
+        {
+            Candidate local;
+            double pt[3];
+            for (std::size_t idx = begin; idx < end; ++idx)
+            {
+                load(idx, pt);
+                local.update(func(pt), idx);
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            res.update(local.value, local.index);
+        });
+        return res;
+    }
+
+    // Finds four points which are not coplanar
+    bool findSimplex(std::size_t * pSimplex) const
+    {
+        if (m_count < 4)
+            return false;
+
+        // The most distant pair of extreme points along coordinate axes
+        std::size_t extremes[6];
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            extremes[2 * axis] = reduce([axis](const double * pt) { return -pt[axis]; }).index;
+            extremes[2 * axis + 1] = reduce([axis](const double * pt) { return pt[axis]; }).index;
+        }
+        double best = 0.0;
+        for (std::size_t idx1 = 0; idx1 < 6; ++idx1)
+        {
+            for (std::size_t idx2 = idx1 + 1; idx2 < 6; ++idx2)
+            {
+                double pt1[3];
+                double pt2[3];
+                load(extremes[idx1], pt1);
+                load(extremes[idx2], pt2);
+                double dist = 0.0;
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                    dist += (pt2[axis] - pt1[axis]) * (pt2[axis] - pt1[axis]);
+                if (dist > best)
+                {
+                    best = dist;
+                    pSimplex[0] = extremes[idx1];
+                    pSimplex[1] = extremes[idx2];
+                }
+            }
+        }
+        if (best == 0.0)
+            return false;
+
+        // The most distant point from the line
+        double pt0[3];
+        double pt1[3];
+        load(pSimplex[0], pt0);
+        load(pSimplex[1], pt1);
+        const double dir[3] = { pt1[0] - pt0[0], pt1[1] - pt0[1], pt1[2] - pt0[2] };
+        const Candidate third = reduce([&](const double * pt)
+        {
+            const double v[3] = { pt[0] - pt0[0], pt[1] - pt0[1], pt[2] - pt0[2] };
+            const double cross[3] = { v[1] * dir[2] - v[2] * dir[1], v[2] * dir[0] - v[0] * dir[2],
+                                      v[0] * dir[1] - v[1] * dir[0] };
+            return cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2];
+        });
+        if (third.value <= 0.0)
+            return false;
+        pSimplex[2] = third.index;
+
+        // The most distant point from the plane
+        double pt2[3];
+        load(pSimplex[2], pt2);
+        const Candidate fourth = reduce([&](const double * pt) { return std::abs(orient3d(pt0, pt1, pt2, pt)); });
+        if (fourth.value <= 0.0)
+            return false;
+        pSimplex[3] = fourth.index;
+        return true;
+    }
+
+    // Assigns points to the first face of [firstFace, firstFace + faceCount) which sees them.
+    // pPoints == nullptr means all points
+    void assign(const Conflict * pPoints, std::size_t count, std::size_t firstFace, std::size_t faceCount)
+    {
+        const auto pointAt = [this, pPoints](std::size_t idx)
+        {
+            if (pPoints)
+                return pPoints[idx];
+            Conflict point;
+            load(idx, point.coord);
+            point.index = idx;
+            return point;
+        };
+
+        // Blocks of points are classified in parallel, then every block writes its points to its own part
+        // of face ranges, so the pool doesn't depend on number of threads
+        const std::size_t blockCount = std::max<std::size_t>(1, std::min<std::size_t>(m_threadCount,
+                                                                                      count / PARALLEL_CHUNK));
+        const std::size_t blockSize = (count + blockCount - 1) / blockCount;
+        m_owner.resize(count);
+        m_blockOffset.assign(blockCount * faceCount, 0);
+        m_blockFarthest.assign(blockCount * faceCount, NONE);
+        m_blockDepth.assign(blockCount * faceCount, 0.0);
+        parallelFor(blockCount, m_threadCount, 1, [&](std::size_t firstBlock, std::size_t lastBlock)
+        {
+            for (std::size_t block = firstBlock; block < lastBlock; ++block)
+            {
+                std::size_t * pCount = m_blockOffset.data() + block * faceCount;
+                std::size_t * pFarthest = m_blockFarthest.data() + block * faceCount;
+                double * pDepth = m_blockDepth.data() + block * faceCount;
+                for (std::size_t idx = block * blockSize; idx < std::min(count, (block + 1) * blockSize); ++idx)
+                {
+                    const Conflict point = pointAt(idx);
+                    m_owner[idx] = NO_OWNER;
+                    for (std::size_t face = 0; face < faceCount; ++face)
+                    {
+                        // Farthest point of face has the largest height
+                        const double depth = height(m_faces[firstFace + face], point.coord);
+                        if (depth > 0.0)
+                        {
+                            m_owner[idx] = static_cast<std::uint32_t>(face);
+                            ++pCount[face];
+                            if (depth > pDepth[face])
+                            {
+                                pDepth[face] = depth;
+                                pFarthest[face] = point.index;
+                            }
+                            break;
+                        }
+                    }
+                }
+            }
+        });
+
+        std::size_t end = m_pool.size();
+        for (std::size_t face = 0; face < faceCount; ++face)
+        {
+            Face & f = m_faces[firstFace + face];
+            f.conflictBegin = end;
+            double depth = 0.0;
+            for (std::size_t block = 0; block < blockCount; ++block)
+            {
+                const std::size_t pos = block * faceCount + face;
+                if (m_blockDepth[pos] > depth)
+                {
+                    depth = m_blockDepth[pos];
+                    f.farthest = m_blockFarthest[pos];
+                }
+                const std::size_t blockPoints = m_blockOffset[pos];
+                m_blockOffset[pos] = end;
+                end += blockPoints;
+            }
+            f.conflictCount = end - f.conflictBegin;
+            m_live += f.conflictCount;
+            if (f.conflictCount != 0)
+                m_pending.push_back(firstFace + face);
+        }
+        m_pool.resize(end);
+        parallelFor(blockCount, m_threadCount, 1, [&](std::size_t firstBlock, std::size_t lastBlock)
+        {
+            for (std::size_t block = firstBlock; block < lastBlock; ++block)
+            {
+                std::size_t * pOffset = m_blockOffset.data() + block * faceCount;
+                for (std::size_t idx = block * blockSize; idx < std::min(count, (block + 1) * blockSize); ++idx)
+                {
+                    if (m_owner[idx] != NO_OWNER)
+                        m_pool[pOffset[m_owner[idx]]++] = pointAt(idx);
+                }
+            }
+        });
+    }
+
+    // Adds the farthest point of face to the hull
+    void addPoint(std::size_t start)
+    {
+        const std::size_t eye = m_faces[start].farthest;
+        double eyeCoords[3];
+        load(eye, eyeCoords);
+
+        // Visible faces form connected region, its boundary is the horizon
+        ++m_stamp;
+        m_visible.clear();
+        m_horizon.clear();
+        m_visible.push_back(start);
+        m_faces[start].stamp = m_stamp;
+        m_faces[start].visible = true;
+        for (std::size_t idx = 0; idx < m_visible.size(); ++idx)
+        {
+            const std::size_t face = m_visible[idx];
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                Face & other = m_faces[m_faces[face].neighbour[k]];
+                if (other.stamp != m_stamp)
+                {
+                    other.stamp = m_stamp;
+                    other.visible = height(other, eyeCoords) > 0.0;
+                    if (other.visible)
+                        m_visible.push_back(m_faces[face].neighbour[k]);
+                }
+                if (!other.visible)
+                    m_horizon.emplace_back(face, k);
+            }
+        }
+
+        // Cone of new faces over the horizon, horizon is a simple cycle so every vertex starts one edge
+        const std::size_t firstFace = m_faces.size();
+        for (const auto & edge : m_horizon)
+        {
+            const std::size_t from = m_faces[edge.first].vertex[edge.second];
+            const std::size_t to = m_faces[edge.first].vertex[(edge.second + 1) % 3];
+            const std::size_t outer = m_faces[edge.first].neighbour[edge.second];
+            Face face = makeFace(from, to, eye);
+            face.neighbour[0] = outer;
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                if (m_faces[outer].vertex[k] == to && m_faces[outer].neighbour[k] == edge.first)
+                    m_faces[outer].neighbour[k] = m_faces.size();
+            }
+            m_slot[from] = m_faces.size();
+            m_faces.push_back(face);
+        }
+        for (std::size_t face = firstFace; face < m_faces.size(); ++face)
+        {
+            const std::size_t next = m_slot[m_faces[face].vertex[1]];
+            m_faces[face].neighbour[1] = next;
+            m_faces[next].neighbour[2] = face;
+        }
+
+        // Points of removed faces are reassigned to new ones
+        m_gather.clear();
+        for (const std::size_t face : m_visible)
+        {
+            Face & f = m_faces[face];
+            for (std::size_t idx = f.conflictBegin; idx < f.conflictBegin + f.conflictCount; ++idx)
+            {
+                if (m_pool[idx].index != eye)
+                    m_gather.push_back(m_pool[idx]);
+            }
+            m_live -= f.conflictCount;
+            f.conflictCount = 0;
+            f.alive = false;
+        }
+        if (m_pool.size() > 2 * m_live + PARALLEL_CHUNK)
+            compact();
+        assign(m_gather.data(), m_gather.size(), firstFace, m_faces.size() - firstFace);
+    }
+
+    // Removes ranges of deleted faces from the pool, all faces with assigned points are pending
+    void compact()
+    {
+        std::vector<Conflict> pool;
+        pool.reserve(m_live);
+        for (const std::size_t pending : m_pending)
+        {
+            Face & face = m_faces[pending];
+            if (!face.alive || face.conflictCount == 0)
+                continue;
+            const std::size_t begin = pool.size();
+            pool.insert(pool.end(), m_pool.begin() + static_cast<std::ptrdiff_t>(face.conflictBegin),
+                        m_pool.begin() + static_cast<std::ptrdiff_t>(face.conflictBegin + face.conflictCount));
+            face.conflictBegin = begin;
+        }
+        m_pool.swap(pool);
+    }
+
+private:
+    const double * const * m_pCoords;
+    std::size_t m_stride;
+    std::size_t m_count;
+    unsigned m_threadCount;
+
+    std::vector<Face> m_faces;
+    // Faces with points to process
+    std::vector<std::size_t> m_pending;
+    // Assigned points of all faces
+    std::vector<Conflict> m_pool;
+    // Number of assigned points of alive faces
+    std::size_t m_live = 0;
+    std::size_t m_stamp = 0;
+
+    // Buffers reused between steps
+    std::vector<std::uint32_t> m_owner;
+    std::vector<std::size_t> m_blockOffset;
+    std::vector<std::size_t> m_blockFarthest;
+    std::vector<double> m_blockDepth;
+    std::vector<std::size_t> m_visible;
+    std::vector<std::pair<std::size_t, std::size_t>> m_horizon;
+    std::vector<Conflict> m_gather;
+    // New face starting at vertex
+    std::vector<std::size_t> m_slot;
+};
+
+} //namespace
+
+GConvexHull::GConvexHull() = default;
+
+GConvexHull::GConvexHull(const GPoint3D * pPoints, std::size_t count, unsigned threadCount /*= 0*/)
+{
+    if (count == 0)
+        return;
+    const double * pData = pPoints->data();
+    const double * coords[3] = { pData, pData + 1, pData + 2 };
+    build(coords, 3, count, threadCount);
+}
+
+GConvexHull::GConvexHull(const GPoint3DArray & points, unsigned threadCount /*= 0*/)
+    : GConvexHull(points.data(), points.size(), threadCount)
+{
+}
+
+GConvexHull::GConvexHull(const GPointCloud & cloud, unsigned threadCount /*= 0*/)
+{
+    const double * coords[3] = { cloud.xData(), cloud.yData(), cloud.zData() };
+    build(coords, 1, cloud.size(), threadCount);
+}
+
+void GConvexHull::build(const double * const * pCoords, std::size_t stride, std::size_t count, unsigned threadCount)
+{
+    Builder builder(pCoords, stride, count, threadCount);
+    if (!builder.build(m_faces, m_neighbours))
+        return;
+
+    std::vector<bool> used(count, false);
+    for (const std::size_t vertex : m_faces)
+        used[vertex] = true;
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        if (used[idx])
+            m_vertices.push_back(idx);
+    }
+}
+
+bool GConvexHull::empty() const
+{
+    return m_faces.empty();
+}
+
+std::size_t GConvexHull::faceCount() const
+{
+    return m_faces.size() / 3;
+}
+
+const std::vector<std::size_t> & GConvexHull::faces() const
+{
+    return m_faces;
+}
+
+const std::vector<std::size_t> & GConvexHull::neighbours() const
+{
+    return m_neighbours;
+}
+
+const std::vector<std::size_t> & GConvexHull::vertices() const
+{
+    return m_vertices;
+}
+
+std::vector<GHullHalfEdge> GConvexHull::halfEdges() const
+{
+    std::vector<GHullHalfEdge> res(m_faces.size());
+    for (std::size_t edge = 0; edge < m_faces.size(); ++edge)
+    {
+        const std::size_t face = edge / 3;
+        const std::size_t next = 3 * face + (edge + 1) % 3;
+        const std::size_t other = m_neighbours[edge];
+        res[edge].origin = m_faces[edge];
+        res[edge].next = next;
+        res[edge].face = face;
+        res[edge].twin = npos;
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+            if (m_faces[3 * other + k] == m_faces[next])
+                res[edge].twin = 3 * other + k;
+        }
+    }
+    return res;
+}
+
+} //namespace sgl
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GDualQuaternion.h"
+#include "GMatrix4D.h"
+#include "GTransform.h"
+#include "GUtils.h"
+
+namespace sgl
+{
+
+GDualQuaternion GDualQuaternion::rotation(double angle, const GVector3D & axis,
+                                          const GPoint3D & center /*= GPoint3D::origin()*/)
+{
+    const GQuaternion q = GQuaternion::rotation(angle, axis);
+    return GDualQuaternion(q, center - q.rotate(center));
+}
+
+GDualQuaternion GDualQuaternion::fromMatrix(const GMatrix4D & m)
+{
+    return GDualQuaternion(GQuaternion::fromMatrix(m), GVector3D(m(0, 3), m(1, 3), m(2, 3)));
+}
+
+bool GDualQuaternion::isUnit(double tolerance /*= GTolerance::lengthTol()*/) const
+{
+    return m_real.isUnit(tolerance) && equal(m_real.dot(m_dual), 0.0, tolerance);
+}
+
+GDualQuaternion & GDualQuaternion::normalize()
+{
+    const double n = m_real.norm();
+    if (equal(n, 0.0, GTolerance::zeroTol()))
+        throw std::logic_error("GDualQuaternion: division by zero");
+    m_real *= 1.0 / n;
+    m_dual *= 1.0 / n;
+    m_dual -= m_real * m_real.dot(m_dual);
+    return *this;
+}
+
+GDualQuaternion GDualQuaternion::normalize() const
+{
+    GDualQuaternion res(*this);
+    res.normalize();
+    return res;
+}
+
+void GDualQuaternion::transform(GPoint3D * pPoints, std::size_t count) const
+{
+    // bulk functions apply matrix to row vectors, so matrix is passed transposed
+    transformPoints(toMatrix().transpose(), pPoints, count);
+}
+
+void GDualQuaternion::transform(GPoint3DArray & points) const
+{
+    transformPoints(toMatrix().transpose(), points);
+}
+
+void GDualQuaternion::transform(GPointCloud & cloud) const
+{
+    transformPoints(toMatrix().transpose(), cloud);
+}
+
+void GDualQuaternion::transform(GVector3D * pVectors, std::size_t count) const
+{
+    transformVectors(toMatrix().transpose(), pVectors, count);
+}
+
+void GDualQuaternion::transform(GVector3DArray & vectors) const
+{
+    transformVectors(toMatrix().transpose(), vectors);
+}
+
+GMatrix4D GDualQuaternion::toMatrix() const
+{
+    GMatrix4D res = m_real.toMatrix();
+    const GVector3D t = translation();
+    res(0, 3) = t.x();
+    res(1, 3) = t.y();
+    res(2, 3) = t.z();
+    return res;
+}
+
+bool GDualQuaternion::equals(const GDualQuaternion & dq, double tolerance /*= GTolerance::lengthTol()*/) const
+{
+    return m_real.equals(dq.m_real, tolerance) && m_dual.equals(dq.m_dual, tolerance);
+}
+
+} //namespace sgl
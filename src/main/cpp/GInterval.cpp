@@ -23,73 +23,98 @@
 namespace sgl
 {
 
-GInterval::GInterval() = default;
+template<typename T>
+GIntervalT<T>::GIntervalT() = default;
 
-GInterval::GInterval(const GInterval &) = default;
+template<typename T>
+GIntervalT<T>::GIntervalT(const GIntervalT<T> &) = default;
 
-GInterval::GInterval(GInterval&&) noexcept = default;
+template<typename T>
+GIntervalT<T>::GIntervalT(GIntervalT<T>&&) noexcept = default;
 
-GInterval::GInterval(double from, double to)
-    : m_from{ from }, m_to{ to }
+template<typename T>
+GIntervalT<T>::GIntervalT(T from, T to)
+    : m_from{ std::min(from, to) }, m_to{ std::max(from, to) }
 {}
 
-GInterval::GInterval(std::initializer_list<double> l)
-    : m_from{ l.begin()[0] }, m_to{ l.begin()[1] }
+template<typename T>
+GIntervalT<T>::GIntervalT(std::initializer_list<T> l)
+    : GIntervalT(l.begin()[0], l.begin()[1])
 {}
 
-GInterval::~GInterval() = default;
+template<typename T>
+GIntervalT<T>::~GIntervalT() = default;
 
-GInterval & GInterval::operator=(const GInterval& i) = default;
+template<typename T>
+GIntervalT<T> & GIntervalT<T>::operator=(const GIntervalT<T>& i) = default;
 
-double GInterval::from() const
+template<typename T>
+T GIntervalT<T>::from() const
 {
     return m_from;
 }
 
-void GInterval::setFrom(double from)
+template<typename T>
+void GIntervalT<T>::setFrom(T from)
 {
     m_from = from;
     if (m_to < m_from)
         std::swap(m_from, m_to);
 }
 
-double GInterval::to() const
+template<typename T>
+T GIntervalT<T>::to() const
 {
     return m_to;
 }
 
-void GInterval::setTo(double to)
+template<typename T>
+void GIntervalT<T>::setTo(T to)
 {
     m_to = to;
     if (m_to < m_from)
         std::swap(m_from, m_to);
 }
 
-bool GInterval::equals(const GInterval & interval, double tolerance /*= GTolerance::zeroTol()*/) const
+template<typename T>
+bool GIntervalT<T>::equals(const GIntervalT<T> & interval, double tolerance /*= GTolerance::zeroTol()*/) const
 {
     return equal(m_from, interval.m_from, tolerance) && equal(m_to, interval.m_to, tolerance);
 }
 
-bool GInterval::intersects(const GInterval & interval, double tolerance /*= GTolerance::zeroTol()*/) const
+template<typename T>
+bool GIntervalT<T>::intersects(const GIntervalT<T> & interval, double tolerance /*= GTolerance::zeroTol()*/) const
 {
-    return greater(m_to, interval.m_from, tolerance) && sgl::less(m_to, interval.m_from, tolerance);
+    return !less(interval, tolerance) && !more(interval, tolerance);
 }
 
-bool GInterval::less(const GInterval & interval, double tolerance /*= GTolerance::zeroTol()*/) const
+template<typename T>
+bool GIntervalT<T>::contains(T value, double tolerance /*= GTolerance::zeroTol()*/) const
+{
+    return !sgl::less(value, m_from, tolerance) && !greater(value, m_to, tolerance);
+}
+
+template<typename T>
+bool GIntervalT<T>::less(const GIntervalT<T> & interval, double tolerance /*= GTolerance::zeroTol()*/) const
 {
     return sgl::less(m_to, interval.m_from, tolerance);
 }
 
-bool GInterval::more(const GInterval & interval, double tolerance /*= GTolerance::zeroTol()*/) const
+template<typename T>
+bool GIntervalT<T>::more(const GIntervalT<T> & interval, double tolerance /*= GTolerance::zeroTol()*/) const
 {
     return greater(m_from, interval.m_to, tolerance);
 }
 
-GInterval & GInterval::operator+=(const GInterval & interval)
+template<typename T>
+GIntervalT<T> & GIntervalT<T>::operator+=(const GIntervalT<T> & interval)
 {
     m_from = std::min(m_from, interval.m_from);
     m_to = std::max(m_to, interval.m_to);
     return *this;
 }
 
+template class SGL_API GIntervalT<double>;
+template class SGL_API GIntervalT<float>;
+
 } //namespace sgl
@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GIntervalTree.h"
+
+#include <numeric>
+
+namespace sgl
+{
+
+namespace
+{
+
+// Subtrees of this level and lower are scanned linearly
+constexpr int LINEAR_SCAN_LEVEL = 3;
+
+} //namespace
+
+GIntervalTree::GIntervalTree() = default;
+
+GIntervalTree::GIntervalTree(const GInterval * pIntervals, std::size_t count)
+{
+    std::vector<std::size_t> order(count);
+    std::iota(order.begin(), order.end(), std::size_t{ 0 });
+    std::stable_sort(order.begin(), order.end(), [pIntervals](std::size_t i1, std::size_t i2)
+    {
+        return pIntervals[i1].from() < pIntervals[i2].from();
+    });
+
+    m_from.resize(count);
+    m_to.resize(count);
+    m_maxTo.resize(count);
+    m_index = std::move(order);
+    m_position.resize(count);
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        m_from[idx] = pIntervals[m_index[idx]].from();
+        m_to[idx] = pIntervals[m_index[idx]].to();
+        m_position[m_index[idx]] = idx;
+    }
+    if (count == 0)
+        return;
+
+    // Node idx of level k has k trailing one bits; its children are idx -/+ 2^(k-1).
+    // Right children may be missing (idx >= count), then the maximum of the last existing
+    // node of the level below is used.
+    std::size_t last = 0;
+    double lastMax = 0.0;
+    for (std::size_t idx = 0; idx < count; idx += 2)
+    {
+        last = idx;
+        lastMax = m_maxTo[idx] = m_to[idx];
+    }
+    int level = 1;
+    for (; (std::size_t{ 1 } << level) <= count; ++level)
+    {
+        const std::size_t half = std::size_t{ 1 } << (level - 1);
+        for (std::size_t idx = (half << 1) - 1; idx < count; idx += half << 2)
+        {
+            const double left = m_maxTo[idx - half];
+            const double right = idx + half < count ? m_maxTo[idx + half] : lastMax;
+            m_maxTo[idx] = std::max(m_to[idx], std::max(left, right));
+        }
+        last = (last >> level) & 1 ? last - half : last + half;
+        if (last < count)
+            lastMax = std::max(lastMax, m_maxTo[last]);
+    }
+    m_rootLevel = level - 1;
+}
+
+GIntervalTree::GIntervalTree(const std::vector<GInterval> & intervals)
+    : GIntervalTree(intervals.data(), intervals.size())
+{
+}
+
+std::size_t GIntervalTree::size() const
+{
+    return m_index.size();
+}
+
+bool GIntervalTree::empty() const
+{
+    return m_index.empty();
+}
+
+GInterval GIntervalTree::interval(std::size_t index) const
+{
+    const std::size_t pos = m_position.at(index);
+    return GInterval(m_from[pos], m_to[pos]);
+}
+
+std::vector<std::size_t> GIntervalTree::stab(double value, double tolerance /*= GTolerance::zeroTol()*/) const
+{
+    std::vector<std::size_t> res;
+    query(value - tolerance, value + tolerance, res);
+    return res;
+}
+
+std::vector<std::size_t> GIntervalTree::overlap(const GInterval & interval,
+                                                double tolerance /*= GTolerance::zeroTol()*/) const
+{
+    std::vector<std::size_t> res;
+    query(interval.from() - tolerance, interval.to() + tolerance, res);
+    return res;
+}
+
+std::size_t GIntervalTree::overlap(const GInterval & interval, double tolerance,
+                                   std::vector<std::size_t> & result) const
+{
+    return query(interval.from() - tolerance, interval.to() + tolerance, result);
+}
+
+std::vector<std::vector<std::size_t>> GIntervalTree::stab(const std::vector<double> & values,
+                                                          double tolerance /*= GTolerance::zeroTol()*/) const
+{
+    std::vector<std::vector<std::size_t>> res(values.size());
+    for (std::size_t idx = 0; idx < values.size(); ++idx)
+        query(values[idx] - tolerance, values[idx] + tolerance, res[idx]);
+    return res;
+}
+
+std::vector<std::vector<std::size_t>> GIntervalTree::overlap(const std::vector<GInterval> & intervals,
+                                                             double tolerance /*= GTolerance::zeroTol()*/) const
+{
+    std::vector<std::vector<std::size_t>> res(intervals.size());
+    for (std::size_t idx = 0; idx < intervals.size(); ++idx)
+        query(intervals[idx].from() - tolerance, intervals[idx].to() + tolerance, res[idx]);
+    return res;
+}
+
+// Reports intervals [a, b] with b >= from and a <= to
+std::size_t GIntervalTree::query(double from, double to, std::vector<std::size_t> & result) const
+{
+    if (m_rootLevel < 0)
+        return 0;
+
+    struct Node
+    {
+        std::size_t idx;
+        int level;
+        bool leftVisited;
+    };
+
+    const std::size_t count = size();
+    const std::size_t initialSize = result.size();
+    // Depth of traversal is bounded by the tree height, two entries per level
+    Node stack[2 * (sizeof(std::size_t) * 8 + 1)];
+    std::size_t top = 0;
+    stack[top++] = { (std::size_t{ 1 } << m_rootLevel) - 1, m_rootLevel, false };
+    while (top > 0)
+    {
+        const Node node = stack[--top];
+        if (node.level <= LINEAR_SCAN_LEVEL)
+        {
+            const std::size_t begin = node.idx >> node.level << node.level;
+            const std::size_t end = std::min(begin + (std::size_t{ 1 } << (node.level + 1)) - 1, count);
+            for (std::size_t idx = begin; idx < end && m_from[idx] <= to; ++idx)
+            {
+                if (m_to[idx] >= from)
+                    result.push_back(m_index[idx]);
+            }
+        }
+        else if (!node.leftVisited)
+        {
+            const std::size_t left = node.idx - (std::size_t{ 1 } << (node.level - 1));
+            stack[top++] = { node.idx, node.level, true };
+            if (left >= count || m_maxTo[left] >= from)
+                stack[top++] = { left, node.level - 1, false };
+        }
+        else if (node.idx < count && m_from[node.idx] <= to)
+        {
+            if (m_to[node.idx] >= from)
+                result.push_back(m_index[node.idx]);
+            const std::size_t right = node.idx + (std::size_t{ 1 } << (node.level - 1));
+            if (right >= count || m_maxTo[right] >= from)
+                stack[top++] = { right, node.level - 1, false };
+        }
+    }
+    return result.size() - initialSize;
+}
+
+} //namespace sgl
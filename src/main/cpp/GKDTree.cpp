@@ -0,0 +1,411 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GKDTree.h"
+#include "GParallel.h"
+#include "GPointCloud.h"
+
+#include <future>
+
+namespace sgl
+{
+
+namespace
+{
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+// Ranges of this size and shorter are scanned linearly
+constexpr std::size_t LEAF_SIZE = 8;
+// Smaller ranges are built on the calling thread
+constexpr std::size_t PARALLEL_THRESHOLD = 8192;
+// Minimal number of batched queries per thread
+constexpr std::size_t QUERY_CHUNK = 64;
+// Median splits give depth of log2(n / LEAF_SIZE), traversal keeps at most two entries per level
+constexpr std::size_t STACK_SIZE = 128;
+
+// Median split builder over coordinates given with stride
+class Builder
+{
+public:
+    Builder(const double * const * pCoords, std::size_t stride, std::size_t * pIndex, std::uint8_t * pAxis,
+            unsigned threadCount)
+        : m_pCoords(pCoords), m_stride{ stride }, m_pIndex{ pIndex }, m_pAxis{ pAxis }
+    {
+        while ((1u << m_parallelDepth) < threadCount)
+            ++m_parallelDepth;
+    }
+
+    void build(std::size_t begin, std::size_t end, std::size_t depth)
+    {
+        if (end - begin <= LEAF_SIZE)
+            return;
+
+        // Split along the largest extent
+        double lo[3] = { INF, INF, INF };
+        double hi[3] = { -INF, -INF, -INF };
+        for (std::size_t idx = begin; idx < end; ++idx)
+        {
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                const double value = coord(m_pIndex[idx], axis);
+                lo[axis] = std::min(lo[axis], value);
+                hi[axis] = std::max(hi[axis], value);
+            }
+        }
+        std::size_t axis = 0;
+        for (std::size_t idx = 1; idx < 3; ++idx)
+        {
+            if (hi[idx] - lo[idx] > hi[axis] - lo[axis])
+                axis = idx;
+        }
+
+        const std::size_t mid = begin + (end - begin) / 2;
+        std::nth_element(m_pIndex + begin, m_pIndex + mid, m_pIndex + end, [this, axis](std::size_t i1, std::size_t i2)
+        {
+            return coord(i1, axis) < coord(i2, axis);
+        });
+        m_pAxis[mid] = static_cast<std::uint8_t>(axis);
+
+        if (end - begin >= PARALLEL_THRESHOLD && depth < m_parallelDepth)
+        {
+            auto left = std::async(std::launch::async, [this, begin, mid, depth]() { build(begin, mid, depth + 1); });
+            build(mid + 1, end, depth + 1);
+            left.get();
+        }
+        else
+        {
+            build(begin, mid, depth + 1);
+            build(mid + 1, end, depth + 1);
+        }
+    }
+
+private:
+    double coord(std::size_t index, std::size_t axis) const
+    {
+        return m_pCoords[axis][index * m_stride];
+    }
+
+    const double * const * m_pCoords;
+    std::size_t m_stride;
+    std::size_t * m_pIndex;
+    std::uint8_t * m_pAxis;
+    std::size_t m_parallelDepth = 0;
+};
+
+// Range of tree order still to be visited and squared distance to its half-space
+struct Range
+{
+    std::size_t begin;
+    std::size_t end;
+    double distance2;
+};
+
+// Bounded max-heap of squared distances living in caller buffers
+void siftUp(double * pKeys, std::size_t * pValues, std::size_t pos)
+{
+    while (pos > 0)
+    {
+        const std::size_t parent = (pos - 1) / 2;
+        if (!(pKeys[parent] < pKeys[pos]))
+            break;
+        std::swap(pKeys[parent], pKeys[pos]);
+        std::swap(pValues[parent], pValues[pos]);
+        pos = parent;
+    }
+}
+
+void siftDown(double * pKeys, std::size_t * pValues, std::size_t pos, std::size_t size)
+{
+    while (true)
+    {
+        std::size_t largest = pos;
+        const std::size_t left = 2 * pos + 1;
+        const std::size_t right = left + 1;
+        if (left < size && pKeys[left] > pKeys[largest])
+            largest = left;
+        if (right < size && pKeys[right] > pKeys[largest])
+            largest = right;
+        if (largest == pos)
+            return;
+        std::swap(pKeys[largest], pKeys[pos]);
+        std::swap(pValues[largest], pValues[pos]);
+        pos = largest;
+    }
+}
+
+} //namespace
+
+GKDTree::GKDTree() = default;
+
+GKDTree::GKDTree(const GPoint3D * pPoints, std::size_t count, unsigned threadCount /*= 0*/)
+{
+    if (count == 0)
+        return;
+    const double * pData = pPoints->data();
+    const double * coords[3] = { pData, pData + 1, pData + 2 };
+    build(coords, 3, count, threadCount);
+}
+
+GKDTree::GKDTree(const GPoint3DArray & points, unsigned threadCount /*= 0*/)
+    : GKDTree(points.data(), points.size(), threadCount)
+{
+}
+
+GKDTree::GKDTree(const GPointCloud & cloud, unsigned threadCount /*= 0*/)
+{
+    const double * coords[3] = { cloud.xData(), cloud.yData(), cloud.zData() };
+    build(coords, 1, cloud.size(), threadCount);
+}
+
+void GKDTree::build(const double * const * pCoords, std::size_t stride, std::size_t count, unsigned threadCount)
+{
+    m_index.resize(count);
+    for (std::size_t idx = 0; idx < count; ++idx)
+        m_index[idx] = idx;
+    m_axis.assign(count, 0);
+
+    Builder builder(pCoords, stride, m_index.data(), m_axis.data(), resolveThreadCount(threadCount));
+    builder.build(0, count, 0);
+
+    m_coords.resize(3 * count);
+    m_position.resize(count);
+    for (std::size_t pos = 0; pos < count; ++pos)
+    {
+        for (std::size_t axis = 0; axis < 3; ++axis)
+            m_coords[3 * pos + axis] = pCoords[axis][m_index[pos] * stride];
+        m_position[m_index[pos]] = pos;
+    }
+}
+
+std::size_t GKDTree::size() const
+{
+    return m_index.size();
+}
+
+bool GKDTree::empty() const
+{
+    return m_index.empty();
+}
+
+GPoint3D GKDTree::point(std::size_t index) const
+{
+    const double * pCoord = &m_coords[3 * m_position.at(index)];
+    return GPoint3D(pCoord[0], pCoord[1], pCoord[2]);
+}
+
+const std::vector<double> & GKDTree::coords() const
+{
+    return m_coords;
+}
+
+const std::vector<std::size_t> & GKDTree::indices() const
+{
+    return m_index;
+}
+
+std::size_t GKDTree::nearest(const GPoint3D & pt, double & distance) const
+{
+    if (empty())
+        throw std::logic_error("GKDTree: nearest point of empty tree");
+    std::size_t index = 0;
+    search(pt, 1, &index, &distance);
+    return index;
+}
+
+std::size_t GKDTree::knn(const GPoint3D & pt, std::size_t k, std::size_t * pIndices, double * pDistances) const
+{
+    return search(pt, k, pIndices, pDistances);
+}
+
+std::vector<std::size_t> GKDTree::knn(const GPoint3D & pt, std::size_t k) const
+{
+    const std::size_t count = std::min(k, size());
+    std::vector<std::size_t> indices(count);
+    std::vector<double> distances(count);
+    search(pt, count, indices.data(), distances.data());
+    return indices;
+}
+
+// Depth-first search, nearer half first; pDistances holds max-heap of squared distances while searching
+std::size_t GKDTree::search(const GPoint3D & pt, std::size_t k, std::size_t * pIndices, double * pDistances) const
+{
+    k = std::min(k, size());
+    if (k == 0)
+        return 0;
+
+    const double query[3] = { pt[0], pt[1], pt[2] };
+    std::size_t found = 0;
+    const auto consider = [&](std::size_t pos)
+    {
+        const double * pCoord = &m_coords[3 * pos];
+        const double dx = pCoord[0] - query[0];
+        const double dy = pCoord[1] - query[1];
+        const double dz = pCoord[2] - query[2];
+        const double distance2 = dx * dx + dy * dy + dz * dz;
+        if (found < k)
+        {
+            pDistances[found] = distance2;
+            pIndices[found] = pos;
+            siftUp(pDistances, pIndices, found++);
+        }
+        else if (distance2 < pDistances[0])
+        {
+            pDistances[0] = distance2;
+            pIndices[0] = pos;
+            siftDown(pDistances, pIndices, 0, k);
+        }
+    };
+
+    Range stack[STACK_SIZE];
+    std::size_t top = 0;
+    stack[top++] = { 0, size(), 0.0 };
+    while (top > 0)
+    {
+        const Range range = stack[--top];
+        if (found == k && range.distance2 >= pDistances[0])
+            continue;
+        if (range.end - range.begin <= LEAF_SIZE)
+        {
+            for (std::size_t pos = range.begin; pos < range.end; ++pos)
+                consider(pos);
+            continue;
+        }
+        const std::size_t mid = range.begin + (range.end - range.begin) / 2;
+        const std::size_t axis = m_axis[mid];
+        const double diff = query[axis] - m_coords[3 * mid + axis];
+        consider(mid);
+        const Range left = { range.begin, mid, diff > 0.0 ? diff * diff : range.distance2 };
+        const Range right = { mid + 1, range.end, diff < 0.0 ? diff * diff : range.distance2 };
+        stack[top++] = diff > 0.0 ? left : right;
+        stack[top++] = diff > 0.0 ? right : left;
+    }
+
+    // Heap sort gives ascending order
+    for (std::size_t end = k; end-- > 1;)
+    {
+        std::swap(pDistances[0], pDistances[end]);
+        std::swap(pIndices[0], pIndices[end]);
+        siftDown(pDistances, pIndices, 0, end);
+    }
+    for (std::size_t idx = 0; idx < k; ++idx)
+    {
+        pDistances[idx] = std::sqrt(pDistances[idx]);
+        pIndices[idx] = m_index[pIndices[idx]];
+    }
+    return k;
+}
+
+std::size_t GKDTree::radius(const GPoint3D & pt, double radius, std::vector<std::size_t> & result) const
+{
+    const std::size_t initialSize = result.size();
+    visitBall(pt, radius, [&result](std::size_t index) { result.push_back(index); });
+    return result.size() - initialSize;
+}
+
+std::size_t GKDTree::radius(const GPoint3D & pt, double radius, std::size_t * pIndices, std::size_t capacity) const
+{
+    std::size_t found = 0;
+    visitBall(pt, radius, [&found, pIndices, capacity](std::size_t index)
+    {
+        if (found < capacity)
+            pIndices[found] = index;
+        ++found;
+    });
+    return found;
+}
+
+void GKDTree::knn(const GPoint3D * pQueries, std::size_t count, std::size_t k, std::size_t * pIndices,
+                  double * pDistances, unsigned threadCount /*= 0*/) const
+{
+    if (k == 0)
+        return;
+    const std::size_t found = std::min(k, size());
+    parallelFor(count, threadCount, QUERY_CHUNK, [&](std::size_t begin, std::size_t end)
+    {
+        // Distances are required by the search, a small per-thread buffer replaces missing output
+        double scratch[64];
+        std::vector<double> buffer;
+        if (!pDistances && found > 64)
+            buffer.resize(found);
+        for (std::size_t query = begin; query < end; ++query)
+        {
+            std::size_t * pQueryIndices = pIndices + query * k;
+            double * pQueryDistances = pDistances ? pDistances + query * k : (buffer.empty() ? scratch : buffer.data());
+            search(pQueries[query], found, pQueryIndices, pQueryDistances);
+            std::fill(pQueryIndices + found, pQueryIndices + k, npos);
+            if (pDistances)
+                std::fill(pQueryDistances + found, pQueryDistances + k, INF);
+        }
+    });
+}
+
+void GKDTree::radius(const GPoint3D * pQueries, std::size_t count, double radius, std::size_t capacity,
+                     std::size_t * pIndices, std::size_t * pCounts, unsigned threadCount /*= 0*/) const
+{
+    parallelFor(count, threadCount, QUERY_CHUNK, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t query = begin; query < end; ++query)
+            pCounts[query] = this->radius(pQueries[query], radius, pIndices + query * capacity, capacity);
+    });
+}
+
+// Calls func(index) for every point within closed ball
+template<typename Func>
+void GKDTree::visitBall(const GPoint3D & pt, double radius, Func && func) const
+{
+    if (empty() || radius < 0.0)
+        return;
+
+    const double query[3] = { pt[0], pt[1], pt[2] };
+    const double radius2 = radius * radius;
+    const auto consider = [&](std::size_t pos)
+    {
+        const double * pCoord = &m_coords[3 * pos];
+        const double dx = pCoord[0] - query[0];
+        const double dy = pCoord[1] - query[1];
+        const double dz = pCoord[2] - query[2];
+        if (dx * dx + dy * dy + dz * dz <= radius2)
+            func(m_index[pos]);
+    };
+
+    Range stack[STACK_SIZE];
+    std::size_t top = 0;
+    stack[top++] = { 0, size(), 0.0 };
+    while (top > 0)
+    {
+        const Range range = stack[--top];
+        if (range.distance2 > radius2)
+            continue;
+        if (range.end - range.begin <= LEAF_SIZE)
+        {
+            for (std::size_t pos = range.begin; pos < range.end; ++pos)
+                consider(pos);
+            continue;
+        }
+        const std::size_t mid = range.begin + (range.end - range.begin) / 2;
+        const std::size_t axis = m_axis[mid];
+        const double diff = query[axis] - m_coords[3 * mid + axis];
+        consider(mid);
+        stack[top++] = { range.begin, mid, diff > 0.0 ? diff * diff : range.distance2 };
+        stack[top++] = { mid + 1, range.end, diff < 0.0 ? diff * diff : range.distance2 };
+    }
+}
+
+} //namespace sgl
@@ -20,184 +20,199 @@
 #include "GMatrix4D.h"
 #include "GVector3D.h"
 #include "GUtils.h"
+#include "GSimd.h"
+#include "GSimdDefs.h"
+
+#include <limits>
 
 namespace sgl
 {
 
-const GMatrix4D &GMatrix4D::identity()
+namespace
 {
-    static GMatrix4D s_identity;
-    return s_identity;
-}
 
-GMatrix4D::GMatrix4D()
+// Inversion by 2x2 subdeterminants, see GMatrix4DMinors
+template<typename T>
+T adjugateScalar(const T * a, T * b)
 {
-    setIdentity();
-}
+    const GMatrix4DMinors<T> minors(a);
+    const T * s = minors.s;
+    const T * c = minors.c;
 
-GMatrix4D::GMatrix4D(const GMatrix4D &m)
-{
-    std::memcpy(m_pData, m.m_pData, 16 * sizeof(double));
-}
+    b[0] = a[5] * c[5] - a[6] * c[4] + a[7] * c[3];
+    b[1] = -a[1] * c[5] + a[2] * c[4] - a[3] * c[3];
+    b[2] = a[13] * s[5] - a[14] * s[4] + a[15] * s[3];
+    b[3] = -a[9] * s[5] + a[10] * s[4] - a[11] * s[3];
 
-GMatrix4D::GMatrix4D(GMatrix4D &&m) noexcept = default;
+    b[4] = -a[4] * c[5] + a[6] * c[2] - a[7] * c[1];
+    b[5] = a[0] * c[5] - a[2] * c[2] + a[3] * c[1];
+    b[6] = -a[12] * s[5] + a[14] * s[2] - a[15] * s[1];
+    b[7] = a[8] * s[5] - a[10] * s[2] + a[11] * s[1];
 
-GMatrix4D::GMatrix4D(std::initializer_list<double> l)
-{
-    std::copy(l.begin(), l.end(), m_pData);
-}
+    b[8] = a[4] * c[4] - a[5] * c[2] + a[7] * c[0];
+    b[9] = -a[0] * c[4] + a[1] * c[2] - a[3] * c[0];
+    b[10] = a[12] * s[4] - a[13] * s[2] + a[15] * s[0];
+    b[11] = -a[8] * s[4] + a[9] * s[2] - a[11] * s[0];
 
-GMatrix4D::GMatrix4D(const GPoint3D &o, const GVector3D &x, const GVector3D &y, const GVector3D &z)
-    : GMatrix4D({ x[0], y[0], z[0], o[0],
-                  x[1], y[1], z[1], o[1],
-                  x[2], y[2], z[2], o[2],
-                   0.0,  0.0,  0.0,  1.0 })
-{}
+    b[12] = -a[4] * c[3] + a[5] * c[1] - a[6] * c[0];
+    b[13] = a[0] * c[3] - a[1] * c[1] + a[2] * c[0];
+    b[14] = -a[12] * s[3] + a[13] * s[1] - a[14] * s[0];
+    b[15] = a[8] * s[3] - a[9] * s[1] + a[10] * s[0];
 
-GMatrix4D::~GMatrix4D() = default;
-
-GMatrix4D & GMatrix4D::operator=(const GMatrix4D &m)
-{
-    std::memcpy(m_pData, m.m_pData, 16 * sizeof(double));
-    return *this;
+    return minors.determinant();
 }
 
-void GMatrix4D::setIdentity()
-{
-    for (std::size_t idx = 0; idx < 16; ++idx)
-        m_pData[idx] = idx % 5 == 0 ? 1.0 : 0.0;
-}
+#if SGL_SIMD_X86
 
-GPoint3D GMatrix4D::origin() const
+// Same expansion with one matrix row per register.
+// Let P(j) = [a1j, a0j, a3j, a2j] (column j with swapped row pairs) and
+// K(i, j) = [c(i,j), c(i,j), s(i,j), s(i,j)] (minors of columns i, j for rows 2-3 and 0-1).
+// Then adjugate rows are combinations of P(j) * K(i, j) with alternating signs.
+SGL_TARGET_AVX2
+inline __m256d minorsAVX2(__m256d colI, __m256d permColJ)
 {
-    return GPoint3D(m_pData[3], m_pData[7], m_pData[11]);
+    const __m256d prod = _mm256_mul_pd(colI, permColJ);      // [a0i*a1j, a1i*a0j, a2i*a3j, a3i*a2j]
+    const __m256d diff = _mm256_hsub_pd(prod, prod);          // [s, s, c, c]
+    return _mm256_permute2f128_pd(diff, diff, 0x01);          // [c, c, s, s]
 }
 
-GVector3D GMatrix4D::x() const
+SGL_TARGET_AVX2
+double adjugateAVX2(const double * a, double * b)
 {
-    return GVector3D(m_pData[0], m_pData[4], m_pData[8]);
-}
+    const __m256d r0 = _mm256_loadu_pd(a);
+    const __m256d r1 = _mm256_loadu_pd(a + 4);
+    const __m256d r2 = _mm256_loadu_pd(a + 8);
+    const __m256d r3 = _mm256_loadu_pd(a + 12);
 
-GVector3D GMatrix4D::y() const
-{
-    return GVector3D(m_pData[1], m_pData[5], m_pData[9]);
-}
+    const __m256d lo10 = _mm256_unpacklo_pd(r1, r0);          // [a10 a00 a12 a02]
+    const __m256d lo32 = _mm256_unpacklo_pd(r3, r2);          // [a30 a20 a32 a22]
+    const __m256d hi10 = _mm256_unpackhi_pd(r1, r0);          // [a11 a01 a13 a03]
+    const __m256d hi32 = _mm256_unpackhi_pd(r3, r2);          // [a31 a21 a33 a23]
 
-GVector3D GMatrix4D::z() const
-{
-    return GVector3D(m_pData[2], m_pData[6], m_pData[10]);
-}
+    const __m256d p0 = _mm256_permute2f128_pd(lo10, lo32, 0x20);
+    const __m256d p1 = _mm256_permute2f128_pd(hi10, hi32, 0x20);
+    const __m256d p2 = _mm256_permute2f128_pd(lo10, lo32, 0x31);
+    const __m256d p3 = _mm256_permute2f128_pd(hi10, hi32, 0x31);
 
-const double * const GMatrix4D::operator[](std::size_t row) const
-{
-    return &m_pData[4 * row];
-}
+    const __m256d col0 = _mm256_permute_pd(p0, 0x5);
+    const __m256d col1 = _mm256_permute_pd(p1, 0x5);
+    const __m256d col2 = _mm256_permute_pd(p2, 0x5);
 
-double * GMatrix4D::operator[](std::size_t row)
-{
-    return &m_pData[4 * row];
-}
+    const __m256d k01 = minorsAVX2(col0, p1);
+    const __m256d k02 = minorsAVX2(col0, p2);
+    const __m256d k03 = minorsAVX2(col0, p3);
+    const __m256d k12 = minorsAVX2(col1, p2);
+    const __m256d k13 = minorsAVX2(col1, p3);
+    const __m256d k23 = minorsAVX2(col2, p3);
 
-double GMatrix4D::operator()(std::size_t row, std::size_t column) const
-{
-    return m_pData[4 * row + column];
-}
+    const __m256d signEven = _mm256_setr_pd(1.0, -1.0, 1.0, -1.0);
+    const __m256d signOdd = _mm256_setr_pd(-1.0, 1.0, -1.0, 1.0);
 
-double & GMatrix4D::operator()(std::size_t row, std::size_t column)
-{
-    return m_pData[4 * row + column];
-}
+    __m256d b0 = _mm256_fmadd_pd(p3, k12, _mm256_fmsub_pd(p1, k23, _mm256_mul_pd(p2, k13)));
+    __m256d b1 = _mm256_fmadd_pd(p3, k02, _mm256_fmsub_pd(p0, k23, _mm256_mul_pd(p2, k03)));
+    __m256d b2 = _mm256_fmadd_pd(p3, k01, _mm256_fmsub_pd(p0, k13, _mm256_mul_pd(p1, k03)));
+    __m256d b3 = _mm256_fmadd_pd(p2, k01, _mm256_fmsub_pd(p0, k12, _mm256_mul_pd(p1, k02)));
+    b0 = _mm256_mul_pd(b0, signEven);
+    b1 = _mm256_mul_pd(b1, signOdd);
+    b2 = _mm256_mul_pd(b2, signEven);
+    b3 = _mm256_mul_pd(b3, signOdd);
 
-GMatrix4D & GMatrix4D::postMultiplyBy(const GMatrix4D &m)
-{
-    return *this = *this * m;
+    _mm256_storeu_pd(b, b0);
+    _mm256_storeu_pd(b + 4, b1);
+    _mm256_storeu_pd(b + 8, b2);
+    _mm256_storeu_pd(b + 12, b3);
+
+    // det = row 0 of matrix * column 0 of adjugate
+    const __m256d b01 = _mm256_unpacklo_pd(b0, b1);           // [b00 b10 b02 b12]
+    const __m256d b23 = _mm256_unpacklo_pd(b2, b3);           // [b20 b30 b22 b32]
+    const __m256d bCol0 = _mm256_permute2f128_pd(b01, b23, 0x20);
+    const __m256d prod = _mm256_mul_pd(r0, bCol0);
+    const __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(prod), _mm256_extractf128_pd(prod, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
 }
 
-GMatrix4D &GMatrix4D::preMultiplyBy(const GMatrix4D &m)
+#endif //SGL_SIMD_X86
+
+double adjugate(const double * a, double * b)
 {
-    return *this = m * *this;
+#if SGL_SIMD_X86
+    if (simdLevel() >= GSimdLevel::AVX2)
+        return adjugateAVX2(a, b);
+#endif
+    return adjugateScalar(a, b);
 }
 
-GMatrix4D &GMatrix4D::product(const GMatrix4D &m1, const GMatrix4D &m2)
+float adjugate(const float * a, float * b)
 {
-    return *this = m1 * m2;
+    return adjugateScalar(a, b);
 }
 
-GMatrix4D GMatrix4D::transpose() const
+template<typename T>
+T normInf(const T * a)
 {
-    const auto & m = *this;
-    return { m(0, 0), m(1, 0), m(2, 0), m(3, 0),
-             m(0, 1), m(1, 1), m(2, 1), m(3, 1),
-             m(0, 2), m(1, 2), m(2, 2), m(3, 2),
-             m(0, 3), m(1, 3), m(2, 3), m(3, 3) };
+    T res = 0;
+    for (std::size_t row = 0; row < 4; ++row, a += 4)
+        res = std::max(res, std::abs(a[0]) + std::abs(a[1]) + std::abs(a[2]) + std::abs(a[3]));
+    return res;
 }
 
-GMatrix4D & GMatrix4D::invert()
+} //namespace
+
+template<typename T>
+GMatrix4DT<T> & GMatrix4DT<T>::invert()
 {
     return *this = inverse();
 }
 
-GMatrix4D GMatrix4D::inverse() const
+template<typename T>
+GMatrix4DT<T> GMatrix4DT<T>::inverse() const
 {
-    const auto & m = *this;
-    double det = m.determinant();
-    if (sgl::equal(det, 0.0))
+    GMatrix4DT<T> res;
+    if (!tryInvert(res))
         throw std::logic_error("Matrix with zero determinant cannot be inverted");
-
-    GMatrix4D res {
-        m[2][2] * m[3][3] * m[4][4] + m[2][3] * m[3][4] * m[4][2] + m[2][4] * m[3][2] * m[4][3]
-        - m[2][4] * m[3][3] * m[4][2] - m[2][3] * m[3][2] * m[4][4] - m[2][2] * m[3][4] * m[4][3],
-        m[1][4] * m[3][3] * m[4][2] + m[1][3] * m[3][2] * m[4][4] + m[1][2] * m[3][4] * m[4][3]
-        - m[1][2] * m[3][3] * m[4][4] - m[1][3] * m[3][4] * m[4][2] - m[1][4] * m[3][2] * m[4][3],
-        m[1][2] * m[2][3] * m[4][4] + m[1][3] * m[2][4] * m[4][2] + m[1][4] * m[2][2] * m[4][3]
-        - m[1][3] * m[2][3] * m[4][2] - m[1][3] * m[2][2] * m[4][4] - m[1][2] * m[2][4] * m[4][3],
-        m[1][4] * m[2][3] * m[3][2] + m[1][3] * m[2][2] * m[3][4] + m[1][2] * m[2][4] * m[3][3]
-        - m[1][2] * m[2][3] * m[3][4] - m[1][3] * m[2][4] * m[3][2] - m[1][4] * m[2][2] * m[3][3],
-
-        m[2][4] * m[3][3] * m[4][1] + m[2][3] * m[3][1] * m[4][4] + m[2][1] * m[3][4] * m[4][3]
-        - m[2][1] * m[3][3] * m[4][4] - m[2][3] * m[3][4] * m[4][1] - m[2][4] * m[3][1] * m[4][3],
-        m[1][1] * m[3][3] * m[4][4] + m[1][3] * m[3][4] * m[4][1] + m[1][4] * m[3][1] * m[4][3]
-        - m[1][4] * m[3][3] * m[4][1] - m[1][3] * m[3][1] * m[4][4] - m[1][1] * m[3][4] * m[4][3],
-        m[1][4] * m[2][3] * m[4][1] + m[1][3] * m[2][1] * m[4][4] + m[1][1] * m[2][4] * m[4][3]
-        - m[1][1] * m[2][3] * m[4][4] - m[1][3] * m[2][4] * m[4][1] - m[1][4] * m[2][1] * m[4][3],
-        m[1][1] * m[2][3] * m[3][4] + m[1][3] * m[2][4] * m[3][1] + m[1][4] * m[2][1] * m[3][3]
-        - m[1][4] * m[2][3] * m[3][1] - m[1][3] * m[2][1] * m[3][4] - m[1][1] * m[2][4] * m[3][3],
-
-        m[2][1] * m[3][2] * m[4][4] + m[2][2] * m[3][4] * m[4][1] + m[2][4] * m[3][1] * m[4][2]
-        - m[2][4] * m[3][2] * m[4][1] - m[2][2] * m[3][1] * m[4][4] - m[2][1] * m[3][4] * m[4][2],
-        m[1][4] * m[3][2] * m[4][1] + m[1][2] * m[3][1] * m[4][4] + m[1][1] * m[3][4] * m[4][2]
-        - m[1][1] * m[3][2] * m[4][4] - m[1][2] * m[3][4] * m[4][1] - m[1][4] * m[3][1] * m[4][2],
-        m[1][1] * m[2][2] * m[4][4] + m[1][2] * m[2][4] * m[4][1] + m[1][4] * m[2][1] * m[4][2]
-        - m[1][4] * m[2][2] * m[4][1] - m[1][2] * m[2][1] * m[4][4] - m[1][1] * m[2][4] * m[4][2],
-        m[1][4] * m[2][2] * m[3][1] + m[1][2] * m[2][1] * m[3][4] + m[1][1] * m[2][4] * m[3][2]
-        - m[1][1] * m[2][2] * m[3][4] - m[1][2] * m[2][4] * m[3][1] - m[1][4] * m[2][1] * m[3][2],
-
-        m[2][3] * m[3][2] * m[4][1] + m[2][2] * m[3][1] * m[4][3] + m[2][1] * m[3][3] * m[4][2]
-        - m[2][1] * m[3][2] * m[4][3] - m[2][2] * m[3][3] * m[4][1] - m[2][3] * m[3][1] * m[4][2],
-        m[1][1] * m[3][2] * m[4][3] + m[1][2] * m[3][3] * m[4][1] + m[1][3] * m[3][1] * m[4][2]
-        - m[1][3] * m[3][2] * m[4][1] - m[1][2] * m[3][1] * m[4][3] - m[1][1] * m[3][3] * m[4][2],
-        m[1][3] * m[2][2] * m[4][1] + m[1][2] * m[2][1] * m[4][3] + m[1][1] * m[2][3] * m[4][2]
-        - m[1][1] * m[2][2] * m[4][3] - m[1][2] * m[2][3] * m[4][1] - m[1][3] * m[2][1] * m[4][2],
-        m[1][1] * m[2][2] * m[3][3] + m[1][2] * m[2][3] * m[3][1] + m[1][3] * m[2][1] * m[3][2]
-        - m[1][3] * m[2][2] * m[3][1] - m[1][2] * m[2][1] * m[3][3] - m[1][1] * m[2][3] * m[3][2]
-    };
-
-    res /= det;
     return res;
 }
 
-bool GMatrix4D::singular(double tolerance /*= GTolerance::zeroTol()*/) const
+template<typename T>
+bool GMatrix4DT<T>::tryInvert(GMatrix4DT<T> & inverse, T * pCondition /*= nullptr*/,
+                          double tolerance /*= GTolerance::zeroTol()*/) const
 {
-    return equal(determinant(), 0.0, tolerance);
+    T adj[16];
+    const T det = adjugate(m_pData, adj);
+    if (equal(det, 0.0, tolerance))
+    {
+        if (pCondition)
+            *pCondition = std::numeric_limits<T>::infinity();
+        return false;
+    }
+
+    const T invDet = 1 / det;
+    for (std::size_t idx = 0; idx < 16; ++idx)
+        inverse.m_pData[idx] = adj[idx] * invDet;
+
+    if (pCondition)
+        *pCondition = normInf(m_pData) * normInf(adj) * std::abs(invDet);
+    return true;
 }
 
-double GMatrix4D::determinant() const
+template<typename T>
+T GMatrix4DT<T>::conditionNumber() const
 {
-    const auto & m = *this;
-    return m(0,0) * m(1, 1) * m(2, 2) - m(2, 0) * m(1, 1) * m(0, 2);
+    T adj[16];
+    const T det = adjugate(m_pData, adj);
+    if (equal(det, 0.0))
+        return std::numeric_limits<T>::infinity();
+    return normInf(m_pData) * normInf(adj) / std::abs(det);
 }
 
-bool GMatrix4D::equals(const GMatrix4D & m, double tolerance /*= GTolerance::zeroTol()*/)
+template<typename T>
+bool GMatrix4DT<T>::singular(double tolerance /*= GTolerance::zeroTol()*/) const
+{
+    return equal(determinant(), 0.0, tolerance);
+}
+
+template<typename T>
+bool GMatrix4DT<T>::equals(const GMatrix4DT<T> & m, double tolerance /*= GTolerance::zeroTol()*/) const
 {
     for (std::size_t idx = 0; idx < 16; ++idx)
     {
@@ -207,40 +222,21 @@ bool GMatrix4D::equals(const GMatrix4D & m, double tolerance /*= GTolerance::zer
     return true;
 }
 
-GMatrix4D & GMatrix4D::operator*=(double scalar)
-{
-    for (auto it = m_pData; it != m_pData + 16; ++it)
-        *it *= scalar;
-}
-
-GMatrix4D & GMatrix4D::operator/=(double scalar)
+template<typename T>
+GMatrix4DT<T> GMatrix4DT<T>::rotation(T angle, const GVector3DT<T> &axis, const GPoint3DT<T> &center)
 {
-    for (auto it = m_pData; it != m_pData + 16; ++it)
-        *it /= scalar;
-}
+    T cos = std::cos(angle);
+    T sin = std::sin(angle);
 
-GMatrix4D GMatrix4D::translation(const GVector3D & v)
-{
-    return { 1.0, 0.0, 0.0, v[0],
-             0.0, 1.0, 0.0, v[1],
-             0.0, 0.0, 1.0, v[2],
-             0.0, 0.0, 0.0, 1.0 };
-}
-
-GMatrix4D GMatrix4D::rotation(double angle, const GVector3D &axis, const GPoint3D &center)
-{
-    double cos = std::cos(angle);
-    double sin = std::sin(angle);
-
-    double a11 = cos + axis[0] * axis[0] * (1.0 - cos);
-    double a21 = axis[0] * axis[1] * (1.0 - cos) + axis[2] * sin;
-    double a31 = axis[0] * axis[2] * (1.0 - cos) - axis[1] * sin;
-    double a12 = axis[0] * axis[1] * (1.0 - cos) - axis[2] * sin;
-    double a22 = cos + axis[1] * axis[1] * (1.0 - cos);
-    double a32 = axis[1] * axis[2] * (1.0 - cos) + axis[0] * sin;
-    double a13 = axis[0] * axis[2] * (1.0 - cos) + axis[1] * sin;
-    double a23 = axis[1] * axis[2] * (1.0 - cos) - axis[0] * sin;
-    double a33 = cos + axis[2] * axis[2] * (1.0 - cos);
+    T a11 = cos + axis[0] * axis[0] * (1 - cos);
+    T a21 = axis[0] * axis[1] * (1 - cos) + axis[2] * sin;
+    T a31 = axis[0] * axis[2] * (1 - cos) - axis[1] * sin;
+    T a12 = axis[0] * axis[1] * (1 - cos) - axis[2] * sin;
+    T a22 = cos + axis[1] * axis[1] * (1 - cos);
+    T a32 = axis[1] * axis[2] * (1 - cos) + axis[0] * sin;
+    T a13 = axis[0] * axis[2] * (1 - cos) + axis[1] * sin;
+    T a23 = axis[1] * axis[2] * (1 - cos) - axis[0] * sin;
+    T a33 = cos + axis[2] * axis[2] * (1 - cos);
 
     return { a11, a12, a13, center[0],
              a21, a22, a23, center[1],
@@ -248,100 +244,8 @@ GMatrix4D GMatrix4D::rotation(double angle, const GVector3D &axis, const GPoint3
              0.0, 0.0, 0.0,       1.0 };
 }
 
-GMatrix4D GMatrix4D::scale(double scale, const GPoint3D &base)
-{
-    return { scale,   0.0,   0.0, base[0],
-               0.0, scale,   0.0, base[1],
-               0.0,   0.0, scale, base[2],
-               0.0,   0.0,   0.0,     1.0 };
-}
 
-GMatrix4D GMatrix4D::scale(double scaleX, double scaleY, double scaleZ, const GPoint3D &base)
-{
-    return { scaleX,    0.0,    0.0, base[0],
-                0.0, scaleY,    0.0, base[1],
-                0.0,    0.0, scaleZ, base[2],
-                0.0,    0.0,    0.0,     1.0 };
-}
-
-GMatrix4D GMatrix4D::scale(double scale, const GVector3D &direction, const GPoint3D &base)
-{
-    return { scale * direction[0],                  0.0,                  0.0, base[0],
-                              0.0, scale * direction[1],                  0.0, base[1],
-                              0.0,                  0.0, scale * direction[2], base[2],
-                              0.0,                  0.0,                  0.0,     1.0 };
-}
-
-GMatrix4D GMatrix4D::mirror(const GPoint3D &base, const GVector3D &direction)
-{
-    GVector3D n = std::move(direction.normalize());
-    double coef = 2 * (base[0] * n[0] + base[1] * n[1] + base[2] * n[2]);
-    double a11 = 1.0 - 2.0 * n[0] * n[0];
-    double a22 = 1.0 - 2.0 * n[1] * n[1];
-    double a33 = 1.0 - 2.0 * n[2] * n[2];
-    double a12 = -n[0] * n[0];
-    double a13 = -n[0] * n[2];
-    double a23 = -n[1] * n[2];
-
-    return { a11, a12, a13, n[0] * coef,
-             a12, a22, a23, n[1] * coef,
-             a13, a23, a33, n[2] * coef,
-             0.0, 0.0, 0.0,         1.0 };
-}
-
-GMatrix4D GMatrix4D::projection(const GPoint3D &plnPoint, const GVector3D &plnNormal, const GVector3D &prjDir)
-{
-    GVector3D n = std::move(plnNormal.normalize());
-    GVector3D udir = std::move(prjDir.normalize());
-
-    const double coef1 = 1.0 / (n % udir);
-    const double coef2 = (n % plnPoint.asVector()) * coef1;
-
-    return { 1.0 - udir[0] * n[0] * coef1,      -udir[1] * n[0] * coef1,      -udir[2] * n[0] * coef1, udir[0] * coef2,
-                  -udir[0] * n[1] * coef1, 1.0 - udir[1] * n[1] * coef1,      -udir[2] * n[1] * coef1, udir[1] * coef2,
-                  -udir[0] * n[2] * coef1,      -udir[1] * n[2] * coef1, 1.0 - udir[2] * n[2] * coef1, udir[2] * coef2,
-             0.0, 0.0, 0.0, 1.0 };
-}
-
-GMatrix4D GMatrix4D::projection(const GPoint3D &plnPoint, const GVector3D &plnNormal)
-{
-    GVector3D n = std::move(plnNormal.normalize());
-    const double coef = n % plnPoint.asVector();
-    double a11 = 1.0 - n[0] * n[0];
-    double a22 = 1.0 - n[1] * n[1];
-    double a33 = 1.0 - n[2] * n[2];
-    double a12 = -n[0] * n[1];
-    double a13 = -n[0] * n[2];
-    double a23 = -n[1] * n[2];
-    return { a11, a12, a13, n[0] * coef,
-             a12, a22, a23, n[1] * coef,
-             a13, a23, a33, n[2] * coef,
-             0.0, 0.0, 0.0,         1.0 };
-}
-
-GMatrix4D operator*(const GMatrix4D & m1, const GMatrix4D & m2)
-{
-    return {
-        m1[0][0] * m2[0][0] + m1[0][1] * m2[1][0] + m1[0][2] * m2[2][0] + m1[0][3] * m2[3][0],
-        m1[0][0] * m2[0][1] + m1[0][1] * m2[1][1] + m1[0][2] * m2[2][1] + m1[0][3] * m2[3][1],
-        m1[0][0] * m2[0][2] + m1[0][1] * m2[1][2] + m1[0][2] * m2[2][2] + m1[0][3] * m2[3][2],
-        m1[0][0] * m2[0][3] + m1[0][1] * m2[1][3] + m1[0][2] * m2[2][3] + m1[0][3] * m2[3][3],
-
-        m1[1][0] * m2[0][0] + m1[1][1] * m2[1][0] + m1[1][2] * m2[2][0] + m1[1][3] * m2[3][0],
-        m1[1][0] * m2[0][1] + m1[1][1] * m2[1][1] + m1[1][2] * m2[2][1] + m1[1][3] * m2[3][1],
-        m1[1][0] * m2[0][2] + m1[1][1] * m2[1][2] + m1[1][2] * m2[2][2] + m1[1][3] * m2[3][2],
-        m1[1][0] * m2[0][3] + m1[1][1] * m2[1][3] + m1[1][2] * m2[2][3] + m1[1][3] * m2[3][3],
-
-        m1[2][0] * m2[0][0] + m1[2][1] * m2[1][0] + m1[2][2] * m2[2][0] + m1[2][3] * m2[3][0],
-        m1[2][0] * m2[0][1] + m1[2][1] * m2[1][1] + m1[2][2] * m2[2][1] + m1[2][3] * m2[3][1],
-        m1[2][0] * m2[0][2] + m1[2][1] * m2[1][2] + m1[2][2] * m2[2][2] + m1[2][3] * m2[3][2],
-        m1[2][0] * m2[0][3] + m1[2][1] * m2[1][3] + m1[2][2] * m2[2][3] + m1[2][3] * m2[3][3],
-
-        m1[3][0] * m2[0][0] + m1[3][1] * m2[1][0] + m1[3][2] * m2[2][0] + m1[3][3] * m2[3][0],
-        m1[3][0] * m2[0][1] + m1[3][1] * m2[1][1] + m1[3][2] * m2[2][1] + m1[3][3] * m2[3][1],
-        m1[3][0] * m2[0][2] + m1[3][1] * m2[1][2] + m1[3][2] * m2[2][2] + m1[3][3] * m2[3][2],
-        m1[3][0] * m2[0][3] + m1[3][1] * m2[1][3] + m1[3][2] * m2[2][3] + m1[3][3] * m2[3][3],
-    };
-}
+template class SGL_API GMatrix4DT<double>;
+template class SGL_API GMatrix4DT<float>;
 
 } //namespace sgl
@@ -0,0 +1,598 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GMatrix4DArray.h"
+#include "GSimd.h"
+#include "GSimdDefs.h"
+
+#include <cstdint>
+
+namespace sgl
+{
+
+namespace
+{
+
+constexpr std::size_t L = GMatrix4DArray::BlockSize;
+constexpr std::size_t S = GMatrix4DArray::BlockStride;
+
+// Kernels work on whole blocks. Element e = 4 * row + column of a block is stored at [e * L, e * L + L).
+// Multiplication operands have block stride S or 0 (the same block, e.g. broadcasted single matrix).
+// Inversion uses 2x2 subdeterminants expansion (see GMatrix4D.cpp) evaluated for one matrix per lane.
+
+GMatrix4D gather(const double * pBlock, std::size_t lane)
+{
+    GMatrix4D m;
+    for (std::size_t e = 0; e < 16; ++e)
+        m.data()[e] = pBlock[e * L + lane];
+    return m;
+}
+
+void scatter(const GMatrix4D & m, double * pBlock, std::size_t lane)
+{
+    for (std::size_t e = 0; e < 16; ++e)
+        pBlock[e * L + lane] = m.data()[e];
+}
+
+void multiplyBlocksScalar(const double * pA, std::size_t strideA, const double * pB, std::size_t strideB,
+                          double * pRes, std::size_t blockCount)
+{
+    double tmp[S];
+    for (std::size_t blk = 0; blk < blockCount; ++blk, pA += strideA, pB += strideB, pRes += S)
+    {
+        for (std::size_t row = 0; row < 4; ++row)
+        {
+            for (std::size_t col = 0; col < 4; ++col)
+            {
+                const double * a = pA + 4 * row * L;
+                const double * b = pB + col * L;
+                double * r = tmp + (4 * row + col) * L;
+                for (std::size_t lane = 0; lane < L; ++lane)
+                {
+                    r[lane] = a[lane] * b[lane] + a[L + lane] * b[4 * L + lane]
+                        + a[2 * L + lane] * b[8 * L + lane] + a[3 * L + lane] * b[12 * L + lane];
+                }
+            }
+        }
+        std::copy(tmp, tmp + S, pRes);
+    }
+}
+
+void determinantBlocksScalar(const double * pSrc, double * pDet, std::size_t blockCount)
+{
+    for (std::size_t blk = 0; blk < blockCount; ++blk, pSrc += S, pDet += L)
+    {
+        for (std::size_t lane = 0; lane < L; ++lane)
+            pDet[lane] = gather(pSrc, lane).determinant();
+    }
+}
+
+void invertBlocksScalar(const double * pSrc, double * pDst, std::uint8_t * pMasks, std::size_t blockCount,
+                        double tolerance)
+{
+    for (std::size_t blk = 0; blk < blockCount; ++blk, pSrc += S, pDst += S)
+    {
+        std::uint8_t mask = 0;
+        for (std::size_t lane = 0; lane < L; ++lane)
+        {
+            GMatrix4D inv;
+            if (gather(pSrc, lane).tryInvert(inv, nullptr, tolerance))
+                mask |= static_cast<std::uint8_t>(1u << lane);
+            scatter(inv, pDst, lane);
+        }
+        pMasks[blk] = mask;
+    }
+}
+
+#if SGL_SIMD_X86
+
+SGL_TARGET_AVX2
+inline __m256d comb3AVX2(__m256d x, __m256d p, __m256d y, __m256d q, __m256d z, __m256d r)
+{
+    // x * p - y * q + z * r
+    return _mm256_fmadd_pd(z, r, _mm256_fmsub_pd(x, p, _mm256_mul_pd(y, q)));
+}
+
+SGL_TARGET_AVX2
+inline __m256d minorsAVX2(const __m256d * a, __m256d * s, __m256d * c)
+{
+    s[0] = _mm256_fmsub_pd(a[0], a[5], _mm256_mul_pd(a[4], a[1]));
+    s[1] = _mm256_fmsub_pd(a[0], a[6], _mm256_mul_pd(a[4], a[2]));
+    s[2] = _mm256_fmsub_pd(a[0], a[7], _mm256_mul_pd(a[4], a[3]));
+    s[3] = _mm256_fmsub_pd(a[1], a[6], _mm256_mul_pd(a[5], a[2]));
+    s[4] = _mm256_fmsub_pd(a[1], a[7], _mm256_mul_pd(a[5], a[3]));
+    s[5] = _mm256_fmsub_pd(a[2], a[7], _mm256_mul_pd(a[6], a[3]));
+
+    c[5] = _mm256_fmsub_pd(a[10], a[15], _mm256_mul_pd(a[14], a[11]));
+    c[4] = _mm256_fmsub_pd(a[9], a[15], _mm256_mul_pd(a[13], a[11]));
+    c[3] = _mm256_fmsub_pd(a[9], a[14], _mm256_mul_pd(a[13], a[10]));
+    c[2] = _mm256_fmsub_pd(a[8], a[15], _mm256_mul_pd(a[12], a[11]));
+    c[1] = _mm256_fmsub_pd(a[8], a[14], _mm256_mul_pd(a[12], a[10]));
+    c[0] = _mm256_fmsub_pd(a[8], a[13], _mm256_mul_pd(a[12], a[9]));
+
+    __m256d det = _mm256_mul_pd(s[0], c[5]);
+    det = _mm256_fnmadd_pd(s[1], c[4], det);
+    det = _mm256_fmadd_pd(s[2], c[3], det);
+    det = _mm256_fmadd_pd(s[3], c[2], det);
+    det = _mm256_fnmadd_pd(s[4], c[1], det);
+    return _mm256_fmadd_pd(s[5], c[0], det);
+}
+
+SGL_TARGET_AVX2
+void multiplyBlocksAVX2(const double * pA, std::size_t strideA, const double * pB, std::size_t strideB,
+                        double * pRes, std::size_t blockCount)
+{
+    for (std::size_t blk = 0; blk < blockCount; ++blk, pA += strideA, pB += strideB, pRes += S)
+    {
+        for (std::size_t half = 0; half < L; half += 4)
+        {
+            __m256d b[16];
+            for (std::size_t e = 0; e < 16; ++e)
+                b[e] = _mm256_load_pd(pB + e * L + half);
+            for (std::size_t row = 0; row < 4; ++row)
+            {
+                const __m256d a0 = _mm256_load_pd(pA + (4 * row) * L + half);
+                const __m256d a1 = _mm256_load_pd(pA + (4 * row + 1) * L + half);
+                const __m256d a2 = _mm256_load_pd(pA + (4 * row + 2) * L + half);
+                const __m256d a3 = _mm256_load_pd(pA + (4 * row + 3) * L + half);
+                for (std::size_t col = 0; col < 4; ++col)
+                {
+                    __m256d r = _mm256_mul_pd(a0, b[col]);
+                    r = _mm256_fmadd_pd(a1, b[4 + col], r);
+                    r = _mm256_fmadd_pd(a2, b[8 + col], r);
+                    r = _mm256_fmadd_pd(a3, b[12 + col], r);
+                    _mm256_store_pd(pRes + (4 * row + col) * L + half, r);
+                }
+            }
+        }
+    }
+}
+
+SGL_TARGET_AVX2
+void determinantBlocksAVX2(const double * pSrc, double * pDet, std::size_t blockCount)
+{
+    for (std::size_t blk = 0; blk < blockCount; ++blk, pSrc += S, pDet += L)
+    {
+        for (std::size_t half = 0; half < L; half += 4)
+        {
+            __m256d a[16], s[6], c[6];
+            for (std::size_t e = 0; e < 16; ++e)
+                a[e] = _mm256_load_pd(pSrc + e * L + half);
+            _mm256_storeu_pd(pDet + half, minorsAVX2(a, s, c));
+        }
+    }
+}
+
+SGL_TARGET_AVX2
+void invertBlocksAVX2(const double * pSrc, double * pDst, std::uint8_t * pMasks, std::size_t blockCount,
+                      double tolerance)
+{
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    const __m256d tol = _mm256_set1_pd(tolerance);
+    for (std::size_t blk = 0; blk < blockCount; ++blk, pSrc += S, pDst += S)
+    {
+        std::uint8_t blockMask = 0;
+        for (std::size_t half = 0; half < L; half += 4)
+        {
+            __m256d a[16], s[6], c[6];
+            for (std::size_t e = 0; e < 16; ++e)
+                a[e] = _mm256_load_pd(pSrc + e * L + half);
+            const __m256d det = minorsAVX2(a, s, c);
+            const __m256d mask = _mm256_cmp_pd(_mm256_andnot_pd(signMask, det), tol, _CMP_GE_OQ);
+            const __m256d pos = _mm256_and_pd(mask, _mm256_div_pd(one, det));
+            const __m256d neg = _mm256_sub_pd(zero, pos);
+
+            __m256d b[16];
+            b[0] = _mm256_mul_pd(comb3AVX2(a[5], c[5], a[6], c[4], a[7], c[3]), pos);
+            b[1] = _mm256_mul_pd(comb3AVX2(a[1], c[5], a[2], c[4], a[3], c[3]), neg);
+            b[2] = _mm256_mul_pd(comb3AVX2(a[13], s[5], a[14], s[4], a[15], s[3]), pos);
+            b[3] = _mm256_mul_pd(comb3AVX2(a[9], s[5], a[10], s[4], a[11], s[3]), neg);
+            b[4] = _mm256_mul_pd(comb3AVX2(a[4], c[5], a[6], c[2], a[7], c[1]), neg);
+            b[5] = _mm256_mul_pd(comb3AVX2(a[0], c[5], a[2], c[2], a[3], c[1]), pos);
+            b[6] = _mm256_mul_pd(comb3AVX2(a[12], s[5], a[14], s[2], a[15], s[1]), neg);
+            b[7] = _mm256_mul_pd(comb3AVX2(a[8], s[5], a[10], s[2], a[11], s[1]), pos);
+            b[8] = _mm256_mul_pd(comb3AVX2(a[4], c[4], a[5], c[2], a[7], c[0]), pos);
+            b[9] = _mm256_mul_pd(comb3AVX2(a[0], c[4], a[1], c[2], a[3], c[0]), neg);
+            b[10] = _mm256_mul_pd(comb3AVX2(a[12], s[4], a[13], s[2], a[15], s[0]), pos);
+            b[11] = _mm256_mul_pd(comb3AVX2(a[8], s[4], a[9], s[2], a[11], s[0]), neg);
+            b[12] = _mm256_mul_pd(comb3AVX2(a[4], c[3], a[5], c[1], a[6], c[0]), neg);
+            b[13] = _mm256_mul_pd(comb3AVX2(a[0], c[3], a[1], c[1], a[2], c[0]), pos);
+            b[14] = _mm256_mul_pd(comb3AVX2(a[12], s[3], a[13], s[1], a[14], s[0]), neg);
+            b[15] = _mm256_mul_pd(comb3AVX2(a[8], s[3], a[9], s[1], a[10], s[0]), pos);
+
+            // singular matrices are replaced by identity
+            for (std::size_t e = 0; e < 16; ++e)
+                _mm256_store_pd(pDst + e * L + half, _mm256_blendv_pd(e % 5 == 0 ? one : zero, b[e], mask));
+            blockMask |= static_cast<std::uint8_t>(_mm256_movemask_pd(mask) << half);
+        }
+        pMasks[blk] = blockMask;
+    }
+}
+
+SGL_TARGET_AVX512
+inline __m512d comb3AVX512(__m512d x, __m512d p, __m512d y, __m512d q, __m512d z, __m512d r)
+{
+    // x * p - y * q + z * r
+    return _mm512_fmadd_pd(z, r, _mm512_fmsub_pd(x, p, _mm512_mul_pd(y, q)));
+}
+
+SGL_TARGET_AVX512
+inline __m512d minorsAVX512(const __m512d * a, __m512d * s, __m512d * c)
+{
+    s[0] = _mm512_fmsub_pd(a[0], a[5], _mm512_mul_pd(a[4], a[1]));
+    s[1] = _mm512_fmsub_pd(a[0], a[6], _mm512_mul_pd(a[4], a[2]));
+    s[2] = _mm512_fmsub_pd(a[0], a[7], _mm512_mul_pd(a[4], a[3]));
+    s[3] = _mm512_fmsub_pd(a[1], a[6], _mm512_mul_pd(a[5], a[2]));
+    s[4] = _mm512_fmsub_pd(a[1], a[7], _mm512_mul_pd(a[5], a[3]));
+    s[5] = _mm512_fmsub_pd(a[2], a[7], _mm512_mul_pd(a[6], a[3]));
+
+    c[5] = _mm512_fmsub_pd(a[10], a[15], _mm512_mul_pd(a[14], a[11]));
+    c[4] = _mm512_fmsub_pd(a[9], a[15], _mm512_mul_pd(a[13], a[11]));
+    c[3] = _mm512_fmsub_pd(a[9], a[14], _mm512_mul_pd(a[13], a[10]));
+    c[2] = _mm512_fmsub_pd(a[8], a[15], _mm512_mul_pd(a[12], a[11]));
+    c[1] = _mm512_fmsub_pd(a[8], a[14], _mm512_mul_pd(a[12], a[10]));
+    c[0] = _mm512_fmsub_pd(a[8], a[13], _mm512_mul_pd(a[12], a[9]));
+
+    __m512d det = _mm512_mul_pd(s[0], c[5]);
+    det = _mm512_fnmadd_pd(s[1], c[4], det);
+    det = _mm512_fmadd_pd(s[2], c[3], det);
+    det = _mm512_fmadd_pd(s[3], c[2], det);
+    det = _mm512_fnmadd_pd(s[4], c[1], det);
+    return _mm512_fmadd_pd(s[5], c[0], det);
+}
+
+SGL_TARGET_AVX512
+void multiplyBlocksAVX512(const double * pA, std::size_t strideA, const double * pB, std::size_t strideB,
+                          double * pRes, std::size_t blockCount)
+{
+    for (std::size_t blk = 0; blk < blockCount; ++blk, pA += strideA, pB += strideB, pRes += S)
+    {
+        __m512d b[16];
+        for (std::size_t e = 0; e < 16; ++e)
+            b[e] = _mm512_load_pd(pB + e * L);
+        for (std::size_t row = 0; row < 4; ++row)
+        {
+            const __m512d a0 = _mm512_load_pd(pA + (4 * row) * L);
+            const __m512d a1 = _mm512_load_pd(pA + (4 * row + 1) * L);
+            const __m512d a2 = _mm512_load_pd(pA + (4 * row + 2) * L);
+            const __m512d a3 = _mm512_load_pd(pA + (4 * row + 3) * L);
+            for (std::size_t col = 0; col < 4; ++col)
+            {
+                __m512d r = _mm512_mul_pd(a0, b[col]);
+                r = _mm512_fmadd_pd(a1, b[4 + col], r);
+                r = _mm512_fmadd_pd(a2, b[8 + col], r);
+                r = _mm512_fmadd_pd(a3, b[12 + col], r);
+                _mm512_store_pd(pRes + (4 * row + col) * L, r);
+            }
+        }
+    }
+}
+
+SGL_TARGET_AVX512
+void determinantBlocksAVX512(const double * pSrc, double * pDet, std::size_t blockCount)
+{
+    for (std::size_t blk = 0; blk < blockCount; ++blk, pSrc += S, pDet += L)
+    {
+        __m512d a[16], s[6], c[6];
+        for (std::size_t e = 0; e < 16; ++e)
+            a[e] = _mm512_load_pd(pSrc + e * L);
+        _mm512_storeu_pd(pDet, minorsAVX512(a, s, c));
+    }
+}
+
+SGL_TARGET_AVX512
+void invertBlocksAVX512(const double * pSrc, double * pDst, std::uint8_t * pMasks, std::size_t blockCount,
+                        double tolerance)
+{
+    const __m512d one = _mm512_set1_pd(1.0);
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d tol = _mm512_set1_pd(tolerance);
+    for (std::size_t blk = 0; blk < blockCount; ++blk, pSrc += S, pDst += S)
+    {
+        __m512d a[16], s[6], c[6];
+        for (std::size_t e = 0; e < 16; ++e)
+            a[e] = _mm512_load_pd(pSrc + e * L);
+        const __m512d det = minorsAVX512(a, s, c);
+        const __mmask8 mask = _mm512_cmp_pd_mask(_mm512_abs_pd(det), tol, _CMP_GE_OQ);
+        const __m512d pos = _mm512_maskz_div_pd(mask, one, det);
+        const __m512d neg = _mm512_sub_pd(zero, pos);
+
+        __m512d b[16];
+        b[0] = _mm512_mul_pd(comb3AVX512(a[5], c[5], a[6], c[4], a[7], c[3]), pos);
+        b[1] = _mm512_mul_pd(comb3AVX512(a[1], c[5], a[2], c[4], a[3], c[3]), neg);
+        b[2] = _mm512_mul_pd(comb3AVX512(a[13], s[5], a[14], s[4], a[15], s[3]), pos);
+        b[3] = _mm512_mul_pd(comb3AVX512(a[9], s[5], a[10], s[4], a[11], s[3]), neg);
+        b[4] = _mm512_mul_pd(comb3AVX512(a[4], c[5], a[6], c[2], a[7], c[1]), neg);
+        b[5] = _mm512_mul_pd(comb3AVX512(a[0], c[5], a[2], c[2], a[3], c[1]), pos);
+        b[6] = _mm512_mul_pd(comb3AVX512(a[12], s[5], a[14], s[2], a[15], s[1]), neg);
+        b[7] = _mm512_mul_pd(comb3AVX512(a[8], s[5], a[10], s[2], a[11], s[1]), pos);
+        b[8] = _mm512_mul_pd(comb3AVX512(a[4], c[4], a[5], c[2], a[7], c[0]), pos);
+        b[9] = _mm512_mul_pd(comb3AVX512(a[0], c[4], a[1], c[2], a[3], c[0]), neg);
+        b[10] = _mm512_mul_pd(comb3AVX512(a[12], s[4], a[13], s[2], a[15], s[0]), pos);
+        b[11] = _mm512_mul_pd(comb3AVX512(a[8], s[4], a[9], s[2], a[11], s[0]), neg);
+        b[12] = _mm512_mul_pd(comb3AVX512(a[4], c[3], a[5], c[1], a[6], c[0]), neg);
+        b[13] = _mm512_mul_pd(comb3AVX512(a[0], c[3], a[1], c[1], a[2], c[0]), pos);
+        b[14] = _mm512_mul_pd(comb3AVX512(a[12], s[3], a[13], s[1], a[14], s[0]), neg);
+        b[15] = _mm512_mul_pd(comb3AVX512(a[8], s[3], a[9], s[1], a[10], s[0]), pos);
+
+        // singular matrices are replaced by identity
+        for (std::size_t e = 0; e < 16; ++e)
+            _mm512_store_pd(pDst + e * L, _mm512_mask_blend_pd(mask, e % 5 == 0 ? one : zero, b[e]));
+        pMasks[blk] = static_cast<std::uint8_t>(mask);
+    }
+}
+
+#endif //SGL_SIMD_X86
+
+void multiplyBlocks(const double * pA, std::size_t strideA, const double * pB, std::size_t strideB,
+                    double * pRes, std::size_t blockCount)
+{
+    switch (simdLevel())
+    {
+#if SGL_SIMD_X86
+        case GSimdLevel::AVX512: return multiplyBlocksAVX512(pA, strideA, pB, strideB, pRes, blockCount);
+        case GSimdLevel::AVX2: return multiplyBlocksAVX2(pA, strideA, pB, strideB, pRes, blockCount);
+#endif
+        default: return multiplyBlocksScalar(pA, strideA, pB, strideB, pRes, blockCount);
+    }
+}
+
+void determinantBlocks(const double * pSrc, double * pDet, std::size_t blockCount)
+{
+    switch (simdLevel())
+    {
+#if SGL_SIMD_X86
+        case GSimdLevel::AVX512: return determinantBlocksAVX512(pSrc, pDet, blockCount);
+        case GSimdLevel::AVX2: return determinantBlocksAVX2(pSrc, pDet, blockCount);
+#endif
+        default: return determinantBlocksScalar(pSrc, pDet, blockCount);
+    }
+}
+
+void invertBlocks(const double * pSrc, double * pDst, std::uint8_t * pMasks, std::size_t blockCount,
+                  double tolerance)
+{
+    switch (simdLevel())
+    {
+#if SGL_SIMD_X86
+        case GSimdLevel::AVX512: return invertBlocksAVX512(pSrc, pDst, pMasks, blockCount, tolerance);
+        case GSimdLevel::AVX2: return invertBlocksAVX2(pSrc, pDst, pMasks, blockCount, tolerance);
+#endif
+        default: return invertBlocksScalar(pSrc, pDst, pMasks, blockCount, tolerance);
+    }
+}
+
+// Single matrix broadcasted to all lanes of a block
+struct BroadcastBlock
+{
+    explicit BroadcastBlock(const GMatrix4D & m)
+    {
+        for (std::size_t e = 0; e < 16; ++e)
+            std::fill(data + e * L, data + e * L + L, m.data()[e]);
+    }
+
+    alignas(G_SIMD_ALIGNMENT) double data[S];
+};
+
+} //namespace
+
+GMatrix4DArray::GMatrix4DArray() = default;
+
+GMatrix4DArray::GMatrix4DArray(std::size_t size)
+{
+    resize(size);
+}
+
+GMatrix4DArray::GMatrix4DArray(const std::vector<GMatrix4D> & matrices)
+{
+    assign(matrices);
+}
+
+GMatrix4DArray::GMatrix4DArray(const GMatrix4DArray &) = default;
+
+GMatrix4DArray::GMatrix4DArray(GMatrix4DArray && m) noexcept
+    : m_data(std::move(m.m_data))
+    , m_size(m.m_size)
+{
+    m.m_size = 0;
+}
+
+GMatrix4DArray::~GMatrix4DArray() = default;
+
+GMatrix4DArray & GMatrix4DArray::operator=(const GMatrix4DArray &) = default;
+
+GMatrix4DArray & GMatrix4DArray::operator=(GMatrix4DArray && m) noexcept
+{
+    m_data = std::move(m.m_data);
+    m_size = m.m_size;
+    m.m_size = 0;
+    return *this;
+}
+
+void GMatrix4DArray::resize(std::size_t size)
+{
+    const std::size_t oldBlockCount = blockCount();
+    const std::size_t newBlockCount = (size + BlockSize - 1) / BlockSize;
+
+    // keep unused matrices of the last block identity
+    for (std::size_t idx = size; idx < std::min(m_size, newBlockCount * BlockSize); ++idx)
+        setMatrix(idx, GMatrix4D::identity());
+
+    m_data.resize(newBlockCount * BlockStride, 0.0);
+    for (std::size_t blk = oldBlockCount; blk < newBlockCount; ++blk)
+    {
+        for (std::size_t e = 0; e < 16; e += 5)
+            std::fill_n(m_data.data() + blk * BlockStride + e * BlockSize, BlockSize, 1.0);
+    }
+    m_size = size;
+}
+
+void GMatrix4DArray::reserve(std::size_t capacity)
+{
+    m_data.reserve((capacity + BlockSize - 1) / BlockSize * BlockStride);
+}
+
+void GMatrix4DArray::clear()
+{
+    m_data.clear();
+    m_size = 0;
+}
+
+void GMatrix4DArray::push_back(const GMatrix4D & m)
+{
+    resize(m_size + 1);
+    setMatrix(m_size - 1, m);
+}
+
+void GMatrix4DArray::assign(const std::vector<GMatrix4D> & matrices)
+{
+    clear();
+    resize(matrices.size());
+    for (std::size_t idx = 0; idx < matrices.size(); ++idx)
+        setMatrix(idx, matrices[idx]);
+}
+
+std::vector<GMatrix4D> GMatrix4DArray::toArray() const
+{
+    std::vector<GMatrix4D> res(m_size);
+    for (std::size_t idx = 0; idx < m_size; ++idx)
+        res[idx] = matrix(idx);
+    return res;
+}
+
+GMatrix4D GMatrix4DArray::matrix(std::size_t index) const
+{
+    return gather(m_data.data() + offset(index, 0, 0), 0);
+}
+
+void GMatrix4DArray::setMatrix(std::size_t index, const GMatrix4D & m)
+{
+    scatter(m, m_data.data() + offset(index, 0, 0), 0);
+}
+
+GMatrix4DArray & GMatrix4DArray::postMultiplyBy(const GMatrix4D & m)
+{
+    const BroadcastBlock block(m);
+    multiplyBlocks(m_data.data(), BlockStride, block.data, 0, m_data.data(), blockCount());
+    return *this;
+}
+
+GMatrix4DArray & GMatrix4DArray::preMultiplyBy(const GMatrix4D & m)
+{
+    const BroadcastBlock block(m);
+    multiplyBlocks(block.data, 0, m_data.data(), BlockStride, m_data.data(), blockCount());
+    return *this;
+}
+
+GMatrix4DArray & GMatrix4DArray::postMultiplyBy(const GMatrix4DArray & m)
+{
+    return product(*this, m);
+}
+
+GMatrix4DArray & GMatrix4DArray::preMultiplyBy(const GMatrix4DArray & m)
+{
+    return product(m, *this);
+}
+
+GMatrix4DArray & GMatrix4DArray::product(const GMatrix4DArray & m1, const GMatrix4DArray & m2)
+{
+    if (m1.size() != m2.size())
+        throw std::invalid_argument("GMatrix4DArray: arrays have different sizes");
+    if (this != &m1 && this != &m2)
+        resize(m1.size());
+    multiplyBlocks(m1.data(), BlockStride, m2.data(), BlockStride, m_data.data(), blockCount());
+    return *this;
+}
+
+GMatrix4DArray GMatrix4DArray::transpose() const
+{
+    // transposition only permutes element rows of blocks
+    GMatrix4DArray res;
+    res.m_data.resize(m_data.size());
+    res.m_size = m_size;
+    for (std::size_t blk = 0; blk < blockCount(); ++blk)
+    {
+        const double * pSrc = m_data.data() + blk * BlockStride;
+        double * pDst = res.m_data.data() + blk * BlockStride;
+        for (std::size_t row = 0; row < 4; ++row)
+        {
+            for (std::size_t col = 0; col < 4; ++col)
+                std::copy_n(pSrc + (4 * col + row) * BlockSize, BlockSize, pDst + (4 * row + col) * BlockSize);
+        }
+    }
+    return res;
+}
+
+GMatrix4DArray & GMatrix4DArray::invert()
+{
+    return *this = inverse();
+}
+
+GMatrix4DArray GMatrix4DArray::inverse() const
+{
+    GMatrix4DArray res;
+    if (!tryInvert(res))
+        throw std::logic_error("Matrix with zero determinant cannot be inverted");
+    return res;
+}
+
+bool GMatrix4DArray::tryInvert(GMatrix4DArray & inverse, bool * pInverted /*= nullptr*/,
+                               double tolerance /*= GTolerance::zeroTol()*/) const
+{
+    inverse.m_data.resize(m_data.size());
+    inverse.m_size = m_size;
+
+    std::vector<std::uint8_t> masks(blockCount());
+    invertBlocks(m_data.data(), inverse.m_data.data(), masks.data(), blockCount(), tolerance);
+
+    bool res = true;
+    for (std::size_t idx = 0; idx < m_size; ++idx)
+    {
+        const bool inverted = (masks[idx / BlockSize] >> (idx % BlockSize)) & 1u;
+        if (pInverted)
+            pInverted[idx] = inverted;
+        res = res && inverted;
+    }
+    return res;
+}
+
+void GMatrix4DArray::determinants(double * pDeterminants) const
+{
+    const std::size_t fullBlockCount = m_size / BlockSize;
+    determinantBlocks(m_data.data(), pDeterminants, fullBlockCount);
+
+    const std::size_t tail = m_size - fullBlockCount * BlockSize;
+    if (tail > 0)
+    {
+        double det[BlockSize];
+        determinantBlocks(m_data.data() + fullBlockCount * BlockStride, det, 1);
+        std::copy_n(det, tail, pDeterminants + fullBlockCount * BlockSize);
+    }
+}
+
+std::vector<double> GMatrix4DArray::determinants() const
+{
+    std::vector<double> res(m_size);
+    determinants(res.data());
+    return res;
+}
+
+} //namespace sgl
@@ -0,0 +1,374 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GNormalEstimation.h"
+#include "GEigen.h"
+#include "GKDTree.h"
+#include "GParallel.h"
+#include "GPoint3D.h"
+#include "GPointCloud.h"
+#include "GVector3D.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace sgl
+{
+
+namespace
+{
+
+// Points processed by one task of parallelFor
+constexpr std::size_t MIN_CHUNK = 1024;
+
+// Eigenvalue gap (relative to the largest eigenvalue) below which the smallest eigenvalue is not simple
+constexpr double EIGEN_GAP = 1e-6;
+
+// Normal coordinates: stride 3 for array of vectors, stride 1 for coordinate arrays
+struct NormalCoords
+{
+    double * pX;
+    double * pY;
+    double * pZ;
+    std::size_t stride;
+
+    double & x(std::size_t idx) const { return pX[idx * stride]; }
+    double & y(std::size_t idx) const { return pY[idx * stride]; }
+    double & z(std::size_t idx) const { return pZ[idx * stride]; }
+
+    void set(std::size_t idx, double nx, double ny, double nz) const
+    {
+        x(idx) = nx;
+        y(idx) = ny;
+        z(idx) = nz;
+    }
+
+    bool isZero(std::size_t idx) const
+    {
+        return x(idx) == 0.0 && y(idx) == 0.0 && z(idx) == 0.0;
+    }
+
+    void flip(std::size_t idx) const
+    {
+        set(idx, -x(idx), -y(idx), -z(idx));
+    }
+
+    double dot(std::size_t idx1, std::size_t idx2) const
+    {
+        return x(idx1) * x(idx2) + y(idx1) * y(idx2) + z(idx1) * z(idx2);
+    }
+};
+
+NormalCoords vectorCoords(GVector3DArray & normals)
+{
+    double * pData = normals.empty() ? nullptr : normals.data()->data();
+    return NormalCoords{ pData, pData + 1, pData + 2, 3 };
+}
+
+// Computes unit eigenvector of the smallest eigenvalue of symmetric matrix a.
+// Returns false if the smallest eigenvalue is not simple
+bool smallestEigenvector(const double a[3][3], double * pN)
+{
+    double values[3];
+    double vectors[3][3];
+    symmetricEigen(a, values, vectors);
+    if (!std::isfinite(values[0]) || values[1] - values[2] <= EIGEN_GAP * values[0])
+        return false;
+
+    std::copy(vectors[2], vectors[2] + 3, pN);
+    return true;
+}
+
+// Points of tree in the build sequence, so that neighbours are read by index without bounds checks
+GPoint3DArray treePoints(const GKDTree & tree)
+{
+    const double * pCoords = tree.coords().data();
+    const std::size_t * pIndices = tree.indices().data();
+    GPoint3DArray points(tree.size());
+    for (std::size_t pos = 0; pos < tree.size(); ++pos)
+        points[pIndices[pos]] = GPoint3D(pCoords[3 * pos], pCoords[3 * pos + 1], pCoords[3 * pos + 2]);
+    return points;
+}
+
+// Computes normal of neighbourhood by principal component analysis, returns false if normal is undefined
+bool neighbourhoodNormal(const GPoint3D * pPoints, const std::size_t * pIndices, std::size_t count, double * pN)
+{
+    if (count < 3)
+        return false;
+
+    double cx = 0.0;
+    double cy = 0.0;
+    double cz = 0.0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const GPoint3D & pt = pPoints[pIndices[i]];
+        cx += pt.x();
+        cy += pt.y();
+        cz += pt.z();
+    }
+    cx /= static_cast<double>(count);
+    cy /= static_cast<double>(count);
+    cz /= static_cast<double>(count);
+
+    double a[3][3] = {};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const GPoint3D & pt = pPoints[pIndices[i]];
+        const double dx = pt.x() - cx;
+        const double dy = pt.y() - cy;
+        const double dz = pt.z() - cz;
+        a[0][0] += dx * dx;
+        a[0][1] += dx * dy;
+        a[0][2] += dx * dz;
+        a[1][1] += dy * dy;
+        a[1][2] += dy * dz;
+        a[2][2] += dz * dz;
+    }
+    return smallestEigenvector(a, pN);
+}
+
+// Estimates normals of all points of tree in parallel. Capacity is size of neighbour buffers,
+// neighbours is function (point, pIndices, pDistances) returning number of neighbours
+template<typename Neighbours>
+std::size_t estimate(const GKDTree & tree, const NormalCoords & out, std::size_t capacity, unsigned threadCount,
+                     Neighbours neighbours)
+{
+    const GPoint3DArray points = treePoints(tree);
+    std::atomic<std::size_t> defined(0);
+    parallelFor(tree.size(), threadCount, MIN_CHUNK, [&](std::size_t begin, std::size_t end)
+    {
+        std::vector<std::size_t> indices(capacity);
+        std::vector<double> distances(capacity);
+        std::size_t count = 0;
+        for (std::size_t idx = begin; idx < end; ++idx)
+        {
+            const std::size_t found = neighbours(points[idx], indices.data(), distances.data());
+            double n[3] = { 0.0, 0.0, 0.0 };
+            if (neighbourhoodNormal(points.data(), indices.data(), found, n))
+                ++count;
+            out.set(idx, n[0], n[1], n[2]);
+        }
+        defined += count;
+    });
+    return defined;
+}
+
+std::size_t estimateKnn(const GKDTree & tree, std::size_t k, const NormalCoords & out, unsigned threadCount)
+{
+    if (k < 3)
+        throw std::invalid_argument("estimateNormals: at least 3 neighbours are required");
+    return estimate(tree, out, k, threadCount, [&tree, k](const GPoint3D & pt, std::size_t * pIndices,
+                                                          double * pDistances)
+    {
+        return tree.knn(pt, k, pIndices, pDistances);
+    });
+}
+
+std::size_t estimateRadius(const GKDTree & tree, double radius, std::size_t maxNeighbours, const NormalCoords & out,
+                           unsigned threadCount)
+{
+    if (maxNeighbours < 3)
+        throw std::invalid_argument("estimateNormalsInRadius: at least 3 neighbours are required");
+    if (!(radius >= 0.0))
+        throw std::invalid_argument("estimateNormalsInRadius: radius must be non-negative");
+    return estimate(tree, out, maxNeighbours, threadCount,
+                    [&tree, radius, maxNeighbours](const GPoint3D & pt, std::size_t * pIndices, double * pDistances)
+    {
+        const std::size_t found = tree.radius(pt, radius, pIndices, maxNeighbours);
+        // Ball holds more than maxNeighbours points, so the nearest ones are all inside it
+        return found > maxNeighbours ? tree.knn(pt, maxNeighbours, pIndices, pDistances) : found;
+    });
+}
+
+void orientToViewpoint(const GKDTree & tree, const GPoint3D & viewpoint, const NormalCoords & normals,
+                       unsigned threadCount)
+{
+    // Points are visited in tree order, normals by index in the build sequence
+    const double * pCoords = tree.coords().data();
+    const std::size_t * pIndices = tree.indices().data();
+    parallelFor(tree.size(), threadCount, MIN_CHUNK, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t pos = begin; pos < end; ++pos)
+        {
+            const double * pt = pCoords + 3 * pos;
+            const std::size_t idx = pIndices[pos];
+            const double dot = normals.x(idx) * (viewpoint.x() - pt[0]) + normals.y(idx) * (viewpoint.y() - pt[1]) +
+                               normals.z(idx) * (viewpoint.z() - pt[2]);
+            if (dot < 0.0)
+                normals.flip(idx);
+        }
+    });
+}
+
+void propagateOrientation(const GKDTree & tree, std::size_t k, const NormalCoords & normals, unsigned threadCount)
+{
+    const std::size_t count = tree.size();
+    if (count == 0 || k == 0)
+        return;
+
+    // Graph of k nearest neighbours, the first neighbour of point is usually the point itself
+    const GPoint3DArray points = treePoints(tree);
+    const std::size_t width = k + 1;
+    std::vector<std::size_t> knn(count * width);
+    tree.knn(points.data(), count, width, knn.data(), nullptr, threadCount);
+
+    // Symmetric adjacency in compressed rows
+    std::vector<std::size_t> offsets(count + 1, 0);
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        for (std::size_t j = 0; j < width; ++j)
+        {
+            const std::size_t nb = knn[idx * width + j];
+            if (nb != GKDTree::npos && nb != idx)
+            {
+                ++offsets[idx + 1];
+                ++offsets[nb + 1];
+            }
+        }
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<std::size_t> adjacency(offsets.back());
+    std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        for (std::size_t j = 0; j < width; ++j)
+        {
+            const std::size_t nb = knn[idx * width + j];
+            if (nb != GKDTree::npos && nb != idx)
+            {
+                adjacency[fill[idx]++] = nb;
+                adjacency[fill[nb]++] = idx;
+            }
+        }
+    }
+    knn = std::vector<std::size_t>();
+
+    // Seeds in order of decreasing height
+    std::vector<std::size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&points](std::size_t i1, std::size_t i2)
+    {
+        return points[i1].z() > points[i2].z();
+    });
+
+    // Undefined normals never join the spanning tree
+    std::vector<char> visited(count);
+    for (std::size_t idx = 0; idx < count; ++idx)
+        visited[idx] = normals.isZero(idx) ? 1 : 0;
+
+    // Edges (weight, point, parent), Prim's algorithm takes the lightest edge first
+    using Edge = std::tuple<double, std::size_t, std::size_t>;
+    std::priority_queue<Edge, std::vector<Edge>, std::greater<Edge>> queue;
+    for (std::size_t seed : order)
+    {
+        if (visited[seed])
+            continue;
+        if (normals.z(seed) < 0.0)
+            normals.flip(seed);
+        queue.emplace(0.0, seed, seed);
+        while (!queue.empty())
+        {
+            const std::size_t idx = std::get<1>(queue.top());
+            const std::size_t parent = std::get<2>(queue.top());
+            queue.pop();
+            if (visited[idx])
+                continue;
+            visited[idx] = 1;
+            if (normals.dot(idx, parent) < 0.0)
+                normals.flip(idx);
+            for (std::size_t pos = offsets[idx]; pos < offsets[idx + 1]; ++pos)
+            {
+                const std::size_t nb = adjacency[pos];
+                if (!visited[nb])
+                    queue.emplace(1.0 - std::fabs(normals.dot(idx, nb)), nb, idx);
+            }
+        }
+    }
+}
+
+} //namespace
+
+std::size_t estimateNormals(const GKDTree & tree, std::size_t k, GVector3DArray & normals,
+                            unsigned threadCount /*= 0*/)
+{
+    normals.resize(tree.size());
+    return estimateKnn(tree, k, vectorCoords(normals), threadCount);
+}
+
+std::size_t estimateNormals(const GKDTree & tree, std::size_t k, double * pX, double * pY, double * pZ,
+                            unsigned threadCount /*= 0*/)
+{
+    return estimateKnn(tree, k, NormalCoords{ pX, pY, pZ, 1 }, threadCount);
+}
+
+std::size_t estimateNormals(GPointCloud & cloud, std::size_t k, unsigned threadCount /*= 0*/)
+{
+    const GKDTree tree(cloud, threadCount);
+    if (!cloud.hasNormals())
+        cloud.enableNormals();
+    return estimateNormals(tree, k, cloud.normalData(0), cloud.normalData(1), cloud.normalData(2), threadCount);
+}
+
+std::size_t estimateNormalsInRadius(const GKDTree & tree, double radius, std::size_t maxNeighbours,
+                                    GVector3DArray & normals, unsigned threadCount /*= 0*/)
+{
+    normals.resize(tree.size());
+    return estimateRadius(tree, radius, maxNeighbours, vectorCoords(normals), threadCount);
+}
+
+std::size_t estimateNormalsInRadius(const GKDTree & tree, double radius, std::size_t maxNeighbours,
+                                    double * pX, double * pY, double * pZ, unsigned threadCount /*= 0*/)
+{
+    return estimateRadius(tree, radius, maxNeighbours, NormalCoords{ pX, pY, pZ, 1 }, threadCount);
+}
+
+void orientNormals(const GKDTree & tree, const GPoint3D & viewpoint, GVector3DArray & normals,
+                   unsigned threadCount /*= 0*/)
+{
+    if (normals.size() != tree.size())
+        throw std::invalid_argument("orientNormals: number of normals differs from number of points");
+    orientToViewpoint(tree, viewpoint, vectorCoords(normals), threadCount);
+}
+
+void orientNormals(const GKDTree & tree, const GPoint3D & viewpoint, double * pX, double * pY, double * pZ,
+                   unsigned threadCount /*= 0*/)
+{
+    orientToViewpoint(tree, viewpoint, NormalCoords{ pX, pY, pZ, 1 }, threadCount);
+}
+
+void orientNormals(const GKDTree & tree, std::size_t k, GVector3DArray & normals, unsigned threadCount /*= 0*/)
+{
+    if (normals.size() != tree.size())
+        throw std::invalid_argument("orientNormals: number of normals differs from number of points");
+    propagateOrientation(tree, k, vectorCoords(normals), threadCount);
+}
+
+void orientNormals(const GKDTree & tree, std::size_t k, double * pX, double * pY, double * pZ,
+                   unsigned threadCount /*= 0*/)
+{
+    propagateOrientation(tree, k, NormalCoords{ pX, pY, pZ, 1 }, threadCount);
+}
+
+} //namespace sgl
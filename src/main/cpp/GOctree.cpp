@@ -0,0 +1,445 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GOctree.h"
+#include "GParallel.h"
+#include "GPointCloud.h"
+
+#include <bitset>
+#include <functional>
+#include <numeric>
+
+namespace sgl
+{
+
+namespace
+{
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+constexpr std::uint32_t CELL_COUNT = 1u << GOctree::MAX_DEPTH;
+// Minimal number of points or nodes per thread
+constexpr std::size_t PARALLEL_CHUNK = 4096;
+
+// Spreads 21 low bits so that there are two zero bits between neighbours
+std::uint64_t spreadBits(std::uint64_t value)
+{
+    value &= 0x1FFFFF;
+    value = (value | value << 32) & 0x1F00000000FFFFull;
+    value = (value | value << 16) & 0x1F0000FF0000FFull;
+    value = (value | value << 8) & 0x100F00F00F00F00Full;
+    value = (value | value << 4) & 0x10C30C30C30C30C3ull;
+    value = (value | value << 2) & 0x1249249249249249ull;
+    return value;
+}
+
+// Inverse of spreadBits
+std::uint64_t compactBits(std::uint64_t value)
+{
+    value &= 0x1249249249249249ull;
+    value = (value | value >> 2) & 0x10C30C30C30C30C3ull;
+    value = (value | value >> 4) & 0x100F00F00F00F00Full;
+    value = (value | value >> 8) & 0x1F0000FF0000FFull;
+    value = (value | value >> 16) & 0x1F00000000FFFFull;
+    value = (value | value >> 32) & 0x1FFFFF;
+    return value;
+}
+
+std::size_t childCount(std::uint8_t mask)
+{
+    return std::bitset<8>(mask).count();
+}
+
+// Depth of locational code, npos for invalid code
+std::size_t keyDepth(std::uint64_t key)
+{
+    if (key == 0)
+        return GOctree::npos;
+    std::size_t bits = 0;
+    while (key >>= 1)
+        ++bits;
+    return bits % 3 == 0 && bits / 3 <= GOctree::MAX_DEPTH ? bits / 3 : GOctree::npos;
+}
+
+struct KeyIndex
+{
+    std::uint64_t key;
+    std::uint32_t index;
+
+    bool operator<(const KeyIndex & other) const
+    {
+        return key < other.key || (key == other.key && index < other.index);
+    }
+};
+
+} //namespace
+
+GOctree::GOctree() = default;
+
+GOctree::GOctree(const GPoint3D * pPoints, std::size_t count, std::size_t leafCapacity /*= 32*/,
+                 std::size_t maxDepth /*= MAX_DEPTH*/, unsigned threadCount /*= 0*/)
+{
+    const double * pData = count != 0 ? pPoints->data() : nullptr;
+    const double * coords[3] = { pData, pData ? pData + 1 : nullptr, pData ? pData + 2 : nullptr };
+    build(coords, 3, count, leafCapacity, maxDepth, threadCount);
+}
+
+GOctree::GOctree(const GPoint3DArray & points, std::size_t leafCapacity /*= 32*/,
+                 std::size_t maxDepth /*= MAX_DEPTH*/, unsigned threadCount /*= 0*/)
+    : GOctree(points.data(), points.size(), leafCapacity, maxDepth, threadCount)
+{
+}
+
+GOctree::GOctree(const GPointCloud & cloud, std::size_t leafCapacity /*= 32*/, std::size_t maxDepth /*= MAX_DEPTH*/,
+                 unsigned threadCount /*= 0*/)
+{
+    const double * coords[3] = { cloud.xData(), cloud.yData(), cloud.zData() };
+    build(coords, 1, cloud.size(), leafCapacity, maxDepth, threadCount);
+}
+
+void GOctree::build(const double * const * pCoords, std::size_t stride, std::size_t count, std::size_t leafCapacity,
+                    std::size_t maxDepth, unsigned threadCount)
+{
+    if (leafCapacity == 0)
+        throw std::invalid_argument("GOctree: leaf capacity must be positive");
+    if (maxDepth > MAX_DEPTH)
+        throw std::invalid_argument("GOctree: maximal depth exceeds GOctree::MAX_DEPTH");
+    if (count > 0xFFFFFFFFu)
+        throw std::length_error("GOctree: too many points");
+    if (count == 0)
+        return;
+
+    // Bounding cube
+    double lo[3] = { INF, INF, INF };
+    double hi[3] = { -INF, -INF, -INF };
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            lo[axis] = std::min(lo[axis], pCoords[axis][idx * stride]);
+            hi[axis] = std::max(hi[axis], pCoords[axis][idx * stride]);
+        }
+    }
+    m_size = std::max({ hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2] });
+    if (!(m_size > 0.0))
+        m_size = 1.0;
+    std::copy_n(lo, 3, m_origin);
+
+    // Points sorted by Morton codes of the finest cells
+    std::vector<KeyIndex> keys(count);
+    parallelFor(count, threadCount, PARALLEL_CHUNK, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t idx = begin; idx < end; ++idx)
+        {
+            const double coord[3] = { pCoords[0][idx * stride], pCoords[1][idx * stride], pCoords[2][idx * stride] };
+            keys[idx] = { pointKey(coord), static_cast<std::uint32_t>(idx) };
+        }
+    });
+    parallelSort(keys.begin(), keys.end(), threadCount, PARALLEL_CHUNK, std::less<KeyIndex>());
+
+    m_indices.resize(count);
+    m_coords.resize(3 * count);
+    for (std::size_t pos = 0; pos < count; ++pos)
+    {
+        m_indices[pos] = keys[pos].index;
+        for (std::size_t axis = 0; axis < 3; ++axis)
+            m_coords[3 * pos + axis] = pCoords[axis][keys[pos].index * stride];
+    }
+
+    // Topology, level by level: children split sorted range of parent by octant bits.
+    // Nodes of level are split in parallel, children are counted first so that every node
+    // knows where its children go and the level stays sorted by key
+    m_nodes.push_back({ 1, 0, static_cast<std::uint32_t>(count), 0, 0, 0, GPoint3D(), GBox3D() });
+    m_levels = { 0, 1 };
+    std::vector<std::uint32_t> offsets;
+    for (std::size_t depth = 0; depth < maxDepth; ++depth)
+    {
+        const std::size_t shift = 3 * (MAX_DEPTH - depth - 1);
+        const std::size_t levelBegin = m_levels[depth];
+        const std::size_t levelSize = m_levels[depth + 1] - levelBegin;
+        // Calls visit(octant, begin, end) for every non-empty octant of node
+        auto split = [&](const GOctreeNode & node, auto && visit)
+        {
+            auto pos = keys.begin() + node.begin;
+            const auto end = pos + node.count;
+            while (pos != end)
+            {
+                const std::uint64_t octant = (pos->key >> shift) & 7;
+                const auto childEnd = std::partition_point(pos, end, [shift, octant](const KeyIndex & value)
+                {
+                    return ((value.key >> shift) & 7) <= octant;
+                });
+                visit(octant, pos - keys.begin(), childEnd - keys.begin());
+                pos = childEnd;
+            }
+        };
+
+        offsets.assign(levelSize + 1, 0);
+        parallelFor(levelSize, threadCount, PARALLEL_CHUNK / 8, [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t idx = begin; idx < end; ++idx)
+            {
+                GOctreeNode & node = m_nodes[levelBegin + idx];
+                if (node.count <= leafCapacity)
+                    continue;
+                split(node, [&node](std::uint64_t octant, std::ptrdiff_t, std::ptrdiff_t)
+                {
+                    node.childMask |= static_cast<std::uint8_t>(1u << octant);
+                });
+                offsets[idx + 1] = static_cast<std::uint32_t>(childCount(node.childMask));
+            }
+        });
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        if (offsets.back() == 0)
+            break;
+
+        const std::size_t levelEnd = m_nodes.size();
+        m_nodes.resize(levelEnd + offsets.back());
+        parallelFor(levelSize, threadCount, PARALLEL_CHUNK / 8, [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t idx = begin; idx < end; ++idx)
+            {
+                GOctreeNode & node = m_nodes[levelBegin + idx];
+                if (node.isLeaf())
+                    continue;
+                node.firstChild = static_cast<std::uint32_t>(levelEnd + offsets[idx]);
+                std::size_t child = node.firstChild;
+                split(node, [&](std::uint64_t octant, std::ptrdiff_t childBegin, std::ptrdiff_t childEnd)
+                {
+                    m_nodes[child++] = { (node.key << 3) | octant, static_cast<std::uint32_t>(childBegin),
+                                         static_cast<std::uint32_t>(childEnd - childBegin), 0, 0,
+                                         static_cast<std::uint8_t>(depth + 1), GPoint3D(), GBox3D() };
+                });
+            }
+        });
+        m_levels.push_back(m_nodes.size());
+    }
+
+    // Aggregates, bottom-up: leaves scan their points, parents combine children
+    std::vector<double> sums(3 * m_nodes.size());
+    for (std::size_t depth = m_levels.size() - 1; depth-- > 0;)
+    {
+        const std::size_t levelBegin = m_levels[depth];
+        parallelFor(m_levels[depth + 1] - levelBegin, threadCount, PARALLEL_CHUNK / 8,
+                    [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t idx = levelBegin + begin; idx < levelBegin + end; ++idx)
+            {
+                GOctreeNode & node = m_nodes[idx];
+                double sum[3] = { 0.0, 0.0, 0.0 };
+                double nodeLo[3] = { INF, INF, INF };
+                double nodeHi[3] = { -INF, -INF, -INF };
+                if (node.isLeaf())
+                {
+                    for (std::size_t pos = node.begin; pos < node.begin + node.count; ++pos)
+                    {
+                        for (std::size_t axis = 0; axis < 3; ++axis)
+                        {
+                            const double value = m_coords[3 * pos + axis];
+                            sum[axis] += value;
+                            nodeLo[axis] = std::min(nodeLo[axis], value);
+                            nodeHi[axis] = std::max(nodeHi[axis], value);
+                        }
+                    }
+                }
+                else
+                {
+                    const std::size_t lastChild = node.firstChild + childCount(node.childMask);
+                    for (std::size_t child = node.firstChild; child < lastChild; ++child)
+                    {
+                        for (std::size_t axis = 0; axis < 3; ++axis)
+                        {
+                            sum[axis] += sums[3 * child + axis];
+                            nodeLo[axis] = std::min(nodeLo[axis], m_nodes[child].bounds[axis].from());
+                            nodeHi[axis] = std::max(nodeHi[axis], m_nodes[child].bounds[axis].to());
+                        }
+                    }
+                }
+                std::copy_n(sum, 3, &sums[3 * idx]);
+                node.centroid = GPoint3D(sum[0] / node.count, sum[1] / node.count, sum[2] / node.count);
+                node.bounds = GBox3D(GPoint3D(nodeLo[0], nodeLo[1], nodeLo[2]),
+                                     GPoint3D(nodeHi[0], nodeHi[1], nodeHi[2]));
+            }
+        });
+    }
+}
+
+std::uint64_t GOctree::pointKey(const double * pCoord) const
+{
+    const double scale = CELL_COUNT / m_size;
+    std::uint64_t cells[3];
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        const double cell = (pCoord[axis] - m_origin[axis]) * scale;
+        cells[axis] = !(cell >= 0.0) ? 0 : cell >= CELL_COUNT - 1 ? CELL_COUNT - 1 : static_cast<std::uint64_t>(cell);
+    }
+    return spreadBits(cells[0]) | (spreadBits(cells[1]) << 1) | (spreadBits(cells[2]) << 2);
+}
+
+std::size_t GOctree::size() const
+{
+    return m_indices.size();
+}
+
+bool GOctree::empty() const
+{
+    return m_indices.empty();
+}
+
+std::size_t GOctree::depth() const
+{
+    return m_levels.size() < 2 ? 0 : m_levels.size() - 2;
+}
+
+GBox3D GOctree::cube() const
+{
+    return GBox3D(GPoint3D(m_origin[0], m_origin[1], m_origin[2]),
+                  GPoint3D(m_origin[0] + m_size, m_origin[1] + m_size, m_origin[2] + m_size));
+}
+
+const std::vector<GOctreeNode> & GOctree::nodes() const
+{
+    return m_nodes;
+}
+
+const std::vector<std::size_t> & GOctree::indices() const
+{
+    return m_indices;
+}
+
+std::pair<std::size_t, std::size_t> GOctree::level(std::size_t depth) const
+{
+    if (depth + 1 >= m_levels.size())
+        return { m_nodes.size(), m_nodes.size() };
+    return { m_levels[depth], m_levels[depth + 1] };
+}
+
+std::size_t GOctree::find(std::uint64_t key) const
+{
+    const std::size_t depth = keyDepth(key);
+    if (depth == npos)
+        return npos;
+    const auto range = level(depth);
+    const auto first = m_nodes.begin() + static_cast<std::ptrdiff_t>(range.first);
+    const auto last = m_nodes.begin() + static_cast<std::ptrdiff_t>(range.second);
+    const auto it = std::lower_bound(first, last, key, [](const GOctreeNode & node, std::uint64_t value)
+    {
+        return node.key < value;
+    });
+    return it != last && it->key == key ? static_cast<std::size_t>(it - m_nodes.begin()) : npos;
+}
+
+std::size_t GOctree::child(std::size_t node, std::size_t octant) const
+{
+    const GOctreeNode & parent = m_nodes.at(node);
+    if (octant > 7 || !(parent.childMask & (1u << octant)))
+        return npos;
+    return parent.firstChild + childCount(static_cast<std::uint8_t>(parent.childMask & ((1u << octant) - 1)));
+}
+
+GBox3D GOctree::cell(std::size_t node) const
+{
+    const GOctreeNode & octreeNode = m_nodes.at(node);
+    const std::uint64_t code = octreeNode.key ^ (std::uint64_t{ 1 } << (3 * octreeNode.depth));
+    const double size = m_size / static_cast<double>(std::uint64_t{ 1 } << octreeNode.depth);
+    double lo[3];
+    for (std::size_t axis = 0; axis < 3; ++axis)
+        lo[axis] = m_origin[axis] + static_cast<double>(compactBits(code >> axis)) * size;
+    return GBox3D(GPoint3D(lo[0], lo[1], lo[2]), GPoint3D(lo[0] + size, lo[1] + size, lo[2] + size));
+}
+
+std::size_t GOctree::locate(const GPoint3D & pt) const
+{
+    if (empty() || !cube().contains(pt, 0.0))
+        return npos;
+    const double coord[3] = { pt[0], pt[1], pt[2] };
+    const std::uint64_t key = pointKey(coord);
+    std::size_t node = 0;
+    while (!m_nodes[node].isLeaf())
+    {
+        const std::size_t next = child(node, (key >> (3 * (MAX_DEPTH - m_nodes[node].depth - 1))) & 7);
+        if (next == npos)
+            break;
+        node = next;
+    }
+    return node;
+}
+
+std::vector<std::size_t> GOctree::cut(std::size_t depth) const
+{
+    std::vector<std::size_t> res;
+    for (std::size_t level = 0; level + 1 < m_levels.size(); ++level)
+    {
+        for (std::size_t idx = m_levels[level]; idx < m_levels[level + 1]; ++idx)
+        {
+            if (level == depth || m_nodes[idx].isLeaf())
+                res.push_back(idx);
+        }
+        if (level == depth)
+            break;
+    }
+    return res;
+}
+
+std::vector<std::size_t> GOctree::intersectBox(const GBox3D & box, std::size_t maxDepth /*= MAX_DEPTH*/) const
+{
+    std::vector<std::size_t> res;
+    if (empty())
+        return res;
+
+    // Every level adds at most 7 pending siblings
+    std::size_t stack[7 * (MAX_DEPTH + 1) + 1];
+    std::size_t top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const std::size_t idx = stack[--top];
+        const GOctreeNode & node = m_nodes[idx];
+        if (!box.intersects(node.bounds, 0.0))
+            continue;
+        const bool inside = box.contains(node.bounds.min(), 0.0) && box.contains(node.bounds.max(), 0.0);
+        if (inside || node.isLeaf() || node.depth >= maxDepth)
+        {
+            res.push_back(idx);
+            continue;
+        }
+        const std::size_t lastChild = node.firstChild + childCount(node.childMask);
+        for (std::size_t child = node.firstChild; child < lastChild; ++child)
+            stack[top++] = child;
+    }
+    return res;
+}
+
+std::vector<std::size_t> GOctree::pointsInBox(const GBox3D & box) const
+{
+    std::vector<std::size_t> res;
+    for (const std::size_t idx : intersectBox(box))
+    {
+        const GOctreeNode & node = m_nodes[idx];
+        const bool inside = box.contains(node.bounds.min(), 0.0) && box.contains(node.bounds.max(), 0.0);
+        for (std::size_t pos = node.begin; pos < node.begin + node.count; ++pos)
+        {
+            const double * pCoord = &m_coords[3 * pos];
+            if (inside || box.contains(GPoint3D(pCoord[0], pCoord[1], pCoord[2]), 0.0))
+                res.push_back(m_indices[pos]);
+        }
+    }
+    return res;
+}
+
+} //namespace sgl
@@ -0,0 +1,767 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GOrientedBox.h"
+#include "GConvexHull.h"
+#include "GEigen.h"
+#include "GParallel.h"
+#include "GPoint3D.h"
+#include "GPointCloud.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace sgl
+{
+
+namespace
+{
+
+// Points reduced by one block; sums of blocks are added in order, so results don't depend on threads
+constexpr std::size_t BLOCK_SIZE = 4096;
+
+// Candidate orientations checked by one task of parallelFor
+constexpr std::size_t MIN_CANDIDATES = 8;
+
+// Face normals closer than this (per coordinate) give the same candidate
+constexpr double NORMAL_EPS = 1e-12;
+
+// Relative distance of planar hull vertices below which they are the same vertex
+constexpr double HULL_EPS = 1e-12;
+
+// Relative thickness of hull below which it is a sliver of coplanar points left by rounding
+constexpr double FLAT_EPS = 1e-12;
+
+// Relative margin of candidate skipping, so that rounding never skips the smallest box
+constexpr double SKIP_MARGIN = 1e-9;
+
+// Point coordinates: stride 3 for array of points, stride 1 for coordinate arrays
+struct PointCoords
+{
+    const double * pX;
+    const double * pY;
+    const double * pZ;
+    std::size_t stride;
+
+    double x(std::size_t idx) const { return pX[idx * stride]; }
+    double y(std::size_t idx) const { return pY[idx * stride]; }
+    double z(std::size_t idx) const { return pZ[idx * stride]; }
+};
+
+using Axes = std::array<GVector3D, 3>;
+using Point2D = std::array<double, 2>;
+
+// Box with ranges [lo, hi] along orthonormal axes, relative to reference point
+struct Box
+{
+    Axes axes;
+    double lo[3];
+    double hi[3];
+
+    double volume() const
+    {
+        return (hi[0] - lo[0]) * (hi[1] - lo[1]) * (hi[2] - lo[2]);
+    }
+};
+
+// Buffers and walk starts of one task
+struct Scratch
+{
+    std::vector<std::size_t> indices;
+    std::vector<Point2D> projected;
+    std::vector<Point2D> hull;
+    std::size_t bottom = 0;
+    std::size_t side = 0;
+};
+
+/**
+ * @brief Finds axes of covariance matrix of points
+ * @return axes sorted by decreasing variance
+ */
+Axes principalAxes(const PointCoords & coords, std::size_t count, const GVector3D & origin, unsigned threadCount)
+{
+    // Sums of x, y, z, xx, xy, xz, yy, yz, zz relative to origin
+    using Sums = std::array<double, 9>;
+    const std::size_t blocks = (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    std::vector<Sums> partial(blocks);
+    parallelFor(blocks, threadCount, 1, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t block = begin; block < end; ++block)
+        {
+            Sums sums = {};
+            const std::size_t last = std::min(count, (block + 1) * BLOCK_SIZE);
+            for (std::size_t idx = block * BLOCK_SIZE; idx < last; ++idx)
+            {
+                const double x = coords.x(idx) - origin.x();
+                const double y = coords.y(idx) - origin.y();
+                const double z = coords.z(idx) - origin.z();
+                sums[0] += x;
+                sums[1] += y;
+                sums[2] += z;
+                sums[3] += x * x;
+                sums[4] += x * y;
+                sums[5] += x * z;
+                sums[6] += y * y;
+                sums[7] += y * z;
+                sums[8] += z * z;
+            }
+            partial[block] = sums;
+        }
+    });
+
+    Sums sums = {};
+    for (const auto & block : partial)
+    {
+        for (std::size_t k = 0; k < sums.size(); ++k)
+            sums[k] += block[k];
+    }
+    const double n = static_cast<double>(count);
+    const double mx = sums[0] / n;
+    const double my = sums[1] / n;
+    const double mz = sums[2] / n;
+    double a[3][3];
+    a[0][0] = sums[3] / n - mx * mx;
+    a[0][1] = a[1][0] = sums[4] / n - mx * my;
+    a[0][2] = a[2][0] = sums[5] / n - mx * mz;
+    a[1][1] = sums[6] / n - my * my;
+    a[1][2] = a[2][1] = sums[7] / n - my * mz;
+    a[2][2] = sums[8] / n - mz * mz;
+
+    double values[3];
+    double vectors[3][3];
+    symmetricEigen(a, values, vectors);
+    Axes res;
+    for (std::size_t k = 0; k < 3; ++k)
+        res[k] = GVector3D(vectors[k][0], vectors[k][1], vectors[k][2]);
+    return res;
+}
+
+/**
+ * @brief Finds ranges of points along axes
+ */
+Box boxAlong(const PointCoords & coords, std::size_t count, const GVector3D & origin, const Axes & axes,
+             unsigned threadCount)
+{
+    using Ranges = std::array<double, 6>;
+    const std::size_t blocks = (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    std::vector<Ranges> partial(blocks);
+    parallelFor(blocks, threadCount, 1, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t block = begin; block < end; ++block)
+        {
+            const double inf = std::numeric_limits<double>::infinity();
+            Ranges ranges = { inf, inf, inf, -inf, -inf, -inf };
+            const std::size_t last = std::min(count, (block + 1) * BLOCK_SIZE);
+            for (std::size_t idx = block * BLOCK_SIZE; idx < last; ++idx)
+            {
+                const GVector3D v(coords.x(idx) - origin.x(), coords.y(idx) - origin.y(),
+                                  coords.z(idx) - origin.z());
+                for (std::size_t k = 0; k < 3; ++k)
+                {
+                    const double proj = v % axes[k];
+                    ranges[k] = std::min(ranges[k], proj);
+                    ranges[k + 3] = std::max(ranges[k + 3], proj);
+                }
+            }
+            partial[block] = ranges;
+        }
+    });
+
+    Box box{ axes, {}, {} };
+    std::copy(partial[0].begin(), partial[0].begin() + 3, box.lo);
+    std::copy(partial[0].begin() + 3, partial[0].end(), box.hi);
+    for (const auto & ranges : partial)
+    {
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+            box.lo[k] = std::min(box.lo[k], ranges[k]);
+            box.hi[k] = std::max(box.hi[k], ranges[k + 3]);
+        }
+    }
+    return box;
+}
+
+double cross(const Point2D & o, const Point2D & a, const Point2D & b)
+{
+    return (a[0] - o[0]) * (b[1] - o[1]) - (a[1] - o[1]) * (b[0] - o[0]);
+}
+
+/**
+ * @brief Builds convex hull of points in plane by monotone chain. Vertices closer to the previous one
+ *   than HULL_EPS of the hull size are dropped: projections of points stacked along the projection
+ *   direction differ by rounding only and their edges have no direction
+ * @param points - [in, out] points, sorted on return
+ * @param hull - [out] hull vertices, counterclockwise, without collinear ones
+ */
+void planarHull(std::vector<Point2D> & points, std::vector<Point2D> & hull)
+{
+    std::sort(points.begin(), points.end());
+    hull.resize(2 * points.size());
+    std::size_t k = 0;
+    for (const auto & pt : points)
+    {
+        while (k >= 2 && cross(hull[k - 2], hull[k - 1], pt) <= 0.0)
+            --k;
+        hull[k++] = pt;
+    }
+    for (std::size_t idx = points.size() - 1, lower = k + 1; idx-- > 0;)
+    {
+        while (k >= lower && cross(hull[k - 2], hull[k - 1], points[idx]) <= 0.0)
+            --k;
+        hull[k++] = points[idx];
+    }
+    hull.resize(points.size() > 1 ? k - 1 : k);
+
+    double ymin = hull[0][1];
+    double ymax = hull[0][1];
+    for (const auto & pt : hull)
+    {
+        ymin = std::min(ymin, pt[1]);
+        ymax = std::max(ymax, pt[1]);
+    }
+    const double eps = HULL_EPS * std::max(points.back()[0] - points.front()[0], ymax - ymin);
+    auto coincident = [eps](const Point2D & pt1, const Point2D & pt2)
+    {
+        return std::fabs(pt1[0] - pt2[0]) <= eps && std::fabs(pt1[1] - pt2[1]) <= eps;
+    };
+    std::size_t kept = 0;
+    for (std::size_t idx = 0; idx < hull.size(); ++idx)
+    {
+        if (kept == 0 || !coincident(hull[idx], hull[kept - 1]))
+            hull[kept++] = hull[idx];
+    }
+    while (kept > 1 && coincident(hull[kept - 1], hull[0]))
+        --kept;
+    hull.resize(kept);
+}
+
+/**
+ * @brief Finds minimal area rectangle enclosing convex polygon by rotating calipers: one side of
+ *   the rectangle lies on polygon edge, the other three touch extreme vertices which move forward
+ *   together with the edge.
+ * @param hull - polygon vertices, counterclockwise
+ * @param pRect - [out] direction of the first side (ux, uy) and ranges umin, umax, vmin, vmax
+ *   along it and along (-uy, ux)
+ */
+void minimalRectangle(const std::vector<Point2D> & hull, double * pRect)
+{
+    const std::size_t count = hull.size();
+    auto proj = [&hull](std::size_t idx, double dx, double dy) { return hull[idx][0] * dx + hull[idx][1] * dy; };
+    auto ranges = [&](double ux, double uy)
+    {
+        pRect[0] = ux;
+        pRect[1] = uy;
+        pRect[2] = pRect[4] = std::numeric_limits<double>::infinity();
+        pRect[3] = pRect[5] = -std::numeric_limits<double>::infinity();
+        for (std::size_t idx = 0; idx < count; ++idx)
+        {
+            pRect[2] = std::min(pRect[2], proj(idx, ux, uy));
+            pRect[3] = std::max(pRect[3], proj(idx, ux, uy));
+            pRect[4] = std::min(pRect[4], proj(idx, -uy, ux));
+            pRect[5] = std::max(pRect[5], proj(idx, -uy, ux));
+        }
+    };
+
+    if (count < 3)
+    {
+        const double dx = hull.back()[0] - hull.front()[0];
+        const double dy = hull.back()[1] - hull.front()[1];
+        const double len = std::sqrt(dx * dx + dy * dy);
+        if (len > 0.0)
+            ranges(dx / len, dy / len);
+        else
+            ranges(1.0, 0.0);
+        return;
+    }
+
+    auto advance = [&](std::size_t & idx, double dx, double dy)
+    {
+        double current = proj(idx, dx, dy);
+        for (std::size_t step = 0; step < count; ++step)
+        {
+            const std::size_t next = idx + 1 < count ? idx + 1 : 0;
+            const double value = proj(next, dx, dy);
+            if (value < current)
+                break;
+            idx = next;
+            current = value;
+        }
+    };
+
+    double bestArea = std::numeric_limits<double>::infinity();
+    std::size_t right = 0;
+    std::size_t top = 0;
+    std::size_t left = 0;
+    for (std::size_t edge = 0; edge < count; ++edge)
+    {
+        const std::size_t next = edge + 1 < count ? edge + 1 : 0;
+        double ux = hull[next][0] - hull[edge][0];
+        double uy = hull[next][1] - hull[edge][1];
+        const double len = std::sqrt(ux * ux + uy * uy);
+        ux /= len;
+        uy /= len;
+        if (edge == 0)
+        {
+            for (std::size_t idx = 1; idx < count; ++idx)
+            {
+                if (proj(idx, ux, uy) > proj(right, ux, uy))
+                    right = idx;
+                if (proj(idx, -uy, ux) > proj(top, -uy, ux))
+                    top = idx;
+                if (proj(idx, ux, uy) < proj(left, ux, uy))
+                    left = idx;
+            }
+        }
+        else
+        {
+            advance(right, ux, uy);
+            advance(top, -uy, ux);
+            advance(left, -ux, -uy);
+        }
+
+        const double umin = proj(left, ux, uy);
+        const double umax = proj(right, ux, uy);
+        const double vmin = proj(edge, -uy, ux);
+        const double vmax = proj(top, -uy, ux);
+        const double area = (umax - umin) * (vmax - vmin);
+        if (area < bestArea)
+        {
+            bestArea = area;
+            const double rect[6] = { ux, uy, umin, umax, vmin, vmax };
+            std::copy(rect, rect + 6, pRect);
+        }
+    }
+}
+
+/**
+ * @brief Convex hull with vertices relative to reference point, half-edges and unit face normals
+ */
+struct HullMesh
+{
+    static constexpr std::size_t npos = GConvexHull::npos;
+
+    GVector3DArray vertices;
+    /** Half-edges, origins refer to vertices */
+    std::vector<GHullHalfEdge> edges;
+    /** Outgoing half-edge of every vertex */
+    std::vector<std::size_t> vertexEdges;
+    /** Outward unit normals of faces, zero for degenerate faces */
+    std::vector<GVector3D> normals;
+
+    HullMesh(const PointCoords & coords, const GVector3D & origin, const GConvexHull & hull)
+        : edges(hull.halfEdges()), normals(hull.faceCount())
+    {
+        const auto & indices = hull.vertices();
+        vertices.reserve(indices.size());
+        for (std::size_t idx : indices)
+            vertices.emplace_back(coords.x(idx) - origin.x(), coords.y(idx) - origin.y(), coords.z(idx) - origin.z());
+
+        vertexEdges.resize(indices.size());
+        for (std::size_t edge = 0; edge < edges.size(); ++edge)
+        {
+            auto & vertex = edges[edge].origin;
+            vertex = static_cast<std::size_t>(std::lower_bound(indices.begin(), indices.end(), vertex) -
+                                              indices.begin());
+            vertexEdges[vertex] = edge;
+        }
+
+        for (std::size_t face = 0; face < normals.size(); ++face)
+        {
+            const GVector3D & p0 = vertices[edges[3 * face].origin];
+            const GVector3D & p1 = vertices[edges[3 * face + 1].origin];
+            const GVector3D & p2 = vertices[edges[3 * face + 2].origin];
+            const GVector3D n = (p1 - p0) * (p2 - p0);
+            const double len = n.length();
+            if (len > 0.0)
+                normals[face] = GVector3D(n.x() / len, n.y() / len, n.z() / len);
+        }
+    }
+
+    /**
+     * @return the next outgoing half-edge of the same vertex
+     */
+    std::size_t rotate(std::size_t edge) const
+    {
+        return edges[edges[edges[edge].next].next].twin;
+    }
+
+    bool front(std::size_t edge, const GVector3D & n) const
+    {
+        return normals[edges[edge].face] % n > 0.0;
+    }
+
+    /**
+     * @brief Finds vertex extreme in direction d by walking to better neighbours (the skeleton of convex
+     *   polytope has no local maxima of linear function)
+     * @param d - direction
+     * @param vertex - vertex to start from
+     * @return extreme vertex
+     */
+    std::size_t extreme(const GVector3D & d, std::size_t vertex) const
+    {
+        double best = vertices[vertex] % d;
+        for (bool moved = true; moved;)
+        {
+            moved = false;
+            const std::size_t first = vertexEdges[vertex];
+            std::size_t edge = first;
+            do
+            {
+                const std::size_t other = edges[edges[edge].next].origin;
+                const double proj = vertices[other] % d;
+                if (proj > best)
+                {
+                    best = proj;
+                    vertex = other;
+                    moved = true;
+                    break;
+                }
+                edge = rotate(edge);
+            } while (edge != first);
+        }
+        return vertex;
+    }
+
+    /**
+     * @brief Collects vertices of silhouette seen along n: origins of half-edges between front and back faces.
+     *   The silhouette is traced from vertex on it; if tracing fails due to rounding, all half-edges are checked
+     * @param n - direction
+     * @param vertex - vertex of silhouette
+     * @param result - [out] silhouette vertices
+     */
+    void silhouette(const GVector3D & n, std::size_t vertex, std::vector<std::size_t> & result) const
+    {
+        result.clear();
+        auto separates = [&](std::size_t edge) { return front(edge, n) && !front(edges[edge].twin, n); };
+
+        std::size_t start = npos;
+        const std::size_t first = vertexEdges[vertex];
+        std::size_t edge = first;
+        do
+        {
+            if (separates(edge))
+                start = edge;
+            edge = rotate(edge);
+        } while (start == npos && edge != first);
+
+        if (start != npos)
+        {
+            edge = start;
+            for (std::size_t step = 0; step < edges.size(); ++step)
+            {
+                result.push_back(edges[edge].origin);
+                // Turn around the end of edge through front faces to the next separating edge
+                edge = edges[edge].next;
+                for (std::size_t turn = 0; turn < edges.size() && front(edges[edge].twin, n); ++turn)
+                    edge = edges[edges[edge].twin].next;
+                if (edge == start)
+                    return;
+                if (!separates(edge))
+                    break;
+            }
+        }
+
+        result.clear();
+        for (std::size_t idx = 0; idx < edges.size(); ++idx)
+        {
+            if (separates(idx))
+                result.push_back(edges[idx].origin);
+        }
+    }
+};
+
+/**
+ * @brief Selects faces with distinct normals, n and -n are the same candidate
+ * @return indices of faces
+ */
+std::vector<std::size_t> candidateFaces(const HullMesh & mesh)
+{
+    using Key = std::pair<std::array<double, 3>, std::size_t>;
+    std::vector<Key> keys;
+    keys.reserve(mesh.normals.size());
+    for (std::size_t face = 0; face < mesh.normals.size(); ++face)
+    {
+        const GVector3D & n = mesh.normals[face];
+        std::array<double, 3> key = { n.x(), n.y(), n.z() };
+        const auto largest = std::max_element(key.begin(), key.end(),
+                                              [](double c1, double c2) { return std::fabs(c1) < std::fabs(c2); });
+        if (*largest == 0.0)
+            continue;
+        if (*largest < 0.0)
+        {
+            for (auto & c : key)
+                c = -c;
+        }
+        keys.emplace_back(key, face);
+    }
+
+    std::sort(keys.begin(), keys.end());
+    std::vector<std::size_t> res;
+    for (std::size_t idx = 0; idx < keys.size(); ++idx)
+    {
+        const auto & key = keys[idx].first;
+        const auto & prev = keys[idx == 0 ? 0 : idx - 1].first;
+        if (idx > 0 && std::fabs(key[0] - prev[0]) < NORMAL_EPS && std::fabs(key[1] - prev[1]) < NORMAL_EPS &&
+            std::fabs(key[2] - prev[2]) < NORMAL_EPS)
+            continue;
+        res.push_back(keys[idx].second);
+    }
+    return res;
+}
+
+/**
+ * @brief Finds basis (a, b) of plane orthogonal to unit vector n, so that a * b = n
+ */
+void planeBasis(const GVector3D & n, GVector3D & a, GVector3D & b)
+{
+    const double an[3] = { std::fabs(n.x()), std::fabs(n.y()), std::fabs(n.z()) };
+    const std::size_t axis = static_cast<std::size_t>(std::min_element(an, an + 3) - an);
+    a = n * GVector3D(axis == 0 ? 1.0 : 0.0, axis == 1 ? 1.0 : 0.0, axis == 2 ? 1.0 : 0.0);
+    a.normalize();
+    b = n * a;
+}
+
+/**
+ * @brief Turns minimal rectangle in plane (a, b) into box
+ */
+Box rectangleBox(const GVector3D & a, const GVector3D & b, const GVector3D & n, const double * pRect,
+                 double nmin, double nmax)
+{
+    Box box;
+    box.axes[0] = GVector3D(pRect[0] * a.x() + pRect[1] * b.x(), pRect[0] * a.y() + pRect[1] * b.y(),
+                            pRect[0] * a.z() + pRect[1] * b.z());
+    box.axes[1] = n * box.axes[0];
+    box.axes[2] = n;
+    box.lo[0] = pRect[2];
+    box.hi[0] = pRect[3];
+    box.lo[1] = pRect[4];
+    box.hi[1] = pRect[5];
+    box.lo[2] = nmin;
+    box.hi[2] = nmax;
+    return box;
+}
+
+// Box with the given axes enclosing all hull vertices
+Box encloseHull(const HullMesh & mesh, const Axes & axes)
+{
+    Box box{ axes, {}, {} };
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+        box.lo[k] = std::numeric_limits<double>::infinity();
+        box.hi[k] = -std::numeric_limits<double>::infinity();
+    }
+    for (const auto & vertex : mesh.vertices)
+    {
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+            const double proj = vertex % axes[k];
+            box.lo[k] = std::min(box.lo[k], proj);
+            box.hi[k] = std::max(box.hi[k], proj);
+        }
+    }
+    return box;
+}
+
+/**
+ * @brief Finds the smallest box flush with face of hull. Only silhouette of hull seen along face normal
+ *   is projected to find orientation of the box, extents are taken over all hull vertices, so the box
+ *   encloses the hull whatever the rounding
+ * @param mesh - hull
+ * @param face - face
+ * @param limit - volume to beat: if area of projected hull or the rectangle around it already give larger
+ *   volume, the box is skipped
+ * @param scratch - buffers of task
+ * @param box - [out] box, unchanged if limit is not beaten
+ * @return volume of box or infinity if limit is not beaten
+ */
+double flushBox(const HullMesh & mesh, std::size_t face, double limit, Scratch & scratch, Box & box)
+{
+    const GVector3D & n = mesh.normals[face];
+    GVector3D a;
+    GVector3D b;
+    planeBasis(n, a, b);
+
+    scratch.bottom = mesh.extreme(GVector3D(-n.x(), -n.y(), -n.z()), scratch.bottom);
+    scratch.side = mesh.extreme(a, scratch.side);
+    mesh.silhouette(n, scratch.side, scratch.indices);
+
+    scratch.projected.clear();
+    for (std::size_t vertex : scratch.indices)
+        scratch.projected.push_back({ mesh.vertices[vertex] % a, mesh.vertices[vertex] % b });
+    planarHull(scratch.projected, scratch.hull);
+
+    const double nmin = mesh.vertices[scratch.bottom] % n;
+    const double nmax = mesh.vertices[mesh.edges[3 * face].origin] % n;
+    double area = 0.0;
+    for (std::size_t idx = 0; idx + 2 < scratch.hull.size(); ++idx)
+        area += cross(scratch.hull[0], scratch.hull[idx + 1], scratch.hull[idx + 2]);
+    if (0.5 * area * (nmax - nmin) > limit * (1.0 + SKIP_MARGIN))
+        return std::numeric_limits<double>::infinity();
+
+    double rect[6];
+    minimalRectangle(scratch.hull, rect);
+    const Box flush = rectangleBox(a, b, n, rect, nmin, nmax);
+    if (flush.volume() > limit * (1.0 + SKIP_MARGIN))
+        return std::numeric_limits<double>::infinity();
+    box = encloseHull(mesh, flush.axes);
+    return box.volume();
+}
+
+/**
+ * @brief Finds the smallest box of coplanar points: minimal area rectangle in plane orthogonal to n
+ */
+Box planarBox(const PointCoords & coords, std::size_t count, const GVector3D & origin, const GVector3D & n)
+{
+    GVector3D a;
+    GVector3D b;
+    planeBasis(n, a, b);
+    double nmin = std::numeric_limits<double>::infinity();
+    double nmax = -std::numeric_limits<double>::infinity();
+    std::vector<Point2D> projected(count);
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        const GVector3D v(coords.x(idx) - origin.x(), coords.y(idx) - origin.y(), coords.z(idx) - origin.z());
+        projected[idx] = { v % a, v % b };
+        nmin = std::min(nmin, v % n);
+        nmax = std::max(nmax, v % n);
+    }
+    std::vector<Point2D> hull;
+    planarHull(projected, hull);
+
+    double rect[6];
+    minimalRectangle(hull, rect);
+    return rectangleBox(a, b, n, rect, nmin, nmax);
+}
+
+/**
+ * @brief Converts box to frame with axes sorted by decreasing extent
+ */
+GOrientedBox orientedBox(const GVector3D & origin, const Box & box)
+{
+    int order[3] = { 0, 1, 2 };
+    std::stable_sort(order, order + 3, [&box](int i1, int i2)
+    {
+        return box.hi[i1] - box.lo[i1] > box.hi[i2] - box.lo[i2];
+    });
+
+    double center[3] = { origin.x(), origin.y(), origin.z() };
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+        const double mid = 0.5 * (box.lo[k] + box.hi[k]);
+        for (std::size_t c = 0; c < 3; ++c)
+            center[c] += mid * box.axes[k].data()[c];
+    }
+
+    const GVector3D & x = box.axes[order[0]];
+    const GVector3D & y = box.axes[order[1]];
+    GOrientedBox res;
+    res.frame = GMatrix4D(GPoint3D(center[0], center[1], center[2]), x, y, x * y);
+    res.halfExtents = GVector3D(0.5 * (box.hi[order[0]] - box.lo[order[0]]),
+                                0.5 * (box.hi[order[1]] - box.lo[order[1]]),
+                                0.5 * (box.hi[order[2]] - box.lo[order[2]]));
+    return res;
+}
+
+void checkCount(std::size_t count)
+{
+    if (count == 0)
+        throw std::invalid_argument("fitOrientedBox: no points");
+}
+
+template<typename MakeHull>
+GOrientedBox fitBox(const PointCoords & coords, std::size_t count, GOrientedBoxFit fit, unsigned threadCount,
+                    MakeHull makeHull)
+{
+    threadCount = resolveThreadCount(threadCount);
+
+    // Coordinates are taken relative to the first point
+    const GVector3D origin(coords.x(0), coords.y(0), coords.z(0));
+    const Axes axes = principalAxes(coords, count, origin, threadCount);
+    if (fit == GOrientedBoxFit::PCA)
+        return orientedBox(origin, boxAlong(coords, count, origin, axes, threadCount));
+
+    const GConvexHull hull = makeHull(threadCount);
+    if (hull.empty())
+        return orientedBox(origin, planarBox(coords, count, origin, axes[2]));
+
+    const HullMesh mesh(coords, origin, hull);
+    Box best = encloseHull(mesh, axes);
+    // Volumes of boxes around a sliver are rounding noise, so it is fitted as a plane
+    const double size = std::max({ best.hi[0] - best.lo[0], best.hi[1] - best.lo[1], best.hi[2] - best.lo[2] });
+    if (best.hi[2] - best.lo[2] <= FLAT_EPS * size)
+        return orientedBox(origin, planarBox(coords, count, origin, axes[2]));
+
+    const std::vector<std::size_t> faces = candidateFaces(mesh);
+    // Candidates which can't beat the best box of their task are skipped, this keeps the smallest volumes
+    std::vector<double> volumes(faces.size());
+    std::vector<Box> boxes(faces.size());
+    parallelFor(faces.size(), threadCount, MIN_CANDIDATES, [&](std::size_t begin, std::size_t end)
+    {
+        Scratch scratch;
+        double limit = std::numeric_limits<double>::infinity();
+        for (std::size_t idx = begin; idx < end; ++idx)
+        {
+            volumes[idx] = flushBox(mesh, faces[idx], limit, scratch, boxes[idx]);
+            limit = std::min(limit, volumes[idx]);
+        }
+    });
+
+    const auto minimal = std::min_element(volumes.begin(), volumes.end());
+    if (minimal != volumes.end() && *minimal <= best.volume())
+        best = boxes[minimal - volumes.begin()];
+    return orientedBox(origin, best);
+}
+
+} //namespace
+
+GOrientedBox fitOrientedBox(const GPoint3D * pPoints, std::size_t count,
+                            GOrientedBoxFit fit /*= GOrientedBoxFit::PCA*/, unsigned threadCount /*= 0*/)
+{
+    checkCount(count);
+    const double * pData = pPoints->data();
+    const PointCoords coords{ pData, pData + 1, pData + 2, 3 };
+    return fitBox(coords, count, fit, threadCount, [pPoints, count](unsigned threads)
+    {
+        return GConvexHull(pPoints, count, threads);
+    });
+}
+
+GOrientedBox fitOrientedBox(const GPoint3DArray & points, GOrientedBoxFit fit /*= GOrientedBoxFit::PCA*/,
+                            unsigned threadCount /*= 0*/)
+{
+    return fitOrientedBox(points.data(), points.size(), fit, threadCount);
+}
+
+GOrientedBox fitOrientedBox(const GPointCloud & cloud, GOrientedBoxFit fit /*= GOrientedBoxFit::PCA*/,
+                            unsigned threadCount /*= 0*/)
+{
+    checkCount(cloud.size());
+    const PointCoords coords{ cloud.xData(), cloud.yData(), cloud.zData(), 1 };
+    return fitBox(coords, cloud.size(), fit, threadCount, [&cloud](unsigned threads)
+    {
+        return GConvexHull(cloud, threads);
+    });
+}
+
+} //namespace sgl
@@ -0,0 +1,193 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GPointCloud.h"
+
+namespace sgl
+{
+
+GPointCloud::GPointCloud() = default;
+
+GPointCloud::GPointCloud(std::size_t size)
+{
+    resize(size);
+}
+
+GPointCloud::GPointCloud(const GPoint3DArray & points)
+{
+    assign(points);
+}
+
+GPointCloud::GPointCloud(GAlignedDoubleArray && x, GAlignedDoubleArray && y, GAlignedDoubleArray && z)
+{
+    if (x.size() != y.size() || x.size() != z.size())
+        throw std::invalid_argument("GPointCloud: coordinate arrays have different sizes");
+    m_coords[0] = std::move(x);
+    m_coords[1] = std::move(y);
+    m_coords[2] = std::move(z);
+}
+
+GPointCloud::GPointCloud(const GPointCloud &) = default;
+
+GPointCloud::GPointCloud(GPointCloud &&) noexcept = default;
+
+GPointCloud::~GPointCloud() = default;
+
+GPointCloud & GPointCloud::operator=(const GPointCloud &) = default;
+
+GPointCloud & GPointCloud::operator=(GPointCloud &&) noexcept = default;
+
+void GPointCloud::resize(std::size_t size)
+{
+    for (auto & coords : m_coords)
+        coords.resize(size, 0.0);
+    if (m_hasNormals)
+    {
+        for (auto & coords : m_normals)
+            coords.resize(size, 0.0);
+    }
+    if (m_hasIntensity)
+        m_intensity.resize(size, 0.0);
+}
+
+void GPointCloud::reserve(std::size_t capacity)
+{
+    for (auto & coords : m_coords)
+        coords.reserve(capacity);
+    if (m_hasNormals)
+    {
+        for (auto & coords : m_normals)
+            coords.reserve(capacity);
+    }
+    if (m_hasIntensity)
+        m_intensity.reserve(capacity);
+}
+
+void GPointCloud::clear()
+{
+    resize(0);
+}
+
+void GPointCloud::push_back(const GPoint3D & pt)
+{
+    const std::size_t idx = size();
+    resize(idx + 1);
+    setPoint(idx, pt);
+}
+
+void GPointCloud::assign(const GPoint3DArray & points)
+{
+    const std::size_t count = points.size();
+    resize(count);
+
+    const double * pSrc = coordinates(points);
+    double * pX = xData();
+    double * pY = yData();
+    double * pZ = zData();
+    for (std::size_t idx = 0; idx < count; ++idx, pSrc += 3)
+    {
+        pX[idx] = pSrc[0];
+        pY[idx] = pSrc[1];
+        pZ[idx] = pSrc[2];
+    }
+}
+
+void GPointCloud::copyTo(GPoint3DArray & points) const
+{
+    const std::size_t count = size();
+    points.resize(count);
+
+    double * pDst = coordinates(points);
+    const double * pX = xData();
+    const double * pY = yData();
+    const double * pZ = zData();
+    for (std::size_t idx = 0; idx < count; ++idx, pDst += 3)
+    {
+        pDst[0] = pX[idx];
+        pDst[1] = pY[idx];
+        pDst[2] = pZ[idx];
+    }
+}
+
+GPoint3DArray GPointCloud::toArray() const
+{
+    GPoint3DArray res;
+    copyTo(res);
+    return res;
+}
+
+const double * GPointCloud::data(std::size_t coordIdx) const
+{
+    if (coordIdx > 2)
+        throw std::invalid_argument("GPointCloud: index out of range");
+    return m_coords[coordIdx].data();
+}
+
+double * GPointCloud::data(std::size_t coordIdx)
+{
+    if (coordIdx > 2)
+        throw std::invalid_argument("GPointCloud: index out of range");
+    return m_coords[coordIdx].data();
+}
+
+void GPointCloud::enableNormals()
+{
+    if (m_hasNormals)
+        return;
+    for (auto & coords : m_normals)
+        coords.assign(size(), 0.0);
+    m_hasNormals = true;
+}
+
+void GPointCloud::disableNormals()
+{
+    for (auto & coords : m_normals)
+        GAlignedDoubleArray().swap(coords);
+    m_hasNormals = false;
+}
+
+const double * GPointCloud::normalData(std::size_t coordIdx) const
+{
+    if (coordIdx > 2)
+        throw std::invalid_argument("GPointCloud: index out of range");
+    return m_hasNormals ? m_normals[coordIdx].data() : nullptr;
+}
+
+double * GPointCloud::normalData(std::size_t coordIdx)
+{
+    if (coordIdx > 2)
+        throw std::invalid_argument("GPointCloud: index out of range");
+    return m_hasNormals ? m_normals[coordIdx].data() : nullptr;
+}
+
+void GPointCloud::enableIntensity()
+{
+    if (m_hasIntensity)
+        return;
+    m_intensity.assign(size(), 0.0);
+    m_hasIntensity = true;
+}
+
+void GPointCloud::disableIntensity()
+{
+    GAlignedDoubleArray().swap(m_intensity);
+    m_hasIntensity = false;
+}
+
+} //namespace sgl
@@ -0,0 +1,391 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GPredicates.h"
+
+#include <cfloat>
+#include <vector>
+
+namespace sgl
+{
+
+namespace
+{
+
+// Error bounds of the floating-point filters, see Shewchuk's paper.
+constexpr double s_epsilon = DBL_EPSILON / 2;
+constexpr double s_ccwErrBound = (3.0 + 16.0 * s_epsilon) * s_epsilon;
+constexpr double s_o3dErrBound = (7.0 + 56.0 * s_epsilon) * s_epsilon;
+constexpr double s_iccErrBound = (10.0 + 96.0 * s_epsilon) * s_epsilon;
+constexpr double s_ispErrBound = (16.0 + 224.0 * s_epsilon) * s_epsilon;
+
+// Expansion is a sum of nonoverlapping doubles sorted by increasing magnitude, without zeros.
+// The last component has the sign of the whole sum.
+using Expansion = std::vector<double>;
+
+inline void twoSum(double a, double b, double & x, double & y)
+{
+    x = a + b;
+    const double bVirtual = x - a;
+    const double aVirtual = x - bVirtual;
+    y = (a - aVirtual) + (b - bVirtual);
+}
+
+inline void fastTwoSum(double a, double b, double & x, double & y)
+{
+    x = a + b;
+    y = b - (x - a);
+}
+
+inline void twoProduct(double a, double b, double & x, double & y)
+{
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+Expansion difference(double a, double b)
+{
+    double x = 0.0;
+    double y = 0.0;
+    twoSum(a, -b, x, y);
+    Expansion res;
+    if (y != 0.0)
+        res.push_back(y);
+    if (x != 0.0)
+        res.push_back(x);
+    return res;
+}
+
+Expansion grow(const Expansion & e, double b)
+{
+    Expansion res;
+    res.reserve(e.size() + 1);
+    double q = b;
+    for (double component : e)
+    {
+        double sum = 0.0;
+        double h = 0.0;
+        twoSum(q, component, sum, h);
+        q = sum;
+        if (h != 0.0)
+            res.push_back(h);
+    }
+    if (q != 0.0)
+        res.push_back(q);
+    return res;
+}
+
+Expansion sum(const Expansion & e, const Expansion & f)
+{
+    Expansion res = e;
+    for (double component : f)
+        res = grow(res, component);
+    return res;
+}
+
+Expansion negate(Expansion e)
+{
+    for (double & component : e)
+        component = -component;
+    return e;
+}
+
+Expansion difference(const Expansion & e, const Expansion & f)
+{
+    return sum(e, negate(f));
+}
+
+Expansion scale(const Expansion & e, double b)
+{
+    Expansion res;
+    if (e.empty() || b == 0.0)
+        return res;
+
+    res.reserve(2 * e.size());
+    double q = 0.0;
+    double h = 0.0;
+    twoProduct(e[0], b, q, h);
+    if (h != 0.0)
+        res.push_back(h);
+    for (std::size_t idx = 1; idx < e.size(); ++idx)
+    {
+        double product1 = 0.0;
+        double product0 = 0.0;
+        twoProduct(e[idx], b, product1, product0);
+        double s = 0.0;
+        twoSum(q, product0, s, h);
+        if (h != 0.0)
+            res.push_back(h);
+        fastTwoSum(product1, s, q, h);
+        if (h != 0.0)
+            res.push_back(h);
+    }
+    if (q != 0.0)
+        res.push_back(q);
+    return res;
+}
+
+Expansion product(const Expansion & e, const Expansion & f)
+{
+    Expansion res;
+    for (double component : f)
+        res = sum(res, scale(e, component));
+    return res;
+}
+
+double sign(const Expansion & e)
+{
+    return e.empty() ? 0.0 : e.back();
+}
+
+// Exact a * b - c * d for expansions
+Expansion crossTerm(const Expansion & a, const Expansion & b, const Expansion & c, const Expansion & d)
+{
+    return difference(product(a, b), product(c, d));
+}
+
+double orient2dExact(const double * pa, const double * pb, const double * pc)
+{
+    const Expansion acx = difference(pa[0], pc[0]);
+    const Expansion acy = difference(pa[1], pc[1]);
+    const Expansion bcx = difference(pb[0], pc[0]);
+    const Expansion bcy = difference(pb[1], pc[1]);
+    return sign(crossTerm(acx, bcy, acy, bcx));
+}
+
+double orient3dExact(const double * pa, const double * pb, const double * pc, const double * pd)
+{
+    Expansion ad[3];
+    Expansion bd[3];
+    Expansion cd[3];
+    for (std::size_t idx = 0; idx < 3; ++idx)
+    {
+        ad[idx] = difference(pa[idx], pd[idx]);
+        bd[idx] = difference(pb[idx], pd[idx]);
+        cd[idx] = difference(pc[idx], pd[idx]);
+    }
+    const Expansion bc = crossTerm(bd[0], cd[1], bd[1], cd[0]);
+    const Expansion ca = crossTerm(cd[0], ad[1], cd[1], ad[0]);
+    const Expansion ab = crossTerm(ad[0], bd[1], ad[1], bd[0]);
+    return sign(sum(sum(product(ad[2], bc), product(bd[2], ca)), product(cd[2], ab)));
+}
+
+double incircleExact(const double * pa, const double * pb, const double * pc, const double * pd)
+{
+    const Expansion adx = difference(pa[0], pd[0]);
+    const Expansion ady = difference(pa[1], pd[1]);
+    const Expansion bdx = difference(pb[0], pd[0]);
+    const Expansion bdy = difference(pb[1], pd[1]);
+    const Expansion cdx = difference(pc[0], pd[0]);
+    const Expansion cdy = difference(pc[1], pd[1]);
+
+    const Expansion aLift = sum(product(adx, adx), product(ady, ady));
+    const Expansion bLift = sum(product(bdx, bdx), product(bdy, bdy));
+    const Expansion cLift = sum(product(cdx, cdx), product(cdy, cdy));
+
+    const Expansion bc = crossTerm(bdx, cdy, cdx, bdy);
+    const Expansion ca = crossTerm(cdx, ady, adx, cdy);
+    const Expansion ab = crossTerm(adx, bdy, bdx, ady);
+    return sign(sum(sum(product(aLift, bc), product(bLift, ca)), product(cLift, ab)));
+}
+
+double insphereExact(const double * pa, const double * pb, const double * pc, const double * pd,
+                     const double * pe)
+{
+    Expansion ae[3];
+    Expansion be[3];
+    Expansion ce[3];
+    Expansion de[3];
+    for (std::size_t idx = 0; idx < 3; ++idx)
+    {
+        ae[idx] = difference(pa[idx], pe[idx]);
+        be[idx] = difference(pb[idx], pe[idx]);
+        ce[idx] = difference(pc[idx], pe[idx]);
+        de[idx] = difference(pd[idx], pe[idx]);
+    }
+
+    const Expansion ab = crossTerm(ae[0], be[1], be[0], ae[1]);
+    const Expansion bc = crossTerm(be[0], ce[1], ce[0], be[1]);
+    const Expansion cd = crossTerm(ce[0], de[1], de[0], ce[1]);
+    const Expansion da = crossTerm(de[0], ae[1], ae[0], de[1]);
+    const Expansion ac = crossTerm(ae[0], ce[1], ce[0], ae[1]);
+    const Expansion bd = crossTerm(be[0], de[1], de[0], be[1]);
+
+    const Expansion abc = sum(difference(product(ae[2], bc), product(be[2], ac)), product(ce[2], ab));
+    const Expansion bcd = sum(difference(product(be[2], cd), product(ce[2], bd)), product(de[2], bc));
+    const Expansion cda = sum(sum(product(ce[2], da), product(de[2], ac)), product(ae[2], cd));
+    const Expansion dab = sum(sum(product(de[2], ab), product(ae[2], bd)), product(be[2], da));
+
+    auto lift = [](const Expansion * p) {
+        return sum(sum(product(p[0], p[0]), product(p[1], p[1])), product(p[2], p[2]));
+    };
+    const Expansion left = difference(product(lift(de), abc), product(lift(ce), dab));
+    const Expansion right = difference(product(lift(be), cda), product(lift(ae), bcd));
+    return sign(sum(left, right));
+}
+
+} //namespace
+
+double orient2d(const double * pa, const double * pb, const double * pc)
+{
+    const double detLeft = (pa[0] - pc[0]) * (pb[1] - pc[1]);
+    const double detRight = (pa[1] - pc[1]) * (pb[0] - pc[0]);
+    const double det = detLeft - detRight;
+    const double errBound = s_ccwErrBound * (std::abs(detLeft) + std::abs(detRight));
+    if (std::abs(det) > errBound)
+        return det;
+    return orient2dExact(pa, pb, pc);
+}
+
+double orient3d(const double * pa, const double * pb, const double * pc, const double * pd)
+{
+    const double adx = pa[0] - pd[0];
+    const double ady = pa[1] - pd[1];
+    const double adz = pa[2] - pd[2];
+    const double bdx = pb[0] - pd[0];
+    const double bdy = pb[1] - pd[1];
+    const double bdz = pb[2] - pd[2];
+    const double cdx = pc[0] - pd[0];
+    const double cdy = pc[1] - pd[1];
+    const double cdz = pc[2] - pd[2];
+
+    const double bdxcdy = bdx * cdy;
+    const double cdxbdy = cdx * bdy;
+    const double cdxady = cdx * ady;
+    const double adxcdy = adx * cdy;
+    const double adxbdy = adx * bdy;
+    const double bdxady = bdx * ady;
+
+    const double det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+    const double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * std::abs(adz) +
+                             (std::abs(cdxady) + std::abs(adxcdy)) * std::abs(bdz) +
+                             (std::abs(adxbdy) + std::abs(bdxady)) * std::abs(cdz);
+    if (std::abs(det) > s_o3dErrBound * permanent)
+        return det;
+    return orient3dExact(pa, pb, pc, pd);
+}
+
+double incircle(const double * pa, const double * pb, const double * pc, const double * pd)
+{
+    const double adx = pa[0] - pd[0];
+    const double ady = pa[1] - pd[1];
+    const double bdx = pb[0] - pd[0];
+    const double bdy = pb[1] - pd[1];
+    const double cdx = pc[0] - pd[0];
+    const double cdy = pc[1] - pd[1];
+
+    const double bdxcdy = bdx * cdy;
+    const double cdxbdy = cdx * bdy;
+    const double aLift = adx * adx + ady * ady;
+
+    const double cdxady = cdx * ady;
+    const double adxcdy = adx * cdy;
+    const double bLift = bdx * bdx + bdy * bdy;
+
+    const double adxbdy = adx * bdy;
+    const double bdxady = bdx * ady;
+    const double cLift = cdx * cdx + cdy * cdy;
+
+    const double det = aLift * (bdxcdy - cdxbdy) + bLift * (cdxady - adxcdy) + cLift * (adxbdy - bdxady);
+    const double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * aLift +
+                             (std::abs(cdxady) + std::abs(adxcdy)) * bLift +
+                             (std::abs(adxbdy) + std::abs(bdxady)) * cLift;
+    if (std::abs(det) > s_iccErrBound * permanent)
+        return det;
+    return incircleExact(pa, pb, pc, pd);
+}
+
+double insphere(const double * pa, const double * pb, const double * pc, const double * pd,
+                const double * pe)
+{
+    const double aex = pa[0] - pe[0];
+    const double aey = pa[1] - pe[1];
+    const double aez = pa[2] - pe[2];
+    const double bex = pb[0] - pe[0];
+    const double bey = pb[1] - pe[1];
+    const double bez = pb[2] - pe[2];
+    const double cex = pc[0] - pe[0];
+    const double cey = pc[1] - pe[1];
+    const double cez = pc[2] - pe[2];
+    const double dex = pd[0] - pe[0];
+    const double dey = pd[1] - pe[1];
+    const double dez = pd[2] - pe[2];
+
+    const double aexbey = aex * bey;
+    const double bexaey = bex * aey;
+    const double ab = aexbey - bexaey;
+    const double bexcey = bex * cey;
+    const double cexbey = cex * bey;
+    const double bc = bexcey - cexbey;
+    const double cexdey = cex * dey;
+    const double dexcey = dex * cey;
+    const double cd = cexdey - dexcey;
+    const double dexaey = dex * aey;
+    const double aexdey = aex * dey;
+    const double da = dexaey - aexdey;
+    const double aexcey = aex * cey;
+    const double cexaey = cex * aey;
+    const double ac = aexcey - cexaey;
+    const double bexdey = bex * dey;
+    const double dexbey = dex * bey;
+    const double bd = bexdey - dexbey;
+
+    const double abc = aez * bc - bez * ac + cez * ab;
+    const double bcd = bez * cd - cez * bd + dez * bc;
+    const double cda = cez * da + dez * ac + aez * cd;
+    const double dab = dez * ab + aez * bd + bez * da;
+
+    const double aLift = aex * aex + aey * aey + aez * aez;
+    const double bLift = bex * bex + bey * bey + bez * bez;
+    const double cLift = cex * cex + cey * cey + cez * cez;
+    const double dLift = dex * dex + dey * dey + dez * dez;
+
+    const double det = (dLift * abc - cLift * dab) + (bLift * cda - aLift * bcd);
+
+    const double aezPlus = std::abs(aez);
+    const double bezPlus = std::abs(bez);
+    const double cezPlus = std::abs(cez);
+    const double dezPlus = std::abs(dez);
+    const double aexbeyPlus = std::abs(aexbey);
+    const double bexaeyPlus = std::abs(bexaey);
+    const double bexceyPlus = std::abs(bexcey);
+    const double cexbeyPlus = std::abs(cexbey);
+    const double cexdeyPlus = std::abs(cexdey);
+    const double dexceyPlus = std::abs(dexcey);
+    const double dexaeyPlus = std::abs(dexaey);
+    const double aexdeyPlus = std::abs(aexdey);
+    const double aexceyPlus = std::abs(aexcey);
+    const double cexaeyPlus = std::abs(cexaey);
+    const double bexdeyPlus = std::abs(bexdey);
+    const double dexbeyPlus = std::abs(dexbey);
+    const double permanent =
+        ((cexdeyPlus + dexceyPlus) * bezPlus + (dexbeyPlus + bexdeyPlus) * cezPlus +
+         (bexceyPlus + cexbeyPlus) * dezPlus) * aLift +
+        ((dexaeyPlus + aexdeyPlus) * cezPlus + (aexceyPlus + cexaeyPlus) * dezPlus +
+         (cexdeyPlus + dexceyPlus) * aezPlus) * bLift +
+        ((aexbeyPlus + bexaeyPlus) * dezPlus + (bexdeyPlus + dexbeyPlus) * aezPlus +
+         (dexaeyPlus + aexdeyPlus) * bezPlus) * cLift +
+        ((bexceyPlus + cexbeyPlus) * aezPlus + (cexaeyPlus + aexceyPlus) * bezPlus +
+         (aexbeyPlus + bexaeyPlus) * cezPlus) * dLift;
+    if (std::abs(det) > s_ispErrBound * permanent)
+        return det;
+    return insphereExact(pa, pb, pc, pd, pe);
+}
+
+} //namespace sgl
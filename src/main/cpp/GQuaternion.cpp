@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GQuaternion.h"
+#include "GMatrix4D.h"
+#include "GTransform.h"
+#include "GUtils.h"
+
+namespace sgl
+{
+
+GQuaternion GQuaternion::rotation(double angle, const GVector3D & axis)
+{
+    GVector3D v = axis.normalize();
+    v *= std::sin(0.5 * angle);
+    return GQuaternion(std::cos(0.5 * angle), v);
+}
+
+GQuaternion GQuaternion::fromMatrix(const GMatrix4D & m)
+{
+    // Shepperd's method: the largest of |w|, |x|, |y|, |z| is computed from the diagonal
+    // and the rest from off-diagonal sums/differences to avoid cancellation
+    GQuaternion res;
+    const double trace = m(0, 0) + m(1, 1) + m(2, 2);
+    if (trace > 0.0)
+    {
+        const double s = 2.0 * std::sqrt(1.0 + trace);
+        res.set(0.25 * s, (m(2, 1) - m(1, 2)) / s, (m(0, 2) - m(2, 0)) / s, (m(1, 0) - m(0, 1)) / s);
+    }
+    else if (m(0, 0) > m(1, 1) && m(0, 0) > m(2, 2))
+    {
+        const double s = 2.0 * std::sqrt(1.0 + m(0, 0) - m(1, 1) - m(2, 2));
+        res.set((m(2, 1) - m(1, 2)) / s, 0.25 * s, (m(0, 1) + m(1, 0)) / s, (m(0, 2) + m(2, 0)) / s);
+    }
+    else if (m(1, 1) > m(2, 2))
+    {
+        const double s = 2.0 * std::sqrt(1.0 + m(1, 1) - m(0, 0) - m(2, 2));
+        res.set((m(0, 2) - m(2, 0)) / s, (m(0, 1) + m(1, 0)) / s, 0.25 * s, (m(1, 2) + m(2, 1)) / s);
+    }
+    else
+    {
+        const double s = 2.0 * std::sqrt(1.0 + m(2, 2) - m(0, 0) - m(1, 1));
+        res.set((m(1, 0) - m(0, 1)) / s, (m(0, 2) + m(2, 0)) / s, (m(1, 2) + m(2, 1)) / s, 0.25 * s);
+    }
+    return res.normalize();
+}
+
+bool GQuaternion::isUnit(double tolerance /*= GTolerance::lengthTol()*/) const
+{
+    return equal(norm(), 1.0, tolerance);
+}
+
+GQuaternion & GQuaternion::normalize()
+{
+    const double n = norm();
+    if (equal(n, 0.0, GTolerance::zeroTol()))
+        throw std::logic_error("GQuaternion: division by zero");
+    return *this *= 1.0 / n;
+}
+
+GQuaternion GQuaternion::normalize() const
+{
+    GQuaternion res(*this);
+    res.normalize();
+    return res;
+}
+
+GQuaternion GQuaternion::inverse() const
+{
+    const double sqNorm = squaredNorm();
+    if (equal(sqNorm, 0.0, GTolerance::zeroTol()))
+        throw std::logic_error("GQuaternion: division by zero");
+    return conjugate() * (1.0 / sqNorm);
+}
+
+double GQuaternion::angle() const
+{
+    return 2.0 * std::atan2(vector().length(), w());
+}
+
+GVector3D GQuaternion::axis() const
+{
+    const GVector3D v = vector();
+    const double len = v.length();
+    if (equal(len, 0.0, GTolerance::zeroTol()))
+        return GVector3D::axisX();
+    return GVector3D(v.x() / len, v.y() / len, v.z() / len);
+}
+
+void GQuaternion::rotate(GPoint3D * pPoints, std::size_t count) const
+{
+    // bulk functions apply matrix to row vectors, so rotation block is passed transposed
+    transformPoints(toMatrix().transpose(), pPoints, count);
+}
+
+void GQuaternion::rotate(GPoint3DArray & points) const
+{
+    transformPoints(toMatrix().transpose(), points);
+}
+
+void GQuaternion::rotate(GPointCloud & cloud) const
+{
+    transformPoints(toMatrix().transpose(), cloud);
+}
+
+void GQuaternion::rotate(GVector3D * pVectors, std::size_t count) const
+{
+    transformVectors(toMatrix().transpose(), pVectors, count);
+}
+
+void GQuaternion::rotate(GVector3DArray & vectors) const
+{
+    transformVectors(toMatrix().transpose(), vectors);
+}
+
+GMatrix4D GQuaternion::toMatrix() const
+{
+    const double qw = w(), qx = x(), qy = y(), qz = z();
+    const double xx = qx * qx, yy = qy * qy, zz = qz * qz;
+    const double xy = qx * qy, xz = qx * qz, yz = qy * qz;
+    const double wx = qw * qx, wy = qw * qy, wz = qw * qz;
+    return { 1.0 - 2.0 * (yy + zz),       2.0 * (xy - wz),       2.0 * (xz + wy), 0.0,
+                   2.0 * (xy + wz), 1.0 - 2.0 * (xx + zz),       2.0 * (yz - wx), 0.0,
+                   2.0 * (xz - wy),       2.0 * (yz + wx), 1.0 - 2.0 * (xx + yy), 0.0,
+                               0.0,                   0.0,                   0.0, 1.0 };
+}
+
+bool GQuaternion::equals(const GQuaternion & q, double tolerance /*= GTolerance::lengthTol()*/) const
+{
+    for (std::size_t idx = 0; idx < 4; ++idx)
+        if (!equal(m_coords[idx], q.m_coords[idx], tolerance))
+            return false;
+    return true;
+}
+
+GQuaternion slerp(const GQuaternion & q1, const GQuaternion & q2, double t)
+{
+    double cosTheta = q1.dot(q2);
+    GQuaternion target = q2;
+    if (cosTheta < 0.0)
+    {
+        // q2 and -q2 are the same rotation, take the shortest arc
+        cosTheta = -cosTheta;
+        target *= -1.0;
+    }
+
+    double k1 = 1.0 - t;
+    double k2 = t;
+    const double sinTheta = std::sqrt(std::max(0.0, 1.0 - cosTheta * cosTheta));
+    if (sinTheta > GTolerance::angularTol())
+    {
+        const double theta = std::atan2(sinTheta, cosTheta);
+        k1 = std::sin(k1 * theta) / sinTheta;
+        k2 = std::sin(k2 * theta) / sinTheta;
+    }
+    return (k1 * q1 + k2 * target).normalize();
+}
+
+} //namespace sgl
@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GSimd.h"
+#include "GSimdDefs.h"
+
+#include <atomic>
+
+#if SGL_SIMD_X86 && defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace sgl
+{
+
+static GSimdLevel detectSimdLevel()
+{
+#if SGL_SIMD_X86 && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    const bool sse2 = (info[3] & (1 << 26)) != 0;
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!sse2)
+        return GSimdLevel::Scalar;
+    if (!osxsave || maxLeaf < 7)
+        return GSimdLevel::SSE2;
+
+    const unsigned long long xcr0 = _xgetbv(0);
+    const bool osAvx = (xcr0 & 0x6) == 0x6;
+    const bool osAvx512 = (xcr0 & 0xe6) == 0xe6;
+
+    __cpuidex(info, 7, 0);
+    const bool avx2 = (info[1] & (1 << 5)) != 0;
+    const bool avx512f = (info[1] & (1 << 16)) != 0;
+
+    if (avx512f && avx2 && fma && osAvx512)
+        return GSimdLevel::AVX512;
+    if (avx2 && fma && osAvx)
+        return GSimdLevel::AVX2;
+    return GSimdLevel::SSE2;
+#elif SGL_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return GSimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return GSimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return GSimdLevel::SSE2;
+    return GSimdLevel::Scalar;
+#else
+    return GSimdLevel::Scalar;
+#endif
+}
+
+static std::atomic<int> & activeSimdLevel()
+{
+    static std::atomic<int> s_level{ static_cast<int>(supportedSimdLevel()) };
+    return s_level;
+}
+
+GSimdLevel supportedSimdLevel()
+{
+    static const GSimdLevel s_supported = detectSimdLevel();
+    return s_supported;
+}
+
+GSimdLevel simdLevel()
+{
+    return static_cast<GSimdLevel>(activeSimdLevel().load(std::memory_order_relaxed));
+}
+
+GSimdLevel setSimdLevel(GSimdLevel level)
+{
+    const GSimdLevel res = std::min(level, supportedSimdLevel());
+    activeSimdLevel().store(static_cast<int>(res), std::memory_order_relaxed);
+    return res;
+}
+
+} //namespace sgl
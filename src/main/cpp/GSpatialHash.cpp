@@ -0,0 +1,332 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GSpatialHash.h"
+#include "GPointCloud.h"
+
+namespace sgl
+{
+
+namespace
+{
+
+// End of list of points of cell
+constexpr std::uint32_t END = 0xFFFFFFFFu;
+constexpr std::size_t MIN_SLOTS = 16;
+// Cell coordinates are clamped so that neighbour coordinates don't overflow
+constexpr double MAX_CELL = 4.0e18;
+
+std::size_t hashCell(const std::int64_t * pCell)
+{
+    std::uint64_t hash = static_cast<std::uint64_t>(pCell[0]) * 0x9E3779B97F4A7C15ull ^
+                         static_cast<std::uint64_t>(pCell[1]) * 0xC2B2AE3D27D4EB4Full ^
+                         static_cast<std::uint64_t>(pCell[2]) * 0x165667B19E3779F9ull;
+    hash ^= hash >> 29;
+    hash *= 0xBF58476D1CE4E5B9ull;
+    hash ^= hash >> 32;
+    return static_cast<std::size_t>(hash);
+}
+
+std::int64_t quantize(double value)
+{
+    const double cell = std::floor(value);
+    return static_cast<std::int64_t>(std::max(-MAX_CELL, std::min(MAX_CELL, cell)));
+}
+
+} //namespace
+
+GSpatialHash::GSpatialHash(double cellSize /*= GTolerance::lengthTol()*/)
+    : m_cellSize{ cellSize }, m_invCellSize{ 1.0 / cellSize }
+{
+    if (!(cellSize > 0.0))
+        throw std::invalid_argument("GSpatialHash: cell size must be positive");
+}
+
+double GSpatialHash::cellSize() const
+{
+    return m_cellSize;
+}
+
+std::size_t GSpatialHash::size() const
+{
+    return m_count;
+}
+
+bool GSpatialHash::empty() const
+{
+    return m_count == 0;
+}
+
+void GSpatialHash::clear()
+{
+    m_count = 0;
+    m_cellCount = 0;
+    m_slots.clear();
+    m_coords.clear();
+    m_next.clear();
+    m_alive.clear();
+}
+
+void GSpatialHash::reserve(std::size_t count)
+{
+    m_coords.reserve(3 * count);
+    m_next.reserve(count);
+    m_alive.reserve(count);
+}
+
+std::size_t GSpatialHash::insert(const GPoint3D & pt)
+{
+    return insert(&pt, 1);
+}
+
+std::size_t GSpatialHash::insert(const GPoint3D * pPoints, std::size_t count)
+{
+    const std::size_t first = m_next.size();
+    if (first + count > END)
+        throw std::length_error("GSpatialHash: too many points");
+    reserve(first + count);
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        m_coords.insert(m_coords.end(), pPoints[idx].data(), pPoints[idx].data() + 3);
+        insertId(first + idx);
+    }
+    return first;
+}
+
+std::size_t GSpatialHash::insert(const GPoint3DArray & points)
+{
+    return insert(points.data(), points.size());
+}
+
+std::size_t GSpatialHash::insert(const GPointCloud & cloud)
+{
+    const std::size_t first = m_next.size();
+    if (first + cloud.size() > END)
+        throw std::length_error("GSpatialHash: too many points");
+    reserve(first + cloud.size());
+    for (std::size_t idx = 0; idx < cloud.size(); ++idx)
+    {
+        m_coords.push_back(cloud.xData()[idx]);
+        m_coords.push_back(cloud.yData()[idx]);
+        m_coords.push_back(cloud.zData()[idx]);
+        insertId(first + idx);
+    }
+    return first;
+}
+
+void GSpatialHash::remove(std::size_t id)
+{
+    if (!contains(id))
+        throw std::out_of_range("GSpatialHash: invalid point id");
+
+    std::int64_t cell[3];
+    cellOf(&m_coords[3 * id], cell);
+    std::size_t slot = findSlot(cell);
+    std::uint32_t * pLink = &m_slots[slot].head;
+    while (*pLink != id)
+        pLink = &m_next[*pLink];
+    *pLink = m_next[id];
+    m_alive[id] = 0;
+    --m_count;
+    if (--m_slots[slot].count != 0)
+        return;
+
+    // Backward shift deletion keeps probe sequences without tombstones
+    --m_cellCount;
+    const std::size_t mask = m_slots.size() - 1;
+    for (std::size_t next = (slot + 1) & mask; m_slots[next].count != 0; next = (next + 1) & mask)
+    {
+        const std::size_t home = hashCell(m_slots[next].cell) & mask;
+        // Entry may move to the freed slot if its home is not within (slot, next]
+        const bool between = slot <= next ? (home > slot && home <= next) : (home > slot || home <= next);
+        if (!between)
+        {
+            m_slots[slot] = m_slots[next];
+            slot = next;
+        }
+    }
+    m_slots[slot].count = 0;
+}
+
+bool GSpatialHash::contains(std::size_t id) const
+{
+    return id < m_alive.size() && m_alive[id] != 0;
+}
+
+GPoint3D GSpatialHash::point(std::size_t id) const
+{
+    if (!contains(id))
+        throw std::out_of_range("GSpatialHash: invalid point id");
+    return GPoint3D(m_coords[3 * id], m_coords[3 * id + 1], m_coords[3 * id + 2]);
+}
+
+std::size_t GSpatialHash::neighbours(const GPoint3D & pt, double radius, std::vector<std::size_t> & result) const
+{
+    const std::size_t initialSize = result.size();
+    const double radius2 = radius * radius;
+    visit(pt, radius, [&result, radius2](std::size_t id, double distance2)
+    {
+        if (distance2 <= radius2)
+            result.push_back(id);
+    });
+    return result.size() - initialSize;
+}
+
+std::vector<std::size_t> GSpatialHash::neighbours(const GPoint3D & pt) const
+{
+    std::vector<std::size_t> res;
+    neighbours(pt, m_cellSize, res);
+    return res;
+}
+
+std::size_t GSpatialHash::nearest(const GPoint3D & pt, double radius, double & distance) const
+{
+    std::size_t res = npos;
+    double best = radius * radius;
+    visit(pt, radius, [&res, &best](std::size_t id, double distance2)
+    {
+        if (distance2 < best || (res == npos && distance2 <= best))
+        {
+            best = distance2;
+            res = id;
+        }
+    });
+    if (res != npos)
+        distance = std::sqrt(best);
+    return res;
+}
+
+void GSpatialHash::cellOf(const double * pCoord, std::int64_t * pCell) const
+{
+    for (std::size_t axis = 0; axis < 3; ++axis)
+        pCell[axis] = quantize(pCoord[axis] * m_invCellSize);
+}
+
+// Returns slot of cell or empty slot where it has to be placed
+std::size_t GSpatialHash::findSlot(const std::int64_t * pCell) const
+{
+    const std::size_t mask = m_slots.size() - 1;
+    std::size_t slot = hashCell(pCell) & mask;
+    while (m_slots[slot].count != 0 && !std::equal(pCell, pCell + 3, m_slots[slot].cell))
+        slot = (slot + 1) & mask;
+    return slot;
+}
+
+void GSpatialHash::insertId(std::size_t id)
+{
+    grow(m_cellCount + 1);
+    m_next.push_back(END);
+    m_alive.push_back(1);
+
+    std::int64_t cell[3];
+    cellOf(&m_coords[3 * id], cell);
+    Slot & slot = m_slots[findSlot(cell)];
+    if (slot.count == 0)
+    {
+        std::copy_n(cell, 3, slot.cell);
+        slot.head = END;
+        ++m_cellCount;
+    }
+    m_next[id] = slot.head;
+    slot.head = static_cast<std::uint32_t>(id);
+    ++slot.count;
+    ++m_count;
+}
+
+// Keeps load factor not greater than 1/2 for count cells
+void GSpatialHash::grow(std::size_t count)
+{
+    if (!m_slots.empty() && 2 * count <= m_slots.size())
+        return;
+    std::size_t capacity = MIN_SLOTS;
+    while (capacity < 2 * count)
+        capacity *= 2;
+    if (capacity <= m_slots.size())
+        return;
+
+    std::vector<Slot> slots(capacity, Slot{ { 0, 0, 0 }, END, 0 });
+    std::swap(slots, m_slots);
+    for (const auto & slot : slots)
+    {
+        if (slot.count != 0)
+            m_slots[findSlot(slot.cell)] = slot;
+    }
+}
+
+// Calls func(id, squared distance) for points of cells overlapping cube [pt - radius, pt + radius]
+template<typename Func>
+void GSpatialHash::visit(const GPoint3D & pt, double radius, Func && func) const
+{
+    if (m_count == 0 || !(radius >= 0.0))
+        return;
+
+    const double query[3] = { pt[0], pt[1], pt[2] };
+    std::int64_t lo[3];
+    std::int64_t hi[3];
+    double cellRange = 1.0;
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        lo[axis] = quantize((query[axis] - radius) * m_invCellSize);
+        hi[axis] = quantize((query[axis] + radius) * m_invCellSize);
+        cellRange *= static_cast<double>(hi[axis] - lo[axis] + 1);
+    }
+    const auto visitCell = [&](const Slot & slot)
+    {
+        for (std::uint32_t id = slot.head; id != END; id = m_next[id])
+        {
+            const double * pCoord = &m_coords[3 * id];
+            const double dx = pCoord[0] - query[0];
+            const double dy = pCoord[1] - query[1];
+            const double dz = pCoord[2] - query[2];
+            func(static_cast<std::size_t>(id), dx * dx + dy * dy + dz * dz);
+        }
+    };
+
+    // Large radius: scanning non-empty cells is cheaper than probing the range
+    if (cellRange > static_cast<double>(m_cellCount))
+    {
+        for (const auto & slot : m_slots)
+        {
+            if (slot.count == 0)
+                continue;
+            bool inside = true;
+            for (std::size_t axis = 0; axis < 3; ++axis)
+                inside = inside && slot.cell[axis] >= lo[axis] && slot.cell[axis] <= hi[axis];
+            if (inside)
+                visitCell(slot);
+        }
+        return;
+    }
+
+    std::int64_t cell[3];
+    for (cell[0] = lo[0]; cell[0] <= hi[0]; ++cell[0])
+    {
+        for (cell[1] = lo[1]; cell[1] <= hi[1]; ++cell[1])
+        {
+            for (cell[2] = lo[2]; cell[2] <= hi[2]; ++cell[2])
+            {
+                const Slot & slot = m_slots[findSlot(cell)];
+                if (slot.count != 0)
+                    visitCell(slot);
+            }
+        }
+    }
+}
+
+} //namespace sgl
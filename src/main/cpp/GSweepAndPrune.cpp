@@ -0,0 +1,340 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GSweepAndPrune.h"
+
+namespace sgl
+{
+
+namespace
+{
+
+// Object states
+constexpr std::uint8_t FREE = 0;
+constexpr std::uint8_t ADDED = 1;
+constexpr std::uint8_t ACTIVE = 2;
+constexpr std::uint8_t REMOVED = 3;
+
+std::uint64_t pairKey(std::size_t id1, std::size_t id2)
+{
+    if (id1 > id2)
+        std::swap(id1, id2);
+    return (static_cast<std::uint64_t>(id1) << 32) | static_cast<std::uint64_t>(id2);
+}
+
+GSweepAndPrune::Pair pairOf(std::uint64_t key)
+{
+    return { static_cast<std::size_t>(key >> 32), static_cast<std::size_t>(key & 0xFFFFFFFFu) };
+}
+
+// Endpoint moves per endpoint allowed to insertion sort before the axis is sorted from scratch
+constexpr std::size_t SHIFT_BUDGET = 8;
+
+// Order of endpoints on axis: equal values keep minimums before maximums, so touching intervals overlap
+template<typename Endpoint>
+bool endpointLess(const Endpoint & endpoint1, const Endpoint & endpoint2)
+{
+    return endpoint1.value < endpoint2.value ||
+           (endpoint1.value == endpoint2.value && !endpoint1.isMax && endpoint2.isMax);
+}
+
+// Insertion sort, cheap for small moves between frames. Overlap on axis changes only when minimum
+// and maximum of different objects swap, such pairs are candidates. Returns false if sort needs more
+// than SHIFT_BUDGET moves per endpoint, then endpoints are left partially sorted
+template<typename Endpoint>
+bool insertionSort(std::vector<Endpoint> & endpoints, std::vector<std::uint64_t> & candidates)
+{
+    std::size_t budget = SHIFT_BUDGET * endpoints.size();
+    for (std::size_t idx = 1; idx < endpoints.size(); ++idx)
+    {
+        const Endpoint endpoint = endpoints[idx];
+        std::size_t pos = idx;
+        for (; pos > 0 && endpointLess(endpoint, endpoints[pos - 1]); --pos)
+        {
+            const Endpoint & prev = endpoints[pos - 1];
+            if (prev.isMax != endpoint.isMax && prev.id != endpoint.id)
+                candidates.push_back(pairKey(prev.id, endpoint.id));
+            endpoints[pos] = prev;
+        }
+        endpoints[pos] = endpoint;
+        if (idx - pos > budget)
+            return false;
+        budget -= idx - pos;
+    }
+    return true;
+}
+
+} //namespace
+
+GSweepAndPrune::GSweepAndPrune(double tolerance /*= GTolerance::zeroTol()*/)
+    : m_tolerance{ tolerance }
+{
+    if (tolerance < 0.0)
+        throw std::invalid_argument("GSweepAndPrune: negative tolerance");
+}
+
+std::size_t GSweepAndPrune::add(const GBox3D & box)
+{
+    std::size_t id = m_boxes.size();
+    if (m_freeIds.empty())
+    {
+        if (id > 0xFFFFFFFFu)
+            throw std::length_error("GSweepAndPrune: too many objects");
+        m_boxes.push_back(box);
+        m_state.push_back(ADDED);
+    }
+    else
+    {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+        m_boxes[id] = box;
+        m_state[id] = ADDED;
+    }
+    ++m_count;
+    return id;
+}
+
+void GSweepAndPrune::remove(std::size_t id)
+{
+    checkId(id);
+    --m_count;
+    // Object added after last update() has no endpoints and pairs yet
+    m_state[id] = m_state[id] == ADDED ? FREE : REMOVED;
+    if (m_state[id] == FREE)
+        m_freeIds.push_back(id);
+}
+
+void GSweepAndPrune::setBox(std::size_t id, const GBox3D & box)
+{
+    checkId(id);
+    m_boxes[id] = box;
+}
+
+const GBox3D & GSweepAndPrune::box(std::size_t id) const
+{
+    checkId(id);
+    return m_boxes[id];
+}
+
+std::size_t GSweepAndPrune::size() const
+{
+    return m_count;
+}
+
+double GSweepAndPrune::tolerance() const
+{
+    return m_tolerance;
+}
+
+void GSweepAndPrune::update()
+{
+    m_added.clear();
+    m_removed.clear();
+
+    // Pairs of removed objects
+    for (auto it = m_pairs.begin(); it != m_pairs.end();)
+    {
+        const Pair pair = pairOf(*it);
+        if (m_state[pair.first] == REMOVED || m_state[pair.second] == REMOVED)
+        {
+            m_removed.push_back(pair);
+            it = m_pairs.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    std::vector<std::uint64_t> candidates;
+    std::vector<Endpoint> added;
+    bool rebuild = false;
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        auto & endpoints = m_endpoints[axis];
+
+        // Refresh values and drop endpoints of removed objects
+        std::size_t count = 0;
+        for (const auto & endpoint : endpoints)
+        {
+            if (m_state[endpoint.id] != ACTIVE)
+                continue;
+            endpoints[count] = endpoint;
+            endpoints[count].value = endpoint.isMax ? maxValue(endpoint.id, axis) : minValue(endpoint.id, axis);
+            ++count;
+        }
+        endpoints.resize(count);
+
+        // Large moves make every axis sorted from scratch and all pairs found by sweep
+        if (!rebuild)
+            rebuild = !insertionSort(endpoints, candidates);
+        if (rebuild)
+            std::sort(endpoints.begin(), endpoints.end(), endpointLess<Endpoint>);
+
+        // New objects are sorted in bulk and merged, their pairs are found by sweep below
+        added.clear();
+        for (std::size_t id = 0; id < m_boxes.size(); ++id)
+        {
+            if (m_state[id] != ADDED)
+                continue;
+            added.push_back({ minValue(id, axis), static_cast<std::uint32_t>(id), false });
+            added.push_back({ maxValue(id, axis), static_cast<std::uint32_t>(id), true });
+        }
+        std::sort(added.begin(), added.end(), endpointLess<Endpoint>);
+        endpoints.insert(endpoints.end(), added.begin(), added.end());
+        std::inplace_merge(endpoints.begin(), endpoints.end() - static_cast<std::ptrdiff_t>(added.size()),
+                           endpoints.end(), endpointLess<Endpoint>);
+    }
+    if (rebuild)
+    {
+        // Known pairs are retested to report the ones which stopped overlapping
+        candidates.assign(m_pairs.begin(), m_pairs.end());
+        sweep(candidates, true);
+    }
+    else if (!added.empty())
+    {
+        sweep(candidates, false);
+    }
+
+    for (std::size_t id = 0; id < m_boxes.size(); ++id)
+    {
+        if (m_state[id] == ADDED)
+        {
+            m_state[id] = ACTIVE;
+        }
+        else if (m_state[id] == REMOVED)
+        {
+            m_state[id] = FREE;
+            m_freeIds.push_back(id);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    for (const auto key : candidates)
+    {
+        const Pair pair = pairOf(key);
+        const bool overlapping = overlaps(pair.first, pair.second);
+        const bool known = m_pairs.count(key) != 0;
+        if (overlapping && !known)
+        {
+            m_pairs.insert(key);
+            m_added.push_back(pair);
+        }
+        else if (!overlapping && known)
+        {
+            m_pairs.erase(key);
+            m_removed.push_back(pair);
+        }
+    }
+    std::sort(m_removed.begin(), m_removed.end());
+}
+
+const std::vector<GSweepAndPrune::Pair> & GSweepAndPrune::addedPairs() const
+{
+    return m_added;
+}
+
+const std::vector<GSweepAndPrune::Pair> & GSweepAndPrune::removedPairs() const
+{
+    return m_removed;
+}
+
+std::vector<GSweepAndPrune::Pair> GSweepAndPrune::pairs() const
+{
+    std::vector<Pair> res;
+    res.reserve(m_pairs.size());
+    for (const auto key : m_pairs)
+        res.push_back(pairOf(key));
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+// Finds overlapping pairs with at least one new object (any pairs if 'all' is set) by one pass over endpoints
+// of the first axis. Objects whose interval is open at the current endpoint overlap it on the first axis;
+// they are kept in separate lists of new and old ones with their bounds on the other axes, so old objects
+// are never tested against each other and tests don't touch the boxes.
+void GSweepAndPrune::sweep(std::vector<std::uint64_t> & candidates, bool all) const
+{
+    struct Open
+    {
+        std::uint32_t id;
+        double lo[2];
+        double hi[2];
+    };
+
+    std::vector<Open> open[2];
+    std::vector<std::size_t> slots(m_boxes.size());
+    for (const Endpoint & endpoint : m_endpoints[0])
+    {
+        const bool isNew = all || m_state[endpoint.id] == ADDED;
+        auto & list = open[isNew ? 1 : 0];
+        if (endpoint.isMax)
+        {
+            const std::size_t slot = slots[endpoint.id];
+            list[slot] = list.back();
+            slots[list[slot].id] = slot;
+            list.pop_back();
+            continue;
+        }
+        const Open current = { endpoint.id, { minValue(endpoint.id, 1), minValue(endpoint.id, 2) },
+                               { maxValue(endpoint.id, 1), maxValue(endpoint.id, 2) } };
+        for (std::size_t kind = isNew ? 0 : 1; kind < 2; ++kind)
+        {
+            for (const Open & other : open[kind])
+            {
+                if (!(other.hi[0] < current.lo[0] || current.hi[0] < other.lo[0] ||
+                      other.hi[1] < current.lo[1] || current.hi[1] < other.lo[1]))
+                    candidates.push_back(pairKey(current.id, other.id));
+            }
+        }
+        slots[endpoint.id] = list.size();
+        list.push_back(current);
+    }
+}
+
+// Tolerance is applied to minimums: [a - tolerance, b], as GInterval::intersects shifts the other bound
+double GSweepAndPrune::minValue(std::size_t id, std::size_t axis) const
+{
+    return m_boxes[id][axis].from() - m_tolerance;
+}
+
+double GSweepAndPrune::maxValue(std::size_t id, std::size_t axis) const
+{
+    return m_boxes[id][axis].to();
+}
+
+// Same predicate as the endpoint order, so sweep and overlap test never disagree
+bool GSweepAndPrune::overlaps(std::size_t id1, std::size_t id2) const
+{
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        if (maxValue(id1, axis) < minValue(id2, axis) || maxValue(id2, axis) < minValue(id1, axis))
+            return false;
+    }
+    return true;
+}
+
+void GSweepAndPrune::checkId(std::size_t id) const
+{
+    if (id >= m_boxes.size() || m_state[id] == FREE || m_state[id] == REMOVED)
+        throw std::out_of_range("GSweepAndPrune: invalid object id");
+}
+
+} //namespace sgl
@@ -22,39 +22,31 @@
 namespace sgl
 {
 
-static double s_lengthTolerance = 1.0e-6;
-static double s_angularTolerance = 1.0e-10;
-static double s_zeroTolerance = 1.0e-30;
+std::atomic<double> GTolerance::s_lengthTol{ 1.0e-6 };
+std::atomic<double> GTolerance::s_angularTol{ 1.0e-10 };
+std::atomic<double> GTolerance::s_zeroTol{ 1.0e-30 };
 
-double GTolerance::lengthTol()
+#ifdef _WIN32
+GTolerance::State & GTolerance::threadState()
 {
-    return s_lengthTolerance;
-}
-
-double GTolerance::angularTol()
-{
-    return s_angularTolerance;
-}
-
-double GTolerance::zeroTol()
-{
-    return s_zeroTolerance;
+    static thread_local State s_state{ 0.0, 0.0, 0.0, false };
+    return s_state;
 }
+#endif
 
 void GTolerance::setLengthTol(double tolerance)
 {
-    s_lengthTolerance = tolerance;
+    s_lengthTol.store(tolerance, std::memory_order_relaxed);
 }
 
 void GTolerance::setAngularTol(double tolerance)
 {
-    s_angularTolerance = tolerance;
+    s_angularTol.store(tolerance, std::memory_order_relaxed);
 }
 
 void GTolerance::setZeroTol(double tolerance)
 {
-    s_zeroTolerance = tolerance;
+    s_zeroTol.store(tolerance, std::memory_order_relaxed);
 }
 
-
 } //namespace sgl
@@ -0,0 +1,311 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GTransform.h"
+#include "GMatrix4D.h"
+#include "GPoint3D.h"
+#include "GPointCloud.h"
+#include "GSimd.h"
+#include "GSimdDefs.h"
+#include "GVector3D.h"
+
+namespace sgl
+{
+
+namespace
+{
+
+// Transformation coefficients: c[3 * i + j] = m(i, j) for i in [0, 3], j in [0, 2].
+// Point (x, y, z) is transformed to x * row0 + y * row1 + z * row2 + row3,
+// row3 is zeroed for vectors.
+struct Coefs
+{
+    double c[12];
+};
+
+Coefs makeCoefs(const GMatrix4D & m, bool translate)
+{
+    const double * pM = m.data();
+    Coefs res;
+    for (std::size_t row = 0; row < 4; ++row)
+    {
+        for (std::size_t col = 0; col < 3; ++col)
+            res.c[3 * row + col] = (row < 3 || translate) ? pM[4 * row + col] : 0.0;
+    }
+    return res;
+}
+
+inline void transformOne(const double * c, const double * pSrc, double * pDst)
+{
+    const double x = pSrc[0], y = pSrc[1], z = pSrc[2];
+    pDst[0] = c[0] * x + c[3] * y + c[6] * z + c[9];
+    pDst[1] = c[1] * x + c[4] * y + c[7] * z + c[10];
+    pDst[2] = c[2] * x + c[5] * y + c[8] * z + c[11];
+}
+
+inline void transformOneSoA(const double * c, double & x, double & y, double & z)
+{
+    const double px = x, py = y, pz = z;
+    x = c[0] * px + c[3] * py + c[6] * pz + c[9];
+    y = c[1] * px + c[4] * py + c[7] * pz + c[10];
+    z = c[2] * px + c[5] * py + c[8] * pz + c[11];
+}
+
+void transformAoSScalar(const Coefs & coefs, const double * pSrc, double * pDst, std::size_t count)
+{
+    for (std::size_t idx = 0; idx < count; ++idx, pSrc += 3, pDst += 3)
+        transformOne(coefs.c, pSrc, pDst);
+}
+
+void transformSoAScalar(const Coefs & coefs, double * pX, double * pY, double * pZ, std::size_t count)
+{
+    for (std::size_t idx = 0; idx < count; ++idx)
+        transformOneSoA(coefs.c, pX[idx], pY[idx], pZ[idx]);
+}
+
+#if SGL_SIMD_X86
+
+SGL_TARGET_SSE2
+void transformAoSSSE2(const Coefs & coefs, const double * pSrc, double * pDst, std::size_t count)
+{
+    const double * c = coefs.c;
+    const __m128d r0 = _mm_loadu_pd(c + 0);
+    const __m128d r1 = _mm_loadu_pd(c + 3);
+    const __m128d r2 = _mm_loadu_pd(c + 6);
+    const __m128d r3 = _mm_loadu_pd(c + 9);
+    for (std::size_t idx = 0; idx < count; ++idx, pSrc += 3, pDst += 3)
+    {
+        const double x = pSrc[0], y = pSrc[1], z = pSrc[2];
+        __m128d xy = _mm_add_pd(_mm_mul_pd(_mm_set1_pd(x), r0), _mm_mul_pd(_mm_set1_pd(y), r1));
+        xy = _mm_add_pd(xy, _mm_add_pd(_mm_mul_pd(_mm_set1_pd(z), r2), r3));
+        pDst[2] = c[2] * x + c[5] * y + c[8] * z + c[11];
+        _mm_storeu_pd(pDst, xy);
+    }
+}
+
+SGL_TARGET_SSE2
+void transformSoASSE2(const Coefs & coefs, double * pX, double * pY, double * pZ, std::size_t count)
+{
+    __m128d c[12];
+    for (std::size_t idx = 0; idx < 12; ++idx)
+        c[idx] = _mm_set1_pd(coefs.c[idx]);
+
+    std::size_t idx = 0;
+    for (; idx + 2 <= count; idx += 2)
+    {
+        const __m128d x = _mm_loadu_pd(pX + idx);
+        const __m128d y = _mm_loadu_pd(pY + idx);
+        const __m128d z = _mm_loadu_pd(pZ + idx);
+        const __m128d rx = _mm_add_pd(_mm_add_pd(_mm_mul_pd(c[0], x), _mm_mul_pd(c[3], y)), _mm_add_pd(_mm_mul_pd(c[6], z), c[9]));
+        const __m128d ry = _mm_add_pd(_mm_add_pd(_mm_mul_pd(c[1], x), _mm_mul_pd(c[4], y)), _mm_add_pd(_mm_mul_pd(c[7], z), c[10]));
+        const __m128d rz = _mm_add_pd(_mm_add_pd(_mm_mul_pd(c[2], x), _mm_mul_pd(c[5], y)), _mm_add_pd(_mm_mul_pd(c[8], z), c[11]));
+        _mm_storeu_pd(pX + idx, rx);
+        _mm_storeu_pd(pY + idx, ry);
+        _mm_storeu_pd(pZ + idx, rz);
+    }
+    for (; idx < count; ++idx)
+        transformOneSoA(coefs.c, pX[idx], pY[idx], pZ[idx]);
+}
+
+SGL_TARGET_AVX2
+inline void transformBlockAVX2(const __m256d * c, __m256d & x, __m256d & y, __m256d & z)
+{
+    const __m256d rx = _mm256_fmadd_pd(c[0], x, _mm256_fmadd_pd(c[3], y, _mm256_fmadd_pd(c[6], z, c[9])));
+    const __m256d ry = _mm256_fmadd_pd(c[1], x, _mm256_fmadd_pd(c[4], y, _mm256_fmadd_pd(c[7], z, c[10])));
+    const __m256d rz = _mm256_fmadd_pd(c[2], x, _mm256_fmadd_pd(c[5], y, _mm256_fmadd_pd(c[8], z, c[11])));
+    x = rx;
+    y = ry;
+    z = rz;
+}
+
+SGL_TARGET_AVX2
+void transformAoSAVX2(const Coefs & coefs, const double * pSrc, double * pDst, std::size_t count)
+{
+    __m256d c[12];
+    for (std::size_t idx = 0; idx < 12; ++idx)
+        c[idx] = _mm256_set1_pd(coefs.c[idx]);
+
+    std::size_t idx = 0;
+    for (; idx + 4 <= count; idx += 4, pSrc += 12, pDst += 12)
+    {
+        __m256d x;
+        __m256d y;
+        __m256d z;
+        loadTriplesAVX2(pSrc, x, y, z);
+        transformBlockAVX2(c, x, y, z);
+        storeTriplesAVX2(pDst, x, y, z);
+    }
+    for (; idx < count; ++idx, pSrc += 3, pDst += 3)
+        transformOne(coefs.c, pSrc, pDst);
+}
+
+SGL_TARGET_AVX2
+void transformSoAAVX2(const Coefs & coefs, double * pX, double * pY, double * pZ, std::size_t count)
+{
+    __m256d c[12];
+    for (std::size_t idx = 0; idx < 12; ++idx)
+        c[idx] = _mm256_set1_pd(coefs.c[idx]);
+
+    std::size_t idx = 0;
+    for (; idx + 4 <= count; idx += 4)
+    {
+        __m256d x = _mm256_loadu_pd(pX + idx);
+        __m256d y = _mm256_loadu_pd(pY + idx);
+        __m256d z = _mm256_loadu_pd(pZ + idx);
+        transformBlockAVX2(c, x, y, z);
+        _mm256_storeu_pd(pX + idx, x);
+        _mm256_storeu_pd(pY + idx, y);
+        _mm256_storeu_pd(pZ + idx, z);
+    }
+    for (; idx < count; ++idx)
+        transformOneSoA(coefs.c, pX[idx], pY[idx], pZ[idx]);
+}
+
+SGL_TARGET_AVX512
+inline void transformBlockAVX512(const __m512d * c, __m512d & x, __m512d & y, __m512d & z)
+{
+    const __m512d rx = _mm512_fmadd_pd(c[0], x, _mm512_fmadd_pd(c[3], y, _mm512_fmadd_pd(c[6], z, c[9])));
+    const __m512d ry = _mm512_fmadd_pd(c[1], x, _mm512_fmadd_pd(c[4], y, _mm512_fmadd_pd(c[7], z, c[10])));
+    const __m512d rz = _mm512_fmadd_pd(c[2], x, _mm512_fmadd_pd(c[5], y, _mm512_fmadd_pd(c[8], z, c[11])));
+    x = rx;
+    y = ry;
+    z = rz;
+}
+
+SGL_TARGET_AVX512
+void transformAoSAVX512(const Coefs & coefs, const double * pSrc, double * pDst, std::size_t count)
+{
+    __m512d c[12];
+    for (std::size_t idx = 0; idx < 12; ++idx)
+        c[idx] = _mm512_set1_pd(coefs.c[idx]);
+
+    std::size_t idx = 0;
+    for (; idx + 8 <= count; idx += 8, pSrc += 24, pDst += 24)
+    {
+        __m512d x;
+        __m512d y;
+        __m512d z;
+        loadTriplesAVX512(pSrc, x, y, z);
+        transformBlockAVX512(c, x, y, z);
+        storeTriplesAVX512(pDst, x, y, z);
+    }
+    transformAoSAVX2(coefs, pSrc, pDst, count - idx);
+}
+
+SGL_TARGET_AVX512
+void transformSoAAVX512(const Coefs & coefs, double * pX, double * pY, double * pZ, std::size_t count)
+{
+    __m512d c[12];
+    for (std::size_t idx = 0; idx < 12; ++idx)
+        c[idx] = _mm512_set1_pd(coefs.c[idx]);
+
+    std::size_t idx = 0;
+    for (; idx + 8 <= count; idx += 8)
+    {
+        __m512d x = _mm512_loadu_pd(pX + idx);
+        __m512d y = _mm512_loadu_pd(pY + idx);
+        __m512d z = _mm512_loadu_pd(pZ + idx);
+        transformBlockAVX512(c, x, y, z);
+        _mm512_storeu_pd(pX + idx, x);
+        _mm512_storeu_pd(pY + idx, y);
+        _mm512_storeu_pd(pZ + idx, z);
+    }
+    transformSoAAVX2(coefs, pX + idx, pY + idx, pZ + idx, count - idx);
+}
+
+#endif //SGL_SIMD_X86
+
+void transformAoS(const GMatrix4D & m, bool translate, const double * pSrc, double * pDst, std::size_t count)
+{
+    const Coefs coefs = makeCoefs(m, translate);
+    switch (simdLevel())
+    {
+#if SGL_SIMD_X86
+        case GSimdLevel::AVX512: return transformAoSAVX512(coefs, pSrc, pDst, count);
+        case GSimdLevel::AVX2: return transformAoSAVX2(coefs, pSrc, pDst, count);
+        case GSimdLevel::SSE2: return transformAoSSSE2(coefs, pSrc, pDst, count);
+#endif
+        default: return transformAoSScalar(coefs, pSrc, pDst, count);
+    }
+}
+
+void transformSoA(const GMatrix4D & m, bool translate, double * pX, double * pY, double * pZ, std::size_t count)
+{
+    const Coefs coefs = makeCoefs(m, translate);
+    switch (simdLevel())
+    {
+#if SGL_SIMD_X86
+        case GSimdLevel::AVX512: return transformSoAAVX512(coefs, pX, pY, pZ, count);
+        case GSimdLevel::AVX2: return transformSoAAVX2(coefs, pX, pY, pZ, count);
+        case GSimdLevel::SSE2: return transformSoASSE2(coefs, pX, pY, pZ, count);
+#endif
+        default: return transformSoAScalar(coefs, pX, pY, pZ, count);
+    }
+}
+
+} //namespace
+
+void transformPoints(const GMatrix4D & m, GPoint3D * pPoints, std::size_t count)
+{
+    transformPoints(m, pPoints, pPoints, count);
+}
+
+void transformPoints(const GMatrix4D & m, const GPoint3D * pSrc, GPoint3D * pDst, std::size_t count)
+{
+    if (count != 0)
+        transformAoS(m, true, pSrc->data(), pDst->data(), count);
+}
+
+void transformPoints(const GMatrix4D & m, GPoint3DArray & points)
+{
+    transformPoints(m, points.data(), points.size());
+}
+
+void transformPoints(const GMatrix4D & m, double * pX, double * pY, double * pZ, std::size_t count)
+{
+    transformSoA(m, true, pX, pY, pZ, count);
+}
+
+void transformPoints(const GMatrix4D & m, GPointCloud & cloud)
+{
+    transformSoA(m, true, cloud.xData(), cloud.yData(), cloud.zData(), cloud.size());
+}
+
+void transformVectors(const GMatrix4D & m, GVector3D * pVectors, std::size_t count)
+{
+    transformVectors(m, pVectors, pVectors, count);
+}
+
+void transformVectors(const GMatrix4D & m, const GVector3D * pSrc, GVector3D * pDst, std::size_t count)
+{
+    if (count != 0)
+        transformAoS(m, false, pSrc->data(), pDst->data(), count);
+}
+
+void transformVectors(const GMatrix4D & m, GVector3DArray & vectors)
+{
+    transformVectors(m, vectors.data(), vectors.size());
+}
+
+void transformVectors(const GMatrix4D & m, double * pX, double * pY, double * pZ, std::size_t count)
+{
+    transformSoA(m, false, pX, pY, pZ, count);
+}
+
+} //namespace sgl
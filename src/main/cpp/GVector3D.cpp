@@ -24,243 +24,127 @@
 namespace sgl
 {
 
-const GVector3D & GVector3D::axisX()
+template<typename T>
+const GVector3DT<T> & GVector3DT<T>::axisX()
 {
-    static GVector3D s_axisX{ 1.0, 0.0, 0.0 };
+    static GVector3DT<T> s_axisX{ 1.0, 0.0, 0.0 };
     return s_axisX;
 }
 
-const GVector3D & GVector3D::axisY()
+template<typename T>
+const GVector3DT<T> & GVector3DT<T>::axisY()
 {
-    static GVector3D s_axisY{ 0.0, 1.0, 0.0 };
+    static GVector3DT<T> s_axisY{ 0.0, 1.0, 0.0 };
     return s_axisY;
 }
 
-const GVector3D & GVector3D::axisZ()
+template<typename T>
+const GVector3DT<T> & GVector3DT<T>::axisZ()
 {
-    static GVector3D s_axisZ{ 0.0, 0.0, 1.0 };
+    static GVector3DT<T> s_axisZ{ 0.0, 0.0, 1.0 };
     return s_axisZ;
 }
 
-GVector3D::GVector3D() = default;
-
-GVector3D::GVector3D(const GVector3D & other) = default;
-
-GVector3D::GVector3D(GVector3D && other) noexcept = default;
-
-GVector3D::GVector3D(double x, double y, double z)
-    : m_x{ x }, m_y{ y }, m_z{ z }
-{}
-
-GVector3D::GVector3D(double * pCoords)
-    : m_x{ *(pCoords++) }, m_y{ *(pCoords++) }, m_z{ *pCoords }
-{}
-
-GVector3D::GVector3D(std::initializer_list<double> l)
-{
-    auto it = l.begin();
-    set(*it, *(it + 1), *(it + 2));
-}
-
-GVector3D::~GVector3D() = default;
-
-double GVector3D::x() const
-{
-    return m_x;
-}
-
-void GVector3D::setX(double newX)
-{
-    m_x = newX;
-}
-
-double GVector3D::y() const
-{
-    return m_y;
-}
-
-void GVector3D::setY(double newY)
-{
-    m_y = newY;
-}
-
-double GVector3D::z() const
-{
-    return m_z;
-}
-
-void GVector3D::setZ(double newZ)
-{
-    m_z = newZ;
-}
-
-void GVector3D::set(double newX, double newY, double newZ)
-{
-    m_x = newX;
-    m_y = newY;
-    m_z = newZ;
-}
-
-double GVector3D::operator[](std::size_t coordIdx) const
-{
-    switch (coordIdx)
-    {
-        case 0: return m_x;
-        case 1: return m_y;
-        case 2: return m_z;
-        default: break;
-    }
-    throw std::invalid_argument("GVector3D: index out of bounds");
-}
-
-double & GVector3D::operator[](std::size_t coordIdx)
-{
-    switch (coordIdx)
-    {
-        case 0: return m_x;
-        case 1: return m_y;
-        case 2: return m_z;
-        default: break;
-    }
-    throw std::invalid_argument("GVector3D: index out of bounds");
-}
-
-double GVector3D::length() const
-{
-    return std::sqrt(m_x * m_x + m_y * m_y + m_z * m_z);
-}
-
-bool GVector3D::isZero(double tolerance /*= GTolerance::lengthTol()*/) const
+template<typename T>
+bool GVector3DT<T>::isZero(double tolerance /*= GTolerance::lengthTol()*/) const
 {
     return equal(length(), 0.0, tolerance);
 }
 
-bool GVector3D::isUnit(double tolerance /*= GTolerance::lengthTol()*/) const
+template<typename T>
+bool GVector3DT<T>::isUnit(double tolerance /*= GTolerance::lengthTol()*/) const
 {
     return equal(length(), 1.0, tolerance);
 }
 
-GVector3D & GVector3D::normalize()
+template<typename T>
+GVector3DT<T> & GVector3DT<T>::normalize()
 {
-    double len = length();
+    T len = length();
     if (equal(len, 0, GTolerance::zeroTol()))
         throw std::logic_error("GVector3D: division by zero");
     *this /= len;
     return *this;
 }
 
-GVector3D GVector3D::normalize() const
+template<typename T>
+GVector3DT<T> GVector3DT<T>::normalize() const
 {
-    GVector3D res(*this);
+    GVector3DT<T> res(*this);
     res.normalize();
     return res;
 }
 
-bool GVector3D::equals(const GVector3D & v, double tolerance /*= GTolerance::lengthTol()*/) const
+template<typename T>
+bool GVector3DT<T>::equals(const GVector3DT<T> & v, double tolerance /*= GTolerance::lengthTol()*/) const
 {
-    const GVector3D & rthis = *this;
     for (std::size_t idx = 0; idx < 3; ++idx)
-        if (!equal(rthis[idx], v[idx], tolerance))
+        if (!equal(m_coords[idx], v.m_coords[idx], tolerance))
             return false;
     return true;
 }
 
-bool GVector3D::parallel(const GVector3D & v, double tolerance /*= GTolerance::angularTol()*/) const
+template<typename T>
+bool GVector3DT<T>::parallel(const GVector3DT<T> & v, double tolerance /*= GTolerance::angularTol()*/) const
 {
-    double cosAngle = (*this % v) / (length() * v.length());
+    T cosAngle = (*this % v) / (length() * v.length());
     return equal(cosAngle, 1.0, tolerance);
 }
 
-bool GVector3D::antiparallel(const GVector3D & v, double tolerance /*= GTolerance::angularTol()*/) const
+template<typename T>
+bool GVector3DT<T>::antiparallel(const GVector3DT<T> & v, double tolerance /*= GTolerance::angularTol()*/) const
 {
-    double cosAngle = (*this % v) / (length() * v.length());
+    T cosAngle = (*this % v) / (length() * v.length());
     return equal(cosAngle, -1.0, tolerance);
 }
 
-bool GVector3D::biparallel(const GVector3D & v, double tolerance /*= GTolerance::angularTol()*/) const
+template<typename T>
+bool GVector3DT<T>::biparallel(const GVector3DT<T> & v, double tolerance /*= GTolerance::angularTol()*/) const
 {
-    double cosAngle = (*this % v) / (length() * v.length());
+    T cosAngle = (*this % v) / (length() * v.length());
     return equal(cosAngle, -1.0, tolerance) || equal(cosAngle, 1.0, tolerance);
 }
 
-bool GVector3D::perpendicular(const GVector3D & v, double tolerance /*= GTolerance::angularTol()*/) const
+template<typename T>
+bool GVector3DT<T>::perpendicular(const GVector3DT<T> & v, double tolerance /*= GTolerance::angularTol()*/) const
 {
-    double cosAngle = (*this % v) / (length() * v.length());
+    T cosAngle = (*this % v) / (length() * v.length());
     return equal(cosAngle, 0.0, tolerance);
 }
 
-GVector3D & GVector3D::operator=(const GVector3D & v) = default;
-
-GVector3D & GVector3D::operator+=(const GVector3D & v)
-{
-    m_x += v.m_x;
-    m_y += v.m_y;
-    m_z += v.m_z;
-    return *this;
-}
-
-GVector3D & GVector3D::operator-=(const GVector3D & v)
-{
-    m_x -= v.m_x;
-    m_y -= v.m_y;
-    m_z -= v.m_z;
-    return *this;
-}
-
-GVector3D & GVector3D::operator*=(double scalar)
-{
-    m_x *= scalar;
-    m_y *= scalar;
-    m_z *= scalar;
-    return *this;
-}
-
-GVector3D & GVector3D::operator/=(double scalar)
+template<typename T>
+GVector3DT<T> & GVector3DT<T>::operator/=(T scalar)
 {
     if (equal(scalar, 0, GTolerance::zeroTol()))
         throw std::logic_error("GVector3D: division by zero");
-    m_x /= scalar;
-    m_y /= scalar;
-    m_z /= scalar;
+    m_coords[0] /= scalar;
+    m_coords[1] /= scalar;
+    m_coords[2] /= scalar;
     return *this;
 }
 
-GVector3D & GVector3D::operator*=(const GMatrix4D & m)
+template<typename T>
+GVector3DT<T> & GVector3DT<T>::operator*=(const GMatrix4DT<T> & m)
 {
-    double x = m(0, 0) * m_x + m(1, 0) * m_y + m(2, 0) * m_z;
-    double y = m(0, 1) * m_x + m(1, 1) * m_y + m(2, 1) * m_z;
-    double z = m(0, 2) * m_x + m(1, 2) * m_y + m(2, 2) * m_z;
+    const T * pM = m.data();
+    T x = pM[0] * m_coords[0] + pM[4] * m_coords[1] + pM[8] * m_coords[2];
+    T y = pM[1] * m_coords[0] + pM[5] * m_coords[1] + pM[9] * m_coords[2];
+    T z = pM[2] * m_coords[0] + pM[6] * m_coords[1] + pM[10] * m_coords[2];
     set(x, y, z);
     return *this;
 }
 
-double operator%(const GVector3D & v1, const GVector3D & v2)
-{
-    return v1[0] * v2[0] + v1[1] * v2[1] + v1[2] * v2[2];
-}
-
-GVector3D operator*(const GVector3D & v1, const GVector3D & v2)
-{
-    return { v1[1] * v2[2] - v1[2] * v2[1],
-             v1[2] * v2[0] - v1[0] * v2[2],
-             v1[0] * v2[1] - v1[1] * v2[0] };
-}
-
-GVector3D operator+(const GVector3D & v1, const GVector3D & v2)
-{
-    return { v1[0] + v2[0], v1[1] + v2[1], v1[2] + v2[2] };
-}
-
-GVector3D operator-(const GVector3D & v1, const GVector3D & v2)
+template<typename T>
+GVector3DT<T> operator*(const GMatrix4DT<T> & m, const GVector3DT<T> & v)
 {
-    return { v1[0] - v2[0], v1[1] - v2[1], v1[2] - v2[2] };
-}
-
-GVector3D operator*(const GMatrix4D & m, const GVector3D & v)
-{
-    GVector3D res = v;
+    GVector3DT<T> res = v;
     res *= m;
     return res;
 }
 
+template class SGL_API GVector3DT<double>;
+template class SGL_API GVector3DT<float>;
+template SGL_API GVector3D operator*(const GMatrix4D & m, const GVector3D & v);
+template SGL_API GVector3Df operator*(const GMatrix4Df & m, const GVector3Df & v);
+
 } //namespace sgl
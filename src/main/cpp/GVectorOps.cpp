@@ -0,0 +1,632 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GVectorOps.h"
+#include "GParallel.h"
+#include "GSimd.h"
+#include "GSimdDefs.h"
+#include "GTolerance.h"
+#include "GVector3D.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace sgl
+{
+
+namespace
+{
+
+// Coordinates of vectors: stride 3 for array of vectors, stride 1 for coordinate arrays
+template<typename T>
+struct CoordsT
+{
+    T * pX;
+    T * pY;
+    T * pZ;
+    std::size_t stride;
+
+    T & x(std::size_t idx) const { return pX[idx * stride]; }
+    T & y(std::size_t idx) const { return pY[idx * stride]; }
+    T & z(std::size_t idx) const { return pZ[idx * stride]; }
+};
+
+using Coords = CoordsT<const double>;
+using MutableCoords = CoordsT<double>;
+
+template<typename Vector>
+auto vectorCoords(Vector * pVectors)
+{
+    auto * pData = pVectors->data();
+    return CoordsT<std::remove_pointer_t<decltype(pData)>>{ pData, pData + 1, pData + 2, 3 };
+}
+
+// Kernels process elements [begin, count), vectorized kernels pass the tail to the next level
+
+void lengthsScalar(const Coords & v, bool squared, std::size_t begin, std::size_t count, double * pRes)
+{
+    for (std::size_t idx = begin; idx < count; ++idx)
+    {
+        const double len = v.x(idx) * v.x(idx) + v.y(idx) * v.y(idx) + v.z(idx) * v.z(idx);
+        pRes[idx] = squared ? len : std::sqrt(len);
+    }
+}
+
+std::size_t normalizeScalar(const MutableCoords & v, double tolerance, std::size_t begin, std::size_t count,
+                            std::uint8_t * pNormalized)
+{
+    std::size_t res = 0;
+    for (std::size_t idx = begin; idx < count; ++idx)
+    {
+        const double len = std::sqrt(v.x(idx) * v.x(idx) + v.y(idx) * v.y(idx) + v.z(idx) * v.z(idx));
+        pNormalized[idx] = len < tolerance ? 0 : 1;
+        if (pNormalized[idx])
+        {
+            v.x(idx) /= len;
+            v.y(idx) /= len;
+            v.z(idx) /= len;
+            ++res;
+        }
+    }
+    return res;
+}
+
+void dotsScalar(const Coords & v1, const Coords & v2, std::size_t begin, std::size_t count, double * pRes)
+{
+    for (std::size_t idx = begin; idx < count; ++idx)
+        pRes[idx] = v1.x(idx) * v2.x(idx) + v1.y(idx) * v2.y(idx) + v1.z(idx) * v2.z(idx);
+}
+
+void crossesScalar(const Coords & v1, const Coords & v2, const MutableCoords & res, std::size_t begin,
+                   std::size_t count)
+{
+    for (std::size_t idx = begin; idx < count; ++idx)
+    {
+        const double x = v1.y(idx) * v2.z(idx) - v1.z(idx) * v2.y(idx);
+        const double y = v1.z(idx) * v2.x(idx) - v1.x(idx) * v2.z(idx);
+        const double z = v1.x(idx) * v2.y(idx) - v1.y(idx) * v2.x(idx);
+        res.x(idx) = x;
+        res.y(idx) = y;
+        res.z(idx) = z;
+    }
+}
+
+// Squared thresholds of direction classification
+struct Thresholds
+{
+    double parallel;
+    double perpendicular;
+};
+
+inline GDirectionRelation relation(bool parallel, bool positive, bool perpendicular)
+{
+    if (parallel)
+        return positive ? GDirectionRelation::Parallel : GDirectionRelation::Antiparallel;
+    return perpendicular ? GDirectionRelation::Perpendicular : GDirectionRelation::None;
+}
+
+// Squared lengths for which products of the classification neither overflow nor underflow
+constexpr double MIN_SQUARED_LENGTH = 1e-140;
+constexpr double MAX_SQUARED_LENGTH = 1e140;
+
+inline bool inRange(double len1, double len2)
+{
+    return len1 >= MIN_SQUARED_LENGTH && len1 <= MAX_SQUARED_LENGTH &&
+           len2 >= MIN_SQUARED_LENGTH && len2 <= MAX_SQUARED_LENGTH;
+}
+
+inline GDirectionRelation relation(double dot, double len1, double len2, const Thresholds & thresholds)
+{
+    const double dot2 = dot * dot;
+    const double len = len1 * len2;
+    return relation(dot2 > thresholds.parallel * len, dot > 0.0, dot2 < thresholds.perpendicular * len);
+}
+
+// Classifies pair with squared lengths out of range, every vector is divided by its largest coordinate first.
+// Zero, infinite and NaN vectors give NaN coordinates and so GDirectionRelation::None
+GDirectionRelation classifyScaled(const Coords & v1, const Coords & v2, const Thresholds & thresholds,
+                                  std::size_t idx)
+{
+    const double scale1 = std::max({ std::abs(v1.x(idx)), std::abs(v1.y(idx)), std::abs(v1.z(idx)) });
+    const double scale2 = std::max({ std::abs(v2.x(idx)), std::abs(v2.y(idx)), std::abs(v2.z(idx)) });
+    const double x1 = v1.x(idx) / scale1, y1 = v1.y(idx) / scale1, z1 = v1.z(idx) / scale1;
+    const double x2 = v2.x(idx) / scale2, y2 = v2.y(idx) / scale2, z2 = v2.z(idx) / scale2;
+    return relation(x1 * x2 + y1 * y2 + z1 * z2, x1 * x1 + y1 * y1 + z1 * z1, x2 * x2 + y2 * y2 + z2 * z2,
+                    thresholds);
+}
+
+void classifyScalar(const Coords & v1, const Coords & v2, const Thresholds & thresholds, std::size_t begin,
+                    std::size_t count, GDirectionRelation * pRes)
+{
+    for (std::size_t idx = begin; idx < count; ++idx)
+    {
+        const double dot = v1.x(idx) * v2.x(idx) + v1.y(idx) * v2.y(idx) + v1.z(idx) * v2.z(idx);
+        const double len1 = v1.x(idx) * v1.x(idx) + v1.y(idx) * v1.y(idx) + v1.z(idx) * v1.z(idx);
+        const double len2 = v2.x(idx) * v2.x(idx) + v2.y(idx) * v2.y(idx) + v2.z(idx) * v2.z(idx);
+        pRes[idx] = inRange(len1, len2) ? relation(dot, len1, len2, thresholds)
+                                        : classifyScaled(v1, v2, thresholds, idx);
+    }
+}
+
+#if SGL_SIMD_X86
+
+template<typename T>
+SGL_TARGET_AVX2
+inline void loadAVX2(const CoordsT<T> & v, std::size_t idx, __m256d & x, __m256d & y, __m256d & z)
+{
+    if (v.stride == 1)
+    {
+        x = _mm256_loadu_pd(v.pX + idx);
+        y = _mm256_loadu_pd(v.pY + idx);
+        z = _mm256_loadu_pd(v.pZ + idx);
+    }
+    else
+    {
+        loadTriplesAVX2(v.pX + 3 * idx, x, y, z);
+    }
+}
+
+SGL_TARGET_AVX2
+inline void storeAVX2(const MutableCoords & v, std::size_t idx, __m256d x, __m256d y, __m256d z)
+{
+    if (v.stride == 1)
+    {
+        _mm256_storeu_pd(v.pX + idx, x);
+        _mm256_storeu_pd(v.pY + idx, y);
+        _mm256_storeu_pd(v.pZ + idx, z);
+    }
+    else
+    {
+        storeTriplesAVX2(v.pX + 3 * idx, x, y, z);
+    }
+}
+
+SGL_TARGET_AVX2
+inline __m256d dotAVX2(__m256d x1, __m256d y1, __m256d z1, __m256d x2, __m256d y2, __m256d z2)
+{
+    return _mm256_fmadd_pd(x1, x2, _mm256_fmadd_pd(y1, y2, _mm256_mul_pd(z1, z2)));
+}
+
+SGL_TARGET_AVX2
+void lengthsAVX2(const Coords & v, bool squared, std::size_t begin, std::size_t count, double * pRes)
+{
+    std::size_t idx = begin;
+    for (; idx + 4 <= count; idx += 4)
+    {
+        __m256d x, y, z;
+        loadAVX2(v, idx, x, y, z);
+        const __m256d len = dotAVX2(x, y, z, x, y, z);
+        _mm256_storeu_pd(pRes + idx, squared ? len : _mm256_sqrt_pd(len));
+    }
+    lengthsScalar(v, squared, idx, count, pRes);
+}
+
+SGL_TARGET_AVX2
+std::size_t normalizeAVX2(const MutableCoords & v, double tolerance, std::size_t begin, std::size_t count,
+                          std::uint8_t * pNormalized)
+{
+    const __m256d tol = _mm256_set1_pd(tolerance);
+    std::size_t res = 0;
+    std::size_t idx = begin;
+    for (; idx + 4 <= count; idx += 4)
+    {
+        __m256d x, y, z;
+        loadAVX2(v, idx, x, y, z);
+        const __m256d len = _mm256_sqrt_pd(dotAVX2(x, y, z, x, y, z));
+        // Zero vectors are kept, NaN lengths are not less than tolerance just as in scalar code
+        const __m256d zero = _mm256_cmp_pd(len, tol, _CMP_LT_OQ);
+        x = _mm256_blendv_pd(_mm256_div_pd(x, len), x, zero);
+        y = _mm256_blendv_pd(_mm256_div_pd(y, len), y, zero);
+        z = _mm256_blendv_pd(_mm256_div_pd(z, len), z, zero);
+        storeAVX2(v, idx, x, y, z);
+        const int zeroMask = _mm256_movemask_pd(zero);
+        for (std::size_t k = 0; k < 4; ++k)
+        {
+            pNormalized[idx + k] = ((zeroMask >> k) & 1) ? 0 : 1;
+            res += pNormalized[idx + k];
+        }
+    }
+    return res + normalizeScalar(v, tolerance, idx, count, pNormalized);
+}
+
+SGL_TARGET_AVX2
+void dotsAVX2(const Coords & v1, const Coords & v2, std::size_t begin, std::size_t count, double * pRes)
+{
+    std::size_t idx = begin;
+    for (; idx + 4 <= count; idx += 4)
+    {
+        __m256d x1, y1, z1, x2, y2, z2;
+        loadAVX2(v1, idx, x1, y1, z1);
+        loadAVX2(v2, idx, x2, y2, z2);
+        _mm256_storeu_pd(pRes + idx, dotAVX2(x1, y1, z1, x2, y2, z2));
+    }
+    dotsScalar(v1, v2, idx, count, pRes);
+}
+
+SGL_TARGET_AVX2
+void crossesAVX2(const Coords & v1, const Coords & v2, const MutableCoords & res, std::size_t begin,
+                 std::size_t count)
+{
+    std::size_t idx = begin;
+    for (; idx + 4 <= count; idx += 4)
+    {
+        __m256d x1, y1, z1, x2, y2, z2;
+        loadAVX2(v1, idx, x1, y1, z1);
+        loadAVX2(v2, idx, x2, y2, z2);
+        storeAVX2(res, idx, _mm256_fmsub_pd(y1, z2, _mm256_mul_pd(z1, y2)),
+                  _mm256_fmsub_pd(z1, x2, _mm256_mul_pd(x1, z2)),
+                  _mm256_fmsub_pd(x1, y2, _mm256_mul_pd(y1, x2)));
+    }
+    crossesScalar(v1, v2, res, idx, count);
+}
+
+SGL_TARGET_AVX2
+void classifyAVX2(const Coords & v1, const Coords & v2, const Thresholds & thresholds, std::size_t begin,
+                  std::size_t count, GDirectionRelation * pRes)
+{
+    const __m256d parallel = _mm256_set1_pd(thresholds.parallel);
+    const __m256d perpendicular = _mm256_set1_pd(thresholds.perpendicular);
+    const __m256d minLength = _mm256_set1_pd(MIN_SQUARED_LENGTH);
+    const __m256d maxLength = _mm256_set1_pd(MAX_SQUARED_LENGTH);
+    std::size_t idx = begin;
+    for (; idx + 4 <= count; idx += 4)
+    {
+        __m256d x1, y1, z1, x2, y2, z2;
+        loadAVX2(v1, idx, x1, y1, z1);
+        loadAVX2(v2, idx, x2, y2, z2);
+        const __m256d dot = dotAVX2(x1, y1, z1, x2, y2, z2);
+        const __m256d dot2 = _mm256_mul_pd(dot, dot);
+        const __m256d len1 = dotAVX2(x1, y1, z1, x1, y1, z1);
+        const __m256d len2 = dotAVX2(x2, y2, z2, x2, y2, z2);
+        const __m256d len = _mm256_mul_pd(len1, len2);
+        const int parallelMask = _mm256_movemask_pd(_mm256_cmp_pd(dot2, _mm256_mul_pd(parallel, len), _CMP_GT_OQ));
+        const int positiveMask = _mm256_movemask_pd(_mm256_cmp_pd(dot, _mm256_setzero_pd(), _CMP_GT_OQ));
+        const int perpendicularMask = _mm256_movemask_pd(_mm256_cmp_pd(dot2, _mm256_mul_pd(perpendicular, len),
+                                                                       _CMP_LT_OQ));
+        const __m256d len1Ok = _mm256_and_pd(_mm256_cmp_pd(len1, minLength, _CMP_GE_OQ),
+                                             _mm256_cmp_pd(len1, maxLength, _CMP_LE_OQ));
+        const __m256d len2Ok = _mm256_and_pd(_mm256_cmp_pd(len2, minLength, _CMP_GE_OQ),
+                                             _mm256_cmp_pd(len2, maxLength, _CMP_LE_OQ));
+        const int rangeMask = _mm256_movemask_pd(_mm256_and_pd(len1Ok, len2Ok));
+        for (std::size_t k = 0; k < 4; ++k)
+        {
+            pRes[idx + k] = ((rangeMask >> k) & 1)
+                ? relation((parallelMask >> k) & 1, (positiveMask >> k) & 1, (perpendicularMask >> k) & 1)
+                : classifyScaled(v1, v2, thresholds, idx + k);
+        }
+    }
+    classifyScalar(v1, v2, thresholds, idx, count, pRes);
+}
+
+template<typename T>
+SGL_TARGET_AVX512
+inline void loadAVX512(const CoordsT<T> & v, std::size_t idx, __m512d & x, __m512d & y, __m512d & z)
+{
+    if (v.stride == 1)
+    {
+        x = _mm512_loadu_pd(v.pX + idx);
+        y = _mm512_loadu_pd(v.pY + idx);
+        z = _mm512_loadu_pd(v.pZ + idx);
+    }
+    else
+    {
+        loadTriplesAVX512(v.pX + 3 * idx, x, y, z);
+    }
+}
+
+SGL_TARGET_AVX512
+inline void storeAVX512(const MutableCoords & v, std::size_t idx, __m512d x, __m512d y, __m512d z)
+{
+    if (v.stride == 1)
+    {
+        _mm512_storeu_pd(v.pX + idx, x);
+        _mm512_storeu_pd(v.pY + idx, y);
+        _mm512_storeu_pd(v.pZ + idx, z);
+    }
+    else
+    {
+        storeTriplesAVX512(v.pX + 3 * idx, x, y, z);
+    }
+}
+
+SGL_TARGET_AVX512
+inline __m512d dotAVX512(__m512d x1, __m512d y1, __m512d z1, __m512d x2, __m512d y2, __m512d z2)
+{
+    return _mm512_fmadd_pd(x1, x2, _mm512_fmadd_pd(y1, y2, _mm512_mul_pd(z1, z2)));
+}
+
+SGL_TARGET_AVX512
+void lengthsAVX512(const Coords & v, bool squared, std::size_t begin, std::size_t count, double * pRes)
+{
+    std::size_t idx = begin;
+    for (; idx + 8 <= count; idx += 8)
+    {
+        __m512d x, y, z;
+        loadAVX512(v, idx, x, y, z);
+        const __m512d len = dotAVX512(x, y, z, x, y, z);
+        _mm512_storeu_pd(pRes + idx, squared ? len : _mm512_sqrt_pd(len));
+    }
+    lengthsAVX2(v, squared, idx, count, pRes);
+}
+
+SGL_TARGET_AVX512
+std::size_t normalizeAVX512(const MutableCoords & v, double tolerance, std::size_t begin, std::size_t count,
+                            std::uint8_t * pNormalized)
+{
+    const __m512d tol = _mm512_set1_pd(tolerance);
+    std::size_t res = 0;
+    std::size_t idx = begin;
+    for (; idx + 8 <= count; idx += 8)
+    {
+        __m512d x, y, z;
+        loadAVX512(v, idx, x, y, z);
+        const __m512d len = _mm512_sqrt_pd(dotAVX512(x, y, z, x, y, z));
+        const __mmask8 nonZero = static_cast<__mmask8>(~_mm512_cmp_pd_mask(len, tol, _CMP_LT_OQ));
+        x = _mm512_mask_div_pd(x, nonZero, x, len);
+        y = _mm512_mask_div_pd(y, nonZero, y, len);
+        z = _mm512_mask_div_pd(z, nonZero, z, len);
+        storeAVX512(v, idx, x, y, z);
+        for (std::size_t k = 0; k < 8; ++k)
+        {
+            pNormalized[idx + k] = (nonZero >> k) & 1;
+            res += pNormalized[idx + k];
+        }
+    }
+    return res + normalizeAVX2(v, tolerance, idx, count, pNormalized);
+}
+
+SGL_TARGET_AVX512
+void dotsAVX512(const Coords & v1, const Coords & v2, std::size_t begin, std::size_t count, double * pRes)
+{
+    std::size_t idx = begin;
+    for (; idx + 8 <= count; idx += 8)
+    {
+        __m512d x1, y1, z1, x2, y2, z2;
+        loadAVX512(v1, idx, x1, y1, z1);
+        loadAVX512(v2, idx, x2, y2, z2);
+        _mm512_storeu_pd(pRes + idx, dotAVX512(x1, y1, z1, x2, y2, z2));
+    }
+    dotsAVX2(v1, v2, idx, count, pRes);
+}
+
+SGL_TARGET_AVX512
+void crossesAVX512(const Coords & v1, const Coords & v2, const MutableCoords & res, std::size_t begin,
+                   std::size_t count)
+{
+    std::size_t idx = begin;
+    for (; idx + 8 <= count; idx += 8)
+    {
+        __m512d x1, y1, z1, x2, y2, z2;
+        loadAVX512(v1, idx, x1, y1, z1);
+        loadAVX512(v2, idx, x2, y2, z2);
+        storeAVX512(res, idx, _mm512_fmsub_pd(y1, z2, _mm512_mul_pd(z1, y2)),
+                    _mm512_fmsub_pd(z1, x2, _mm512_mul_pd(x1, z2)),
+                    _mm512_fmsub_pd(x1, y2, _mm512_mul_pd(y1, x2)));
+    }
+    crossesAVX2(v1, v2, res, idx, count);
+}
+
+SGL_TARGET_AVX512
+void classifyAVX512(const Coords & v1, const Coords & v2, const Thresholds & thresholds, std::size_t begin,
+                    std::size_t count, GDirectionRelation * pRes)
+{
+    const __m512d parallel = _mm512_set1_pd(thresholds.parallel);
+    const __m512d perpendicular = _mm512_set1_pd(thresholds.perpendicular);
+    const __m512i parallelCode = _mm512_set1_epi64(static_cast<long long>(GDirectionRelation::Parallel));
+    const __m512i antiparallelCode = _mm512_set1_epi64(static_cast<long long>(GDirectionRelation::Antiparallel));
+    const __m512i perpendicularCode = _mm512_set1_epi64(static_cast<long long>(GDirectionRelation::Perpendicular));
+    const __m512d minLength = _mm512_set1_pd(MIN_SQUARED_LENGTH);
+    const __m512d maxLength = _mm512_set1_pd(MAX_SQUARED_LENGTH);
+    std::size_t idx = begin;
+    for (; idx + 8 <= count; idx += 8)
+    {
+        __m512d x1, y1, z1, x2, y2, z2;
+        loadAVX512(v1, idx, x1, y1, z1);
+        loadAVX512(v2, idx, x2, y2, z2);
+        const __m512d dot = dotAVX512(x1, y1, z1, x2, y2, z2);
+        const __m512d dot2 = _mm512_mul_pd(dot, dot);
+        const __m512d len1 = dotAVX512(x1, y1, z1, x1, y1, z1);
+        const __m512d len2 = dotAVX512(x2, y2, z2, x2, y2, z2);
+        const __m512d len = _mm512_mul_pd(len1, len2);
+        const __mmask8 parallelMask = _mm512_cmp_pd_mask(dot2, _mm512_mul_pd(parallel, len), _CMP_GT_OQ);
+        const __mmask8 positiveMask = _mm512_cmp_pd_mask(dot, _mm512_setzero_pd(), _CMP_GT_OQ);
+        const __mmask8 perpendicularMask = _mm512_cmp_pd_mask(dot2, _mm512_mul_pd(perpendicular, len), _CMP_LT_OQ);
+
+        // Parallel pairs can't be perpendicular for tolerance less than 0.5
+        __m512i codes = _mm512_maskz_mov_epi64(perpendicularMask, perpendicularCode);
+        codes = _mm512_mask_mov_epi64(codes, parallelMask & positiveMask, parallelCode);
+        codes = _mm512_mask_mov_epi64(codes, parallelMask & static_cast<__mmask8>(~positiveMask), antiparallelCode);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(pRes + idx), _mm512_cvtepi64_epi8(codes));
+
+        const __mmask8 rangeMask = _mm512_cmp_pd_mask(len1, minLength, _CMP_GE_OQ) &
+                                   _mm512_cmp_pd_mask(len1, maxLength, _CMP_LE_OQ) &
+                                   _mm512_cmp_pd_mask(len2, minLength, _CMP_GE_OQ) &
+                                   _mm512_cmp_pd_mask(len2, maxLength, _CMP_LE_OQ);
+        if (rangeMask != 0xFF)
+        {
+            for (std::size_t k = 0; k < 8; ++k)
+            {
+                if (!((rangeMask >> k) & 1))
+                    pRes[idx + k] = classifyScaled(v1, v2, thresholds, idx + k);
+            }
+        }
+    }
+    classifyAVX2(v1, v2, thresholds, idx, count, pRes);
+}
+
+#endif //SGL_SIMD_X86
+
+void computeLengths(const Coords & v, bool squared, std::size_t count, double * pRes)
+{
+    switch (simdLevel())
+    {
+#if SGL_SIMD_X86
+        case GSimdLevel::AVX512: return lengthsAVX512(v, squared, 0, count, pRes);
+        case GSimdLevel::AVX2: return lengthsAVX2(v, squared, 0, count, pRes);
+#endif
+        default: return lengthsScalar(v, squared, 0, count, pRes);
+    }
+}
+
+std::size_t normalize(const MutableCoords & v, std::size_t count, std::uint8_t * pNormalized)
+{
+    const double tolerance = GTolerance::zeroTol();
+    switch (simdLevel())
+    {
+#if SGL_SIMD_X86
+        case GSimdLevel::AVX512: return normalizeAVX512(v, tolerance, 0, count, pNormalized);
+        case GSimdLevel::AVX2: return normalizeAVX2(v, tolerance, 0, count, pNormalized);
+#endif
+        default: return normalizeScalar(v, tolerance, 0, count, pNormalized);
+    }
+}
+
+void computeDots(const Coords & v1, const Coords & v2, std::size_t count, double * pRes)
+{
+    switch (simdLevel())
+    {
+#if SGL_SIMD_X86
+        case GSimdLevel::AVX512: return dotsAVX512(v1, v2, 0, count, pRes);
+        case GSimdLevel::AVX2: return dotsAVX2(v1, v2, 0, count, pRes);
+#endif
+        default: return dotsScalar(v1, v2, 0, count, pRes);
+    }
+}
+
+void computeCrosses(const Coords & v1, const Coords & v2, const MutableCoords & res, std::size_t count)
+{
+    switch (simdLevel())
+    {
+#if SGL_SIMD_X86
+        case GSimdLevel::AVX512: return crossesAVX512(v1, v2, res, 0, count);
+        case GSimdLevel::AVX2: return crossesAVX2(v1, v2, res, 0, count);
+#endif
+        default: return crossesScalar(v1, v2, res, 0, count);
+    }
+}
+
+// Minimal number of pairs per thread
+constexpr std::size_t PARALLEL_CHUNK = 16384;
+
+void classify(const Coords & v1, const Coords & v2, std::size_t count, GDirectionRelation * pRes, double tolerance,
+              unsigned threadCount)
+{
+    if (!(tolerance > 0.0 && tolerance < 0.5))
+        throw std::invalid_argument("classifyDirections: tolerance must be in (0, 0.5)");
+
+    // cos > 1 - tol is cos^2 > (1 - tol)^2 for positive cos, |cos| < tol is cos^2 < tol^2
+    const Thresholds thresholds = { (1.0 - tolerance) * (1.0 - tolerance), tolerance * tolerance };
+    const GSimdLevel level = simdLevel();
+    parallelFor(count, threadCount, PARALLEL_CHUNK, [&](std::size_t begin, std::size_t end)
+    {
+        switch (level)
+        {
+#if SGL_SIMD_X86
+            case GSimdLevel::AVX512: return classifyAVX512(v1, v2, thresholds, begin, end, pRes);
+            case GSimdLevel::AVX2: return classifyAVX2(v1, v2, thresholds, begin, end, pRes);
+#endif
+            default: return classifyScalar(v1, v2, thresholds, begin, end, pRes);
+        }
+    });
+}
+
+} //namespace
+
+void lengths(const GVector3D * pVectors, std::size_t count, double * pLengths)
+{
+    if (count != 0)
+        computeLengths(vectorCoords(pVectors), false, count, pLengths);
+}
+
+void lengths(const double * pX, const double * pY, const double * pZ, std::size_t count, double * pLengths)
+{
+    computeLengths(Coords{ pX, pY, pZ, 1 }, false, count, pLengths);
+}
+
+void squaredLengths(const GVector3D * pVectors, std::size_t count, double * pLengths)
+{
+    if (count != 0)
+        computeLengths(vectorCoords(pVectors), true, count, pLengths);
+}
+
+void squaredLengths(const double * pX, const double * pY, const double * pZ, std::size_t count,
+                    double * pLengths)
+{
+    computeLengths(Coords{ pX, pY, pZ, 1 }, true, count, pLengths);
+}
+
+std::size_t normalizeVectors(GVector3D * pVectors, std::size_t count, std::uint8_t * pNormalized)
+{
+    return count != 0 ? normalize(vectorCoords(pVectors), count, pNormalized) : 0;
+}
+
+std::size_t normalizeVectors(GVector3DArray & vectors, std::uint8_t * pNormalized)
+{
+    return normalizeVectors(vectors.data(), vectors.size(), pNormalized);
+}
+
+std::size_t normalizeVectors(double * pX, double * pY, double * pZ, std::size_t count, std::uint8_t * pNormalized)
+{
+    return normalize(MutableCoords{ pX, pY, pZ, 1 }, count, pNormalized);
+}
+
+void dotProducts(const GVector3D * pVectors1, const GVector3D * pVectors2, std::size_t count, double * pDots)
+{
+    if (count != 0)
+        computeDots(vectorCoords(pVectors1), vectorCoords(pVectors2), count, pDots);
+}
+
+void dotProducts(const double * pX1, const double * pY1, const double * pZ1, const double * pX2,
+                 const double * pY2, const double * pZ2, std::size_t count, double * pDots)
+{
+    computeDots(Coords{ pX1, pY1, pZ1, 1 }, Coords{ pX2, pY2, pZ2, 1 }, count, pDots);
+}
+
+void crossProducts(const GVector3D * pVectors1, const GVector3D * pVectors2, GVector3D * pResult,
+                   std::size_t count)
+{
+    if (count != 0)
+        computeCrosses(vectorCoords(pVectors1), vectorCoords(pVectors2), vectorCoords(pResult), count);
+}
+
+void crossProducts(const double * pX1, const double * pY1, const double * pZ1, const double * pX2,
+                   const double * pY2, const double * pZ2, double * pX, double * pY, double * pZ,
+                   std::size_t count)
+{
+    computeCrosses(Coords{ pX1, pY1, pZ1, 1 }, Coords{ pX2, pY2, pZ2, 1 }, MutableCoords{ pX, pY, pZ, 1 }, count);
+}
+
+void classifyDirections(const GVector3D * pVectors1, const GVector3D * pVectors2, std::size_t count,
+                        GDirectionRelation * pRelations, double tolerance /*= GTolerance::angularTol()*/,
+                        unsigned threadCount /*= 0*/)
+{
+    const Coords v1 = count != 0 ? vectorCoords(pVectors1) : Coords{};
+    const Coords v2 = count != 0 ? vectorCoords(pVectors2) : Coords{};
+    classify(v1, v2, count, pRelations, tolerance, threadCount);
+}
+
+void classifyDirections(const double * pX1, const double * pY1, const double * pZ1, const double * pX2,
+                        const double * pY2, const double * pZ2, std::size_t count, GDirectionRelation * pRelations,
+                        double tolerance /*= GTolerance::angularTol()*/, unsigned threadCount /*= 0*/)
+{
+    classify(Coords{ pX1, pY1, pZ1, 1 }, Coords{ pX2, pY2, pZ2, 1 }, count, pRelations, tolerance, threadCount);
+}
+
+} //namespace sgl
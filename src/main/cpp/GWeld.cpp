@@ -0,0 +1,299 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPrecompiled.h"
+#include "GWeld.h"
+#include "GParallel.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace sgl
+{
+
+namespace
+{
+
+// Minimal number of points or cells per thread
+constexpr std::size_t PARALLEL_CHUNK = 4096;
+// Cell coordinates are clamped so that neighbour coordinates don't overflow
+constexpr double MAX_CELL = 4.0e18;
+
+using Cell = std::array<std::int64_t, 3>;
+
+struct Entry
+{
+    Cell cell;
+    std::size_t index;
+};
+
+// Lock-free union-find: roots are linked to the smaller root, so partition doesn't depend on thread timing
+class DisjointSets
+{
+public:
+    explicit DisjointSets(std::size_t count)
+        : m_parent(new std::atomic<std::size_t>[count])
+    {
+        for (std::size_t idx = 0; idx < count; ++idx)
+            m_parent[idx].store(idx, std::memory_order_relaxed);
+    }
+
+    std::size_t find(std::size_t idx) const
+    {
+        while (true)
+        {
+            std::size_t parent = m_parent[idx].load(std::memory_order_acquire);
+            if (parent == idx)
+                return idx;
+            const std::size_t grandParent = m_parent[parent].load(std::memory_order_acquire);
+            // Path halving, failure only means somebody else changed the link
+            m_parent[idx].compare_exchange_weak(parent, grandParent, std::memory_order_acq_rel);
+            idx = grandParent;
+        }
+    }
+
+    void unite(std::size_t idx1, std::size_t idx2)
+    {
+        while (true)
+        {
+            idx1 = find(idx1);
+            idx2 = find(idx2);
+            if (idx1 == idx2)
+                return;
+            if (idx1 > idx2)
+                std::swap(idx1, idx2);
+            std::size_t expected = idx2;
+            if (m_parent[idx2].compare_exchange_strong(expected, idx1, std::memory_order_acq_rel))
+                return;
+        }
+    }
+
+private:
+    std::unique_ptr<std::atomic<std::size_t>[]> m_parent;
+};
+
+std::int64_t quantize(double value)
+{
+    return static_cast<std::int64_t>(std::max(-MAX_CELL, std::min(MAX_CELL, std::floor(value))));
+}
+
+bool lexicographicLess(const GPoint3D & pt1, const GPoint3D & pt2)
+{
+    return std::lexicographical_compare(pt1.data(), pt1.data() + 3, pt2.data(), pt2.data() + 3);
+}
+
+bool sameCoords(const GPoint3D & pt1, const GPoint3D & pt2)
+{
+    return std::equal(pt1.data(), pt1.data() + 3, pt2.data());
+}
+
+} //namespace
+
+GWeldResult weldPoints(const GPoint3D * pPoints, std::size_t count, double tolerance /*= lengthTol()*/,
+                       unsigned threadCount /*= 0*/)
+{
+    if (!(tolerance > 0.0))
+        throw std::invalid_argument("weldPoints: tolerance must be positive");
+
+    GWeldResult res;
+    if (count == 0)
+        return res;
+
+    // Coincident points lie in the same or adjacent cells
+    const double scale = 1.0 / tolerance;
+    std::vector<Entry> entries(count);
+    parallelFor(count, threadCount, PARALLEL_CHUNK, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t idx = begin; idx < end; ++idx)
+        {
+            const double * pCoords = pPoints[idx].data();
+            for (std::size_t axis = 0; axis < 3; ++axis)
+                entries[idx].cell[axis] = quantize(pCoords[axis] * scale);
+            entries[idx].index = idx;
+        }
+    });
+    parallelSort(entries.begin(), entries.end(), threadCount, PARALLEL_CHUNK, [&](const Entry & e1, const Entry & e2)
+    {
+        if (e1.cell != e2.cell)
+            return e1.cell < e2.cell;
+        const GPoint3D & pt1 = pPoints[e1.index];
+        const GPoint3D & pt2 = pPoints[e2.index];
+        if (lexicographicLess(pt1, pt2) || lexicographicLess(pt2, pt1))
+            return lexicographicLess(pt1, pt2);
+        return e1.index < e2.index;
+    });
+
+    // Exact duplicates are adjacent: they are welded at once and only the first of them is compared further
+    DisjointSets sets(count);
+    std::size_t uniqueCount = 0;
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        if (uniqueCount > 0)
+        {
+            const Entry & prev = entries[uniqueCount - 1];
+            if (prev.cell == entries[idx].cell && sameCoords(pPoints[prev.index], pPoints[entries[idx].index]))
+            {
+                sets.unite(prev.index, entries[idx].index);
+                continue;
+            }
+        }
+        entries[uniqueCount++] = entries[idx];
+    }
+    entries.resize(uniqueCount);
+
+    // Ranges of entries of non-empty cells
+    std::vector<std::size_t> cellBegin;
+    for (std::size_t idx = 0; idx < uniqueCount; ++idx)
+    {
+        if (idx == 0 || entries[idx].cell != entries[idx - 1].cell)
+            cellBegin.push_back(idx);
+    }
+    cellBegin.push_back(uniqueCount);
+    const std::size_t cellCount = cellBegin.size() - 1;
+
+    // Every pair of cells is visited once: cell itself and 13 neighbours with greater coordinates
+    std::vector<Cell> offsets;
+    for (std::int64_t dx = -1; dx <= 1; ++dx)
+    {
+        for (std::int64_t dy = -1; dy <= 1; ++dy)
+        {
+            for (std::int64_t dz = -1; dz <= 1; ++dz)
+            {
+                const Cell offset = { dx, dy, dz };
+                if (offset > Cell{ 0, 0, 0 })
+                    offsets.push_back(offset);
+            }
+        }
+    }
+
+    const auto weldPair = [&](std::size_t idx1, std::size_t idx2)
+    {
+        const std::size_t pt1 = entries[idx1].index;
+        const std::size_t pt2 = entries[idx2].index;
+        if (pPoints[pt1].equals(pPoints[pt2], tolerance) && sets.find(pt1) != sets.find(pt2))
+            sets.unite(pt1, pt2);
+    };
+    // Points of one cell are within tolerance of each other up to rounding: every point is welded to the
+    // first one, only points which turn out not coincident with it are compared with all the others
+    const auto weldCell = [&](std::size_t begin, std::size_t end)
+    {
+        const std::size_t first = entries[begin].index;
+        for (std::size_t idx1 = begin + 1; idx1 < end; ++idx1)
+        {
+            const std::size_t pt1 = entries[idx1].index;
+            if (pPoints[pt1].equals(pPoints[first], tolerance))
+            {
+                sets.unite(first, pt1);
+                continue;
+            }
+            for (std::size_t idx2 = begin + 1; idx2 < end; ++idx2)
+            {
+                if (idx2 != idx1)
+                    weldPair(idx1, idx2);
+            }
+        }
+    };
+    // If points of the first cell are already one cluster, a point of the second cell is welded to it by one
+    // coincident pair, and points already in the cluster are skipped
+    const auto weldCells = [&](std::size_t begin1, std::size_t end1, std::size_t begin2, std::size_t end2)
+    {
+        const std::size_t root = sets.find(entries[begin1].index);
+        bool whole = true;
+        for (std::size_t idx1 = begin1 + 1; idx1 < end1 && whole; ++idx1)
+            whole = sets.find(entries[idx1].index) == root;
+
+        for (std::size_t idx2 = begin2; idx2 < end2; ++idx2)
+        {
+            const std::size_t pt2 = entries[idx2].index;
+            if (whole && sets.find(pt2) == sets.find(root))
+                continue;
+            for (std::size_t idx1 = begin1; idx1 < end1; ++idx1)
+            {
+                const std::size_t pt1 = entries[idx1].index;
+                if (!pPoints[pt1].equals(pPoints[pt2], tolerance))
+                    continue;
+                sets.unite(pt1, pt2);
+                if (whole)
+                    break;
+            }
+        }
+    };
+    parallelFor(cellCount, threadCount, PARALLEL_CHUNK / 8, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t cell = begin; cell < end; ++cell)
+        {
+            const std::size_t first = cellBegin[cell];
+            const std::size_t last = cellBegin[cell + 1];
+            weldCell(first, last);
+            for (const auto & offset : offsets)
+            {
+                Entry key = entries[first];
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                    key.cell[axis] += offset[axis];
+                const auto it = std::lower_bound(cellBegin.begin() + static_cast<std::ptrdiff_t>(cell + 1),
+                                                 cellBegin.end() - 1, key.cell, [&](std::size_t pos, const Cell & value)
+                {
+                    return entries[pos].cell < value;
+                });
+                if (it != cellBegin.end() - 1 && entries[*it].cell == key.cell)
+                    weldCells(first, last, *it, *(it + 1));
+            }
+        }
+    });
+
+    // Cluster is represented by its lexicographically smallest point
+    std::vector<std::size_t> representative(count, count);
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        std::size_t & rep = representative[sets.find(idx)];
+        if (rep == count || lexicographicLess(pPoints[idx], pPoints[rep]))
+            rep = idx;
+    }
+    std::vector<std::size_t> clusters;
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        if (representative[idx] != count)
+            clusters.push_back(idx);
+    }
+    std::sort(clusters.begin(), clusters.end(), [&](std::size_t root1, std::size_t root2)
+    {
+        return lexicographicLess(pPoints[representative[root1]], pPoints[representative[root2]]);
+    });
+
+    std::vector<std::size_t> clusterIndex(count);
+    res.points.reserve(clusters.size());
+    for (std::size_t idx = 0; idx < clusters.size(); ++idx)
+    {
+        clusterIndex[clusters[idx]] = idx;
+        res.points.push_back(pPoints[representative[clusters[idx]]]);
+    }
+    res.remap.resize(count);
+    for (std::size_t idx = 0; idx < count; ++idx)
+        res.remap[idx] = clusterIndex[sets.find(idx)];
+    return res;
+}
+
+GWeldResult weldPoints(const GPoint3DArray & points, double tolerance /*= lengthTol()*/,
+                       unsigned threadCount /*= 0*/)
+{
+    return weldPoints(points.data(), points.size(), tolerance, threadCount);
+}
+
+} //namespace sgl
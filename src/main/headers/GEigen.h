@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GEIGEN_H_
+#define _GEIGEN_H_
+
+// Private eigen solver shared by principal component analysis of point sets.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace sgl
+{
+
+/**
+ * @brief Applies Jacobi rotation zeroing off-diagonal element apq of symmetric 3x3 matrix
+ * @param p, q - rotated rows and columns (p < q)
+ * @param d - diagonal of matrix
+ * @param apq - element (p, q)
+ * @param arp, arq - elements (r, p) and (r, q), r is the third index
+ * @param v - accumulated rotations, columns p and q are rotated
+ */
+inline void jacobiRotate(int p, int q, double d[3], double & apq, double & arp, double & arq, double v[3][3])
+{
+    if (apq == 0.0)
+        return;
+    const double theta = (d[q] - d[p]) / (2.0 * apq);
+    const double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+    const double c = 1.0 / std::sqrt(t * t + 1.0);
+    const double s = t * c;
+    const double tau = s / (1.0 + c);
+    d[p] -= t * apq;
+    d[q] += t * apq;
+    apq = 0.0;
+    const double rp = arp;
+    const double rq = arq;
+    arp = rp - s * (rq + tau * rp);
+    arq = rq + s * (rp - tau * rq);
+    for (int k = 0; k < 3; ++k)
+    {
+        const double vkp = v[k][p];
+        const double vkq = v[k][q];
+        v[k][p] = vkp - s * (vkq + tau * vkp);
+        v[k][q] = vkq + s * (vkp - tau * vkq);
+    }
+}
+
+/**
+ * @brief Computes eigenvalues and eigenvectors of symmetric 3x3 matrix by cyclic Jacobi rotations.
+ *   Eigenvalues are accurate to machine epsilon relative to the largest one, eigenvectors are
+ *   orthonormal even if eigenvalues are repeated.
+ * @param a - symmetric matrix, only upper triangle is read
+ * @param values - [out] eigenvalues in decreasing order
+ * @param vectors - [out] vectors[k] is unit eigenvector of values[k]
+ */
+inline void symmetricEigen(const double a[3][3], double values[3], double vectors[3][3])
+{
+    constexpr int maxSweeps = 50;
+    constexpr double eps = std::numeric_limits<double>::epsilon();
+
+    double d[3] = { a[0][0], a[1][1], a[2][2] };
+    double a01 = a[0][1];
+    double a02 = a[0][2];
+    double a12 = a[1][2];
+    double v[3][3] = { { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 } };
+    for (int sweep = 0; sweep < maxSweeps; ++sweep)
+    {
+        const double off = a01 * a01 + a02 * a02 + a12 * a12;
+        if (off <= eps * eps * (d[0] * d[0] + d[1] * d[1] + d[2] * d[2]))
+            break;
+        jacobiRotate(0, 1, d, a01, a02, a12, v);
+        jacobiRotate(0, 2, d, a02, a01, a12, v);
+        jacobiRotate(1, 2, d, a12, a01, a02, v);
+    }
+
+    int order[3] = { 0, 1, 2 };
+    std::stable_sort(order, order + 3, [&d](int i1, int i2) { return d[i1] > d[i2]; });
+    for (int k = 0; k < 3; ++k)
+    {
+        values[k] = d[order[k]];
+        for (int c = 0; c < 3; ++c)
+            vectors[k][c] = v[c][order[k]];
+    }
+}
+
+} //namespace sgl
+
+#endif //_GEIGEN_H_
@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GPARALLEL_H_
+#define _GPARALLEL_H_
+
+// Private helpers for multithreaded algorithms.
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace sgl
+{
+
+/**
+ * @brief Resolves requested number of threads
+ * @param threadCount - requested number of threads, 0 - number of hardware threads
+ * @return number of threads, at least 1
+ */
+inline unsigned resolveThreadCount(unsigned threadCount)
+{
+    return threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Splits range [0, count) into contiguous chunks and calls func(begin, end) for each chunk
+ *   on its own thread. The first chunk is processed by the calling thread.
+ * @param count - size of range
+ * @param threadCount - maximal number of threads, 0 - number of hardware threads
+ * @param minChunk - minimal size of chunk worth a thread
+ * @param func - callable (std::size_t begin, std::size_t end)
+ */
+template<typename Func>
+void parallelFor(std::size_t count, unsigned threadCount, std::size_t minChunk, Func && func)
+{
+    const std::size_t maxChunks = std::max<std::size_t>(1, count / std::max<std::size_t>(1, minChunk));
+    const std::size_t chunkCount = std::min<std::size_t>(resolveThreadCount(threadCount), maxChunks);
+    if (chunkCount <= 1)
+    {
+        func(std::size_t{ 0 }, count);
+        return;
+    }
+    const std::size_t chunk = (count + chunkCount - 1) / chunkCount;
+    std::vector<std::thread> workers;
+    workers.reserve(chunkCount - 1);
+    for (std::size_t idx = 1; idx < chunkCount; ++idx)
+    {
+        const std::size_t begin = std::min(count, idx * chunk);
+        const std::size_t end = std::min(count, begin + chunk);
+        workers.emplace_back([&func, begin, end]() { func(begin, end); });
+    }
+    func(std::size_t{ 0 }, std::min(count, chunk));
+    for (auto & worker : workers)
+        worker.join();
+}
+
+/**
+ * @brief Sorts range: chunks are sorted in parallel, then merged pairwise
+ * @param first - the first element
+ * @param last - the element past the last one
+ * @param threadCount - maximal number of threads, 0 - number of hardware threads
+ * @param minChunk - minimal size of chunk worth a thread
+ * @param comp - strict weak ordering
+ */
+template<typename RandomIt, typename Compare>
+void parallelSort(RandomIt first, RandomIt last, unsigned threadCount, std::size_t minChunk, Compare comp)
+{
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    const std::size_t maxChunks = std::max<std::size_t>(1, count / std::max<std::size_t>(1, minChunk));
+    const std::size_t chunkCount = std::min<std::size_t>(resolveThreadCount(threadCount), maxChunks);
+    const std::size_t chunk = (count + chunkCount - 1) / std::max<std::size_t>(1, chunkCount);
+    const auto at = [first, count](std::size_t pos)
+    {
+        return first + static_cast<std::ptrdiff_t>(std::min(pos, count));
+    };
+    parallelFor(chunkCount, threadCount, 1, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t idx = begin; idx < end; ++idx)
+            std::sort(at(idx * chunk), at((idx + 1) * chunk), comp);
+    });
+    for (std::size_t width = chunk; width != 0 && width < count; width *= 2)
+    {
+        for (std::size_t begin = 0; begin + width < count; begin += 2 * width)
+            std::inplace_merge(at(begin), at(begin + width), at(begin + 2 * width), comp);
+    }
+}
+
+} //namespace sgl
+
+#endif //_GPARALLEL_H_
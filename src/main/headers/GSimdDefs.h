@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GSIMDDEFS_H_
+#define _GSIMDDEFS_H_
+
+// Private helpers for SIMD kernels.
+// Kernels are compiled with per-function target attributes, so the library itself
+// doesn't require any instruction set flags and picks the kernel at runtime (see GSimd.h).
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define SGL_SIMD_X86 1
+    // GCC fills unused lanes of unmasked AVX-512 intrinsics with self-initialized
+    // _mm512_undefined_*() values and then warns about them in its own header
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+        #include <immintrin.h>
+        #pragma GCC diagnostic pop
+    #else
+        #include <immintrin.h>
+    #endif
+#else
+    #define SGL_SIMD_X86 0
+#endif
+
+#if SGL_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+    #define SGL_TARGET_SSE2 __attribute__((target("sse2")))
+    #define SGL_TARGET_AVX2 __attribute__((target("avx2,fma")))
+    #define SGL_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+#else
+    #define SGL_TARGET_SSE2
+    #define SGL_TARGET_AVX2
+    #define SGL_TARGET_AVX512
+#endif
+
+#if SGL_SIMD_X86
+
+namespace sgl
+{
+
+// Loads 4 triples [x0 y0 z0 x1 y1 z1 ...] (array of structures) to x = [x0 x1 x2 x3], y = [...], z = [...]
+SGL_TARGET_AVX2
+inline void loadTriplesAVX2(const double * pSrc, __m256d & x, __m256d & y, __m256d & z)
+{
+    // a = [x0 y0 z0 x1], b = [y1 z1 x2 y2], c = [z2 x3 y3 z3]
+    const __m256d a = _mm256_loadu_pd(pSrc);
+    const __m256d b = _mm256_loadu_pd(pSrc + 4);
+    const __m256d c = _mm256_loadu_pd(pSrc + 8);
+
+    const __m256d ab = _mm256_blend_pd(a, b, 0xc);                      // [x0 y0 x2 y2]
+    const __m256d bc = _mm256_blend_pd(b, c, 0xc);                      // [y1 z1 y3 z3]
+    __m256d ca = _mm256_blend_pd(c, a, 0xc);                            // [z2 x3 z0 x1]
+    ca = _mm256_permute2f128_pd(ca, ca, 0x01);                          // [z0 x1 z2 x3]
+    x = _mm256_blend_pd(ab, ca, 0xa);
+    y = _mm256_shuffle_pd(ab, bc, 0x5);
+    z = _mm256_blend_pd(ca, bc, 0xa);
+}
+
+// Stores 4 triples, inverse of loadTriplesAVX2()
+SGL_TARGET_AVX2
+inline void storeTriplesAVX2(double * pDst, __m256d x, __m256d y, __m256d z)
+{
+    const __m256d xy = _mm256_shuffle_pd(x, y, 0x0);                    // [x0 y0 x2 y2]
+    const __m256d yz = _mm256_shuffle_pd(y, z, 0xf);                    // [y1 z1 y3 z3]
+    __m256d zx = _mm256_blend_pd(z, x, 0xa);                            // [z0 x1 z2 x3]
+    zx = _mm256_permute2f128_pd(zx, zx, 0x01);                          // [z2 x3 z0 x1]
+    _mm256_storeu_pd(pDst, _mm256_blend_pd(xy, zx, 0xc));
+    _mm256_storeu_pd(pDst + 4, _mm256_blend_pd(yz, xy, 0xc));
+    _mm256_storeu_pd(pDst + 8, _mm256_blend_pd(zx, yz, 0xc));
+}
+
+// Loads 8 triples (24 doubles: a = d[0..7], b = d[8..15], c = d[16..23]).
+// Coordinate k of triple i is d[3 * i + k]; gathered in two steps: first from (a, b), then from c.
+SGL_TARGET_AVX512
+inline void loadTriplesAVX512(const double * pSrc, __m512d & x, __m512d & y, __m512d & z)
+{
+    const __m512i xAB = _mm512_setr_epi64(0, 3, 6, 9, 12, 15, 0, 0);
+    const __m512i xC = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 8 + 2, 8 + 5);
+    const __m512i yAB = _mm512_setr_epi64(1, 4, 7, 10, 13, 0, 0, 0);
+    const __m512i yC = _mm512_setr_epi64(0, 1, 2, 3, 4, 8 + 0, 8 + 3, 8 + 6);
+    const __m512i zAB = _mm512_setr_epi64(2, 5, 8, 11, 14, 0, 0, 0);
+    const __m512i zC = _mm512_setr_epi64(0, 1, 2, 3, 4, 8 + 1, 8 + 4, 8 + 7);
+
+    const __m512d a = _mm512_loadu_pd(pSrc);
+    const __m512d b = _mm512_loadu_pd(pSrc + 8);
+    const __m512d c = _mm512_loadu_pd(pSrc + 16);
+    x = _mm512_permutex2var_pd(_mm512_permutex2var_pd(a, xAB, b), xC, c);
+    y = _mm512_permutex2var_pd(_mm512_permutex2var_pd(a, yAB, b), yC, c);
+    z = _mm512_permutex2var_pd(_mm512_permutex2var_pd(a, zAB, b), zC, c);
+}
+
+// Stores 8 triples, inverse of loadTriplesAVX512(): first from (x, y), then z is inserted
+SGL_TARGET_AVX512
+inline void storeTriplesAVX512(double * pDst, __m512d x, __m512d y, __m512d z)
+{
+    const __m512i aXY = _mm512_setr_epi64(0, 8, 0, 1, 9, 0, 2, 10);
+    const __m512i aZ = _mm512_setr_epi64(0, 1, 8 + 0, 3, 4, 8 + 1, 6, 7);
+    const __m512i bXY = _mm512_setr_epi64(0, 3, 11, 0, 4, 12, 0, 5);
+    const __m512i bZ = _mm512_setr_epi64(8 + 2, 1, 2, 8 + 3, 4, 5, 8 + 4, 7);
+    const __m512i cXY = _mm512_setr_epi64(13, 0, 6, 14, 0, 7, 15, 0);
+    const __m512i cZ = _mm512_setr_epi64(0, 8 + 5, 2, 3, 8 + 6, 5, 6, 8 + 7);
+
+    _mm512_storeu_pd(pDst, _mm512_permutex2var_pd(_mm512_permutex2var_pd(x, aXY, y), aZ, z));
+    _mm512_storeu_pd(pDst + 8, _mm512_permutex2var_pd(_mm512_permutex2var_pd(x, bXY, y), bZ, z));
+    _mm512_storeu_pd(pDst + 16, _mm512_permutex2var_pd(_mm512_permutex2var_pd(x, cXY, y), cZ, z));
+}
+
+} //namespace sgl
+
+#endif //SGL_SIMD_X86
+
+#endif //_GSIMDDEFS_H_
@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GAffine3D.h"
+#include "GMatrix4D.h"
+#include "GPoint3D.h"
+#include "GVector3D.h"
+#include "GUtils.h"
+
+#include <cmath>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+using namespace sgl;
+
+namespace
+{
+
+const GMatrix4D s_general{ 2.0, 1.0, 0.5, 3.0,
+                           -1.0, 3.0, 2.0, -4.0,
+                           0.5, -2.0, 1.5, 5.0,
+                           0.0, 0.0, 0.0, 1.0 };
+
+bool matricesEqual(const GMatrix4D & m1, const GMatrix4D & m2, double tolerance)
+{
+    for (std::size_t row = 0; row < 4; ++row)
+        for (std::size_t col = 0; col < 4; ++col)
+            if (!equal(m1(row, col), m2(row, col), tolerance))
+                return false;
+    return true;
+}
+
+} //namespace
+
+TEST(GAffine3DTest, test_identity)
+{
+    const auto & e = GAffine3D::identity();
+    for (std::size_t rowIdx = 0; rowIdx < 4; ++rowIdx)
+        for (std::size_t colIdx = 0; colIdx < 4; ++colIdx)
+            ASSERT_NEAR(e(rowIdx, colIdx), ((rowIdx == colIdx) ? 1.0 : 0.0), GTolerance::zeroTol());
+}
+
+TEST(GAffine3DTest, test_constructorWCS)
+{
+    GPoint3D origin{ 2.0, 3.0, 4.0 };
+    GAffine3D a{ origin, GVector3D::axisY(), GVector3D::axisZ(), GVector3D::axisX() };
+    ASSERT_TRUE(a.origin().equals(origin));
+    ASSERT_TRUE(a.x().equals(GVector3D::axisY()));
+    ASSERT_TRUE(a.y().equals(GVector3D::axisZ()));
+    ASSERT_TRUE(a.z().equals(GVector3D::axisX()));
+    ASSERT_TRUE(a.isOrthonormal());
+}
+
+TEST(GAffine3DTest, test_initializerList)
+{
+    const GAffine3D a{ 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0, 12.0 };
+    ASSERT_DOUBLE_EQ(a(1, 0), 5.0);
+    ASSERT_DOUBLE_EQ(a(2, 3), 12.0);
+    ASSERT_THROW((GAffine3D{ 1.0, 2.0, 3.0 }), std::invalid_argument);
+    ASSERT_THROW((GAffine3D{ 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0, 12.0, 13.0 }),
+                 std::invalid_argument);
+}
+
+TEST(GAffine3DTest, test_conversion)
+{
+    GAffine3D a = s_general;
+    GMatrix4D m = a;
+    ASSERT_TRUE(matricesEqual(m, s_general, GTolerance::zeroTol()));
+    ASSERT_NEAR(a(3, 3), 1.0, GTolerance::zeroTol());
+    ASSERT_NEAR(a(3, 0), 0.0, GTolerance::zeroTol());
+}
+
+TEST(GAffine3DTest, test_product)
+{
+    const GMatrix4D m2 = GMatrix4D::translation(GVector3D(1.0, -2.0, 3.0));
+    const GAffine3D a1 = s_general;
+    const GAffine3D a2 = m2;
+
+    ASSERT_TRUE(matricesEqual(a1 * a2, s_general * m2, 1.0e-12));
+    ASSERT_TRUE(matricesEqual(a2 * a1, m2 * s_general, 1.0e-12));
+    ASSERT_TRUE(matricesEqual(s_general * a2, s_general * m2, 1.0e-12));
+    ASSERT_TRUE(matricesEqual(a1 * m2, s_general * m2, 1.0e-12));
+
+    GAffine3D a = a1;
+    a.postMultiplyBy(a2);
+    ASSERT_TRUE(a.equals(a1 * a2));
+    a = a1;
+    a.preMultiplyBy(a2);
+    ASSERT_TRUE(a.equals(a2 * a1));
+    a.product(a1, a2);
+    ASSERT_TRUE(a.equals(a1 * a2));
+}
+
+TEST(GAffine3DTest, test_inverseOrthonormal)
+{
+    const double s = std::sin(0.3), c = std::cos(0.3);
+    const GAffine3D a{ c, -s, 0.0, 1.0,
+                       s, c, 0.0, 2.0,
+                       0.0, 0.0, 1.0, 3.0 };
+    ASSERT_TRUE(a.isOrthonormal());
+    ASSERT_NEAR(a.determinant(), 1.0, 1.0e-12);
+
+    const GAffine3D inv = a.inverse();
+    ASSERT_TRUE((a * inv).equals(GAffine3D::identity(), 1.0e-12));
+    ASSERT_TRUE((inv * a).equals(GAffine3D::identity(), 1.0e-12));
+}
+
+TEST(GAffine3DTest, test_inverseGeneral)
+{
+    GAffine3D a = s_general;
+    ASSERT_FALSE(a.isOrthonormal());
+    const GAffine3D inv = a.inverse();
+    ASSERT_TRUE((a * inv).equals(GAffine3D::identity(), 1.0e-12));
+
+    a.invert();
+    ASSERT_TRUE(a.equals(inv));
+
+    GAffine3D singular{ 1.0, 2.0, 3.0, 0.0,
+                        2.0, 4.0, 6.0, 0.0,
+                        0.0, 0.0, 1.0, 0.0 };
+    ASSERT_TRUE(singular.singular());
+    ASSERT_THROW(singular.invert(), std::logic_error);
+}
@@ -0,0 +1,252 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "GTestUtils.h"
+#include "GBVH.h"
+#include "GBox3DArray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace sgl;
+using sgl::test::sorted;
+
+namespace
+{
+
+std::vector<GBox3D> randomBoxes(std::size_t count, unsigned seed = 42)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> center(-50.0, 50.0);
+    std::uniform_real_distribution<double> extent(0.05, 2.0);
+    std::vector<GBox3D> res;
+    res.reserve(count);
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        const GPoint3D c(center(gen), center(gen), center(gen));
+        const GVector3D e(extent(gen), extent(gen), extent(gen));
+        res.emplace_back(c - e, c + e);
+    }
+    return res;
+}
+
+// Checks that every node encloses its children and primitives
+void checkStructure(const GBVH & bvh, const std::vector<GBox3D> & bounds)
+{
+    const auto & nodes = bvh.nodes();
+    std::vector<std::size_t> visited(bvh.size(), 0);
+    for (std::size_t idx = 0; idx < nodes.size(); ++idx)
+    {
+        const GBVHNode & node = nodes[idx];
+        if (node.isLeaf())
+        {
+            for (std::size_t prim = node.index; prim < node.index + node.count; ++prim)
+            {
+                const std::size_t id = bvh.primitives()[prim];
+                ++visited[id];
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    ASSERT_LE(node.min[axis], bounds[id][axis].from());
+                    ASSERT_GE(node.max[axis], bounds[id][axis].to());
+                }
+            }
+            continue;
+        }
+        ASSERT_GT(node.index, idx + 1);
+        for (const std::size_t child : { idx + 1, static_cast<std::size_t>(node.index) })
+        {
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                ASSERT_LE(node.min[axis], nodes[child].min[axis]);
+                ASSERT_GE(node.max[axis], nodes[child].max[axis]);
+            }
+        }
+    }
+    ASSERT_TRUE(std::all_of(visited.begin(), visited.end(), [](std::size_t count) { return count == 1; }));
+}
+
+} //namespace
+
+TEST(GBVHTest, test_build)
+{
+    GBVH empty;
+    ASSERT_TRUE(empty.empty());
+    ASSERT_TRUE(empty.intersectBox(GBox3D()).empty());
+    std::size_t primitive = 0;
+    double distance = 0.0;
+    ASSERT_FALSE(empty.nearest(GPoint3D(), primitive, distance));
+    ASSERT_THROW(empty.bounds(), std::logic_error);
+
+    for (std::size_t count : { 1u, 5u, 100u, 10000u })
+    {
+        for (unsigned threads : { 1u, 4u })
+        {
+            const auto bounds = randomBoxes(count);
+            GBVH bvh(bounds, 4, threads);
+            ASSERT_EQ(bvh.size(), count);
+            checkStructure(bvh, bounds);
+        }
+    }
+
+    // Coincident primitives can not be separated by binning
+    GBVH same(std::vector<GBox3D>(50, GBox3D()), 2);
+    checkStructure(same, std::vector<GBox3D>(50, GBox3D()));
+    ASSERT_TRUE(same.bounds().equals(GBox3D()));
+
+    ASSERT_THROW(GBVH(randomBoxes(3), 0), std::invalid_argument);
+}
+
+TEST(GBVHTest, test_intersectRay)
+{
+    const auto bounds = randomBoxes(5000);
+    const GBVH bvh(bounds);
+    const GBox3DArray boxes(bounds);
+
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> dist(-60.0, 60.0);
+    for (int idx = 0; idx < 50; ++idx)
+    {
+        const GPoint3D origin(dist(gen), dist(gen), dist(gen));
+        const GVector3D direction(dist(gen), idx % 5 == 0 ? 0.0 : dist(gen), dist(gen));
+        for (double maxDistance : { 0.3, std::numeric_limits<double>::infinity() })
+        {
+            const auto expected = boxes.intersectRay(origin, direction, maxDistance);
+            ASSERT_EQ(sorted(bvh.intersectRay(origin, direction, maxDistance)), expected);
+
+            // Closest hit against boxes themselves
+            std::size_t primitive = 0;
+            double t = 0.0;
+            const auto entry = [&](std::size_t id)
+            {
+                double tNear = 0.0;
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    if (direction[axis] == 0.0)
+                        continue;
+                    const double t1 = (bounds[id][axis].from() - origin[axis]) / direction[axis];
+                    const double t2 = (bounds[id][axis].to() - origin[axis]) / direction[axis];
+                    tNear = std::max(tNear, std::min(t1, t2));
+                }
+                return tNear;
+            };
+            const bool hit = bvh.closestHit(origin, direction, maxDistance, entry, primitive, t);
+            ASSERT_EQ(hit, !expected.empty());
+            if (hit)
+            {
+                double best = std::numeric_limits<double>::infinity();
+                for (const auto id : expected)
+                    best = std::min(best, entry(id));
+                ASSERT_DOUBLE_EQ(t, best);
+            }
+        }
+    }
+}
+
+TEST(GBVHTest, test_intersectBox)
+{
+    const auto bounds = randomBoxes(3000);
+    const GBVH bvh(bounds, 8);
+    const GBox3DArray boxes(bounds);
+    for (const auto & query : randomBoxes(30, 11))
+        ASSERT_EQ(sorted(bvh.intersectBox(query)), boxes.intersectBox(query));
+}
+
+TEST(GBVHTest, test_nearest)
+{
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> dist(-10.0, 10.0);
+    std::vector<GPoint3D> points(2000);
+    std::vector<GBox3D> bounds;
+    for (auto & pt : points)
+    {
+        pt = GPoint3D(dist(gen), dist(gen), dist(gen));
+        bounds.emplace_back(pt, pt);
+    }
+    const GBVH bvh(bounds, 2);
+
+    for (int idx = 0; idx < 50; ++idx)
+    {
+        const GPoint3D query(dist(gen), dist(gen), dist(gen));
+        double expected = std::numeric_limits<double>::infinity();
+        for (const auto & pt : points)
+            expected = std::min(expected, (pt - query).length());
+
+        std::size_t primitive = 0;
+        double distance = 0.0;
+        ASSERT_TRUE(bvh.nearest(query, primitive, distance));
+        ASSERT_NEAR(distance, expected, 1e-12);
+        ASSERT_NEAR((points[primitive] - query).length(), expected, 1e-12);
+
+        const auto distanceTo = [&](std::size_t id) { return (points[id] - query).length(); };
+        ASSERT_TRUE(bvh.nearest(query, distanceTo, primitive, distance));
+        ASSERT_DOUBLE_EQ(distance, expected);
+        ASSERT_FALSE(bvh.nearest(query, distanceTo, primitive, distance, expected * 0.5));
+    }
+}
+
+TEST(GBVHTest, test_refit)
+{
+    auto bounds = randomBoxes(2000);
+    GBVH bvh(bounds);
+
+    const GMatrix4D scale = GMatrix4D::scale(2.0, 2.0, 2.0);
+    bvh.refit(scale);
+    std::vector<GBox3D> scaled;
+    for (const auto & box : bounds)
+        scaled.emplace_back(GPoint3D(2.0 * box.min()[0], 2.0 * box.min()[1], 2.0 * box.min()[2]),
+                            GPoint3D(2.0 * box.max()[0], 2.0 * box.max()[1], 2.0 * box.max()[2]));
+    checkStructure(bvh, scaled);
+    const GBox3DArray boxes(scaled);
+    for (const auto & query : randomBoxes(20, 9))
+        ASSERT_EQ(sorted(bvh.intersectBox(query)), boxes.intersectBox(query));
+
+    bvh.refit(bounds);
+    checkStructure(bvh, bounds);
+    ASSERT_THROW(bvh.refit(randomBoxes(3)), std::invalid_argument);
+}
+
+TEST(GBVHTest, test_refitTranslation)
+{
+    const auto bounds = randomBoxes(2000);
+    GBVH bvh(bounds);
+
+    const GVector3D offset(10.0, -20.0, 5.0);
+    bvh.refit(GMatrix4D::translation(offset).transpose());
+    std::vector<GBox3D> moved;
+    for (const auto & box : bounds)
+        moved.emplace_back(box.min() + offset, box.max() + offset);
+    checkStructure(bvh, moved);
+
+    const GBVHNode & root = bvh.nodes().front();
+    GBox3D total = moved.front();
+    for (const auto & box : moved)
+        total += box;
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        // Node bounds are floats rounded outwards
+        ASSERT_NEAR(root.min[axis], total[axis].from(), 1e-4);
+        ASSERT_NEAR(root.max[axis], total[axis].to(), 1e-4);
+    }
+
+    const GBox3DArray boxes(moved);
+    for (const auto & query : randomBoxes(20, 9))
+        ASSERT_EQ(sorted(bvh.intersectBox(query)), boxes.intersectBox(query));
+}
@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "GBox3DArray.h"
+#include "GBox3D.h"
+#include "GPoint3D.h"
+#include "GPointCloud.h"
+#include "GSimd.h"
+#include "GVector3D.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace sgl;
+
+namespace
+{
+
+std::vector<GSimdLevel> supportedLevels()
+{
+    std::vector<GSimdLevel> res;
+    for (int level = 0; level <= static_cast<int>(supportedSimdLevel()); ++level)
+        res.push_back(static_cast<GSimdLevel>(level));
+    return res;
+}
+
+class SimdLevelGuard
+{
+public:
+    explicit SimdLevelGuard(GSimdLevel level) : m_level{ simdLevel() } { setSimdLevel(level); }
+    ~SimdLevelGuard() { setSimdLevel(m_level); }
+private:
+    GSimdLevel m_level;
+};
+
+std::vector<GBox3D> randomBoxes(std::size_t count, unsigned seed = 42)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> center(-10.0, 10.0);
+    std::uniform_real_distribution<double> extent(0.1, 3.0);
+    std::vector<GBox3D> res;
+    res.reserve(count);
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        const GPoint3D c(center(gen), center(gen), center(gen));
+        const GVector3D e(extent(gen), extent(gen), extent(gen));
+        res.emplace_back(c - e, c + e);
+    }
+    return res;
+}
+
+// Reference slab test, written independently of the batched kernels
+bool rayHits(const GBox3D & box, const GPoint3D & origin, const GVector3D & direction, double maxDistance)
+{
+    double tNear = 0.0;
+    double tFar = maxDistance;
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        if (direction[axis] == 0.0)
+        {
+            if (!box[axis].contains(origin[axis], 0.0))
+                return false;
+            continue;
+        }
+        double t1 = (box[axis].from() - origin[axis]) / direction[axis];
+        double t2 = (box[axis].to() - origin[axis]) / direction[axis];
+        if (t1 > t2)
+            std::swap(t1, t2);
+        tNear = std::max(tNear, t1);
+        tFar = std::min(tFar, t2);
+    }
+    return tNear <= tFar;
+}
+
+} //namespace
+
+TEST(GBox3DArrayTest, test_container)
+{
+    GBox3DArray arr;
+    ASSERT_TRUE(arr.empty());
+
+    const auto boxes = randomBoxes(5);
+    for (const auto & box : boxes)
+        arr.push_back(box);
+    ASSERT_EQ(arr.size(), 5u);
+    for (std::size_t idx = 0; idx < boxes.size(); ++idx)
+        ASSERT_TRUE(arr.box(idx).equals(boxes[idx]));
+
+    arr.setBox(2, GBox3D());
+    ASSERT_TRUE(arr.box(2).equals(GBox3D()));
+    ASSERT_DOUBLE_EQ(arr.minData(0)[2], 0.0);
+    ASSERT_DOUBLE_EQ(arr.maxData(2)[2], 1.0);
+
+    GBox3DArray copy(boxes);
+    ASSERT_EQ(copy.size(), 5u);
+    copy.clear();
+    ASSERT_TRUE(copy.empty());
+}
+
+TEST(GBox3DArrayTest, test_intersectRay)
+{
+    const auto boxes = randomBoxes(203);
+    const GBox3DArray arr(boxes);
+
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dist(-12.0, 12.0);
+    std::vector<std::pair<GPoint3D, GVector3D>> rays;
+    for (int idx = 0; idx < 20; ++idx)
+        rays.emplace_back(GPoint3D(dist(gen), dist(gen), dist(gen)), GVector3D(dist(gen), dist(gen), dist(gen)));
+    rays.emplace_back(GPoint3D(0.0, 0.0, 0.0), GVector3D(1.0, 0.0, 0.0));
+    rays.emplace_back(GPoint3D(-15.0, 1.0, 2.0), GVector3D(0.0, 0.0, 1.0));
+
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+        for (const auto & ray : rays)
+        {
+            for (double maxDistance : { 0.5, std::numeric_limits<double>::infinity() })
+            {
+                std::vector<std::size_t> expected;
+                for (std::size_t idx = 0; idx < boxes.size(); ++idx)
+                {
+                    if (rayHits(boxes[idx], ray.first, ray.second, maxDistance))
+                        expected.push_back(idx);
+                }
+                ASSERT_EQ(arr.intersectRay(ray.first, ray.second, maxDistance), expected);
+
+                std::vector<std::uint8_t> hits(boxes.size());
+                ASSERT_EQ(arr.intersectRay(ray.first, ray.second, maxDistance, hits.data()), expected.size());
+            }
+        }
+    }
+}
+
+TEST(GBox3DArrayTest, test_intersectBox)
+{
+    const auto boxes = randomBoxes(117);
+    const GBox3DArray arr(boxes);
+    const auto queries = randomBoxes(15, 3);
+
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+        for (const auto & query : queries)
+        {
+            std::vector<std::size_t> expected;
+            for (std::size_t idx = 0; idx < boxes.size(); ++idx)
+            {
+                if (boxes[idx].intersects(query, 0.0))
+                    expected.push_back(idx);
+            }
+            ASSERT_EQ(arr.intersectBox(query), expected);
+        }
+
+        // Touching boxes are reported as intersecting
+        GBox3DArray touching(std::vector<GBox3D>(9, GBox3D(GPoint3D(1.0, 0.0, 0.0), GPoint3D(2.0, 1.0, 1.0))));
+        ASSERT_EQ(touching.intersectBox(GBox3D()).size(), 9u);
+    }
+}
+
+TEST(GBox3DArrayTest, test_containsPoints)
+{
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> dist(-2.0, 2.0);
+    std::vector<GPoint3D> points(301);
+    for (auto & pt : points)
+        pt = GPoint3D(dist(gen), dist(gen), dist(gen));
+    points[5] = GPoint3D(1.0, -1.0, 0.0);
+
+    const GBox3D box(GPoint3D(-1.0, -1.0, -1.0), GPoint3D(1.0, 1.5, 0.5));
+    std::vector<std::uint8_t> expected(points.size());
+    std::size_t expectedCount = 0;
+    for (std::size_t idx = 0; idx < points.size(); ++idx)
+    {
+        expected[idx] = box.contains(points[idx], 0.0) ? 1 : 0;
+        expectedCount += expected[idx];
+    }
+    ASSERT_EQ(expected[5], 1);
+
+    GPointCloud cloud;
+    for (const auto & pt : points)
+        cloud.push_back(pt);
+
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+        std::vector<std::uint8_t> inside(points.size(), 2);
+        ASSERT_EQ(containsPoints(box, points.data(), points.size(), inside.data()), expectedCount);
+        ASSERT_EQ(inside, expected);
+
+        std::fill(inside.begin(), inside.end(), 2);
+        ASSERT_EQ(containsPoints(box, cloud, inside.data()), expectedCount);
+        ASSERT_EQ(inside, expected);
+    }
+}
@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "GBox3D.h"
+#include "GPoint3D.h"
+#include "GVector3D.h"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace sgl;
+
+TEST(GBox3DTest, test_constructor)
+{
+    GBox3D def;
+    ASSERT_TRUE(def.min().equals(GPoint3D(0.0, 0.0, 0.0)));
+    ASSERT_TRUE(def.max().equals(GPoint3D(1.0, 1.0, 1.0)));
+
+    GBox3D corners(GPoint3D(2.0, -1.0, 5.0), GPoint3D(-2.0, 1.0, 3.0));
+    ASSERT_TRUE(corners.min().equals(GPoint3D(-2.0, -1.0, 3.0)));
+    ASSERT_TRUE(corners.max().equals(GPoint3D(2.0, 1.0, 5.0)));
+    ASSERT_TRUE(corners.center().equals(GPoint3D(0.0, 0.0, 4.0)));
+    ASSERT_TRUE(corners.diagonal().equals(GVector3D(4.0, 2.0, 2.0)));
+    ASSERT_DOUBLE_EQ(corners[2].from(), 3.0);
+
+    GBox3D intervals(GInterval(-2.0, 2.0), GInterval(-1.0, 1.0), GInterval(3.0, 5.0));
+    ASSERT_TRUE(intervals.equals(corners));
+
+    GBox3Df single(corners);
+    ASSERT_FLOAT_EQ(single.x().from(), -2.0f);
+    ASSERT_FLOAT_EQ(single.z().to(), 5.0f);
+}
+
+TEST(GBox3DTest, test_fromPoints)
+{
+    std::vector<GPoint3D> points = { GPoint3D(1.0, 2.0, 3.0), GPoint3D(-1.0, 5.0, 0.0), GPoint3D(0.0, 0.0, 7.0) };
+    GBox3D box = GBox3D::fromPoints(points);
+    ASSERT_TRUE(box.min().equals(GPoint3D(-1.0, 0.0, 0.0)));
+    ASSERT_TRUE(box.max().equals(GPoint3D(1.0, 5.0, 7.0)));
+
+    ASSERT_THROW(GBox3D::fromPoints(std::vector<GPoint3D>()), std::invalid_argument);
+}
+
+TEST(GBox3DTest, test_intersects)
+{
+    GBox3D box(GPoint3D(0.0, 0.0, 0.0), GPoint3D(2.0, 2.0, 2.0));
+    ASSERT_TRUE(box.intersects(GBox3D(GPoint3D(1.0, 1.0, 1.0), GPoint3D(3.0, 3.0, 3.0))));
+    ASSERT_TRUE(box.intersects(GBox3D(GPoint3D(2.0, 0.0, 0.0), GPoint3D(3.0, 1.0, 1.0))));
+    ASSERT_TRUE(box.intersects(GBox3D(GPoint3D(-1.0, -1.0, -1.0), GPoint3D(3.0, 3.0, 3.0))));
+    ASSERT_FALSE(box.intersects(GBox3D(GPoint3D(0.0, 2.5, 0.0), GPoint3D(1.0, 3.0, 1.0))));
+}
+
+TEST(GBox3DTest, test_contains)
+{
+    GBox3D box(GPoint3D(0.0, 0.0, 0.0), GPoint3D(2.0, 2.0, 2.0));
+    ASSERT_TRUE(box.contains(GPoint3D(1.0, 1.0, 1.0)));
+    ASSERT_TRUE(box.contains(GPoint3D(2.0, 0.0, 1.0)));
+    ASSERT_FALSE(box.contains(GPoint3D(1.0, 2.5, 1.0)));
+    ASSERT_TRUE(box.contains(GPoint3D(1.0, 2.05, 1.0), 0.1));
+}
+
+TEST(GBox3DTest, test_add)
+{
+    GBox3D box(GPoint3D(0.0, 0.0, 0.0), GPoint3D(1.0, 1.0, 1.0));
+    box += GPoint3D(-1.0, 0.5, 3.0);
+    ASSERT_TRUE(box.min().equals(GPoint3D(-1.0, 0.0, 0.0)));
+    ASSERT_TRUE(box.max().equals(GPoint3D(1.0, 1.0, 3.0)));
+
+    box += GBox3D(GPoint3D(0.0, -4.0, 0.0), GPoint3D(5.0, 0.0, 0.0));
+    ASSERT_TRUE(box.min().equals(GPoint3D(-1.0, -4.0, 0.0)));
+    ASSERT_TRUE(box.max().equals(GPoint3D(5.0, 1.0, 3.0)));
+}
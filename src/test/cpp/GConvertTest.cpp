@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GConvert.h"
+#include "GPoint3D.h"
+#include "GSimd.h"
+#include "GVector3D.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace sgl;
+
+namespace
+{
+
+std::vector<GSimdLevel> supportedLevels()
+{
+    std::vector<GSimdLevel> res;
+    for (int level = 0; level <= static_cast<int>(supportedSimdLevel()); ++level)
+        res.push_back(static_cast<GSimdLevel>(level));
+    return res;
+}
+
+std::vector<double> randomValues(std::size_t count)
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1000.0, 1000.0);
+    std::vector<double> res(count);
+    for (auto & value : res)
+        value = dist(gen);
+    return res;
+}
+
+class SimdLevelGuard
+{
+public:
+    explicit SimdLevelGuard(GSimdLevel level) : m_level{ simdLevel() } { setSimdLevel(level); }
+    ~SimdLevelGuard() { setSimdLevel(m_level); }
+private:
+    GSimdLevel m_level;
+};
+
+} //namespace
+
+TEST(GConvertTest, test_convertValues)
+{
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+        for (std::size_t count = 0; count < 40; ++count)
+        {
+            const auto src = randomValues(count);
+            std::vector<float> down(count);
+            convert(src.data(), down.data(), count);
+            std::vector<double> up(count);
+            convert(down.data(), up.data(), count);
+            for (std::size_t idx = 0; idx < count; ++idx)
+            {
+                ASSERT_EQ(down[idx], static_cast<float>(src[idx]));
+                ASSERT_EQ(up[idx], static_cast<double>(down[idx]));
+            }
+        }
+    }
+}
+
+TEST(GConvertTest, test_convertPoints)
+{
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+        const auto values = randomValues(3 * 11);
+        GPoint3DArray points;
+        for (std::size_t idx = 0; idx < values.size(); idx += 3)
+            points.emplace_back(values[idx], values[idx + 1], values[idx + 2]);
+
+        const GPoint3DfArray pointsf = toFloat(points);
+        ASSERT_EQ(pointsf.size(), points.size());
+        for (std::size_t idx = 0; idx < points.size(); ++idx)
+        {
+            const GPoint3Df expected(points[idx]);
+            ASSERT_EQ(pointsf[idx].x(), expected.x());
+            ASSERT_EQ(pointsf[idx].y(), expected.y());
+            ASSERT_EQ(pointsf[idx].z(), expected.z());
+        }
+
+        const GPoint3DArray back = toDouble(pointsf);
+        for (std::size_t idx = 0; idx < points.size(); ++idx)
+            ASSERT_TRUE(back[idx].equals(points[idx], 1e-4));
+    }
+}
+
+TEST(GConvertTest, test_convertVectors)
+{
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+        GVector3DArray vectors{ GVector3D(1.0 / 3.0, -2.5, 1e10), GVector3D(0.1, 0.2, 0.3) };
+        GVector3DfArray vectorsf(vectors.size());
+        convert(vectors.data(), vectorsf.data(), vectors.size());
+        ASSERT_EQ(vectorsf[0].x(), 1.0f / 3.0f);
+        ASSERT_EQ(vectorsf[0].z(), 1e10f);
+        ASSERT_EQ(vectorsf[1].y(), 0.2f);
+
+        GVector3DArray back(vectors.size());
+        convert(vectorsf.data(), back.data(), vectors.size());
+        ASSERT_EQ(back[1].y(), static_cast<double>(0.2f));
+        ASSERT_TRUE(toDouble(vectorsf)[0].equals(back[0]));
+        ASSERT_TRUE(toFloat(GVector3DArray()).empty());
+    }
+}
@@ -0,0 +1,165 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "GTestUtils.h"
+#include "GConvexHull.h"
+#include "GPointCloud.h"
+#include "GPredicates.h"
+
+#include <random>
+#include <vector>
+
+using namespace sgl;
+using sgl::test::randomPoints;
+
+namespace
+{
+
+GPoint3DArray spherePoints(std::size_t count, double radius, unsigned seed = 42)
+{
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> dist;
+    GPoint3DArray res(count);
+    for (auto & pt : res)
+    {
+        const double x = dist(gen);
+        const double y = dist(gen);
+        const double z = dist(gen);
+        const double scale = radius / std::sqrt(x * x + y * y + z * z);
+        pt = GPoint3D(x * scale, y * scale, z * scale);
+    }
+    return res;
+}
+
+// Every point lies on or inside every face, half-edges are consistent
+void checkHull(const GPoint3DArray & points, const GConvexHull & hull)
+{
+    const auto & faces = hull.faces();
+    ASSERT_EQ(3 * hull.faceCount(), faces.size());
+    for (std::size_t face = 0; face < hull.faceCount(); ++face)
+    {
+        for (const auto & pt : points)
+        {
+            ASSERT_GE(orient3d(points[faces[3 * face]], points[faces[3 * face + 1]], points[faces[3 * face + 2]], pt),
+                      0.0);
+        }
+    }
+
+    const std::vector<GHullHalfEdge> edges = hull.halfEdges();
+    ASSERT_EQ(faces.size(), edges.size());
+    for (std::size_t edge = 0; edge < edges.size(); ++edge)
+    {
+        ASSERT_NE(GConvexHull::npos, edges[edge].twin);
+        EXPECT_EQ(edge, edges[edges[edge].twin].twin);
+        EXPECT_EQ(edges[edges[edge].next].origin, edges[edges[edge].twin].origin);
+        EXPECT_EQ(edge / 3, edges[edge].face);
+        EXPECT_EQ(edges[edge].twin / 3, hull.neighbours()[edge]);
+    }
+
+    // Closed triangulated surface of genus 0
+    EXPECT_EQ(2 * hull.vertices().size() - 4, hull.faceCount());
+}
+
+} //namespace
+
+TEST(GConvexHullTest, test_degenerate)
+{
+    EXPECT_TRUE(GConvexHull().empty());
+    EXPECT_TRUE(GConvexHull(GPoint3DArray()).empty());
+
+    const GPoint3DArray three = { GPoint3D(0.0, 0.0, 0.0), GPoint3D(1.0, 0.0, 0.0), GPoint3D(0.0, 1.0, 0.0) };
+    EXPECT_TRUE(GConvexHull(three).empty());
+
+    GPoint3DArray planar = randomPoints(100, 1.0);
+    for (auto & pt : planar)
+        pt.setZ(2.0);
+    const GConvexHull hull(planar);
+    EXPECT_TRUE(hull.empty());
+    EXPECT_EQ(0u, hull.faceCount());
+    EXPECT_TRUE(hull.vertices().empty());
+}
+
+TEST(GConvexHullTest, test_tetrahedron)
+{
+    const GPoint3DArray points = { GPoint3D(0.0, 0.0, 0.0), GPoint3D(1.0, 0.0, 0.0), GPoint3D(0.0, 1.0, 0.0),
+                                   GPoint3D(0.0, 0.0, 1.0), GPoint3D(0.1, 0.1, 0.1) };
+    const GConvexHull hull(points);
+    EXPECT_EQ(4u, hull.faceCount());
+    EXPECT_EQ((std::vector<std::size_t>{ 0, 1, 2, 3 }), hull.vertices());
+    checkHull(points, hull);
+}
+
+TEST(GConvexHullTest, test_cubeGrid)
+{
+    // Many coplanar and collinear points, only corners are vertices
+    GPoint3DArray points;
+    for (int x = 0; x <= 6; ++x)
+    {
+        for (int y = 0; y <= 6; ++y)
+        {
+            for (int z = 0; z <= 6; ++z)
+                points.emplace_back(x * 0.5, y * 0.5, z * 0.5);
+        }
+    }
+    const GConvexHull hull(points);
+    EXPECT_EQ(12u, hull.faceCount());
+    ASSERT_EQ(8u, hull.vertices().size());
+    for (const std::size_t vertex : hull.vertices())
+    {
+        const GPoint3D & pt = points[vertex];
+        EXPECT_TRUE(pt.x() == 0.0 || pt.x() == 3.0);
+        EXPECT_TRUE(pt.y() == 0.0 || pt.y() == 3.0);
+        EXPECT_TRUE(pt.z() == 0.0 || pt.z() == 3.0);
+    }
+    checkHull(points, hull);
+}
+
+TEST(GConvexHullTest, test_random)
+{
+    const GPoint3DArray points = randomPoints(3000, 10.0);
+    const GConvexHull hull(points);
+    EXPECT_FALSE(hull.empty());
+    checkHull(points, hull);
+}
+
+TEST(GConvexHullTest, test_sphere)
+{
+    // All points are vertices
+    const GPoint3DArray points = spherePoints(1000, 5.0);
+    const GConvexHull hull(points);
+    EXPECT_EQ(points.size(), hull.vertices().size());
+    checkHull(points, hull);
+}
+
+TEST(GConvexHullTest, test_deterministic)
+{
+    GPoint3DArray points = randomPoints(100000, 1.0);
+    const GPoint3DArray sphere = spherePoints(2000, 2.0);
+    points.insert(points.end(), sphere.begin(), sphere.end());
+
+    const GConvexHull hull(points, 1);
+    const GConvexHull parallelHull(points, 4);
+    EXPECT_EQ(hull.faces(), parallelHull.faces());
+    EXPECT_EQ(hull.neighbours(), parallelHull.neighbours());
+
+    const GConvexHull cloudHull(GPointCloud(points), 4);
+    EXPECT_EQ(hull.faces(), cloudHull.faces());
+    EXPECT_EQ(hull.vertices(), cloudHull.vertices());
+    EXPECT_EQ(sphere.size(), hull.vertices().size());
+}
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "GDualQuaternion.h"
+#include "GMatrix4D.h"
+#include "GPoint3D.h"
+#include "GVector3D.h"
+
+using namespace sgl;
+
+namespace
+{
+
+const double s_tol = 1e-12;
+
+} //namespace
+
+TEST(GDualQuaternionTest, test_layout)
+{
+    static_assert(std::is_trivially_copyable<GDualQuaternion>::value, "");
+    constexpr auto dq = GDualQuaternion::translation(GVector3D(1.0, 2.0, 3.0));
+    static_assert(dq.translation().y() == 2.0, "");
+    ASSERT_EQ(sizeof(GDualQuaternion), 8 * sizeof(double));
+}
+
+TEST(GDualQuaternionTest, test_transform)
+{
+    const auto q = GQuaternion::rotation(M_PI / 2.0, GVector3D::axisZ());
+    const GDualQuaternion dq(q, GVector3D(1.0, 2.0, 3.0));
+    ASSERT_TRUE(dq.isUnit());
+    ASSERT_TRUE(dq.rotation().equals(q));
+    ASSERT_TRUE(dq.translation().equals(GVector3D(1.0, 2.0, 3.0), s_tol));
+    ASSERT_TRUE(dq.transform(GPoint3D(1.0, 0.0, 0.0)).equals(GPoint3D(1.0, 3.0, 3.0), s_tol));
+    ASSERT_TRUE(dq.transform(GVector3D(1.0, 0.0, 0.0)).equals(GVector3D(0.0, 1.0, 0.0), s_tol));
+
+    const auto rot = GDualQuaternion::rotation(M_PI / 2.0, GVector3D::axisZ(), GPoint3D(1.0, 1.0, 0.0));
+    ASSERT_TRUE(rot.transform(GPoint3D(1.0, 1.0, 7.0)).equals(GPoint3D(1.0, 1.0, 7.0), s_tol));
+    ASSERT_TRUE(rot.transform(GPoint3D(2.0, 1.0, 0.0)).equals(GPoint3D(1.0, 2.0, 0.0), s_tol));
+
+    const auto inv = dq.inverse();
+    ASSERT_TRUE(inv.transform(dq.transform(GPoint3D(4.0, -5.0, 6.0))).equals(GPoint3D(4.0, -5.0, 6.0), s_tol));
+}
+
+TEST(GDualQuaternionTest, test_compose)
+{
+    const GDualQuaternion dq1(GQuaternion::rotation(0.4, GVector3D(1.0, 0.0, 1.0)), GVector3D(1.0, -1.0, 2.0));
+    const GDualQuaternion dq2(GQuaternion::rotation(-2.0, GVector3D(0.0, 3.0, 1.0)), GVector3D(0.0, 5.0, -2.0));
+    const GPoint3D pt(3.0, 2.0, 1.0);
+
+    ASSERT_TRUE((dq1 * dq2).transform(pt).equals(dq1.transform(dq2.transform(pt)), s_tol));
+    ASSERT_TRUE((dq1 * dq2).toMatrix().equals(dq1.toMatrix() * dq2.toMatrix(), s_tol));
+
+    auto dq = dq1;
+    dq *= dq2;
+    ASSERT_TRUE(dq.equals(dq1 * dq2));
+    ASSERT_TRUE((dq1 * dq1.inverse()).equals(GDualQuaternion::identity(), s_tol));
+}
+
+TEST(GDualQuaternionTest, test_matrix)
+{
+    const auto axis = GVector3D(2.0, 1.0, -1.0).normalize();
+    const GMatrix4D m = GQuaternion::rotation(1.3, axis).toMatrix() * GMatrix4D::translation(GVector3D(0.0, 2.0, 4.0));
+    const auto dq = GDualQuaternion::fromMatrix(m);
+    ASSERT_TRUE(dq.isUnit());
+    ASSERT_TRUE(dq.toMatrix().equals(m, s_tol));
+}
+
+TEST(GDualQuaternionTest, test_normalize)
+{
+    GDualQuaternion dq(GQuaternion(2.0, 0.0, 0.0, 0.0), GQuaternion(0.5, 1.0, 2.0, 3.0));
+    ASSERT_FALSE(dq.isUnit());
+    dq.normalize();
+    ASSERT_TRUE(dq.isUnit(s_tol));
+    ASSERT_TRUE(dq.translation().equals(GVector3D(1.0, 2.0, 3.0), s_tol));
+    ASSERT_THROW(GDualQuaternion(GQuaternion(0.0, 0.0, 0.0, 0.0), GQuaternion()).normalize(), std::logic_error);
+}
+
+TEST(GDualQuaternionTest, test_transformArray)
+{
+    const GDualQuaternion dq(GQuaternion::rotation(0.9, GVector3D(1.0, 1.0, 1.0)), GVector3D(-3.0, 2.0, 1.0));
+    GPoint3DArray points;
+    GVector3DArray vectors;
+    for (int idx = 0; idx < 21; ++idx)
+    {
+        points.emplace_back(idx * 0.5, -idx * 1.0, 3.0 - idx);
+        vectors.emplace_back(1.0 - idx, idx * 0.25, idx * 2.0);
+    }
+    auto pointsCopy = points;
+    dq.transform(pointsCopy);
+    auto vectorsCopy = vectors;
+    dq.transform(vectorsCopy.data(), vectorsCopy.size());
+    for (std::size_t idx = 0; idx < points.size(); ++idx)
+    {
+        ASSERT_TRUE(pointsCopy[idx].equals(dq.transform(points[idx]), 1e-10));
+        ASSERT_TRUE(vectorsCopy[idx].equals(dq.transform(vectors[idx]), 1e-10));
+    }
+}
@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GExpression.h"
+#include "GMatrix4D.h"
+#include "GPoint3D.h"
+#include "GUtils.h"
+#include "GVector3D.h"
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "GTestUtils.h"
+
+using namespace sgl;
+using sgl::test::randomPoints;
+
+namespace
+{
+
+const GMatrix4D s_matrix{ 0.5, -1.0, 2.0, 7.0,
+                          1.5, 0.25, -3.0, 8.0,
+                          -2.0, 1.0, 0.75, 9.0,
+                          4.0, -5.0, 6.0, 1.0 };
+
+GVector3DArray randomVectors(std::size_t count)
+{
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    GVector3DArray res(count);
+    for (auto & v : res)
+        v.set(dist(gen), dist(gen), dist(gen));
+    return res;
+}
+
+} //namespace
+
+TEST(GExpressionTest, test_single)
+{
+    const GPoint3D pt(1.0, 2.0, 3.0);
+    const GVector3D v1(1.0, 0.5, -2.0);
+    const GVector3D v2(-3.0, 4.0, 0.25);
+
+    GVector3D cross = v1 * v2;
+    GPoint3D expected = pt + (cross *= s_matrix);
+    ASSERT_TRUE(evaluate(lazy(pt) + (lazy(v1) * v2) * s_matrix).equals(expected));
+    ASSERT_TRUE(evaluate(lazy(pt) + s_matrix * (lazy(v1) * v2)).equals(expected));
+
+    GPoint3D moved = pt;
+    moved *= s_matrix;
+    ASSERT_TRUE(evaluate(lazy(pt) * s_matrix).equals(moved));
+    ASSERT_TRUE(evaluate(lazy(pt) - GPoint3D(1.0, 1.0, 1.0)).equals(GVector3D(0.0, 1.0, 2.0)));
+
+    ASSERT_TRUE(equal(evaluate(lazy(v1) % v2), v1 % v2));
+    ASSERT_TRUE(evaluate(lazy(v1) * 2.0).equals(GVector3D(2.0, 1.0, -4.0)));
+    ASSERT_TRUE(evaluate(2 * lazy(v1) / 4.0).equals(GVector3D(0.5, 0.25, -1.0)));
+    ASSERT_TRUE(evaluate(-lazy(v1)).equals(GVector3D(-1.0, -0.5, 2.0)));
+    GVector3D scaled = v1;
+    scaled *= v1 % v2;
+    ASSERT_TRUE(evaluate((lazy(v1) % v2) * lazy(v1)).equals(scaled));
+}
+
+TEST(GExpressionTest, test_constexpr)
+{
+    constexpr GVector3D x(1.0, 0.0, 0.0);
+    constexpr GVector3D y(0.0, 1.0, 0.0);
+    constexpr GPoint3D pt(1.0, 2.0, 3.0);
+    constexpr GPoint3D res = evaluate(lazy(pt) + lazy(x) * y * 2.0);
+    static_assert(res.z() == 5.0, "expression must be evaluated at compile time");
+}
+
+TEST(GExpressionTest, test_array)
+{
+    for (std::size_t count : { 0, 1, 7, 100 })
+    {
+        const GPoint3DArray points = randomPoints(count, 100.0);
+        const GVector3DArray normals = randomVectors(count);
+        const GVector3D offset(0.5, -0.25, 1.0);
+
+        GPoint3DArray res;
+        evaluate(lazy(points) + (lazy(normals) * 0.5 + offset) * s_matrix, res);
+        ASSERT_EQ(res.size(), count);
+        for (std::size_t idx = 0; idx < count; ++idx)
+        {
+            GVector3D v(normals[idx][0] * 0.5, normals[idx][1] * 0.5, normals[idx][2] * 0.5);
+            v += offset;
+            v *= s_matrix;
+            ASSERT_TRUE(res[idx].equals(points[idx] + v));
+        }
+    }
+}
+
+TEST(GExpressionTest, test_arrayInPlace)
+{
+    GPoint3DArray points = randomPoints(20, 100.0);
+    const GPoint3DArray src = points;
+    evaluate(lazy(points) * s_matrix, points.data(), points.size());
+    for (std::size_t idx = 0; idx < points.size(); ++idx)
+        ASSERT_TRUE(points[idx].equals(s_matrix * src[idx]));
+
+    GVector3DArray vectors(5);
+    evaluate(lazy(GVector3D(1.0, 2.0, 3.0)), vectors.data(), vectors.size());
+    for (const auto & v : vectors)
+        ASSERT_TRUE(v.equals(GVector3D(1.0, 2.0, 3.0)));
+}
+
+TEST(GExpressionTest, test_sizeMismatch)
+{
+    const GPoint3DArray points = randomPoints(3, 100.0);
+    const GVector3DArray vectors = randomVectors(4);
+    GPoint3DArray res;
+    ASSERT_THROW(evaluate(lazy(points) + vectors, res), std::invalid_argument);
+    ASSERT_THROW(evaluate(lazy(points) + GVector3D()), std::invalid_argument);
+
+    GPoint3DArray small(2);
+    ASSERT_THROW(evaluate(lazy(points) + GVector3D(), small.data(), small.size()), std::invalid_argument);
+
+    const GPoint3DArray empty;
+    ASSERT_THROW(evaluate(lazy(empty) + vectors, res), std::invalid_argument);
+    ASSERT_THROW(evaluate(lazy(empty) + vectors, small.data(), small.size()), std::invalid_argument);
+    ASSERT_THROW(evaluate(lazy(GPoint3D()) + GVector3D(), res), std::invalid_argument);
+    evaluate(lazy(empty) + GVector3D(), res);
+    ASSERT_TRUE(res.empty());
+}
+
+TEST(GExpressionTest, test_divisionByZero)
+{
+    const GVector3DArray vectors = randomVectors(3);
+    GVector3DArray res;
+    ASSERT_THROW(evaluate(lazy(GVector3D(1.0, 2.0, 3.0)) / 0.0), std::logic_error);
+    ASSERT_THROW(evaluate(lazy(vectors) / 0, res), std::logic_error);
+}
+
+TEST(GExpressionTest, test_float)
+{
+    const GPoint3DfArray points{ GPoint3Df(1.0f, 2.0f, 3.0f), GPoint3Df(4.0f, 5.0f, 6.0f) };
+    GPoint3DfArray res;
+    evaluate(lazy(points) + lazy(GVector3Df(1.0f, 1.0f, 1.0f)) * 2, res);
+    ASSERT_TRUE(res[0].equals(GPoint3Df(3.0f, 4.0f, 5.0f)));
+    ASSERT_TRUE(res[1].equals(GPoint3Df(6.0f, 7.0f, 8.0f)));
+}
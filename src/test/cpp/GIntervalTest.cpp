@@ -16,3 +16,69 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 /////////////////////////////////////////////////////////////////////////
 
+
+#include "gtest/gtest.h"
+#include "GInterval.h"
+
+using namespace sgl;
+
+TEST(GIntervalTest, test_constructor)
+{
+    GInterval def;
+    ASSERT_DOUBLE_EQ(def.from(), 0.0);
+    ASSERT_DOUBLE_EQ(def.to(), 1.0);
+
+    GInterval inverted(5.0, -2.0);
+    ASSERT_DOUBLE_EQ(inverted.from(), -2.0);
+    ASSERT_DOUBLE_EQ(inverted.to(), 5.0);
+
+    GInterval list{ 3.0, 1.0 };
+    ASSERT_DOUBLE_EQ(list.from(), 1.0);
+    ASSERT_DOUBLE_EQ(list.to(), 3.0);
+}
+
+TEST(GIntervalTest, test_intersects)
+{
+    GInterval a(0.0, 2.0);
+    ASSERT_TRUE(a.intersects(GInterval(1.0, 3.0)));
+    ASSERT_TRUE(a.intersects(GInterval(-1.0, 0.5)));
+    ASSERT_TRUE(a.intersects(GInterval(0.5, 1.5)));
+    ASSERT_TRUE(a.intersects(GInterval(-5.0, 5.0)));
+    ASSERT_TRUE(a.intersects(GInterval(2.0, 4.0)));
+    ASSERT_FALSE(a.intersects(GInterval(2.5, 4.0)));
+    ASSERT_FALSE(a.intersects(GInterval(-3.0, -0.5)));
+    ASSERT_TRUE(a.intersects(GInterval(2.1, 4.0), 0.2));
+}
+
+TEST(GIntervalTest, test_contains)
+{
+    GInterval a(-1.0, 1.0);
+    ASSERT_TRUE(a.contains(0.0));
+    ASSERT_TRUE(a.contains(-1.0));
+    ASSERT_TRUE(a.contains(1.0));
+    ASSERT_FALSE(a.contains(1.5));
+    ASSERT_FALSE(a.contains(-1.5));
+    ASSERT_TRUE(a.contains(1.05, 0.1));
+}
+
+TEST(GIntervalTest, test_lessMore)
+{
+    GInterval a(0.0, 1.0);
+    GInterval b(2.0, 3.0);
+    ASSERT_TRUE(a.less(b));
+    ASSERT_FALSE(b.less(a));
+    ASSERT_TRUE(b.more(a));
+    ASSERT_FALSE(a.more(b));
+    ASSERT_FALSE(a.less(GInterval(0.5, 2.0)));
+}
+
+TEST(GIntervalTest, test_add)
+{
+    GInterval a(0.0, 1.0);
+    a += GInterval(-2.0, 0.5);
+    ASSERT_DOUBLE_EQ(a.from(), -2.0);
+    ASSERT_DOUBLE_EQ(a.to(), 1.0);
+    a += GInterval(3.0, 4.0);
+    ASSERT_DOUBLE_EQ(a.from(), -2.0);
+    ASSERT_DOUBLE_EQ(a.to(), 4.0);
+}
@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "GTestUtils.h"
+#include "GIntervalTree.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace sgl;
+using sgl::test::sorted;
+
+namespace
+{
+
+std::vector<GInterval> randomIntervals(std::size_t count, unsigned seed = 42)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> start(-100.0, 100.0);
+    std::exponential_distribution<double> length(0.2);
+    std::vector<GInterval> res;
+    res.reserve(count);
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        const double from = std::round(start(gen));
+        res.emplace_back(from, from + std::round(length(gen)));
+    }
+    return res;
+}
+
+std::vector<std::size_t> bruteForce(const std::vector<GInterval> & intervals, const GInterval & query,
+                                    double tolerance)
+{
+    std::vector<std::size_t> res;
+    for (std::size_t idx = 0; idx < intervals.size(); ++idx)
+    {
+        if (intervals[idx].intersects(query, tolerance))
+            res.push_back(idx);
+    }
+    return res;
+}
+
+} //namespace
+
+TEST(GIntervalTreeTest, test_empty)
+{
+    GIntervalTree tree;
+    ASSERT_TRUE(tree.empty());
+    ASSERT_TRUE(tree.stab(0.0).empty());
+    ASSERT_TRUE(tree.overlap(GInterval(-1.0, 1.0)).empty());
+
+    GIntervalTree single(std::vector<GInterval>{ GInterval(1.0, 2.0) });
+    ASSERT_EQ(single.size(), 1u);
+    ASSERT_EQ(single.stab(1.5), std::vector<std::size_t>{ 0 });
+    ASSERT_TRUE(single.stab(2.5).empty());
+    ASSERT_TRUE(single.interval(0).equals(GInterval(1.0, 2.0)));
+}
+
+TEST(GIntervalTreeTest, test_stab)
+{
+    std::vector<GInterval> intervals = { GInterval(0.0, 10.0), GInterval(2.0, 3.0), GInterval(5.0, 8.0),
+                                         GInterval(3.0, 3.0), GInterval(9.0, 12.0) };
+    GIntervalTree tree(intervals);
+    ASSERT_EQ(sorted(tree.stab(3.0)), (std::vector<std::size_t>{ 0, 1, 3 }));
+    ASSERT_EQ(sorted(tree.stab(9.5)), (std::vector<std::size_t>{ 0, 4 }));
+    ASSERT_EQ(sorted(tree.stab(11.0)), (std::vector<std::size_t>{ 4 }));
+    ASSERT_TRUE(tree.stab(-1.0).empty());
+    ASSERT_EQ(sorted(tree.stab(-0.5, 1.0)), (std::vector<std::size_t>{ 0 }));
+    ASSERT_TRUE(tree.interval(2).equals(GInterval(5.0, 8.0)));
+}
+
+TEST(GIntervalTreeTest, test_overlapRandom)
+{
+    for (std::size_t count : { 2u, 7u, 16u, 17u, 100u, 1000u, 1025u })
+    {
+        const auto intervals = randomIntervals(count);
+        GIntervalTree tree(intervals.data(), intervals.size());
+        ASSERT_EQ(tree.size(), count);
+
+        const auto queries = randomIntervals(50, 7);
+        for (double tolerance : { 0.0, 0.5, 2.0 })
+        {
+            for (const auto & query : queries)
+            {
+                ASSERT_EQ(sorted(tree.overlap(query, tolerance)), bruteForce(intervals, query, tolerance));
+                ASSERT_EQ(sorted(tree.stab(query.from(), tolerance)),
+                          bruteForce(intervals, GInterval(query.from(), query.from()), tolerance));
+            }
+        }
+    }
+}
+
+TEST(GIntervalTreeTest, test_batch)
+{
+    const auto intervals = randomIntervals(300);
+    GIntervalTree tree(intervals);
+    const auto queries = randomIntervals(40, 3);
+
+    const auto overlaps = tree.overlap(queries, 0.25);
+    ASSERT_EQ(overlaps.size(), queries.size());
+    std::vector<double> values;
+    for (std::size_t idx = 0; idx < queries.size(); ++idx)
+    {
+        ASSERT_EQ(sorted(overlaps[idx]), bruteForce(intervals, queries[idx], 0.25));
+        values.push_back(queries[idx].to());
+    }
+
+    const auto stabs = tree.stab(values);
+    ASSERT_EQ(stabs.size(), values.size());
+    for (std::size_t idx = 0; idx < values.size(); ++idx)
+        ASSERT_EQ(sorted(stabs[idx]), sorted(tree.stab(values[idx])));
+
+    std::vector<std::size_t> appended{ 12345 };
+    const std::size_t added = tree.overlap(queries[0], 0.0, appended);
+    ASSERT_EQ(appended.size(), added + 1);
+    ASSERT_EQ(appended[0], 12345u);
+}
@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "GTestUtils.h"
+#include "GKDTree.h"
+#include "GPointCloud.h"
+#include "GVector3D.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace sgl;
+using sgl::test::randomPoints;
+
+namespace
+{
+
+// Indices of all points sorted by distance to pt, ties by index
+std::vector<std::size_t> byDistance(const GPoint3DArray & points, const GPoint3D & pt)
+{
+    std::vector<std::size_t> res(points.size());
+    for (std::size_t idx = 0; idx < res.size(); ++idx)
+        res[idx] = idx;
+    std::sort(res.begin(), res.end(), [&](std::size_t i1, std::size_t i2)
+    {
+        const double d1 = (points[i1] - pt).length();
+        const double d2 = (points[i2] - pt).length();
+        return d1 < d2 || (d1 == d2 && i1 < i2);
+    });
+    return res;
+}
+
+} //namespace
+
+TEST(GKDTreeTest, test_empty)
+{
+    GKDTree tree;
+    ASSERT_TRUE(tree.empty());
+    double distance = 0.0;
+    ASSERT_THROW(tree.nearest(GPoint3D(), distance), std::logic_error);
+    ASSERT_TRUE(tree.knn(GPoint3D(), 3).empty());
+    std::vector<std::size_t> result;
+    ASSERT_EQ(tree.radius(GPoint3D(), 1.0, result), 0u);
+}
+
+TEST(GKDTreeTest, test_nearestKnn)
+{
+    for (std::size_t count : { 1u, 9u, 100u, 20000u })
+    {
+        const auto points = randomPoints(count, 10.0);
+        GKDTree tree(points, 4);
+        ASSERT_EQ(tree.size(), count);
+        ASSERT_TRUE(tree.point(count - 1).equals(points[count - 1]));
+        ASSERT_EQ(tree.coords().size(), 3 * count);
+        ASSERT_EQ(tree.indices().size(), count);
+        for (std::size_t pos = 0; pos < count; ++pos)
+        {
+            const GPoint3D & pt = points[tree.indices()[pos]];
+            for (std::size_t axis = 0; axis < 3; ++axis)
+                ASSERT_EQ(pt[axis], tree.coords()[3 * pos + axis]);
+        }
+
+        for (const auto & query : randomPoints(20, 10.0, 7))
+        {
+            const auto expected = byDistance(points, query);
+            double distance = 0.0;
+            const std::size_t nearest = tree.nearest(query, distance);
+            ASSERT_DOUBLE_EQ(distance, (points[expected[0]] - query).length());
+            ASSERT_DOUBLE_EQ((points[nearest] - query).length(), distance);
+
+            const std::size_t k = 10;
+            std::size_t indices[k];
+            double distances[k];
+            const std::size_t found = tree.knn(query, k, indices, distances);
+            ASSERT_EQ(found, std::min(k, count));
+            for (std::size_t idx = 0; idx < found; ++idx)
+            {
+                ASSERT_DOUBLE_EQ(distances[idx], (points[expected[idx]] - query).length());
+                ASSERT_DOUBLE_EQ(distances[idx], (points[indices[idx]] - query).length());
+            }
+            ASSERT_EQ(tree.knn(query, k).size(), found);
+        }
+    }
+}
+
+TEST(GKDTreeTest, test_radius)
+{
+    const auto points = randomPoints(3000, 10.0);
+    GPointCloud cloud;
+    for (const auto & pt : points)
+        cloud.push_back(pt);
+    GKDTree tree(cloud);
+
+    for (const auto & query : randomPoints(30, 10.0, 3))
+    {
+        std::vector<std::size_t> expected;
+        for (std::size_t idx = 0; idx < points.size(); ++idx)
+        {
+            const GVector3D delta = points[idx] - query;
+            if (delta.x() * delta.x() + delta.y() * delta.y() + delta.z() * delta.z() <= 4.0)
+                expected.push_back(idx);
+        }
+        std::vector<std::size_t> result{ 777 };
+        ASSERT_EQ(tree.radius(query, 2.0, result), expected.size());
+        result.erase(result.begin());
+        std::sort(result.begin(), result.end());
+        ASSERT_EQ(result, expected);
+
+        std::vector<std::size_t> buffer(3);
+        ASSERT_EQ(tree.radius(query, 2.0, buffer.data(), buffer.size()), expected.size());
+    }
+}
+
+TEST(GKDTreeTest, test_batch)
+{
+    const auto points = randomPoints(2000, 10.0);
+    GKDTree tree(points.data(), points.size());
+    const auto queries = randomPoints(500, 10.0, 5);
+
+    for (unsigned threads : { 1u, 4u })
+    {
+        const std::size_t k = 4;
+        std::vector<std::size_t> indices(queries.size() * k);
+        std::vector<double> distances(queries.size() * k);
+        tree.knn(queries.data(), queries.size(), k, indices.data(), distances.data(), threads);
+        for (std::size_t query = 0; query < queries.size(); ++query)
+        {
+            std::size_t expected[k];
+            double expectedDistances[k];
+            tree.knn(queries[query], k, expected, expectedDistances);
+            for (std::size_t idx = 0; idx < k; ++idx)
+                ASSERT_DOUBLE_EQ(distances[query * k + idx], expectedDistances[idx]);
+        }
+
+        std::vector<std::size_t> nearest(queries.size());
+        tree.knn(queries.data(), queries.size(), 1, nearest.data(), nullptr, threads);
+        for (std::size_t query = 0; query < queries.size(); ++query)
+            ASSERT_DOUBLE_EQ((points[nearest[query]] - queries[query]).length(), distances[query * k]);
+
+        const std::size_t capacity = 16;
+        std::vector<std::size_t> ball(queries.size() * capacity);
+        std::vector<std::size_t> counts(queries.size());
+        tree.radius(queries.data(), queries.size(), 1.5, capacity, ball.data(), counts.data(), threads);
+        for (std::size_t query = 0; query < queries.size(); ++query)
+        {
+            std::vector<std::size_t> expected;
+            ASSERT_EQ(counts[query], tree.radius(queries[query], 1.5, expected));
+        }
+    }
+
+    // Missing neighbours are padded
+    GKDTree small(randomPoints(2, 10.0));
+    std::size_t indices[3];
+    double distances[3];
+    small.knn(queries.data(), 1, 3, indices, distances);
+    ASSERT_EQ(indices[2], GKDTree::npos);
+    ASSERT_TRUE(std::isinf(distances[2]));
+}
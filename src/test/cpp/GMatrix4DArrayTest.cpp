@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "GMatrix4DArray.h"
+#include "GMatrix4D.h"
+#include "GSimd.h"
+#include "GUtils.h"
+
+#include <random>
+#include <vector>
+
+using namespace sgl;
+
+namespace
+{
+
+std::vector<GSimdLevel> supportedLevels()
+{
+    std::vector<GSimdLevel> res;
+    for (int level = 0; level <= static_cast<int>(supportedSimdLevel()); ++level)
+        res.push_back(static_cast<GSimdLevel>(level));
+    return res;
+}
+
+class SimdLevelGuard
+{
+public:
+    explicit SimdLevelGuard(GSimdLevel level) : m_level{ simdLevel() } { setSimdLevel(level); }
+    ~SimdLevelGuard() { setSimdLevel(m_level); }
+private:
+    GSimdLevel m_level;
+};
+
+std::vector<GMatrix4D> randomMatrices(std::size_t count, unsigned seed = 42)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-10.0, 10.0);
+    std::vector<GMatrix4D> res(count);
+    for (auto & m : res)
+    {
+        for (std::size_t idx = 0; idx < 16; ++idx)
+            m.data()[idx] = dist(gen);
+    }
+    return res;
+}
+
+void assertNear(const GMatrix4D & m1, const GMatrix4D & m2, double tolerance)
+{
+    for (std::size_t idx = 0; idx < 16; ++idx)
+    {
+        ASSERT_NEAR(m1.data()[idx], m2.data()[idx], tolerance);
+    }
+}
+
+} //namespace
+
+TEST(GMatrix4DArrayTest, test_constructor)
+{
+    GMatrix4DArray empty;
+    ASSERT_TRUE(empty.empty());
+    ASSERT_EQ(empty.blockCount(), 0u);
+
+    GMatrix4DArray arr(11);
+    ASSERT_EQ(arr.size(), 11u);
+    ASSERT_EQ(arr.blockCount(), 2u);
+    for (std::size_t idx = 0; idx < arr.size(); ++idx)
+    {
+        ASSERT_TRUE(arr.matrix(idx).equals(GMatrix4D::identity()));
+    }
+
+    const auto matrices = randomMatrices(13);
+    GMatrix4DArray arr2(matrices);
+    ASSERT_EQ(arr2.size(), matrices.size());
+    const auto copy = arr2.toArray();
+    for (std::size_t idx = 0; idx < matrices.size(); ++idx)
+    {
+        ASSERT_TRUE(copy[idx].equals(matrices[idx]));
+    }
+}
+
+TEST(GMatrix4DArrayTest, test_layout)
+{
+    GMatrix4DArray arr(10);
+    arr(9, 1, 2) = 5.0;
+    ASSERT_EQ(arr.data()[GMatrix4DArray::BlockStride + 6 * GMatrix4DArray::BlockSize + 1], 5.0);
+    ASSERT_EQ(arr.matrix(9)(1, 2), 5.0);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(arr.data()) % G_SIMD_ALIGNMENT, 0u);
+}
+
+TEST(GMatrix4DArrayTest, test_resize)
+{
+    GMatrix4DArray arr(randomMatrices(7));
+    arr.resize(3);
+    arr.resize(8);
+    for (std::size_t idx = 3; idx < arr.size(); ++idx)
+    {
+        ASSERT_TRUE(arr.matrix(idx).equals(GMatrix4D::identity()));
+    }
+
+    const auto m = randomMatrices(1)[0];
+    arr.push_back(m);
+    ASSERT_EQ(arr.size(), 9u);
+    ASSERT_TRUE(arr.matrix(8).equals(m));
+
+    arr.setMatrix(0, m);
+    ASSERT_TRUE(arr.matrix(0).equals(m));
+
+    arr.clear();
+    ASSERT_TRUE(arr.empty());
+}
+
+TEST(GMatrix4DArrayTest, test_multiply)
+{
+    const auto matrices1 = randomMatrices(21, 1);
+    const auto matrices2 = randomMatrices(21, 2);
+    const auto & m = matrices2[0];
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+
+        GMatrix4DArray res;
+        res.product(GMatrix4DArray(matrices1), GMatrix4DArray(matrices2));
+        GMatrix4DArray post(matrices1);
+        post.postMultiplyBy(m);
+        GMatrix4DArray pre(matrices1);
+        pre.preMultiplyBy(m);
+        GMatrix4DArray postArr(matrices1);
+        postArr.postMultiplyBy(GMatrix4DArray(matrices2));
+        GMatrix4DArray preArr(matrices1);
+        preArr.preMultiplyBy(GMatrix4DArray(matrices2));
+
+        for (std::size_t idx = 0; idx < matrices1.size(); ++idx)
+        {
+            assertNear(res.matrix(idx), matrices1[idx] * matrices2[idx], 1e-10);
+            assertNear(post.matrix(idx), matrices1[idx] * m, 1e-10);
+            assertNear(pre.matrix(idx), m * matrices1[idx], 1e-10);
+            assertNear(postArr.matrix(idx), matrices1[idx] * matrices2[idx], 1e-10);
+            assertNear(preArr.matrix(idx), matrices2[idx] * matrices1[idx], 1e-10);
+        }
+    }
+
+    GMatrix4DArray arr(3);
+    ASSERT_THROW(arr.postMultiplyBy(GMatrix4DArray(4)), std::invalid_argument);
+}
+
+TEST(GMatrix4DArrayTest, test_transpose)
+{
+    const auto matrices = randomMatrices(10);
+    const auto res = GMatrix4DArray(matrices).transpose();
+    ASSERT_EQ(res.size(), matrices.size());
+    for (std::size_t idx = 0; idx < matrices.size(); ++idx)
+    {
+        ASSERT_TRUE(res.matrix(idx).equals(matrices[idx].transpose()));
+    }
+}
+
+TEST(GMatrix4DArrayTest, test_determinants)
+{
+    const auto matrices = randomMatrices(19);
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+
+        const auto res = GMatrix4DArray(matrices).determinants();
+        ASSERT_EQ(res.size(), matrices.size());
+        for (std::size_t idx = 0; idx < matrices.size(); ++idx)
+        {
+            ASSERT_NEAR(res[idx], matrices[idx].determinant(), 1e-9);
+        }
+    }
+}
+
+TEST(GMatrix4DArrayTest, test_inverse)
+{
+    const auto matrices = randomMatrices(19);
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+
+        GMatrix4DArray arr(matrices);
+        const auto inv = arr.inverse();
+        arr.invert();
+        for (std::size_t idx = 0; idx < matrices.size(); ++idx)
+        {
+            assertNear(inv.matrix(idx), matrices[idx].inverse(), 1e-10);
+            assertNear(arr.matrix(idx), matrices[idx].inverse(), 1e-10);
+        }
+    }
+}
+
+TEST(GMatrix4DArrayTest, test_tryInvert)
+{
+    auto matrices = randomMatrices(12);
+    matrices[10] = GMatrix4D{ 0, 1, 1, 1,
+                              1, 1, 1, 1,
+                              0, 1, 1, 1,
+                              0, 0, 0, 1 };
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+
+        GMatrix4DArray arr(matrices);
+        ASSERT_THROW(arr.invert(), std::logic_error);
+        ASSERT_TRUE(arr.matrix(10).equals(matrices[10]));
+
+        GMatrix4DArray inv;
+        bool inverted[12];
+        ASSERT_FALSE(arr.tryInvert(inv, inverted));
+        for (std::size_t idx = 0; idx < matrices.size(); ++idx)
+        {
+            ASSERT_EQ(inverted[idx], idx != 10);
+            if (idx != 10)
+            {
+                assertNear(inv.matrix(idx), matrices[idx].inverse(), 1e-10);
+            }
+        }
+        ASSERT_TRUE(inv.matrix(10).equals(GMatrix4D::identity()));
+    }
+}
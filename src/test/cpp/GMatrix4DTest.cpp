@@ -21,9 +21,27 @@
 #include "GVector3D.h"
 #include "GPoint3D.h"
 #include "GUtils.h"
+#include "GSimd.h"
+
+#include <limits>
+#include <random>
 
 using namespace sgl;
 
+namespace
+{
+
+GMatrix4D randomMatrix(std::mt19937 & gen)
+{
+    std::uniform_real_distribution<double> dist(-10.0, 10.0);
+    GMatrix4D res;
+    for (std::size_t idx = 0; idx < 16; ++idx)
+        res.data()[idx] = dist(gen);
+    return res;
+}
+
+} //namespace
+
 TEST(GMatrix4DTest, test_identity)
 {
     const auto & e = GMatrix4D::identity();
@@ -311,3 +329,156 @@ TEST(GMatrix4DTest, test_inverse)
     ASSERT_NEAR(m[3][2], 0.25, GTolerance::zeroTol());
     ASSERT_NEAR(m[3][3], 0.25, GTolerance::zeroTol());
 }
+
+TEST(GMatrix4DTest, test_inverseRandom)
+{
+    for (int level = 0; level <= static_cast<int>(supportedSimdLevel()); ++level)
+    {
+        const auto prevLevel = simdLevel();
+        setSimdLevel(static_cast<GSimdLevel>(level));
+
+        std::mt19937 gen(7);
+        for (std::size_t iter = 0; iter < 100; ++iter)
+        {
+            const auto m = randomMatrix(gen);
+            const auto e = m * m.inverse();
+            for (std::size_t rowIdx = 0; rowIdx < 4; ++rowIdx)
+            {
+                for (std::size_t colIdx = 0; colIdx < 4; ++colIdx)
+                {
+                    ASSERT_NEAR(e(rowIdx, colIdx), ((rowIdx == colIdx) ? 1.0 : 0.0), 1e-9);
+                }
+            }
+        }
+
+        setSimdLevel(prevLevel);
+    }
+}
+
+TEST(GMatrix4DTest, test_determinant)
+{
+    GMatrix4D m{ 2, 0, 0, 1,
+                 0, 3, 0, 2,
+                 0, 0, 4, 3,
+                 1, 0, 0, 5 };
+    ASSERT_NEAR(m.determinant(), 108.0, GTolerance::zeroTol());
+    ASSERT_NEAR(GMatrix4D::identity().determinant(), 1.0, GTolerance::zeroTol());
+    ASSERT_NEAR(m.transpose().determinant(), m.determinant(), GTolerance::zeroTol());
+}
+
+TEST(GMatrix4DTest, test_tryInvert)
+{
+    GMatrix4D det0{ 0, 1, 1, 1,
+                    1, 1, 1, 1,
+                    0, 1, 1, 1,
+                    0, 0, 0, 1 };
+    GMatrix4D inv;
+    double condition = 0.0;
+    ASSERT_FALSE(det0.tryInvert(inv, &condition));
+    ASSERT_TRUE(inv.equals(GMatrix4D::identity()));
+    ASSERT_EQ(condition, std::numeric_limits<double>::infinity());
+
+    GMatrix4D m{ 1, 1, 1, -1,
+                 1, 1, -1, 1,
+                 1, -1, 1, 1,
+                 -1, 1, 1, 1 };
+    ASSERT_TRUE(m.tryInvert(inv, &condition));
+    ASSERT_TRUE(inv.equals(m.inverse()));
+    ASSERT_NEAR(condition, 4.0, GTolerance::zeroTol());
+    ASSERT_TRUE(m.tryInvert(inv));
+}
+
+TEST(GMatrix4DTest, test_conditionNumber)
+{
+    ASSERT_NEAR(GMatrix4D::identity().conditionNumber(), 1.0, GTolerance::zeroTol());
+
+    GMatrix4D det0{ 0, 1, 1, 1,
+                    1, 1, 1, 1,
+                    0, 1, 1, 1,
+                    0, 0, 0, 1 };
+    ASSERT_EQ(det0.conditionNumber(), std::numeric_limits<double>::infinity());
+
+    GMatrix4D nearSingular{ 1, 1, 0, 0,
+                            1, 1 + 1e-10, 0, 0,
+                            0, 0, 1, 0,
+                            0, 0, 0, 1 };
+    ASSERT_FALSE(nearSingular.singular());
+    ASSERT_GT(nearSingular.conditionNumber(), 1e9);
+}
+
+TEST(GMatrix4DTest, test_float)
+{
+    const GMatrix4Df m = GMatrix4Df::rotation(0.5f, GVector3Df(0.0f, 0.0f, 1.0f)) *
+                         GMatrix4Df::translation(GVector3Df(1.0f, 2.0f, 3.0f));
+    const GMatrix4Df inv = m.inverse();
+    ASSERT_TRUE((m * inv).equals(GMatrix4Df::identity(), 1e-6));
+    ASSERT_TRUE(std::abs(m.determinant() - 1.0f) < 1e-6f);
+
+    float condition = 0.0f;
+    GMatrix4Df res;
+    ASSERT_TRUE(m.tryInvert(res, &condition));
+    ASSERT_TRUE(res.equals(inv));
+    ASSERT_GE(condition, 1.0f);
+}
+
+TEST(GMatrix4DTest, test_convert)
+{
+    std::mt19937 gen(7);
+    const GMatrix4D m = randomMatrix(gen);
+    const GMatrix4Df mf(m);
+    for (std::size_t row = 0; row < 4; ++row)
+    {
+        for (std::size_t col = 0; col < 4; ++col)
+            ASSERT_EQ(mf(row, col), static_cast<float>(m(row, col)));
+    }
+    ASSERT_TRUE(GMatrix4D(mf).equals(m, 1e-5));
+}
+
+TEST(GMatrix4DTest, test_constexpr)
+{
+    constexpr GMatrix4D calibration = GMatrix4D::translation(GVector3D(1.0, 2.0, 3.0)) *
+                                      GMatrix4D::scale(2.0, 3.0, 4.0) *
+                                      GMatrix4D::identity();
+    static_assert(calibration(0, 0) == 2.0 && calibration(2, 2) == 4.0, "folded at compile time");
+    static_assert(calibration(1, 3) == 2.0 && calibration(3, 3) == 1.0, "folded at compile time");
+    static_assert(calibration.determinant() == 24.0, "determinant is constexpr");
+    static_assert(GMatrix4D().transpose()(0, 0) == 1.0, "identity by default");
+
+    constexpr GMatrix4D mirror = GMatrix4D::mirror(GPoint3D(0.0, 0.0, 1.0), GVector3D(0.0, 0.0, 2.0));
+    static_assert(mirror(2, 2) == -1.0 && mirror(2, 3) == 2.0, "mirror is constexpr");
+
+    const GMatrix4D runtime = GMatrix4D::translation(GVector3D(1.0, 2.0, 3.0)) * GMatrix4D::scale(2.0, 3.0, 4.0);
+    ASSERT_TRUE(runtime.equals(calibration));
+}
+
+TEST(GMatrix4DTest, test_mirror)
+{
+    const GPoint3D base(1.0, -2.0, 0.5);
+    const GVector3D dir(1.0, 2.0, -2.0);
+    const GMatrix4D m = GMatrix4D::mirror(base, dir);
+    ASSERT_TRUE((m * m).equals(GMatrix4D::identity(), 1e-12));
+    ASSERT_TRUE(m.equals(GMatrix4D::mirror(base, GVector3D(3.0, 6.0, -6.0)), 1e-12));
+    for (std::size_t row = 0; row < 3; ++row)
+        ASSERT_NEAR(m(row, 0) * dir[0] + m(row, 1) * dir[1] + m(row, 2) * dir[2], -dir[row], 1e-12);
+    ASSERT_THROW(GMatrix4D::mirror(base, GVector3D()), std::logic_error);
+}
+
+TEST(GMatrix4DTest, test_projection)
+{
+    const GPoint3D point(1.0, 2.0, 3.0);
+    const GVector3D normal(0.0, 0.0, 2.0);
+    const GMatrix4D ortho = GMatrix4D::projection(point, normal);
+    ASSERT_TRUE((ortho * ortho).equals(ortho, 1e-12));
+    ASSERT_TRUE(ortho.equals(GMatrix4D::projection(point, GVector3D(0.0, 0.0, 1.0)), 1e-12));
+
+    const GMatrix4D oblique = GMatrix4D::projection(point, normal, GVector3D(1.0, 0.0, 1.0));
+    const GMatrix4D square = oblique * oblique;
+    for (std::size_t row = 0; row < 3; ++row)
+    {
+        for (std::size_t col = 0; col < 3; ++col)
+            ASSERT_NEAR(square(row, col), oblique(row, col), 1e-12);
+    }
+    const GMatrix4D expected = GMatrix4D::projection(point, GVector3D(0.0, 0.0, 1.0), GVector3D(2.0, 0.0, 2.0));
+    ASSERT_TRUE(oblique.equals(expected, 1e-12));
+    ASSERT_THROW(GMatrix4D::projection(point, GVector3D()), std::logic_error);
+}
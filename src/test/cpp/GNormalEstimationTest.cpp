@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "GNormalEstimation.h"
+#include "GKDTree.h"
+#include "GPointCloud.h"
+#include "GVector3D.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace sgl;
+
+namespace
+{
+
+// Jittered grid on plane z = 0.5 * x + 1
+GPoint3DArray planePoints(std::size_t side, unsigned seed = 42)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-0.25, 0.25);
+    GPoint3DArray res;
+    for (std::size_t i = 0; i < side; ++i)
+    {
+        for (std::size_t j = 0; j < side; ++j)
+        {
+            const double x = static_cast<double>(i) + dist(gen);
+            const double y = static_cast<double>(j) + dist(gen);
+            res.emplace_back(x, y, 0.5 * x + 1.0);
+        }
+    }
+    return res;
+}
+
+GPoint3DArray spherePoints(std::size_t count, double radius, unsigned seed = 42)
+{
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    GPoint3DArray res(count);
+    for (auto & pt : res)
+    {
+        GVector3D v(dist(gen), dist(gen), dist(gen));
+        v.normalize();
+        pt = GPoint3D(radius * v.x(), radius * v.y(), radius * v.z());
+    }
+    return res;
+}
+
+double radialAlignment(const GPoint3D & pt, const GVector3D & n)
+{
+    GVector3D radial(pt.x(), pt.y(), pt.z());
+    radial.normalize();
+    return radial % n;
+}
+
+} //namespace
+
+TEST(GNormalEstimationTest, test_plane)
+{
+    const GKDTree tree(planePoints(40));
+    GVector3DArray normals;
+    ASSERT_EQ(estimateNormals(tree, 10, normals), tree.size());
+    ASSERT_EQ(normals.size(), tree.size());
+    const double len = std::sqrt(1.25);
+    for (const auto & n : normals)
+    {
+        ASSERT_NEAR(n.length(), 1.0, 1e-12);
+        ASSERT_NEAR(std::fabs(n.x() * -0.5 / len + n.z() / len), 1.0, 1e-9);
+    }
+}
+
+TEST(GNormalEstimationTest, test_sphereViewpoint)
+{
+    const GKDTree tree(spherePoints(5000, 3.0));
+    GVector3DArray normals;
+    ASSERT_EQ(estimateNormalsInRadius(tree, 0.5, 30, normals), tree.size());
+    orientNormals(tree, GPoint3D(0.0, 0.0, 0.0), normals);
+    for (std::size_t idx = 0; idx < tree.size(); ++idx)
+        ASSERT_LT(radialAlignment(tree.point(idx), normals[idx]), -0.99);
+}
+
+TEST(GNormalEstimationTest, test_spherePropagation)
+{
+    const GKDTree tree(spherePoints(5000, 3.0, 7));
+    GVector3DArray normals;
+    ASSERT_EQ(estimateNormals(tree, 12, normals), tree.size());
+    orientNormals(tree, 12, normals);
+    // the highest point is turned upwards, so all normals look outside
+    for (std::size_t idx = 0; idx < tree.size(); ++idx)
+        ASSERT_GT(radialAlignment(tree.point(idx), normals[idx]), 0.99);
+}
+
+TEST(GNormalEstimationTest, test_threadsAndLayouts)
+{
+    const GKDTree tree(spherePoints(20000, 1.0, 3));
+    GVector3DArray single;
+    GVector3DArray multi;
+    ASSERT_EQ(estimateNormals(tree, 8, single, 1), estimateNormals(tree, 8, multi, 4));
+    std::vector<double> x(tree.size());
+    std::vector<double> y(tree.size());
+    std::vector<double> z(tree.size());
+    estimateNormals(tree, 8, x.data(), y.data(), z.data(), 3);
+    for (std::size_t idx = 0; idx < tree.size(); ++idx)
+    {
+        ASSERT_EQ(single[idx].x(), multi[idx].x());
+        ASSERT_EQ(single[idx].y(), multi[idx].y());
+        ASSERT_EQ(single[idx].z(), multi[idx].z());
+        ASSERT_EQ(single[idx].x(), x[idx]);
+        ASSERT_EQ(single[idx].y(), y[idx]);
+        ASSERT_EQ(single[idx].z(), z[idx]);
+    }
+
+    orientNormals(tree, 8, single, 1);
+    orientNormals(tree, 8, x.data(), y.data(), z.data(), 4);
+    for (std::size_t idx = 0; idx < tree.size(); ++idx)
+    {
+        ASSERT_EQ(single[idx].x(), x[idx]);
+        ASSERT_EQ(single[idx].z(), z[idx]);
+    }
+}
+
+TEST(GNormalEstimationTest, test_pointCloud)
+{
+    GPointCloud cloud(planePoints(20));
+    ASSERT_FALSE(cloud.hasNormals());
+    ASSERT_EQ(estimateNormals(cloud, 6), cloud.size());
+    ASSERT_TRUE(cloud.hasNormals());
+    const GKDTree tree(cloud);
+    GVector3DArray normals;
+    estimateNormals(tree, 6, normals);
+    for (std::size_t idx = 0; idx < cloud.size(); ++idx)
+    {
+        ASSERT_EQ(cloud.normal(idx).x(), normals[idx].x());
+        ASSERT_EQ(cloud.normal(idx).z(), normals[idx].z());
+    }
+}
+
+TEST(GNormalEstimationTest, test_degenerate)
+{
+    GVector3DArray normals;
+    ASSERT_THROW(estimateNormals(GKDTree(planePoints(3)), 2, normals), std::invalid_argument);
+    ASSERT_THROW(estimateNormalsInRadius(GKDTree(planePoints(3)), -1.0, 5, normals), std::invalid_argument);
+    ASSERT_EQ(estimateNormals(GKDTree(), 5, normals), 0u);
+    ASSERT_TRUE(normals.empty());
+
+    // coincident, collinear and too few points
+    GPoint3DArray points(10, GPoint3D(1.0, 2.0, 3.0));
+    for (std::size_t idx = 0; idx < 10; ++idx)
+        points.emplace_back(static_cast<double>(idx) + 100.0, 0.0, 0.0);
+    points.emplace_back(1000.0, 1000.0, 1000.0);
+    points.emplace_back(1001.0, 1000.0, 1000.0);
+    const GKDTree tree(points);
+    ASSERT_EQ(estimateNormalsInRadius(tree, 5.0, 10, normals), 0u);
+    for (const auto & n : normals)
+        ASSERT_EQ(n.length(), 0.0);
+
+    // undefined normals are left untouched by orientation
+    orientNormals(tree, 3, normals);
+    orientNormals(tree, GPoint3D(), normals);
+    for (const auto & n : normals)
+        ASSERT_EQ(n.length(), 0.0);
+    GVector3DArray wrong(3);
+    ASSERT_THROW(orientNormals(tree, 3, wrong), std::invalid_argument);
+}
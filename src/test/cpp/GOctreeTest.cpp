@@ -0,0 +1,193 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "GOctree.h"
+#include "GPointCloud.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace sgl;
+
+namespace
+{
+
+GPoint3DArray randomPoints(std::size_t count, unsigned seed = 42)
+{
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> dist(0.0, 5.0);
+    GPoint3DArray res(count);
+    for (auto & pt : res)
+        pt = GPoint3D(dist(gen), dist(gen), dist(gen));
+    return res;
+}
+
+void checkNode(const GOctree & octree, const GPoint3DArray & points, std::size_t idx, std::size_t leafCapacity)
+{
+    const GOctreeNode & node = octree.nodes()[idx];
+    ASSERT_GT(node.count, 0u);
+    const GBox3D cell = octree.cell(idx);
+    double sum[3] = { 0.0, 0.0, 0.0 };
+    GBox3D bounds = GBox3D::fromPoints(&points[octree.indices()[node.begin]], 1);
+    for (std::size_t pos = node.begin; pos < node.begin + node.count; ++pos)
+    {
+        const GPoint3D & pt = points[octree.indices()[pos]];
+        ASSERT_TRUE(cell.contains(pt, 1e-9));
+        bounds += pt;
+        for (std::size_t axis = 0; axis < 3; ++axis)
+            sum[axis] += pt[axis];
+    }
+    ASSERT_TRUE(node.bounds.equals(bounds));
+    ASSERT_TRUE(node.centroid.equals(GPoint3D(sum[0] / node.count, sum[1] / node.count, sum[2] / node.count), 1e-9));
+    ASSERT_EQ(octree.find(node.key), idx);
+
+    if (node.isLeaf())
+    {
+        ASSERT_TRUE(node.count <= leafCapacity || node.depth == GOctree::MAX_DEPTH);
+        return;
+    }
+    std::size_t childPoints = 0;
+    for (std::size_t octant = 0; octant < 8; ++octant)
+    {
+        const std::size_t child = octree.child(idx, octant);
+        if (child == GOctree::npos)
+            continue;
+        ASSERT_EQ(octree.nodes()[child].key, (node.key << 3) | octant);
+        ASSERT_EQ(octree.nodes()[child].depth, node.depth + 1);
+        childPoints += octree.nodes()[child].count;
+    }
+    ASSERT_EQ(childPoints, node.count);
+}
+
+} //namespace
+
+TEST(GOctreeTest, test_build)
+{
+    GOctree empty;
+    ASSERT_TRUE(empty.empty());
+    ASSERT_EQ(empty.locate(GPoint3D()), GOctree::npos);
+
+    const auto points = randomPoints(20000);
+    for (unsigned threads : { 1u, 4u })
+    {
+        GOctree octree(points, 16, GOctree::MAX_DEPTH, threads);
+        ASSERT_EQ(octree.size(), points.size());
+        ASSERT_GT(octree.depth(), 2u);
+        ASSERT_EQ(octree.nodes()[0].count, points.size());
+        for (std::size_t idx = 0; idx < octree.nodes().size(); ++idx)
+            checkNode(octree, points, idx, 16);
+
+        std::vector<std::size_t> indices = octree.indices();
+        std::sort(indices.begin(), indices.end());
+        for (std::size_t idx = 0; idx < indices.size(); ++idx)
+            ASSERT_EQ(indices[idx], idx);
+    }
+
+    // Wide levels are split by several threads, layout must not depend on it
+    const GOctree serial(points, 2, GOctree::MAX_DEPTH, 1);
+    const GOctree parallel(points, 2, GOctree::MAX_DEPTH, 4);
+    ASSERT_EQ(serial.nodes().size(), parallel.nodes().size());
+    for (std::size_t idx = 0; idx < serial.nodes().size(); ++idx)
+    {
+        ASSERT_EQ(serial.nodes()[idx].key, parallel.nodes()[idx].key);
+        ASSERT_EQ(serial.nodes()[idx].firstChild, parallel.nodes()[idx].firstChild);
+        ASSERT_EQ(serial.nodes()[idx].begin, parallel.nodes()[idx].begin);
+    }
+
+    ASSERT_THROW(GOctree(points, 0), std::invalid_argument);
+    ASSERT_THROW(GOctree(points, 4, GOctree::MAX_DEPTH + 1), std::invalid_argument);
+}
+
+TEST(GOctreeTest, test_maxDepth)
+{
+    const auto points = randomPoints(1000);
+    GOctree octree(points, 1, 3);
+    ASSERT_EQ(octree.depth(), 3u);
+    for (const auto & node : octree.nodes())
+        ASSERT_LE(node.depth, 3u);
+
+    // Coincident points stop at maximal depth
+    GOctree same(GPoint3DArray(10, GPoint3D(1.0, 2.0, 3.0)), 2, 5);
+    ASSERT_EQ(same.depth(), 5u);
+    ASSERT_EQ(same.nodes().back().count, 10u);
+    ASSERT_TRUE(same.nodes().back().centroid.equals(GPoint3D(1.0, 2.0, 3.0)));
+}
+
+TEST(GOctreeTest, test_lodAndLocate)
+{
+    const auto points = randomPoints(5000);
+    GPointCloud cloud;
+    for (const auto & pt : points)
+        cloud.push_back(pt);
+    GOctree octree(cloud, 8);
+
+    for (std::size_t depth = 0; depth <= octree.depth() + 1; ++depth)
+    {
+        std::size_t total = 0;
+        for (const std::size_t idx : octree.cut(depth))
+        {
+            ASSERT_LE(octree.nodes()[idx].depth, depth);
+            total += octree.nodes()[idx].count;
+        }
+        ASSERT_EQ(total, points.size());
+    }
+    ASSERT_EQ(octree.cut(0), std::vector<std::size_t>{ 0 });
+
+    for (std::size_t idx = 0; idx < points.size(); idx += 97)
+    {
+        const std::size_t node = octree.locate(points[idx]);
+        ASSERT_NE(node, GOctree::npos);
+        ASSERT_TRUE(octree.nodes()[node].isLeaf());
+        const auto & octreeNode = octree.nodes()[node];
+        const auto first = octree.indices().begin() + octreeNode.begin;
+        ASSERT_NE(std::find(first, first + octreeNode.count, idx), first + octreeNode.count);
+    }
+    ASSERT_EQ(octree.locate(GPoint3D(1e6, 0.0, 0.0)), GOctree::npos);
+    ASSERT_EQ(octree.find(0), GOctree::npos);
+}
+
+TEST(GOctreeTest, test_boxQueries)
+{
+    const auto points = randomPoints(8000);
+    GOctree octree(points, 8);
+    const GBox3D box(GPoint3D(-3.0, -2.0, -4.0), GPoint3D(4.0, 5.0, 1.0));
+
+    std::vector<std::size_t> expected;
+    for (std::size_t idx = 0; idx < points.size(); ++idx)
+    {
+        if (box.contains(points[idx], 0.0))
+            expected.push_back(idx);
+    }
+    auto result = octree.pointsInBox(box);
+    std::sort(result.begin(), result.end());
+    ASSERT_EQ(result, expected);
+
+    // Coarse estimate bounds the exact count from above
+    for (std::size_t depth : { 1u, 3u, 5u })
+    {
+        std::size_t estimate = 0;
+        for (const std::size_t idx : octree.intersectBox(box, depth))
+        {
+            ASSERT_LE(octree.nodes()[idx].depth, depth);
+            estimate += octree.nodes()[idx].count;
+        }
+        ASSERT_GE(estimate, expected.size());
+    }
+}
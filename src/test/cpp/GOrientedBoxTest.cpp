@@ -0,0 +1,264 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "GOrientedBox.h"
+#include "GPointCloud.h"
+#include "GVector3D.h"
+
+#include <cmath>
+#include <random>
+
+using namespace sgl;
+
+namespace
+{
+
+// Right handed orthonormal axes of test boxes
+const GVector3D AXIS_X(1.0 / 3.0, 2.0 / 3.0, 2.0 / 3.0);
+const GVector3D AXIS_Y(2.0 / 3.0, 1.0 / 3.0, -2.0 / 3.0);
+const GVector3D AXIS_Z(-2.0 / 3.0, 2.0 / 3.0, -1.0 / 3.0);
+const GPoint3D CENTER(5.0, -3.0, 2.0);
+
+GPoint3D boxPoint(double x, double y, double z)
+{
+    return GPoint3D(CENTER.x() + x * AXIS_X.x() + y * AXIS_Y.x() + z * AXIS_Z.x(),
+                    CENTER.y() + x * AXIS_X.y() + y * AXIS_Y.y() + z * AXIS_Z.y(),
+                    CENTER.z() + x * AXIS_X.z() + y * AXIS_Y.z() + z * AXIS_Z.z());
+}
+
+// Corners and random inner points of box with half-extents 4, 2, 1
+GPoint3DArray randomBox(std::size_t count, unsigned seed = 42)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    GPoint3DArray res;
+    for (int corner = 0; corner < 8; ++corner)
+        res.push_back(boxPoint(corner & 1 ? 4.0 : -4.0, corner & 2 ? 2.0 : -2.0, corner & 4 ? 1.0 : -1.0));
+    for (std::size_t idx = 0; idx < count; ++idx)
+        res.push_back(boxPoint(4.0 * dist(gen), 2.0 * dist(gen), dist(gen)));
+    return res;
+}
+
+// Symmetric grid of box with half-extents 4, 2, 1 (its covariance is diagonal in box axes)
+GPoint3DArray gridBox()
+{
+    GPoint3DArray res;
+    for (int i = -4; i <= 4; ++i)
+        for (int j = -2; j <= 2; ++j)
+            for (int k = -1; k <= 1; ++k)
+                res.push_back(boxPoint(i, j, k));
+    return res;
+}
+
+void checkFrame(const GOrientedBox & box, const GPoint3DArray & points)
+{
+    const GVector3D x = box.frame.x();
+    const GVector3D y = box.frame.y();
+    const GVector3D z = box.frame.z();
+    ASSERT_NEAR(x.length(), 1.0, 1e-12);
+    ASSERT_NEAR(y.length(), 1.0, 1e-12);
+    ASSERT_NEAR(x % y, 0.0, 1e-12);
+    const GVector3D xy = x * y;
+    ASSERT_NEAR((xy - z).length(), 0.0, 1e-12);
+    ASSERT_GE(box.halfExtents.x(), box.halfExtents.y());
+    ASSERT_GE(box.halfExtents.y(), box.halfExtents.z());
+    for (const auto & pt : points)
+    {
+        const GVector3D v = pt - box.frame.origin();
+        ASSERT_LE(std::fabs(v % x), box.halfExtents.x() + 1e-9);
+        ASSERT_LE(std::fabs(v % y), box.halfExtents.y() + 1e-9);
+        ASSERT_LE(std::fabs(v % z), box.halfExtents.z() + 1e-9);
+    }
+}
+
+void checkTestBox(const GOrientedBox & box, double tolerance)
+{
+    EXPECT_NEAR(box.halfExtents.x(), 4.0, tolerance);
+    EXPECT_NEAR(box.halfExtents.y(), 2.0, tolerance);
+    EXPECT_NEAR(box.halfExtents.z(), 1.0, tolerance);
+    EXPECT_NEAR(std::fabs(box.frame.x() % AXIS_X), 1.0, tolerance);
+    EXPECT_NEAR(std::fabs(box.frame.y() % AXIS_Y), 1.0, tolerance);
+    EXPECT_NEAR(std::fabs(box.frame.z() % AXIS_Z), 1.0, tolerance);
+    EXPECT_NEAR((box.frame.origin() - CENTER).length(), 0.0, tolerance);
+}
+
+double volume(const GOrientedBox & box)
+{
+    return 8.0 * box.halfExtents.x() * box.halfExtents.y() * box.halfExtents.z();
+}
+
+} //namespace
+
+TEST(GOrientedBoxTest, test_pca)
+{
+    const GPoint3DArray points = gridBox();
+    const GOrientedBox box = fitOrientedBox(points);
+    checkFrame(box, points);
+    checkTestBox(box, 1e-9);
+}
+
+TEST(GOrientedBoxTest, test_hull)
+{
+    const GPoint3DArray points = randomBox(2000);
+    const GOrientedBox box = fitOrientedBox(points, GOrientedBoxFit::Hull);
+    checkFrame(box, points);
+    checkTestBox(box, 1e-9);
+
+    // PCA box of random points is only close to the tight one
+    const GOrientedBox pca = fitOrientedBox(points, GOrientedBoxFit::PCA);
+    checkFrame(pca, points);
+    ASSERT_GE(volume(pca), volume(box) - 1e-9);
+}
+
+TEST(GOrientedBoxTest, test_hullSubdividedFaces)
+{
+    // surface grid of box 4 x 3 x 2 under random rotations: hull vertices are stacked along face normals
+    std::mt19937 gen(11);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    for (int subdivisions = 2; subdivisions <= 8; ++subdivisions)
+    {
+        for (int attempt = 0; attempt < 10; ++attempt)
+        {
+            GVector3D x(dist(gen), dist(gen), dist(gen));
+            x.normalize();
+            GVector3D y = x * GVector3D(dist(gen), dist(gen), dist(gen));
+            y.normalize();
+            const GVector3D z = x * y;
+
+            GPoint3DArray points;
+            for (int i = 0; i <= subdivisions; ++i)
+            {
+                for (int j = 0; j <= subdivisions; ++j)
+                {
+                    for (int k = 0; k <= subdivisions; ++k)
+                    {
+                        const bool surface = i == 0 || j == 0 || k == 0 || i == subdivisions ||
+                                             j == subdivisions || k == subdivisions;
+                        if (!surface)
+                            continue;
+                        const double u = 4.0 * i / subdivisions;
+                        const double v = 3.0 * j / subdivisions;
+                        const double w = 2.0 * k / subdivisions;
+                        points.emplace_back(u * x.x() + v * y.x() + w * z.x(), u * x.y() + v * y.y() + w * z.y(),
+                                            u * x.z() + v * y.z() + w * z.z());
+                    }
+                }
+            }
+
+            const GOrientedBox box = fitOrientedBox(points, GOrientedBoxFit::Hull);
+            checkFrame(box, points);
+            ASSERT_NEAR(volume(box), 24.0, 1e-9);
+            ASSERT_NEAR(box.halfExtents.x(), 2.0, 1e-9);
+            ASSERT_NEAR(box.halfExtents.y(), 1.5, 1e-9);
+            ASSERT_NEAR(box.halfExtents.z(), 1.0, 1e-9);
+        }
+    }
+}
+
+TEST(GOrientedBoxTest, test_hullNotLargerThanPca)
+{
+    std::mt19937 gen(7);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    for (int attempt = 0; attempt < 20; ++attempt)
+    {
+        GPoint3DArray points;
+        for (int idx = 0; idx < 200; ++idx)
+        {
+            const double x = 5.0 * dist(gen);
+            points.emplace_back(x, 0.3 * x + dist(gen), 0.2 * dist(gen) * dist(gen));
+        }
+        const GOrientedBox hull = fitOrientedBox(points, GOrientedBoxFit::Hull);
+        const GOrientedBox pca = fitOrientedBox(points, GOrientedBoxFit::PCA);
+        checkFrame(hull, points);
+        checkFrame(pca, points);
+        ASSERT_LE(volume(hull), volume(pca) * (1.0 + 1e-12));
+    }
+}
+
+TEST(GOrientedBoxTest, test_threads)
+{
+    const GPoint3DArray points = randomBox(50000, 3);
+    for (GOrientedBoxFit fit : { GOrientedBoxFit::PCA, GOrientedBoxFit::Hull })
+    {
+        const GOrientedBox single = fitOrientedBox(points, fit, 1);
+        const GOrientedBox multi = fitOrientedBox(points, fit, 4);
+        for (int k = 0; k < 3; ++k)
+        {
+            ASSERT_EQ(single.frame.origin().data()[k], multi.frame.origin().data()[k]);
+            ASSERT_EQ(single.frame.x().data()[k], multi.frame.x().data()[k]);
+            ASSERT_EQ(single.frame.y().data()[k], multi.frame.y().data()[k]);
+            ASSERT_EQ(single.halfExtents.data()[k], multi.halfExtents.data()[k]);
+        }
+    }
+}
+
+TEST(GOrientedBoxTest, test_pointCloud)
+{
+    const GPoint3DArray points = randomBox(500);
+    const GPointCloud cloud(points);
+    for (GOrientedBoxFit fit : { GOrientedBoxFit::PCA, GOrientedBoxFit::Hull })
+    {
+        const GOrientedBox box1 = fitOrientedBox(points, fit);
+        const GOrientedBox box2 = fitOrientedBox(cloud, fit);
+        for (int k = 0; k < 3; ++k)
+        {
+            ASSERT_EQ(box1.frame.origin().data()[k], box2.frame.origin().data()[k]);
+            ASSERT_EQ(box1.frame.z().data()[k], box2.frame.z().data()[k]);
+            ASSERT_EQ(box1.halfExtents.data()[k], box2.halfExtents.data()[k]);
+        }
+    }
+}
+
+TEST(GOrientedBoxTest, test_degenerate)
+{
+    ASSERT_THROW(fitOrientedBox(GPoint3DArray()), std::invalid_argument);
+    ASSERT_THROW(fitOrientedBox(GPointCloud(), GOrientedBoxFit::Hull), std::invalid_argument);
+
+    for (GOrientedBoxFit fit : { GOrientedBoxFit::PCA, GOrientedBoxFit::Hull })
+    {
+        const GOrientedBox point = fitOrientedBox(GPoint3DArray(3, CENTER), fit);
+        ASSERT_EQ(point.halfExtents.length(), 0.0);
+        ASSERT_NEAR((point.frame.origin() - CENTER).length(), 0.0, 1e-12);
+
+        const GPoint3DArray segment = { boxPoint(-4.0, 0.0, 0.0), boxPoint(1.0, 0.0, 0.0), boxPoint(4.0, 0.0, 0.0) };
+        const GOrientedBox line = fitOrientedBox(segment, fit);
+        checkFrame(line, segment);
+        ASSERT_NEAR(line.halfExtents.x(), 4.0, 1e-9);
+        ASSERT_NEAR(line.halfExtents.y(), 0.0, 1e-9);
+    }
+
+    // rectangle 6 x 2 in plane of box axes x, y, rotated by 30 degrees and filled with random points
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    const double c = std::cos(M_PI / 6.0);
+    const double s = std::sin(M_PI / 6.0);
+    GPoint3DArray points;
+    for (int idx = 0; idx < 300; ++idx)
+    {
+        const double u = idx < 4 ? (idx & 1 ? 3.0 : -3.0) : 3.0 * dist(gen);
+        const double v = idx < 4 ? (idx & 2 ? 1.0 : -1.0) : dist(gen);
+        points.push_back(boxPoint(c * u - s * v, s * u + c * v, 0.0));
+    }
+    const GOrientedBox rect = fitOrientedBox(points, GOrientedBoxFit::Hull);
+    checkFrame(rect, points);
+    ASSERT_NEAR(rect.halfExtents.x(), 3.0, 1e-9);
+    ASSERT_NEAR(rect.halfExtents.y(), 1.0, 1e-9);
+    ASSERT_NEAR(rect.halfExtents.z(), 0.0, 1e-9);
+    ASSERT_NEAR(std::fabs(rect.frame.z() % AXIS_Z), 1.0, 1e-9);
+}
@@ -23,6 +23,7 @@
 
 #include <utility>
 #include <stdexcept>
+#include <type_traits>
 
 #include "gtest/gtest.h"
 
@@ -276,3 +277,53 @@ TEST(GPoint3DTest, test_operatorMultiplyMatrix)
     ASSERT_TRUE(equal(r[1], 21.0));
     ASSERT_TRUE(equal(r[2], 19.0));
 }
+
+TEST(GPoint3DTest, test_layout)
+{
+    ASSERT_TRUE(std::is_trivially_copyable<GPoint3D>::value);
+    ASSERT_TRUE(std::is_standard_layout<GPoint3D>::value);
+    ASSERT_EQ(sizeof(GPoint3D), 3 * sizeof(double));
+
+    constexpr GPoint3D p = GPoint3D(1.0, 2.0, 3.0) + GVector3D(1.0, 1.0, 1.0);
+    static_assert(p.x() == 2.0 && p.y() == 3.0 && p.z() == 4.0, "constexpr arithmetic");
+}
+
+TEST(GPoint3DTest, test_coordinates)
+{
+    GPoint3DArray points{ GPoint3D(1.0, 2.0, 3.0), GPoint3D(4.0, 5.0, 6.0) };
+    double * pCoords = coordinates(points);
+    for (std::size_t idx = 0; idx < 6; ++idx)
+        ASSERT_TRUE(equal(pCoords[idx], static_cast<double>(idx + 1)));
+
+    pCoords[4] = 10.0;
+    ASSERT_TRUE(equal(points[1].y(), 10.0));
+
+    GPoint3DArray empty;
+    ASSERT_EQ(coordinates(empty), nullptr);
+}
+
+TEST(GPoint3DTest, test_float)
+{
+    constexpr GPoint3Df pt(1.5f, -2.0f, 3.25f);
+    static_assert(pt.y() == -2.0f, "constexpr access");
+
+    GPoint3Df moved = pt + GVector3Df(0.5f, 1.0f, -0.25f);
+    ASSERT_TRUE(moved.equals(GPoint3Df(2.0f, -1.0f, 3.0f)));
+    ASSERT_TRUE((moved - pt).equals(GVector3Df(0.5f, 1.0f, -0.25f)));
+
+    moved *= GMatrix4Df::scale(2.0f);
+    ASSERT_TRUE(moved.equals(GPoint3Df(4.0f, -2.0f, 6.0f)));
+}
+
+TEST(GPoint3DTest, test_convert)
+{
+    const GPoint3D pt(1.0 / 3.0, 1e20, -0.1);
+    const GPoint3Df ptf(pt);
+    ASSERT_EQ(ptf.x(), 1.0f / 3.0f);
+    ASSERT_EQ(ptf.y(), 1e20f);
+    ASSERT_EQ(ptf.z(), -0.1f);
+
+    const GPoint3D back(ptf);
+    ASSERT_EQ(back.x(), static_cast<double>(1.0f / 3.0f));
+    ASSERT_TRUE(back.equals(pt, 1e-6 * 1e20));
+}
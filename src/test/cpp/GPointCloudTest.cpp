@@ -0,0 +1,200 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPointCloud.h"
+#include "GPoint3D.h"
+#include "GVector3D.h"
+#include "GUtils.h"
+
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+using namespace sgl;
+
+namespace
+{
+
+bool aligned(const double * p)
+{
+    return reinterpret_cast<std::uintptr_t>(p) % G_SIMD_ALIGNMENT == 0;
+}
+
+GPoint3DArray samplePoints()
+{
+    return { GPoint3D(1.0, 2.0, 3.0), GPoint3D(4.0, 5.0, 6.0), GPoint3D(7.0, 8.0, 9.0) };
+}
+
+} //namespace
+
+TEST(GPointCloudTest, test_constructor)
+{
+    GPointCloud cloud;
+    ASSERT_TRUE(cloud.empty());
+    ASSERT_EQ(cloud.size(), 0u);
+    ASSERT_FALSE(cloud.hasNormals());
+    ASSERT_FALSE(cloud.hasIntensity());
+
+    GPointCloud zeros(5);
+    ASSERT_EQ(zeros.size(), 5u);
+    for (std::size_t idx = 0; idx < zeros.size(); ++idx)
+        ASSERT_TRUE(zeros.point(idx).equals(GPoint3D::origin()));
+}
+
+TEST(GPointCloudTest, test_constructorArray)
+{
+    const auto points = samplePoints();
+    GPointCloud cloud(points);
+    ASSERT_EQ(cloud.size(), points.size());
+    ASSERT_TRUE(aligned(cloud.xData()));
+    ASSERT_TRUE(aligned(cloud.yData()));
+    ASSERT_TRUE(aligned(cloud.zData()));
+    for (std::size_t idx = 0; idx < points.size(); ++idx)
+    {
+        ASSERT_TRUE(equal(cloud.xData()[idx], points[idx].x()));
+        ASSERT_TRUE(equal(cloud.yData()[idx], points[idx].y()));
+        ASSERT_TRUE(equal(cloud.zData()[idx], points[idx].z()));
+    }
+}
+
+TEST(GPointCloudTest, test_constructorMoveArrays)
+{
+    GAlignedDoubleArray x{ 1.0, 2.0 }, y{ 3.0, 4.0 }, z{ 5.0, 6.0 };
+    const double * pX = x.data();
+    GPointCloud cloud(std::move(x), std::move(y), std::move(z));
+    ASSERT_EQ(cloud.size(), 2u);
+    ASSERT_EQ(cloud.xData(), pX);
+    ASSERT_TRUE(cloud.point(1).equals(GPoint3D(2.0, 4.0, 6.0)));
+
+    GAlignedDoubleArray a{ 1.0 }, b{ 1.0, 2.0 }, c{ 1.0 };
+    ASSERT_THROW(GPointCloud(std::move(a), std::move(b), std::move(c)), std::invalid_argument);
+}
+
+TEST(GPointCloudTest, test_toArray)
+{
+    const auto points = samplePoints();
+    GPointCloud cloud(points);
+    const auto res = cloud.toArray();
+    ASSERT_EQ(res.size(), points.size());
+    for (std::size_t idx = 0; idx < points.size(); ++idx)
+        ASSERT_TRUE(res[idx].equals(points[idx]));
+}
+
+TEST(GPointCloudTest, test_pushBackResize)
+{
+    GPointCloud cloud;
+    cloud.enableIntensity();
+    cloud.push_back(GPoint3D(1.0, 1.0, 1.0));
+    cloud.push_back(GPoint3D(2.0, 2.0, 2.0));
+    ASSERT_EQ(cloud.size(), 2u);
+    ASSERT_TRUE(cloud.point(1).equals(GPoint3D(2.0, 2.0, 2.0)));
+    ASSERT_TRUE(equal(cloud.intensity(1), 0.0));
+
+    cloud.resize(4);
+    ASSERT_EQ(cloud.size(), 4u);
+    ASSERT_TRUE(cloud.point(3).equals(GPoint3D::origin()));
+
+    cloud.clear();
+    ASSERT_TRUE(cloud.empty());
+    ASSERT_TRUE(cloud.hasIntensity());
+}
+
+TEST(GPointCloudTest, test_reference)
+{
+    GPointCloud cloud(samplePoints());
+    cloud[1] = GPoint3D(-1.0, -2.0, -3.0);
+    ASSERT_TRUE(cloud.point(1).equals(GPoint3D(-1.0, -2.0, -3.0)));
+
+    cloud[0].setY(10.0);
+    ASSERT_TRUE(equal(cloud[0].y(), 10.0));
+    ASSERT_TRUE(equal(cloud[0][1], 10.0));
+
+    cloud[2] += GVector3D(1.0, 1.0, 1.0);
+    ASSERT_TRUE(cloud[2].equals(GPoint3D(8.0, 9.0, 10.0)));
+
+    cloud[0] = cloud[2];
+    ASSERT_TRUE(cloud.point(0).equals(GPoint3D(8.0, 9.0, 10.0)));
+
+    GPoint3D pt = cloud[1];
+    ASSERT_TRUE(pt.equals(GPoint3D(-1.0, -2.0, -3.0)));
+
+    GVector3D v = cloud[0] - cloud[1];
+    ASSERT_TRUE(v.equals(GVector3D(9.0, 11.0, 13.0)));
+}
+
+TEST(GPointCloudTest, test_iterator)
+{
+    const auto points = samplePoints();
+    GPointCloud cloud(points);
+    ASSERT_EQ(cloud.end() - cloud.begin(), 3);
+    static_assert(std::is_same<std::iterator_traits<GPointCloud::iterator>::iterator_category,
+                               std::input_iterator_tag>::value, "proxy iterator must not claim random access");
+
+    std::size_t idx = 0;
+    for (GPoint3D pt : cloud)
+        ASSERT_TRUE(pt.equals(points[idx++]));
+
+    for (auto pt : cloud)
+        pt += GVector3D(1.0, 0.0, 0.0);
+
+    const GPointCloud & cref = cloud;
+    idx = 0;
+    for (auto it = cref.begin(); it != cref.end(); ++it, ++idx)
+        ASSERT_TRUE(equal((*it).x(), points[idx].x() + 1.0));
+}
+
+TEST(GPointCloudTest, test_normals)
+{
+    GPointCloud cloud(samplePoints());
+    ASSERT_EQ(cloud.normalData(0), nullptr);
+
+    cloud.enableNormals();
+    ASSERT_TRUE(cloud.hasNormals());
+    ASSERT_TRUE(aligned(cloud.normalData(0)));
+    ASSERT_TRUE(cloud.normal(2).equals(GVector3D()));
+
+    cloud.setNormal(1, GVector3D::axisZ());
+    ASSERT_TRUE(cloud.normal(1).equals(GVector3D::axisZ()));
+    ASSERT_TRUE(equal(cloud.normalData(2)[1], 1.0));
+
+    cloud.push_back(GPoint3D(1.0, 1.0, 1.0));
+    ASSERT_TRUE(cloud.normal(3).equals(GVector3D()));
+
+    cloud.disableNormals();
+    ASSERT_FALSE(cloud.hasNormals());
+    ASSERT_EQ(cloud.normalData(0), nullptr);
+    ASSERT_THROW(cloud.normalData(3), std::invalid_argument);
+}
+
+TEST(GPointCloudTest, test_intensity)
+{
+    GPointCloud cloud(samplePoints());
+    ASSERT_EQ(cloud.intensityData(), nullptr);
+
+    cloud.enableIntensity();
+    cloud.setIntensity(2, 0.5);
+    ASSERT_TRUE(equal(cloud.intensity(2), 0.5));
+    ASSERT_TRUE(aligned(cloud.intensityData()));
+
+    cloud.disableIntensity();
+    ASSERT_EQ(cloud.intensityData(), nullptr);
+}
@@ -0,0 +1,236 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GPredicates.h"
+#include "GPoint3D.h"
+
+#include <cstdint>
+#include <random>
+
+#include "gtest/gtest.h"
+
+using namespace sgl;
+
+namespace
+{
+
+// Exact references for integer coordinates
+using Int = __int128;
+
+int signOf(Int value)
+{
+    return value > 0 ? 1 : (value < 0 ? -1 : 0);
+}
+
+int signOf(double value)
+{
+    return value > 0.0 ? 1 : (value < 0.0 ? -1 : 0);
+}
+
+Int det2(Int a, Int b, Int c, Int d)
+{
+    return a * d - b * c;
+}
+
+int orient2dReference(const double * a, const double * b, const double * c)
+{
+    const Int acx = Int(a[0]) - Int(c[0]);
+    const Int acy = Int(a[1]) - Int(c[1]);
+    const Int bcx = Int(b[0]) - Int(c[0]);
+    const Int bcy = Int(b[1]) - Int(c[1]);
+    return signOf(det2(acx, acy, bcx, bcy));
+}
+
+int orient3dReference(const double * a, const double * b, const double * c, const double * d)
+{
+    Int ad[3];
+    Int bd[3];
+    Int cd[3];
+    for (int idx = 0; idx < 3; ++idx)
+    {
+        ad[idx] = Int(a[idx]) - Int(d[idx]);
+        bd[idx] = Int(b[idx]) - Int(d[idx]);
+        cd[idx] = Int(c[idx]) - Int(d[idx]);
+    }
+    return signOf(ad[2] * det2(bd[0], bd[1], cd[0], cd[1]) +
+                  bd[2] * det2(cd[0], cd[1], ad[0], ad[1]) +
+                  cd[2] * det2(ad[0], ad[1], bd[0], bd[1]));
+}
+
+int incircleReference(const double * a, const double * b, const double * c, const double * d)
+{
+    const Int adx = Int(a[0]) - Int(d[0]);
+    const Int ady = Int(a[1]) - Int(d[1]);
+    const Int bdx = Int(b[0]) - Int(d[0]);
+    const Int bdy = Int(b[1]) - Int(d[1]);
+    const Int cdx = Int(c[0]) - Int(d[0]);
+    const Int cdy = Int(c[1]) - Int(d[1]);
+    return signOf((adx * adx + ady * ady) * det2(bdx, bdy, cdx, cdy) +
+                  (bdx * bdx + bdy * bdy) * det2(cdx, cdy, adx, ady) +
+                  (cdx * cdx + cdy * cdy) * det2(adx, ady, bdx, bdy));
+}
+
+int insphereReference(const double * a, const double * b, const double * c, const double * d, const double * e)
+{
+    const double * points[4] = { a, b, c, d };
+    Int m[4][4];
+    for (int row = 0; row < 4; ++row)
+    {
+        Int lift = 0;
+        for (int col = 0; col < 3; ++col)
+        {
+            m[row][col] = Int(points[row][col]) - Int(e[col]);
+            lift += m[row][col] * m[row][col];
+        }
+        m[row][3] = lift;
+    }
+    auto det3 = [&m](int r0, int r1, int r2) {
+        return m[r0][0] * det2(m[r1][1], m[r1][2], m[r2][1], m[r2][2]) -
+               m[r0][1] * det2(m[r1][0], m[r1][2], m[r2][0], m[r2][2]) +
+               m[r0][2] * det2(m[r1][0], m[r1][1], m[r2][0], m[r2][1]);
+    };
+    // Expansion by the last column; sign matches Shewchuk's insphere
+    const Int det = -m[0][3] * det3(1, 2, 3) + m[1][3] * det3(0, 2, 3) -
+                    m[2][3] * det3(0, 1, 3) + m[3][3] * det3(0, 1, 2);
+    return signOf(det);
+}
+
+} //namespace
+
+TEST(GPredicatesTest, test_orient2d)
+{
+    const double a[2] = { 0.0, 0.0 };
+    const double b[2] = { 1.0, 0.0 };
+    const double c[2] = { 0.0, 1.0 };
+    ASSERT_GT(orient2d(a, b, c), 0.0);
+    ASSERT_LT(orient2d(a, c, b), 0.0);
+
+    // Points on the line y = x with coordinates that aren't exactly representable differences
+    const double p[2] = { 0.1, 0.1 };
+    const double q[2] = { 0.7, 0.7 };
+    const double r[2] = { 1e10, 1e10 };
+    ASSERT_EQ(orient2d(p, q, r), 0.0);
+
+    std::mt19937_64 gen(1);
+    std::uniform_int_distribution<std::int64_t> dist(-(std::int64_t(1) << 50), std::int64_t(1) << 50);
+    std::uniform_int_distribution<int> perturbation(-1, 1);
+    for (int iter = 0; iter < 2000; ++iter)
+    {
+        const double base[2] = { double(dist(gen)), double(dist(gen)) };
+        const double dir[2] = { double(dist(gen) >> 28), double(dist(gen) >> 28) };
+        const double p0[2] = { base[0], base[1] };
+        const double p1[2] = { base[0] + 3 * dir[0], base[1] + 3 * dir[1] };
+        const double p2[2] = { base[0] + 7 * dir[0] + perturbation(gen), base[1] + 7 * dir[1] + perturbation(gen) };
+        ASSERT_EQ(signOf(orient2d(p0, p1, p2)), orient2dReference(p0, p1, p2));
+    }
+}
+
+TEST(GPredicatesTest, test_orient3d)
+{
+    const GPoint3D a(0.0, 0.0, 0.0);
+    const GPoint3D b(1.0, 0.0, 0.0);
+    const GPoint3D c(0.0, 1.0, 0.0);
+    ASSERT_GT(orient3d(a, b, c, GPoint3D(0.0, 0.0, -1.0)), 0.0);
+    ASSERT_LT(orient3d(a, b, c, GPoint3D(0.0, 0.0, 1.0)), 0.0);
+    ASSERT_EQ(orient3d(a, b, c, GPoint3D(0.3, 0.7, 0.0)), 0.0);
+
+    std::mt19937_64 gen(2);
+    std::uniform_int_distribution<std::int64_t> dist(-(std::int64_t(1) << 38), std::int64_t(1) << 38);
+    std::uniform_int_distribution<int> perturbation(-1, 1);
+    for (int iter = 0; iter < 2000; ++iter)
+    {
+        double u[3];
+        double v[3];
+        double o[3];
+        for (int idx = 0; idx < 3; ++idx)
+        {
+            o[idx] = double(dist(gen));
+            u[idx] = double(dist(gen) >> 20);
+            v[idx] = double(dist(gen) >> 20);
+        }
+        double p[4][3];
+        const int coefs[4][2] = { { 0, 0 }, { 1, 0 }, { 0, 1 }, { 3, 5 } };
+        for (int pt = 0; pt < 4; ++pt)
+        {
+            for (int idx = 0; idx < 3; ++idx)
+                p[pt][idx] = o[idx] + coefs[pt][0] * u[idx] + coefs[pt][1] * v[idx];
+        }
+        p[3][iter % 3] += perturbation(gen);
+        ASSERT_EQ(signOf(orient3d(p[0], p[1], p[2], p[3])), orient3dReference(p[0], p[1], p[2], p[3]));
+    }
+}
+
+TEST(GPredicatesTest, test_incircle)
+{
+    const double a[2] = { 1.0, 0.0 };
+    const double b[2] = { 0.0, 1.0 };
+    const double c[2] = { -1.0, 0.0 };
+    const double inside[2] = { 0.1, 0.2 };
+    const double outside[2] = { 2.0, 0.0 };
+    const double on[2] = { 0.0, -1.0 };
+    ASSERT_GT(incircle(a, b, c, inside), 0.0);
+    ASSERT_LT(incircle(a, b, c, outside), 0.0);
+    ASSERT_EQ(incircle(a, b, c, on), 0.0);
+
+    // Cocircular points 5k * (cos, sin) with 3-4-5 triangles, perturbed by one unit
+    std::mt19937_64 gen(3);
+    std::uniform_int_distribution<std::int64_t> dist(1, std::int64_t(1) << 24);
+    std::uniform_int_distribution<std::int64_t> offset(-(std::int64_t(1) << 26), std::int64_t(1) << 26);
+    std::uniform_int_distribution<int> perturbation(-1, 1);
+    for (int iter = 0; iter < 2000; ++iter)
+    {
+        const double k = double(dist(gen));
+        const double ox = double(offset(gen));
+        const double oy = double(offset(gen));
+        const double p0[2] = { ox + 3 * k, oy + 4 * k };
+        const double p1[2] = { ox - 4 * k, oy + 3 * k };
+        const double p2[2] = { ox - 5 * k, oy };
+        const double p3[2] = { ox + 4 * k + perturbation(gen), oy - 3 * k + perturbation(gen) };
+        ASSERT_EQ(signOf(incircle(p0, p1, p2, p3)), incircleReference(p0, p1, p2, p3));
+    }
+}
+
+TEST(GPredicatesTest, test_insphere)
+{
+    const GPoint3D a(1.0, 0.0, 0.0);
+    const GPoint3D b(0.0, 1.0, 0.0);
+    const GPoint3D c(-1.0, 0.0, 0.0);
+    const GPoint3D d(0.0, 0.0, 1.0);
+    const GPoint3D & pa = orient3d(a, b, c, d) > 0.0 ? a : b;
+    const GPoint3D & pb = orient3d(a, b, c, d) > 0.0 ? b : a;
+    ASSERT_GT(insphere(pa, pb, c, d, GPoint3D(0.1, 0.1, 0.1)), 0.0);
+    ASSERT_LT(insphere(pa, pb, c, d, GPoint3D(2.0, 0.0, 0.0)), 0.0);
+    ASSERT_EQ(insphere(pa, pb, c, d, GPoint3D(0.0, 0.0, -1.0)), 0.0);
+
+    std::mt19937_64 gen(4);
+    std::uniform_int_distribution<std::int64_t> dist(1, std::int64_t(1) << 16);
+    std::uniform_int_distribution<std::int64_t> offset(-(std::int64_t(1) << 18), std::int64_t(1) << 18);
+    std::uniform_int_distribution<int> perturbation(-1, 1);
+    for (int iter = 0; iter < 2000; ++iter)
+    {
+        const double k = double(dist(gen));
+        const double o[3] = { double(offset(gen)), double(offset(gen)), double(offset(gen)) };
+        // Points on sphere of radius 3k: (2, 2, 1) * k permutations
+        const double p0[3] = { o[0] + 2 * k, o[1] + 2 * k, o[2] + k };
+        const double p1[3] = { o[0] - 2 * k, o[1] + k, o[2] + 2 * k };
+        const double p2[3] = { o[0] + k, o[1] - 2 * k, o[2] + 2 * k };
+        const double p3[3] = { o[0] + 2 * k, o[1] - k, o[2] - 2 * k };
+        const double p4[3] = { o[0] - k + perturbation(gen), o[1] - 2 * k + perturbation(gen), o[2] - 2 * k };
+        ASSERT_EQ(signOf(insphere(p0, p1, p2, p3, p4)), insphereReference(p0, p1, p2, p3, p4));
+    }
+}
@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "GQuaternion.h"
+#include "GMatrix4D.h"
+#include "GPoint3D.h"
+#include "GPointCloud.h"
+#include "GVector3D.h"
+#include "GUtils.h"
+
+#include <cmath>
+
+using namespace sgl;
+
+namespace
+{
+
+const double s_tol = 1e-12;
+
+GVector3D applyRotationBlock(const GMatrix4D & m, const GVector3D & v)
+{
+    return GVector3D(m(0, 0) * v.x() + m(0, 1) * v.y() + m(0, 2) * v.z(),
+                     m(1, 0) * v.x() + m(1, 1) * v.y() + m(1, 2) * v.z(),
+                     m(2, 0) * v.x() + m(2, 1) * v.y() + m(2, 2) * v.z());
+}
+
+} //namespace
+
+TEST(GQuaternionTest, test_layout)
+{
+    static_assert(std::is_trivially_copyable<GQuaternion>::value, "");
+    constexpr GQuaternion q;
+    static_assert(q.w() == 1.0 && q.x() == 0.0, "");
+    ASSERT_EQ(sizeof(GQuaternion), 4 * sizeof(double));
+}
+
+TEST(GQuaternionTest, test_rotation)
+{
+    const auto q = GQuaternion::rotation(M_PI / 2.0, GVector3D(0.0, 0.0, 2.0));
+    ASSERT_TRUE(q.isUnit());
+    ASSERT_NEAR(q.angle(), M_PI / 2.0, s_tol);
+    ASSERT_TRUE(q.axis().equals(GVector3D::axisZ(), s_tol));
+    ASSERT_TRUE(q.rotate(GVector3D::axisX()).equals(GVector3D::axisY(), s_tol));
+    ASSERT_TRUE(q.rotate(GPoint3D(1.0, 0.0, 5.0)).equals(GPoint3D(0.0, 1.0, 5.0), s_tol));
+    ASSERT_THROW(GQuaternion::rotation(1.0, GVector3D()), std::logic_error);
+}
+
+TEST(GQuaternionTest, test_toMatrix)
+{
+    const GVector3D axis = GVector3D(1.0, -2.0, 0.5).normalize();
+    const auto m = GQuaternion::rotation(0.7, axis).toMatrix();
+    ASSERT_TRUE(m.equals(GMatrix4D::rotation(0.7, axis), s_tol));
+
+    const auto q = GQuaternion::fromMatrix(m);
+    ASSERT_TRUE(q.equals(GQuaternion::rotation(0.7, axis), s_tol));
+
+    // branches with non-positive trace
+    for (const auto & a : { GVector3D::axisX(), GVector3D::axisY(), GVector3D::axisZ(), axis })
+    {
+        const auto qPi = GQuaternion::rotation(M_PI, a);
+        const auto res = GQuaternion::fromMatrix(qPi.toMatrix());
+        ASSERT_NEAR(std::abs(res.dot(qPi)), 1.0, s_tol);
+    }
+}
+
+TEST(GQuaternionTest, test_compose)
+{
+    const auto q1 = GQuaternion::rotation(0.3, GVector3D(1.0, 2.0, 3.0));
+    const auto q2 = GQuaternion::rotation(-1.1, GVector3D(0.0, 1.0, -1.0));
+    const GVector3D v(0.5, -4.0, 2.0);
+
+    ASSERT_TRUE((q1 * q2).rotate(v).equals(q1.rotate(q2.rotate(v)), s_tol));
+    ASSERT_TRUE((q1 * q2).toMatrix().equals(q1.toMatrix() * q2.toMatrix(), s_tol));
+
+    auto q = q1;
+    q *= q2;
+    ASSERT_TRUE(q.equals(q1 * q2));
+    ASSERT_TRUE((q1 * q1.conjugate()).equals(GQuaternion::identity(), s_tol));
+    ASSERT_TRUE((q1 * (2.0 * q1).inverse()).equals(0.5 * GQuaternion::identity(), s_tol));
+    ASSERT_THROW(GQuaternion(0.0, 0.0, 0.0, 0.0).inverse(), std::logic_error);
+}
+
+TEST(GQuaternionTest, test_normalize)
+{
+    auto q = GQuaternion::rotation(0.01, GVector3D(1.0, 1.0, 0.0));
+    const auto step = q;
+    for (int idx = 0; idx < 10000; ++idx)
+        q *= step * 1.000001;
+    ASSERT_FALSE(q.isUnit());
+    q.normalize();
+    ASSERT_TRUE(q.isUnit(s_tol));
+    ASSERT_THROW(GQuaternion(0.0, 0.0, 0.0, 0.0).normalize(), std::logic_error);
+}
+
+TEST(GQuaternionTest, test_rotateArray)
+{
+    const auto q = GQuaternion::rotation(2.0, GVector3D(-1.0, 0.5, 3.0));
+    const auto m = q.toMatrix();
+
+    GPoint3DArray points;
+    GVector3DArray vectors;
+    for (int idx = 0; idx < 37; ++idx)
+    {
+        points.emplace_back(idx * 0.5, -idx * 1.0, 3.0 - idx);
+        vectors.emplace_back(1.0 - idx, idx * 0.25, idx * 2.0);
+    }
+    GPointCloud cloud(points);
+    auto pointsCopy = points;
+    q.rotate(pointsCopy);
+    auto vectorsCopy = vectors;
+    q.rotate(vectorsCopy);
+    q.rotate(cloud);
+
+    for (std::size_t idx = 0; idx < points.size(); ++idx)
+    {
+        const GVector3D expected = applyRotationBlock(m, points[idx].asVector());
+        ASSERT_TRUE(pointsCopy[idx].asVector().equals(expected, 1e-10));
+        ASSERT_TRUE(cloud.point(idx).asVector().equals(expected, 1e-10));
+        ASSERT_TRUE(q.rotate(points[idx]).asVector().equals(expected, 1e-10));
+        ASSERT_TRUE(vectorsCopy[idx].equals(applyRotationBlock(m, vectors[idx]), 1e-10));
+    }
+}
+
+TEST(GQuaternionTest, test_slerp)
+{
+    const auto q1 = GQuaternion::rotation(0.2, GVector3D::axisZ());
+    const auto q2 = GQuaternion::rotation(1.0, GVector3D::axisZ());
+    ASSERT_TRUE(slerp(q1, q2, 0.0).equals(q1, s_tol));
+    ASSERT_TRUE(slerp(q1, q2, 1.0).equals(q2, s_tol));
+    ASSERT_TRUE(slerp(q1, q2, 0.5).equals(GQuaternion::rotation(0.6, GVector3D::axisZ()), s_tol));
+    // -q2 is the same rotation
+    ASSERT_TRUE(slerp(q1, -1.0 * q2, 0.5).equals(GQuaternion::rotation(0.6, GVector3D::axisZ()), s_tol));
+    ASSERT_TRUE(slerp(q1, q1, 0.3).equals(q1, s_tol));
+}
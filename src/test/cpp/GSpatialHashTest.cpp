@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "GTestUtils.h"
+#include "GSpatialHash.h"
+#include "GPointCloud.h"
+#include "GVector3D.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace sgl;
+using sgl::test::randomPoints;
+using sgl::test::sorted;
+
+namespace
+{
+
+std::vector<std::size_t> bruteForce(const GPoint3DArray & points, const std::vector<bool> & alive,
+                                    const GPoint3D & pt, double radius)
+{
+    std::vector<std::size_t> res;
+    for (std::size_t idx = 0; idx < points.size(); ++idx)
+    {
+        const GVector3D delta = points[idx] - pt;
+        if (alive[idx] && delta.x() * delta.x() + delta.y() * delta.y() + delta.z() * delta.z() <= radius * radius)
+            res.push_back(idx);
+    }
+    return res;
+}
+
+} //namespace
+
+TEST(GSpatialHashTest, test_insertRemove)
+{
+    GSpatialHash grid(0.5);
+    ASSERT_TRUE(grid.empty());
+    ASSERT_DOUBLE_EQ(grid.cellSize(), 0.5);
+    ASSERT_TRUE(grid.neighbours(GPoint3D()).empty());
+
+    const auto a = grid.insert(GPoint3D(0.0, 0.0, 0.0));
+    const auto b = grid.insert(GPoint3D(0.3, 0.0, 0.0));
+    const auto c = grid.insert(GPoint3D(-0.1, -0.1, 0.0));
+    ASSERT_EQ(grid.size(), 3u);
+    ASSERT_EQ(sorted(grid.neighbours(GPoint3D(0.1, 0.0, 0.0))), (std::vector<std::size_t>{ a, b, c }));
+
+    grid.remove(b);
+    ASSERT_FALSE(grid.contains(b));
+    ASSERT_THROW(grid.remove(b), std::out_of_range);
+    ASSERT_THROW(grid.point(b), std::out_of_range);
+    ASSERT_EQ(sorted(grid.neighbours(GPoint3D(0.1, 0.0, 0.0))), (std::vector<std::size_t>{ a, c }));
+    ASSERT_TRUE(grid.point(c).equals(GPoint3D(-0.1, -0.1, 0.0)));
+
+    double distance = 0.0;
+    ASSERT_EQ(grid.nearest(GPoint3D(-0.2, -0.1, 0.0), 0.5, distance), c);
+    ASSERT_NEAR(distance, 0.1, 1e-15);
+    ASSERT_EQ(grid.nearest(GPoint3D(5.0, 0.0, 0.0), 0.5, distance), GSpatialHash::npos);
+
+    grid.clear();
+    ASSERT_TRUE(grid.empty());
+    ASSERT_EQ(grid.insert(GPoint3D()), 0u);
+
+    ASSERT_THROW(GSpatialHash(0.0), std::invalid_argument);
+}
+
+TEST(GSpatialHashTest, test_random)
+{
+    const auto points = randomPoints(5000, 10.0);
+    GSpatialHash grid(0.75);
+    ASSERT_EQ(grid.insert(points), 0u);
+    std::vector<bool> alive(points.size(), true);
+
+    // Removals exercise backward shift deletion of emptied cells
+    std::mt19937 gen(1);
+    for (std::size_t idx = 0; idx < points.size(); idx += 1 + gen() % 3)
+    {
+        grid.remove(idx);
+        alive[idx] = false;
+    }
+    ASSERT_EQ(grid.size(), static_cast<std::size_t>(std::count(alive.begin(), alive.end(), true)));
+
+    for (const auto & query : randomPoints(200, 11.0, 5))
+    {
+        for (double radius : { 0.1, 0.75, 2.0, 50.0 })
+        {
+            std::vector<std::size_t> result;
+            grid.neighbours(query, radius, result);
+            const auto expected = bruteForce(points, alive, query, radius);
+            ASSERT_EQ(sorted(result), expected);
+
+            double distance = 0.0;
+            const std::size_t nearest = grid.nearest(query, radius, distance);
+            ASSERT_EQ(nearest == GSpatialHash::npos, expected.empty());
+            if (nearest != GSpatialHash::npos)
+            {
+                for (const auto idx : expected)
+                    ASSERT_LE(distance, (points[idx] - query).length() + 1e-12);
+            }
+        }
+    }
+}
+
+TEST(GSpatialHashTest, test_cloud)
+{
+    const auto points = randomPoints(1000, 1e-3);
+    GPointCloud cloud;
+    for (const auto & pt : points)
+        cloud.push_back(pt);
+
+    GSpatialHash grid;
+    ASSERT_DOUBLE_EQ(grid.cellSize(), GTolerance::lengthTol());
+    grid.insert(GPoint3D(1.0, 1.0, 1.0));
+    ASSERT_EQ(grid.insert(cloud), 1u);
+    ASSERT_EQ(grid.size(), 1001u);
+
+    std::vector<bool> alive(points.size(), true);
+    for (std::size_t idx = 0; idx < points.size(); idx += 50)
+    {
+        auto result = grid.neighbours(points[idx]);
+        for (auto & id : result)
+            --id;
+        ASSERT_EQ(sorted(result), bruteForce(points, alive, points[idx], GTolerance::lengthTol()));
+    }
+}
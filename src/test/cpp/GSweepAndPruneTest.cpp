@@ -0,0 +1,231 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "GSweepAndPrune.h"
+#include "GPoint3D.h"
+#include "GVector3D.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace sgl;
+
+namespace
+{
+
+using Pair = GSweepAndPrune::Pair;
+
+GBox3D cube(const GPoint3D & center, double halfSize)
+{
+    const GVector3D half(halfSize, halfSize, halfSize);
+    return GBox3D(center - half, center + half);
+}
+
+std::vector<Pair> bruteForce(const std::vector<GBox3D> & boxes, const std::vector<bool> & alive, double tolerance)
+{
+    // Cheap rejection of boxes far apart on x keeps large cases fast
+    std::vector<double> lo;
+    std::vector<double> hi;
+    for (const auto & box : boxes)
+    {
+        lo.push_back(box[0].from() - 2.0 * tolerance);
+        hi.push_back(box[0].to());
+    }
+    std::vector<Pair> res;
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+        for (std::size_t j = i + 1; j < boxes.size(); ++j)
+        {
+            if (lo[j] > hi[i] || lo[i] > hi[j])
+                continue;
+            if (alive[i] && alive[j] && boxes[i].intersects(boxes[j], tolerance))
+                res.emplace_back(i, j);
+        }
+    }
+    return res;
+}
+
+} //namespace
+
+TEST(GSweepAndPruneTest, test_simple)
+{
+    GSweepAndPrune sap;
+    const auto a = sap.add(cube(GPoint3D(0.0, 0.0, 0.0), 1.0));
+    const auto b = sap.add(cube(GPoint3D(1.5, 0.0, 0.0), 1.0));
+    const auto c = sap.add(cube(GPoint3D(10.0, 0.0, 0.0), 1.0));
+    ASSERT_EQ(sap.size(), 3u);
+
+    sap.update();
+    ASSERT_EQ(sap.addedPairs(), (std::vector<Pair>{ { a, b } }));
+    ASSERT_TRUE(sap.removedPairs().empty());
+
+    sap.setBox(c, cube(GPoint3D(3.0, 0.0, 0.0), 1.0));
+    sap.update();
+    ASSERT_EQ(sap.addedPairs(), (std::vector<Pair>{ { b, c } }));
+    ASSERT_EQ(sap.pairs(), (std::vector<Pair>{ { a, b }, { b, c } }));
+
+    // Touching boxes overlap
+    sap.setBox(a, cube(GPoint3D(-0.5, 0.0, 0.0), 1.0));
+    sap.update();
+    ASSERT_TRUE(sap.addedPairs().empty());
+    ASSERT_TRUE(sap.removedPairs().empty());
+
+    sap.setBox(a, cube(GPoint3D(-5.0, 0.0, 0.0), 1.0));
+    sap.update();
+    ASSERT_EQ(sap.removedPairs(), (std::vector<Pair>{ { a, b } }));
+
+    sap.remove(b);
+    ASSERT_EQ(sap.size(), 2u);
+    ASSERT_THROW(sap.box(b), std::out_of_range);
+    sap.update();
+    ASSERT_EQ(sap.removedPairs(), (std::vector<Pair>{ { b, c } }));
+    ASSERT_TRUE(sap.pairs().empty());
+
+    // Removed id is reused
+    ASSERT_EQ(sap.add(cube(GPoint3D(-4.0, 0.0, 0.0), 0.5)), b);
+    sap.update();
+    ASSERT_EQ(sap.addedPairs(), (std::vector<Pair>{ { a, b } }));
+}
+
+TEST(GSweepAndPruneTest, test_tolerance)
+{
+    GSweepAndPrune sap(0.5);
+    ASSERT_DOUBLE_EQ(sap.tolerance(), 0.5);
+    sap.add(cube(GPoint3D(0.0, 0.0, 0.0), 1.0));
+    sap.add(cube(GPoint3D(2.25, 0.0, 0.0), 1.0));
+    sap.add(cube(GPoint3D(0.0, 3.0, 0.0), 1.0));
+    sap.update();
+    ASSERT_EQ(sap.pairs(), (std::vector<Pair>{ { 0, 1 } }));
+
+    ASSERT_THROW(GSweepAndPrune(-1.0), std::invalid_argument);
+}
+
+TEST(GSweepAndPruneTest, test_randomMotion)
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> position(-20.0, 20.0);
+    std::uniform_real_distribution<double> size(0.5, 3.0);
+    std::uniform_real_distribution<double> step(-0.7, 0.7);
+    std::uniform_int_distribution<int> action(0, 19);
+
+    const double tolerance = 0.1;
+    GSweepAndPrune sap(tolerance);
+    std::vector<GBox3D> boxes;
+    std::vector<GPoint3D> centers;
+    std::vector<double> sizes;
+    std::vector<bool> alive;
+    std::set<Pair> tracked;
+
+    for (int frame = 0; frame < 60; ++frame)
+    {
+        for (int idx = 0; idx < (frame == 0 ? 150 : 3); ++idx)
+        {
+            const GPoint3D center(position(gen), position(gen), position(gen));
+            const double halfSize = size(gen);
+            const auto id = sap.add(cube(center, halfSize));
+            if (id >= boxes.size())
+            {
+                boxes.resize(id + 1);
+                centers.resize(id + 1);
+                sizes.resize(id + 1);
+                alive.resize(id + 1);
+            }
+            centers[id] = center;
+            sizes[id] = halfSize;
+            boxes[id] = cube(center, halfSize);
+            alive[id] = true;
+        }
+
+        for (std::size_t id = 0; id < boxes.size(); ++id)
+        {
+            if (!alive[id])
+                continue;
+            if (action(gen) == 0)
+            {
+                sap.remove(id);
+                alive[id] = false;
+                continue;
+            }
+            centers[id] = centers[id] + GVector3D(step(gen), step(gen), step(gen));
+            boxes[id] = cube(centers[id], sizes[id]);
+            sap.setBox(id, boxes[id]);
+        }
+
+        sap.update();
+        for (const auto & pair : sap.removedPairs())
+            ASSERT_EQ(tracked.erase(pair), 1u);
+        for (const auto & pair : sap.addedPairs())
+            ASSERT_TRUE(tracked.insert(pair).second);
+
+        const auto expected = bruteForce(boxes, alive, tolerance);
+        ASSERT_EQ(sap.pairs(), expected);
+        ASSERT_EQ(std::vector<Pair>(tracked.begin(), tracked.end()), expected);
+        ASSERT_EQ(sap.size(), static_cast<std::size_t>(std::count(alive.begin(), alive.end(), true)));
+    }
+}
+
+TEST(GSweepAndPruneTest, test_bulkAdd)
+{
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> position(-100.0, 100.0);
+    std::uniform_real_distribution<double> size(0.5, 2.5);
+
+    const double tolerance = 0.1;
+    GSweepAndPrune sap(tolerance);
+    std::vector<GBox3D> boxes;
+    auto addBoxes = [&](std::size_t count)
+    {
+        for (std::size_t idx = 0; idx < count; ++idx)
+        {
+            boxes.push_back(cube(GPoint3D(position(gen), position(gen), position(gen)), size(gen)));
+            ASSERT_EQ(sap.add(boxes.back()), boxes.size() - 1);
+        }
+    };
+
+    // Initial build and bulk insertion into existing endpoints
+    addBoxes(12000);
+    sap.update();
+    auto expected = bruteForce(boxes, std::vector<bool>(boxes.size(), true), tolerance);
+    ASSERT_FALSE(expected.empty());
+    ASSERT_EQ(sap.addedPairs(), expected);
+    ASSERT_EQ(sap.pairs(), expected);
+
+    // Boxes jumping far away exceed insertion sort budget, pairs are found again from scratch
+    for (std::size_t id = 0; id < boxes.size(); id += 10)
+    {
+        boxes[id] = cube(GPoint3D(position(gen), position(gen), position(gen)), size(gen));
+        sap.setBox(id, boxes[id]);
+    }
+    sap.update();
+    std::set<Pair> tracked(expected.begin(), expected.end());
+    for (const auto & pair : sap.removedPairs())
+        ASSERT_EQ(tracked.erase(pair), 1u);
+    for (const auto & pair : sap.addedPairs())
+        ASSERT_TRUE(tracked.insert(pair).second);
+    expected = bruteForce(boxes, std::vector<bool>(boxes.size(), true), tolerance);
+    ASSERT_EQ(sap.pairs(), expected);
+    ASSERT_EQ(std::vector<Pair>(tracked.begin(), tracked.end()), expected);
+
+    addBoxes(3000);
+    sap.update();
+    expected = bruteForce(boxes, std::vector<bool>(boxes.size(), true), tolerance);
+    ASSERT_EQ(sap.pairs(), expected);
+}
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GTolerance.h"
+#include "GUtils.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace sgl;
+
+TEST(GToleranceTest, test_defaults)
+{
+    ASSERT_EQ(GTolerance::lengthTol(), 1.0e-6);
+    ASSERT_EQ(GTolerance::angularTol(), 1.0e-10);
+    ASSERT_EQ(GTolerance::zeroTol(), 1.0e-30);
+}
+
+TEST(GToleranceTest, test_setters)
+{
+    GTolerance::setLengthTol(1.0e-4);
+    ASSERT_EQ(GTolerance::lengthTol(), 1.0e-4);
+    {
+        GToleranceScope scope(1.0e-2);
+        GTolerance::setLengthTol(1.0e-3);
+        ASSERT_EQ(GTolerance::lengthTol(), 1.0e-2);
+    }
+    ASSERT_EQ(GTolerance::lengthTol(), 1.0e-3);
+    GTolerance::setLengthTol(1.0e-6);
+}
+
+TEST(GToleranceTest, test_scope)
+{
+    {
+        GToleranceScope outer(1.0e-3, 1.0e-5);
+        ASSERT_EQ(GTolerance::lengthTol(), 1.0e-3);
+        ASSERT_EQ(GTolerance::angularTol(), 1.0e-5);
+        ASSERT_EQ(GTolerance::zeroTol(), 1.0e-30);
+        ASSERT_TRUE(equal(1.0, 1.0005, GTolerance::lengthTol()));
+        {
+            GToleranceScope inner(1.0e-8);
+            ASSERT_EQ(GTolerance::lengthTol(), 1.0e-8);
+            ASSERT_EQ(GTolerance::angularTol(), 1.0e-5);
+        }
+        ASSERT_EQ(GTolerance::lengthTol(), 1.0e-3);
+    }
+    ASSERT_EQ(GTolerance::lengthTol(), 1.0e-6);
+    ASSERT_EQ(GTolerance::angularTol(), 1.0e-10);
+}
+
+TEST(GToleranceTest, test_threads)
+{
+    GToleranceScope scope(0.5);
+    std::vector<double> seen(4, 0.0);
+    std::vector<std::thread> threads;
+    for (std::size_t idx = 0; idx < seen.size(); ++idx)
+    {
+        threads.emplace_back([idx, &seen]() {
+            const double tolerance = 1.0e-3 * static_cast<double>(idx + 1);
+            GToleranceScope threadScope(tolerance);
+            for (int iter = 0; iter < 1000; ++iter)
+            {
+                if (GTolerance::lengthTol() != tolerance)
+                    return;
+            }
+            seen[idx] = GTolerance::lengthTol();
+        });
+    }
+    for (auto & thread : threads)
+        thread.join();
+
+    for (std::size_t idx = 0; idx < seen.size(); ++idx)
+        ASSERT_EQ(seen[idx], 1.0e-3 * static_cast<double>(idx + 1));
+    ASSERT_EQ(GTolerance::lengthTol(), 0.5);
+
+    double unscoped = 0.0;
+    std::thread([&unscoped]() { unscoped = GTolerance::lengthTol(); }).join();
+    ASSERT_EQ(unscoped, 1.0e-6);
+}
@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GTransform.h"
+#include "GMatrix4D.h"
+#include "GPoint3D.h"
+#include "GPointCloud.h"
+#include "GSimd.h"
+#include "GVector3D.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "GTestUtils.h"
+
+using namespace sgl;
+using sgl::test::randomPoints;
+
+namespace
+{
+
+const GMatrix4D s_matrix{ 0.5, -1.0, 2.0, 7.0,
+                          1.5, 0.25, -3.0, 8.0,
+                          -2.0, 1.0, 0.75, 9.0,
+                          4.0, -5.0, 6.0, 1.0 };
+
+std::vector<GSimdLevel> supportedLevels()
+{
+    std::vector<GSimdLevel> res;
+    for (int level = 0; level <= static_cast<int>(supportedSimdLevel()); ++level)
+        res.push_back(static_cast<GSimdLevel>(level));
+    return res;
+}
+
+class SimdLevelGuard
+{
+public:
+    explicit SimdLevelGuard(GSimdLevel level) : m_level{ simdLevel() } { setSimdLevel(level); }
+    ~SimdLevelGuard() { setSimdLevel(m_level); }
+private:
+    GSimdLevel m_level;
+};
+
+} //namespace
+
+TEST(GTransformTest, test_setSimdLevel)
+{
+    SimdLevelGuard guard(GSimdLevel::Scalar);
+    ASSERT_EQ(simdLevel(), GSimdLevel::Scalar);
+    ASSERT_EQ(setSimdLevel(GSimdLevel::AVX512), supportedSimdLevel());
+    ASSERT_EQ(simdLevel(), supportedSimdLevel());
+}
+
+TEST(GTransformTest, test_transformPoints)
+{
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+        for (std::size_t count = 0; count < 40; ++count)
+        {
+            const auto src = randomPoints(count, 100.0);
+            auto points = src;
+            transformPoints(s_matrix, points);
+            for (std::size_t idx = 0; idx < count; ++idx)
+            {
+                GPoint3D expected = src[idx];
+                expected *= s_matrix;
+                ASSERT_TRUE(points[idx].equals(expected, 1.0e-9)) << "level " << static_cast<int>(level);
+            }
+        }
+    }
+}
+
+TEST(GTransformTest, test_transformPointsCopy)
+{
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+        const auto src = randomPoints(29, 100.0);
+        GPoint3DArray dst(src.size());
+        transformPoints(s_matrix, src.data(), dst.data(), src.size());
+        for (std::size_t idx = 0; idx < src.size(); ++idx)
+            ASSERT_TRUE(dst[idx].equals(s_matrix * src[idx], 1.0e-9));
+    }
+}
+
+TEST(GTransformTest, test_transformPointsSoA)
+{
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+        const auto src = randomPoints(37, 100.0);
+        GPointCloud cloud(src);
+        transformPoints(s_matrix, cloud);
+        for (std::size_t idx = 0; idx < src.size(); ++idx)
+            ASSERT_TRUE(cloud[idx].equals(s_matrix * src[idx], 1.0e-9));
+    }
+}
+
+TEST(GTransformTest, test_transformVectors)
+{
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+        for (std::size_t count = 0; count < 20; ++count)
+        {
+            const auto pts = randomPoints(count, 100.0);
+            GVector3DArray src, vectors;
+            for (const auto & pt : pts)
+                src.push_back(pt.asVector());
+            vectors = src;
+            transformVectors(s_matrix, vectors);
+            for (std::size_t idx = 0; idx < count; ++idx)
+                ASSERT_TRUE(vectors[idx].equals(s_matrix * src[idx], 1.0e-9));
+        }
+    }
+}
+
+TEST(GTransformTest, test_transformVectorsSoA)
+{
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+        const auto pts = randomPoints(21, 100.0);
+        std::vector<double> x, y, z;
+        for (const auto & pt : pts)
+        {
+            x.push_back(pt.x());
+            y.push_back(pt.y());
+            z.push_back(pt.z());
+        }
+        transformVectors(s_matrix, x.data(), y.data(), z.data(), pts.size());
+        for (std::size_t idx = 0; idx < pts.size(); ++idx)
+            ASSERT_TRUE(GVector3D(x[idx], y[idx], z[idx]).equals(s_matrix * pts[idx].asVector(), 1.0e-9));
+    }
+}
@@ -22,6 +22,7 @@
 #include "GUtils.h"
 
 #include <cmath>
+#include <type_traits>
 #include <utility>
 
 #include "gtest/gtest.h"
@@ -363,3 +364,48 @@ TEST(GVector3DTest, test_operatorMultiplyByMatrixCopy)
     ASSERT_NEAR(res[1], 26.0, GTolerance::lengthTol());
     ASSERT_NEAR(res[2], 2.0, GTolerance::lengthTol());
 }
+
+TEST(GVector3DTest, test_layout)
+{
+    ASSERT_TRUE(std::is_trivially_copyable<GVector3D>::value);
+    ASSERT_TRUE(std::is_standard_layout<GVector3D>::value);
+    ASSERT_EQ(sizeof(GVector3D), 3 * sizeof(double));
+
+    constexpr GVector3D v = GVector3D(1.0, 0.0, 0.0) * GVector3D(0.0, 1.0, 0.0);
+    static_assert(v.x() == 0.0 && v.y() == 0.0 && v.z() == 1.0, "constexpr cross product");
+    static_assert(GVector3D(1.0, 2.0, 3.0) % GVector3D(1.0, 2.0, 3.0) == 14.0, "constexpr scalar product");
+}
+
+TEST(GVector3DTest, test_squaredLength)
+{
+    GVector3D v { 4.0, 6.0, 2.0 };
+    ASSERT_NEAR(v.squaredLength(), 56.0, GTolerance::lengthTol());
+}
+
+TEST(GVector3DTest, test_coordinates)
+{
+    GVector3DArray vectors{ GVector3D(1.0, 2.0, 3.0), GVector3D(4.0, 5.0, 6.0) };
+    const double * pCoords = coordinates(vectors);
+    for (std::size_t idx = 0; idx < 6; ++idx)
+        ASSERT_NEAR(pCoords[idx], static_cast<double>(idx + 1), GTolerance::lengthTol());
+}
+
+TEST(GVector3DTest, test_float)
+{
+    const GVector3Df x(1.0f, 0.0f, 0.0f);
+    const GVector3Df y(0.0f, 1.0f, 0.0f);
+    ASSERT_TRUE((x * y).equals(GVector3Df(0.0f, 0.0f, 1.0f)));
+    ASSERT_TRUE(equal(x % y, 0.0));
+    ASSERT_TRUE(x.perpendicular(y));
+    ASSERT_TRUE(GVector3Df(3.0f, 4.0f, 0.0f).normalize().equals(GVector3Df(0.6f, 0.8f, 0.0f)));
+}
+
+TEST(GVector3DTest, test_convert)
+{
+    const GVector3D v(0.1, 0.2, 0.3);
+    const GVector3Df vf(v);
+    ASSERT_EQ(vf.x(), 0.1f);
+    ASSERT_EQ(vf.y(), 0.2f);
+    ASSERT_EQ(vf.z(), 0.3f);
+    ASSERT_TRUE(GVector3D(vf).equals(v, 1e-7));
+}
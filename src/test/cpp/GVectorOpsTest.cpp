@@ -0,0 +1,346 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "GVectorOps.h"
+#include "GSimd.h"
+#include "GUtils.h"
+#include "GVector3D.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace sgl;
+
+namespace
+{
+
+GVector3D scaled(GVector3D v, double scale)
+{
+    v *= scale;
+    return v;
+}
+
+std::vector<GSimdLevel> supportedLevels()
+{
+    std::vector<GSimdLevel> res;
+    for (int level = 0; level <= static_cast<int>(supportedSimdLevel()); ++level)
+        res.push_back(static_cast<GSimdLevel>(level));
+    return res;
+}
+
+// Every fifth vector is zero or shorter than zero tolerance
+GVector3DArray randomVectors(std::size_t count, unsigned seed = 42)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-100.0, 100.0);
+    GVector3DArray res(count);
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        const double scale = idx % 5 == 3 ? (idx % 10 == 3 ? 0.0 : 1.0e-14) : 1.0;
+        res[idx] = GVector3D(dist(gen) * scale, dist(gen) * scale, dist(gen) * scale);
+    }
+    return res;
+}
+
+struct SoA
+{
+    explicit SoA(const GVector3DArray & vectors)
+    {
+        for (const auto & v : vectors)
+        {
+            x.push_back(v.x());
+            y.push_back(v.y());
+            z.push_back(v.z());
+        }
+    }
+
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+};
+
+class SimdLevelGuard
+{
+public:
+    explicit SimdLevelGuard(GSimdLevel level) : m_level{ simdLevel() } { setSimdLevel(level); }
+    ~SimdLevelGuard() { setSimdLevel(m_level); }
+private:
+    GSimdLevel m_level;
+};
+
+} //namespace
+
+TEST(GVectorOpsTest, test_lengths)
+{
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+        for (std::size_t count = 0; count < 40; ++count)
+        {
+            const GVector3DArray vectors = randomVectors(count);
+            const SoA soa(vectors);
+            std::vector<double> len(count + 1, -1.0);
+            std::vector<double> len2(count + 1, -1.0);
+            std::vector<double> soaLen(count + 1, -1.0);
+            std::vector<double> soaLen2(count + 1, -1.0);
+            lengths(vectors.data(), count, len.data());
+            squaredLengths(vectors.data(), count, len2.data());
+            lengths(soa.x.data(), soa.y.data(), soa.z.data(), count, soaLen.data());
+            squaredLengths(soa.x.data(), soa.y.data(), soa.z.data(), count, soaLen2.data());
+            for (std::size_t idx = 0; idx < count; ++idx)
+            {
+                ASSERT_NEAR(vectors[idx].length(), len[idx], 1.0e-9);
+                ASSERT_NEAR(vectors[idx].squaredLength(), len2[idx], 1.0e-9);
+                ASSERT_NEAR(vectors[idx].length(), soaLen[idx], 1.0e-9);
+                ASSERT_NEAR(vectors[idx].squaredLength(), soaLen2[idx], 1.0e-9);
+            }
+            ASSERT_EQ(-1.0, len[count]);
+            ASSERT_EQ(-1.0, soaLen2[count]);
+        }
+    }
+}
+
+TEST(GVectorOpsTest, test_normalizeVectors)
+{
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+        for (std::size_t count = 0; count < 40; ++count)
+        {
+            const GVector3DArray source = randomVectors(count);
+            GVector3DArray vectors = source;
+            SoA soa(source);
+            std::vector<std::uint8_t> normalized(count + 1, 7);
+            std::vector<std::uint8_t> soaNormalized(count + 1, 7);
+            const std::size_t res = normalizeVectors(vectors, normalized.data());
+            const std::size_t soaRes = normalizeVectors(soa.x.data(), soa.y.data(), soa.z.data(), count,
+                                                        soaNormalized.data());
+
+            std::size_t expected = 0;
+            for (std::size_t idx = 0; idx < count; ++idx)
+            {
+                GVector3D v = source[idx];
+                const bool zero = equal(v.length(), 0.0, GTolerance::zeroTol());
+                if (zero)
+                {
+                    EXPECT_THROW(v.normalize(), std::logic_error);
+                }
+                else
+                {
+                    v.normalize();
+                    ++expected;
+                }
+                ASSERT_EQ(zero ? 0 : 1, normalized[idx]);
+                ASSERT_EQ(zero ? 0 : 1, soaNormalized[idx]);
+                ASSERT_NEAR(v.x(), vectors[idx].x(), 1.0e-12);
+                ASSERT_NEAR(v.y(), vectors[idx].y(), 1.0e-12);
+                ASSERT_NEAR(v.z(), vectors[idx].z(), 1.0e-12);
+                ASSERT_NEAR(v.x(), soa.x[idx], 1.0e-12);
+                ASSERT_NEAR(v.y(), soa.y[idx], 1.0e-12);
+                ASSERT_NEAR(v.z(), soa.z[idx], 1.0e-12);
+            }
+            ASSERT_EQ(expected, res);
+            ASSERT_EQ(expected, soaRes);
+            ASSERT_EQ(7, normalized[count]);
+        }
+    }
+}
+
+TEST(GVectorOpsTest, test_dotProducts)
+{
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+        for (std::size_t count = 0; count < 40; ++count)
+        {
+            const GVector3DArray vectors1 = randomVectors(count, 1);
+            const GVector3DArray vectors2 = randomVectors(count, 2);
+            const SoA soa1(vectors1);
+            const SoA soa2(vectors2);
+            std::vector<double> dots(count);
+            std::vector<double> soaDots(count);
+            dotProducts(vectors1.data(), vectors2.data(), count, dots.data());
+            dotProducts(soa1.x.data(), soa1.y.data(), soa1.z.data(), soa2.x.data(), soa2.y.data(), soa2.z.data(),
+                        count, soaDots.data());
+            for (std::size_t idx = 0; idx < count; ++idx)
+            {
+                ASSERT_NEAR(vectors1[idx] % vectors2[idx], dots[idx], 1.0e-9);
+                ASSERT_NEAR(vectors1[idx] % vectors2[idx], soaDots[idx], 1.0e-9);
+            }
+        }
+    }
+}
+
+TEST(GVectorOpsTest, test_crossProducts)
+{
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+        for (std::size_t count = 0; count < 40; ++count)
+        {
+            const GVector3DArray vectors1 = randomVectors(count, 1);
+            const GVector3DArray vectors2 = randomVectors(count, 2);
+            const SoA soa1(vectors1);
+            SoA soa2(vectors2);
+            GVector3DArray crosses(count);
+            crossProducts(vectors1.data(), vectors2.data(), crosses.data(), count);
+
+            // Result replaces the second operand
+            crossProducts(soa1.x.data(), soa1.y.data(), soa1.z.data(), soa2.x.data(), soa2.y.data(), soa2.z.data(),
+                          soa2.x.data(), soa2.y.data(), soa2.z.data(), count);
+            for (std::size_t idx = 0; idx < count; ++idx)
+            {
+                const GVector3D expected = vectors1[idx] * vectors2[idx];
+                ASSERT_NEAR(expected.x(), crosses[idx].x(), 1.0e-9);
+                ASSERT_NEAR(expected.y(), crosses[idx].y(), 1.0e-9);
+                ASSERT_NEAR(expected.z(), crosses[idx].z(), 1.0e-9);
+                ASSERT_NEAR(expected.x(), soa2.x[idx], 1.0e-9);
+                ASSERT_NEAR(expected.y(), soa2.y[idx], 1.0e-9);
+                ASSERT_NEAR(expected.z(), soa2.z[idx], 1.0e-9);
+            }
+
+            // In place for array of vectors
+            GVector3DArray inPlace = vectors1;
+            crossProducts(inPlace.data(), vectors2.data(), inPlace.data(), count);
+            for (std::size_t idx = 0; idx < count; ++idx)
+            {
+                ASSERT_EQ(crosses[idx].x(), inPlace[idx].x());
+                ASSERT_EQ(crosses[idx].y(), inPlace[idx].y());
+                ASSERT_EQ(crosses[idx].z(), inPlace[idx].z());
+            }
+        }
+    }
+}
+
+TEST(GVectorOpsTest, test_classifyDirections)
+{
+    // Random pairs and pairs close to the thresholds of each relation
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-10.0, 10.0);
+    const GVector3DArray base = randomVectors(200, 3);
+    GVector3DArray vectors1;
+    GVector3DArray vectors2;
+    for (std::size_t idx = 0; idx < base.size(); ++idx)
+    {
+        const GVector3D v = base[idx];
+        const GVector3D other(dist(gen), dist(gen), dist(gen));
+        const GVector3D normal = v * other;
+        const double scale = 1.0 + idx % 7;
+        for (const double eps : { 0.0, 1.0e-12, 1.0e-9, 1.0e-6 })
+        {
+            vectors1.push_back(v);
+            vectors2.push_back(scaled(v, scale) + scaled(other, eps));
+            vectors1.push_back(v);
+            vectors2.push_back(scaled(v, -scale) + scaled(other, eps));
+            vectors1.push_back(v);
+            vectors2.push_back(normal + scaled(v, eps));
+        }
+        vectors1.push_back(v);
+        vectors2.push_back(other);
+    }
+    const SoA soa1(vectors1);
+    const SoA soa2(vectors2);
+    const std::size_t count = vectors1.size();
+
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+        for (const unsigned threadCount : { 1u, 4u })
+        {
+            std::vector<GDirectionRelation> relations(count);
+            std::vector<GDirectionRelation> soaRelations(count);
+            classifyDirections(vectors1.data(), vectors2.data(), count, relations.data(), GTolerance::angularTol(),
+                               threadCount);
+            classifyDirections(soa1.x.data(), soa1.y.data(), soa1.z.data(), soa2.x.data(), soa2.y.data(),
+                               soa2.z.data(), count, soaRelations.data(), GTolerance::angularTol(), threadCount);
+            for (std::size_t idx = 0; idx < count; ++idx)
+            {
+                const GVector3D & v1 = vectors1[idx];
+                const GVector3D & v2 = vectors2[idx];
+                GDirectionRelation expected = GDirectionRelation::None;
+                if (v1.parallel(v2))
+                    expected = GDirectionRelation::Parallel;
+                else if (v1.antiparallel(v2))
+                    expected = GDirectionRelation::Antiparallel;
+                else if (v1.perpendicular(v2))
+                    expected = GDirectionRelation::Perpendicular;
+                ASSERT_EQ(expected, relations[idx]) << "pair " << idx << " level " << static_cast<int>(level);
+                ASSERT_EQ(expected, soaRelations[idx]) << "pair " << idx << " level " << static_cast<int>(level);
+            }
+        }
+    }
+}
+
+TEST(GVectorOpsTest, test_classifyDirectionsSpecial)
+{
+    const GVector3DArray vectors1 = { GVector3D(0.0, 0.0, 0.0), GVector3D(1.0, 0.0, 0.0), GVector3D(1.0, 0.0, 0.0) };
+    const GVector3DArray vectors2 = { GVector3D(1.0, 0.0, 0.0), GVector3D(0.0, 0.0, 0.0), GVector3D(1.0, 0.1, 0.0) };
+    std::vector<GDirectionRelation> relations(3);
+    classifyDirections(vectors1.data(), vectors2.data(), 3, relations.data());
+    EXPECT_EQ(GDirectionRelation::None, relations[0]);
+    EXPECT_EQ(GDirectionRelation::None, relations[1]);
+    EXPECT_EQ(GDirectionRelation::None, relations[2]);
+
+    // Tolerance is applied to cosine
+    classifyDirections(vectors1.data(), vectors2.data(), 3, relations.data(), 0.01);
+    EXPECT_EQ(GDirectionRelation::Parallel, relations[2]);
+
+    EXPECT_THROW(classifyDirections(vectors1.data(), vectors2.data(), 3, relations.data(), 0.0), std::invalid_argument);
+    EXPECT_THROW(classifyDirections(vectors1.data(), vectors2.data(), 0, relations.data(), 0.5), std::invalid_argument);
+}
+
+TEST(GVectorOpsTest, test_classifyDirectionsRange)
+{
+    // Products of very long or very short vectors overflow or underflow without scaling
+    const GVector3D v(1.0, 2.0, -3.0);
+    const GVector3D normal(3.0, 0.0, 1.0);
+    const GVector3D other(1.0, 1.0, 0.0);
+    const std::vector<std::pair<GVector3D, GDirectionRelation>> cases = {
+        { v, GDirectionRelation::Parallel }, { scaled(v, -2.0), GDirectionRelation::Antiparallel },
+        { normal, GDirectionRelation::Perpendicular }, { other, GDirectionRelation::None } };
+    GVector3DArray vectors1;
+    GVector3DArray vectors2;
+    std::vector<GDirectionRelation> expected;
+    for (const double scale1 : { 1.0, 1e-160, 1e-80, 1e80, 1e160, 1e300 })
+    {
+        for (const double scale2 : { 1.0, 1e-300, 1e-80, 1e80, 1e160 })
+        {
+            for (const auto & item : cases)
+            {
+                vectors1.push_back(scaled(v, scale1));
+                vectors2.push_back(scaled(item.first, scale2));
+                expected.push_back(item.second);
+            }
+        }
+    }
+    vectors1.emplace_back(1e-320, 0.0, 0.0);
+    vectors2.emplace_back(1e300, 0.0, 0.0);
+    expected.push_back(GDirectionRelation::Parallel);
+
+    for (auto level : supportedLevels())
+    {
+        SimdLevelGuard guard(level);
+        std::vector<GDirectionRelation> relations(vectors1.size());
+        classifyDirections(vectors1.data(), vectors2.data(), vectors1.size(), relations.data());
+        for (std::size_t idx = 0; idx < relations.size(); ++idx)
+            ASSERT_EQ(expected[idx], relations[idx]) << "pair " << idx << " level " << static_cast<int>(level);
+    }
+}
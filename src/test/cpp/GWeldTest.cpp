@@ -0,0 +1,195 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "GWeld.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace sgl;
+
+namespace
+{
+
+// Points are grouped around few centers, so that many of them are coincident
+GPoint3DArray clusteredPoints(std::size_t count, double tolerance, unsigned seed = 42)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> center(-20, 20);
+    std::uniform_real_distribution<double> noise(-tolerance, tolerance);
+    GPoint3DArray res(count);
+    for (auto & pt : res)
+    {
+        pt = GPoint3D(center(gen) * 10.0 * tolerance + noise(gen), center(gen) * 10.0 * tolerance + noise(gen),
+                      center(gen) * 10.0 * tolerance + noise(gen));
+    }
+    return res;
+}
+
+// Connected components of "equals" graph by quadratic comparison
+std::vector<std::size_t> bruteForceComponents(const GPoint3DArray & points, double tolerance)
+{
+    std::vector<std::size_t> component(points.size());
+    std::iota(component.begin(), component.end(), 0);
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (std::size_t idx1 = 0; idx1 < points.size(); ++idx1)
+        {
+            for (std::size_t idx2 = idx1 + 1; idx2 < points.size(); ++idx2)
+            {
+                if (points[idx1].equals(points[idx2], tolerance) && component[idx1] != component[idx2])
+                {
+                    component[idx1] = component[idx2] = std::min(component[idx1], component[idx2]);
+                    changed = true;
+                }
+            }
+        }
+    }
+    return component;
+}
+
+bool samePoints(const GPoint3DArray & points1, const GPoint3DArray & points2)
+{
+    return std::equal(points1.begin(), points1.end(), points2.begin(), points2.end(),
+                      [](const GPoint3D & pt1, const GPoint3D & pt2)
+    {
+        return std::equal(pt1.data(), pt1.data() + 3, pt2.data());
+    });
+}
+
+} //namespace
+
+TEST(GWeldTest, test_empty)
+{
+    const GWeldResult res = weldPoints(GPoint3DArray());
+    EXPECT_TRUE(res.points.empty());
+    EXPECT_TRUE(res.remap.empty());
+}
+
+TEST(GWeldTest, test_invalidTolerance)
+{
+    const GPoint3DArray points = { GPoint3D(0.0, 0.0, 0.0) };
+    EXPECT_THROW(weldPoints(points, 0.0), std::invalid_argument);
+    EXPECT_THROW(weldPoints(points, -1.0), std::invalid_argument);
+}
+
+TEST(GWeldTest, test_simple)
+{
+    const GPoint3DArray points = { GPoint3D(1.0, 0.0, 0.0), GPoint3D(0.0, 0.0, 0.0), GPoint3D(1.0, 0.05, 0.0),
+                                   GPoint3D(0.0, 0.0, 1.0) };
+    const GWeldResult res = weldPoints(points, 0.1);
+    ASSERT_EQ(3u, res.points.size());
+    EXPECT_TRUE(res.points[0].equals(GPoint3D(0.0, 0.0, 0.0)));
+    EXPECT_TRUE(res.points[1].equals(GPoint3D(0.0, 0.0, 1.0)));
+    EXPECT_TRUE(res.points[2].equals(GPoint3D(1.0, 0.0, 0.0)));
+    EXPECT_EQ((std::vector<std::size_t>{ 2, 0, 2, 1 }), res.remap);
+}
+
+TEST(GWeldTest, test_chain)
+{
+    // Neighbours are coincident, ends are not: whole chain is one point
+    GPoint3DArray points;
+    for (int idx = 9; idx >= 0; --idx)
+        points.emplace_back(idx * 0.09, 0.0, 0.0);
+    points.emplace_back(5.0, 0.0, 0.0);
+    const GWeldResult res = weldPoints(points, 0.1);
+    ASSERT_EQ(2u, res.points.size());
+    EXPECT_TRUE(res.points[0].equals(GPoint3D(0.0, 0.0, 0.0)));
+    EXPECT_TRUE(res.points[1].equals(GPoint3D(5.0, 0.0, 0.0)));
+    for (std::size_t idx = 0; idx < 10; ++idx)
+        EXPECT_EQ(0u, res.remap[idx]);
+    EXPECT_EQ(1u, res.remap[10]);
+}
+
+TEST(GWeldTest, test_bruteForce)
+{
+    const double tolerance = 0.01;
+    const GPoint3DArray points = clusteredPoints(2000, tolerance);
+    const GWeldResult res = weldPoints(points, tolerance);
+    const std::vector<std::size_t> component = bruteForceComponents(points, tolerance);
+
+    ASSERT_EQ(points.size(), res.remap.size());
+    for (std::size_t idx1 = 0; idx1 < points.size(); ++idx1)
+    {
+        ASSERT_LT(res.remap[idx1], res.points.size());
+        for (std::size_t idx2 = idx1 + 1; idx2 < points.size(); ++idx2)
+            ASSERT_EQ(component[idx1] == component[idx2], res.remap[idx1] == res.remap[idx2]);
+    }
+
+    // Unique point is the smallest point of its cluster, unique points are sorted
+    for (std::size_t idx = 0; idx < points.size(); ++idx)
+    {
+        const GPoint3D & rep = res.points[res.remap[idx]];
+        EXPECT_FALSE(std::lexicographical_compare(points[idx].data(), points[idx].data() + 3, rep.data(),
+                                                  rep.data() + 3));
+    }
+    for (std::size_t idx = 1; idx < res.points.size(); ++idx)
+    {
+        EXPECT_TRUE(std::lexicographical_compare(res.points[idx - 1].data(), res.points[idx - 1].data() + 3,
+                                                 res.points[idx].data(), res.points[idx].data() + 3));
+    }
+}
+
+TEST(GWeldTest, test_coincident)
+{
+    // Exact duplicates and a dense cluster on the cell boundary: both are welded in linear time
+    const double tolerance = 0.01;
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> noise(-0.1 * tolerance, 0.1 * tolerance);
+    GPoint3DArray points;
+    for (std::size_t idx = 0; idx < 200000; ++idx)
+    {
+        if (idx % 2 == 0)
+            points.emplace_back(-1.0, 2.0, 3.0);
+        else
+            points.emplace_back(0.5 + noise(gen), 0.5 + noise(gen), 0.5 + noise(gen));
+    }
+    const GWeldResult res = weldPoints(points, tolerance, 1);
+    ASSERT_EQ(2u, res.points.size());
+    for (std::size_t idx = 0; idx < points.size(); ++idx)
+        ASSERT_EQ(idx % 2, res.remap[idx]);
+}
+
+TEST(GWeldTest, test_deterministic)
+{
+    const double tolerance = 0.01;
+    const GPoint3DArray points = clusteredPoints(50000, tolerance);
+    const GWeldResult res = weldPoints(points, tolerance, 1);
+
+    const GWeldResult parallelRes = weldPoints(points, tolerance, 4);
+    EXPECT_TRUE(samePoints(res.points, parallelRes.points));
+    EXPECT_EQ(res.remap, parallelRes.remap);
+
+    // Permutation of source points permutes remap only
+    std::vector<std::size_t> order(points.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(7));
+    GPoint3DArray shuffled(points.size());
+    for (std::size_t idx = 0; idx < order.size(); ++idx)
+        shuffled[idx] = points[order[idx]];
+    const GWeldResult shuffledRes = weldPoints(shuffled, tolerance, 4);
+    EXPECT_TRUE(samePoints(res.points, shuffledRes.points));
+    for (std::size_t idx = 0; idx < order.size(); ++idx)
+        ASSERT_EQ(res.remap[order[idx]], shuffledRes.remap[idx]);
+}
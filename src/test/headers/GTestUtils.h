@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////
+// Simple Geometric Library (sglib)
+// Copyright (C) 2020   Artemiy Kanshin
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef _GTESTUTILS_H_
+#define _GTESTUTILS_H_
+
+#include "GCollections.h"
+#include "GPoint3D.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace sgl
+{
+namespace test
+{
+
+/**
+ * @brief Returns points uniformly distributed in the cube [-extent, extent]^3.
+ */
+inline GPoint3DArray randomPoints(std::size_t count, double extent, unsigned seed = 42)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-extent, extent);
+    GPoint3DArray res(count);
+    for (auto & pt : res)
+        pt = GPoint3D(dist(gen), dist(gen), dist(gen));
+    return res;
+}
+
+/**
+ * @brief Returns indices in ascending order, for comparing query results as sets.
+ */
+inline std::vector<std::size_t> sorted(std::vector<std::size_t> indices)
+{
+    std::sort(indices.begin(), indices.end());
+    return indices;
+}
+
+} //namespace test
+} //namespace sgl
+
+#endif //_GTESTUTILS_H_